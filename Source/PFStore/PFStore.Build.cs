@@ -26,6 +26,8 @@ public class PFStore : ModuleRules
 			new string[]
 			{
 				"Core",
+				"CoreUObject",
+				"Engine",
                 "EngineSettings",
                 "DeveloperSettings"
 				// ... add other public dependencies that you statically link with here ...
@@ -41,14 +43,13 @@ public class PFStore : ModuleRules
 				"EditorFramework",
 				"UnrealEd",
 				"ToolMenus",
-				"CoreUObject",
-				"Engine",
 				"Slate",
 				"SlateCore",
                 "Json",
                 "JsonUtilities",
                 "PlayFab",
                 "PlayFabCpp",
+                "PlayFabCommon",
                 "Settings",
 				// ... add private dependencies that you statically link with here ...	
 			}
@@ -2,13 +2,35 @@
 
 #include "PFStoreModule.h"
 
+#include "StoreItemDataAsset.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
 
 class FPFStoreModule : public IModuleInterface
 {
 public:
-    virtual void StartupModule() override {}
-    virtual void ShutdownModule() override {}
+    virtual void StartupModule() override
+    {
+        // Cached item layouts hold property offsets, which reinstanced classes no longer match.
+        ReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const auto&)
+            {
+                FStoreItemPropertyLayout::Invalidate();
+            });
+        ReloadHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](auto)
+            {
+                FStoreItemPropertyLayout::Invalidate();
+            });
+    }
+
+    virtual void ShutdownModule() override
+    {
+        FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ReinstancedHandle);
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadHandle);
+    }
+
+private:
+    FDelegateHandle ReinstancedHandle;
+    FDelegateHandle ReloadHandle;
 };
 
 IMPLEMENT_MODULE(FPFStoreModule, PFStore)
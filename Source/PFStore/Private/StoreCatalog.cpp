@@ -0,0 +1,785 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreCatalog.h"
+
+#include "StoreCatalogBlob.h"
+#include "StoreItemBitSet.h"
+#include "StoreStats.h"
+#include "StoreItemRecord.h"
+#include "StoreDropTableProvider.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+
+namespace StoreCatalogPrivate
+{
+	static constexpr uint32 SectionAlignment = 16;
+
+	static uint32 HashName(FUtf8StringView Name)
+	{
+		return CityHash32(reinterpret_cast<const char*>(Name.GetData()), Name.Len());
+	}
+
+	static FUtf8StringView NameAt(TConstArrayView<uint32> Offsets, const UTF8CHAR* Data, FStoreNameId Id)
+	{
+		return FUtf8StringView(Data + Offsets[Id], Offsets[Id + 1] - Offsets[Id]);
+	}
+
+	static bool NamesEqual(FUtf8StringView A, FUtf8StringView B)
+	{
+		return A.Len() == B.Len() && FMemory::Memcmp(A.GetData(), B.GetData(), A.Len()) == 0;
+	}
+
+	/** Linear probe over an open-addressed table. Returns the matching slot or the first empty one. */
+	static int32 ProbeSlot(TConstArrayView<FStoreNameId> Slots, TConstArrayView<uint32> Offsets, const UTF8CHAR* Data,
+		FUtf8StringView Name, uint32 Hash)
+	{
+		const uint32 Mask = Slots.Num() - 1;
+		for (uint32 Slot = Hash & Mask;; Slot = (Slot + 1) & Mask)
+		{
+			const FStoreNameId Id = Slots[Slot];
+			if (Id == INDEX_NONE || NamesEqual(NameAt(Offsets, Data, Id), Name))
+			{
+				return Slot;
+			}
+		}
+	}
+
+	static uint32 GetSectionElementSize(EStoreCatalogSection Section)
+	{
+		switch (Section)
+		{
+		case EStoreCatalogSection::StringOffsets:
+			return sizeof(uint32);
+		case EStoreCatalogSection::StringData:
+			return sizeof(UTF8CHAR);
+		case EStoreCatalogSection::Flags:
+			return sizeof(EStoreItemFlags);
+		case EStoreCatalogSection::Currencies:
+			return sizeof(FCurrencyCode);
+		case EStoreCatalogSection::CurrencyAmounts:
+			return sizeof(FStoreCurrencyAmount);
+		case EStoreCatalogSection::DropNodes:
+			return sizeof(FStoreDropNode);
+		case EStoreCatalogSection::TagBits:
+			return sizeof(uint64);
+		case EStoreCatalogSection::Tags:
+		case EStoreCatalogSection::Prices:
+		case EStoreCatalogSection::BundledItems:
+		case EStoreCatalogSection::BundledResultTables:
+		case EStoreCatalogSection::BundledCurrencies:
+		case EStoreCatalogSection::ContainerItems:
+		case EStoreCatalogSection::ContainerResultTables:
+		case EStoreCatalogSection::ContainerCurrencies:
+		case EStoreCatalogSection::DropTableNodes:
+			return sizeof(FStoreSpan);
+		default:
+			return sizeof(int32);
+		}
+	}
+
+	/**
+	 * Cheap structural checks: every section lies inside the payload and the section counts agree.
+	 * Section contents (spans, name ids, node types) are not checked, so a blob that may be
+	 * damaged must also pass the payload checksum, see LoadCooked's bVerifyPayload.
+	 */
+	static bool ValidateSections(const FStoreCatalogSectionEntry* Sections, uint32 PayloadSize)
+	{
+		for (int32 Index = 0; Index < (int32)EStoreCatalogSection::Count; ++Index)
+		{
+			const uint64 End = uint64(Sections[Index].Offset) + uint64(Sections[Index].Num) * GetSectionElementSize((EStoreCatalogSection)Index);
+			if (Sections[Index].Offset % SectionAlignment != 0 || End > PayloadSize)
+			{
+				return false;
+			}
+		}
+
+		auto Num = [Sections](EStoreCatalogSection Section) { return Sections[(int32)Section].Num; };
+
+		const uint32 NumNames = Num(EStoreCatalogSection::ItemByName);
+		const uint32 NumItems = Num(EStoreCatalogSection::ItemIds);
+		const uint32 NumBundles = Num(EStoreCatalogSection::BundledItems);
+		const uint32 NumContainers = Num(EStoreCatalogSection::ContainerKeyItems);
+		const uint32 NumSlots = Num(EStoreCatalogSection::NameSlots);
+
+		const bool bNamesOk =
+			Num(EStoreCatalogSection::StringOffsets) == NumNames + 1 &&
+			Num(EStoreCatalogSection::DropTableByName) == NumNames &&
+			NumSlots > NumNames && FMath::IsPowerOfTwo(NumSlots);
+
+		bool bItemsOk = true;
+		for (EStoreCatalogSection Column = EStoreCatalogSection::ItemIds; Column <= EStoreCatalogSection::ContainerIndices;
+			Column = (EStoreCatalogSection)((int32)Column + 1))
+		{
+			bItemsOk &= Num(Column) == NumItems;
+		}
+
+		const bool bBundlesOk =
+			Num(EStoreCatalogSection::BundledResultTables) == NumBundles &&
+			Num(EStoreCatalogSection::BundledCurrencies) == NumBundles;
+
+		const bool bContainersOk =
+			Num(EStoreCatalogSection::ContainerItems) == NumContainers &&
+			Num(EStoreCatalogSection::ContainerResultTables) == NumContainers &&
+			Num(EStoreCatalogSection::ContainerCurrencies) == NumContainers;
+
+		const bool bDropTablesOk = Num(EStoreCatalogSection::DropTableNodes) == Num(EStoreCatalogSection::DropTableIds);
+
+		const bool bTagsOk =
+			Num(EStoreCatalogSection::TagByName) == NumNames &&
+			uint64(Num(EStoreCatalogSection::TagBits)) == uint64(Num(EStoreCatalogSection::TagNames)) * FStoreItemBitSet::GetNumWords(NumItems);
+
+		const bool bPricesOk =
+			uint64(Num(EStoreCatalogSection::PriceColumns)) == uint64(Num(EStoreCatalogSection::Currencies)) * FStoreItemBitSet::GetNumWords(NumItems) * 64;
+
+		return bNamesOk && bItemsOk && bBundlesOk && bContainersOk && bDropTablesOk && bTagsOk && bPricesOk;
+	}
+
+	static FUtf8StringView ToUtf8(const FString& Str, TArray<UTF8CHAR, TInlineAllocator<256>>& Scratch)
+	{
+		const FTCHARToUTF8 Converted(*Str, Str.Len());
+		Scratch.SetNumUninitialized(Converted.Length(), EAllowShrinking::No);
+		FMemory::Memcpy(Scratch.GetData(), Converted.Get(), Converted.Length());
+		return FUtf8StringView(Scratch.GetData(), Scratch.Num());
+	}
+}
+
+// ---------- FStoreCatalog ----------
+
+FStoreCatalog::FStoreCatalog() = default;
+
+FStoreCatalog::~FStoreCatalog()
+{
+	if (bTracked)
+	{
+		DEC_DWORD_STAT(STAT_PFStore_LiveCatalogs);
+		DEC_MEMORY_STAT_BY(STAT_PFStore_CatalogHeapMemory, TrackedHeapBytes);
+		DEC_MEMORY_STAT_BY(STAT_PFStore_CatalogMappedMemory, TrackedMappedBytes);
+	}
+}
+
+void FStoreCatalog::TrackMemory()
+{
+	check(!bTracked);
+	bTracked = true;
+	TrackedHeapBytes = Storage.GetAllocatedSize();
+	TrackedMappedBytes = MappedRegion ? MappedRegion->GetMappedSize() : 0;
+
+	INC_DWORD_STAT(STAT_PFStore_LiveCatalogs);
+	INC_MEMORY_STAT_BY(STAT_PFStore_CatalogHeapMemory, TrackedHeapBytes);
+	INC_MEMORY_STAT_BY(STAT_PFStore_CatalogMappedMemory, TrackedMappedBytes);
+}
+
+TSharedPtr<const FStoreCatalog> FStoreCatalog::LoadCooked(const FString& FilePath, EStoreCatalogLoadResult& OutResult, bool bVerifyPayload)
+{
+	PFSTORE_SCOPE(CatalogLoad);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion(0, MappedFile->GetFileSize()) : nullptr);
+
+	if (!MappedRegion)
+	{
+		// No mapping support on this platform (or the file is missing): read it once, it is still used in place.
+		TArray<uint8> Blob;
+		if (!FFileHelper::LoadFileToArray(Blob, *FilePath, FILEREAD_Silent))
+		{
+			OutResult = EStoreCatalogLoadResult::FileNotFound;
+			return nullptr;
+		}
+		return LoadCooked(MoveTemp(Blob), OutResult, bVerifyPayload);
+	}
+
+	const uint8* Blob = MappedRegion->GetMappedPtr();
+	const int64 BlobSize = MappedRegion->GetMappedSize();
+
+	TSharedRef<FStoreCatalog> Catalog = MakeShareable(new FStoreCatalog());
+	Catalog->MappedFile = MoveTemp(MappedFile);
+	Catalog->MappedRegion = MoveTemp(MappedRegion);
+
+	return FromBlob(Catalog, Blob, BlobSize, OutResult, bVerifyPayload);
+}
+
+TSharedPtr<const FStoreCatalog> FStoreCatalog::LoadCooked(TArray<uint8>&& Blob, EStoreCatalogLoadResult& OutResult, bool bVerifyPayload)
+{
+	PFSTORE_SCOPE(CatalogLoad);
+
+	TSharedRef<FStoreCatalog> Catalog = MakeShareable(new FStoreCatalog());
+	Catalog->Storage = MoveTemp(Blob);
+
+	return FromBlob(Catalog, Catalog->Storage.GetData(), Catalog->Storage.Num(), OutResult, bVerifyPayload);
+}
+
+TSharedPtr<const FStoreCatalog> FStoreCatalog::FromBlob(TSharedRef<FStoreCatalog> Catalog, const uint8* Blob, int64 BlobSize,
+	EStoreCatalogLoadResult& OutResult, bool bVerifyPayload)
+{
+	using namespace StoreCatalogPrivate;
+
+	FStoreCatalogBlobHeader Header;
+	if (BlobSize < (int64)sizeof(Header))
+	{
+		OutResult = EStoreCatalogLoadResult::BadHeader;
+		return nullptr;
+	}
+	FMemory::Memcpy(&Header, Blob, sizeof(Header));
+
+	if (Header.Magic != FStoreCatalogBlobHeader::ExpectedMagic)
+	{
+		OutResult = EStoreCatalogLoadResult::BadHeader;
+		return nullptr;
+	}
+
+	if (Header.Version != FStoreCatalogBlobHeader::CurrentVersion || Header.NumSections != (uint32)EStoreCatalogSection::Count)
+	{
+		OutResult = EStoreCatalogLoadResult::VersionMismatch;
+		return nullptr;
+	}
+
+	const uint32 HeaderCrc = Header.HeaderCrc;
+	Header.HeaderCrc = 0;
+	if (FCrc::MemCrc32(&Header, sizeof(Header)) != HeaderCrc)
+	{
+		OutResult = EStoreCatalogLoadResult::ChecksumMismatch;
+		return nullptr;
+	}
+
+	if (Header.PayloadOffset < sizeof(Header) || Header.PayloadOffset % SectionAlignment != 0 ||
+		int64(Header.PayloadOffset) + Header.PayloadSize > BlobSize ||
+		!ValidateSections(Header.Sections, Header.PayloadSize))
+	{
+		OutResult = EStoreCatalogLoadResult::BadHeader;
+		return nullptr;
+	}
+
+	const uint8* Payload = Blob + Header.PayloadOffset;
+	if (bVerifyPayload && FCrc::MemCrc32(Payload, Header.PayloadSize) != Header.PayloadCrc)
+	{
+		OutResult = EStoreCatalogLoadResult::ChecksumMismatch;
+		return nullptr;
+	}
+
+	Catalog->Base = Payload;
+	Catalog->DataSize = Header.PayloadSize;
+	FMemory::Memcpy(Catalog->Sections, Header.Sections, sizeof(Header.Sections));
+	Catalog->TrackMemory();
+
+	OutResult = EStoreCatalogLoadResult::Success;
+	return Catalog;
+}
+
+void FStoreCatalog::WriteCooked(TArray<uint8>& OutBlob) const
+{
+	using namespace StoreCatalogPrivate;
+
+	FStoreCatalogBlobHeader Header;
+	Header.PayloadOffset = Align((uint32)sizeof(Header), SectionAlignment);
+	Header.PayloadSize = DataSize;
+	Header.PayloadCrc = FCrc::MemCrc32(Base, DataSize);
+	FMemory::Memcpy(Header.Sections, Sections, sizeof(Sections));
+	Header.HeaderCrc = FCrc::MemCrc32(&Header, sizeof(Header));
+
+	OutBlob.Reset();
+	OutBlob.SetNumZeroed(Header.PayloadOffset + DataSize);
+	FMemory::Memcpy(OutBlob.GetData(), &Header, sizeof(Header));
+	FMemory::Memcpy(OutBlob.GetData() + Header.PayloadOffset, Base, DataSize);
+}
+
+FStoreNameId FStoreCatalog::FindName(FUtf8StringView Name) const
+{
+	using namespace StoreCatalogPrivate;
+
+	const TConstArrayView<FStoreNameId> Slots = GetSection<FStoreNameId>(EStoreCatalogSection::NameSlots);
+	if (Slots.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const TConstArrayView<uint32> Offsets = GetSection<uint32>(EStoreCatalogSection::StringOffsets);
+	const UTF8CHAR* Data = GetSection<UTF8CHAR>(EStoreCatalogSection::StringData).GetData();
+
+	return Slots[ProbeSlot(Slots, Offsets, Data, Name, HashName(Name))];
+}
+
+FStoreNameId FStoreCatalog::FindName(FStringView Name) const
+{
+	const FTCHARToUTF8 Converted(Name.GetData(), Name.Len());
+	return FindName(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Converted.Get()), Converted.Length()));
+}
+
+FUtf8StringView FStoreCatalog::GetName(FStoreNameId Id) const
+{
+	return StoreCatalogPrivate::NameAt(
+		GetSection<uint32>(EStoreCatalogSection::StringOffsets),
+		GetSection<UTF8CHAR>(EStoreCatalogSection::StringData).GetData(),
+		Id);
+}
+
+FString FStoreCatalog::GetNameString(FStoreNameId Id) const
+{
+	const FUtf8StringView Name = GetName(Id);
+	const FUTF8ToTCHAR Converted(Name.GetData(), Name.Len());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+FStoreItemHandle FStoreCatalog::FindItem(FStringView ItemId) const
+{
+	return FindItemByName(FindName(ItemId));
+}
+
+FStoreItemHandle FStoreCatalog::FindItemByName(FStoreNameId ItemId) const
+{
+	if (ItemId == INDEX_NONE)
+	{
+		return FStoreItemHandle();
+	}
+	return FStoreItemHandle(GetSection<int32>(EStoreCatalogSection::ItemByName)[ItemId]);
+}
+
+TConstArrayView<FStoreNameId> FStoreCatalog::GetTags(FStoreItemHandle Item) const
+{
+	return Pool<FStoreNameId>(EStoreCatalogSection::NameLists, Column<FStoreSpan>(EStoreCatalogSection::Tags, Item));
+}
+
+TConstArrayView<FStoreCurrencyAmount> FStoreCatalog::GetPrices(FStoreItemHandle Item) const
+{
+	return Pool<FStoreCurrencyAmount>(EStoreCatalogSection::CurrencyAmounts, Column<FStoreSpan>(EStoreCatalogSection::Prices, Item));
+}
+
+int32 FStoreCatalog::GetPriceColumnStride() const
+{
+	return FStoreItemBitSet::GetNumWords(NumItems()) * 64;
+}
+
+TConstArrayView<int32> FStoreCatalog::GetPriceColumn(int32 CurrencyIndex) const
+{
+	const int32 Stride = GetPriceColumnStride();
+	return GetSection<int32>(EStoreCatalogSection::PriceColumns).Slice(CurrencyIndex * Stride, Stride);
+}
+
+TConstArrayView<FStoreNameId> FStoreCatalog::GetBundledItems(FStoreItemHandle Item) const
+{
+	const int32 Bundle = Column<int32>(EStoreCatalogSection::BundleIndices, Item);
+	if (Bundle == INDEX_NONE)
+	{
+		return {};
+	}
+	return Pool<FStoreNameId>(EStoreCatalogSection::NameLists, GetSection<FStoreSpan>(EStoreCatalogSection::BundledItems)[Bundle]);
+}
+
+TConstArrayView<FStoreNameId> FStoreCatalog::GetBundledResultTables(FStoreItemHandle Item) const
+{
+	const int32 Bundle = Column<int32>(EStoreCatalogSection::BundleIndices, Item);
+	if (Bundle == INDEX_NONE)
+	{
+		return {};
+	}
+	return Pool<FStoreNameId>(EStoreCatalogSection::NameLists, GetSection<FStoreSpan>(EStoreCatalogSection::BundledResultTables)[Bundle]);
+}
+
+TConstArrayView<FStoreCurrencyAmount> FStoreCatalog::GetBundledCurrencies(FStoreItemHandle Item) const
+{
+	const int32 Bundle = Column<int32>(EStoreCatalogSection::BundleIndices, Item);
+	if (Bundle == INDEX_NONE)
+	{
+		return {};
+	}
+	return Pool<FStoreCurrencyAmount>(EStoreCatalogSection::CurrencyAmounts, GetSection<FStoreSpan>(EStoreCatalogSection::BundledCurrencies)[Bundle]);
+}
+
+FStoreNameId FStoreCatalog::GetContainerKeyItem(FStoreItemHandle Item) const
+{
+	const int32 Container = Column<int32>(EStoreCatalogSection::ContainerIndices, Item);
+	if (Container == INDEX_NONE)
+	{
+		return 0;
+	}
+	return GetSection<FStoreNameId>(EStoreCatalogSection::ContainerKeyItems)[Container];
+}
+
+TConstArrayView<FStoreNameId> FStoreCatalog::GetContainerItems(FStoreItemHandle Item) const
+{
+	const int32 Container = Column<int32>(EStoreCatalogSection::ContainerIndices, Item);
+	if (Container == INDEX_NONE)
+	{
+		return {};
+	}
+	return Pool<FStoreNameId>(EStoreCatalogSection::NameLists, GetSection<FStoreSpan>(EStoreCatalogSection::ContainerItems)[Container]);
+}
+
+TConstArrayView<FStoreNameId> FStoreCatalog::GetContainerResultTables(FStoreItemHandle Item) const
+{
+	const int32 Container = Column<int32>(EStoreCatalogSection::ContainerIndices, Item);
+	if (Container == INDEX_NONE)
+	{
+		return {};
+	}
+	return Pool<FStoreNameId>(EStoreCatalogSection::NameLists, GetSection<FStoreSpan>(EStoreCatalogSection::ContainerResultTables)[Container]);
+}
+
+TConstArrayView<FStoreCurrencyAmount> FStoreCatalog::GetContainerCurrencies(FStoreItemHandle Item) const
+{
+	const int32 Container = Column<int32>(EStoreCatalogSection::ContainerIndices, Item);
+	if (Container == INDEX_NONE)
+	{
+		return {};
+	}
+	return Pool<FStoreCurrencyAmount>(EStoreCatalogSection::CurrencyAmounts, GetSection<FStoreSpan>(EStoreCatalogSection::ContainerCurrencies)[Container]);
+}
+
+int32 FStoreCatalog::FindDropTable(FStringView TableId) const
+{
+	const FStoreNameId Id = FindName(TableId);
+	if (Id == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+	return GetSection<int32>(EStoreCatalogSection::DropTableByName)[Id];
+}
+
+TConstArrayView<FStoreDropNode> FStoreCatalog::GetDropTableNodes(int32 Table) const
+{
+	return Pool<FStoreDropNode>(EStoreCatalogSection::DropNodes, GetSection<FStoreSpan>(EStoreCatalogSection::DropTableNodes)[Table]);
+}
+
+int32 FStoreCatalog::FindTag(FStringView Tag) const
+{
+	const FStoreNameId Id = FindName(Tag);
+	if (Id == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+	return GetSection<int32>(EStoreCatalogSection::TagByName)[Id];
+}
+
+TConstArrayView<uint64> FStoreCatalog::GetTagBits(int32 Tag) const
+{
+	const int32 NumWords = FStoreItemBitSet::GetNumWords(NumItems());
+	return GetSection<uint64>(EStoreCatalogSection::TagBits).Slice(Tag * NumWords, NumWords);
+}
+
+const TCHAR* LexToString(EStoreCatalogLoadResult Result)
+{
+	switch (Result)
+	{
+	case EStoreCatalogLoadResult::Success:          return TEXT("Success");
+	case EStoreCatalogLoadResult::FileNotFound:     return TEXT("FileNotFound");
+	case EStoreCatalogLoadResult::BadHeader:        return TEXT("BadHeader");
+	case EStoreCatalogLoadResult::VersionMismatch:  return TEXT("VersionMismatch");
+	case EStoreCatalogLoadResult::ChecksumMismatch: return TEXT("ChecksumMismatch");
+	default:                                        return TEXT("Unknown");
+	}
+}
+
+// ---------- FStoreCatalogBuilder ----------
+
+FStoreCatalogBuilder::FStoreCatalogBuilder()
+{
+	StringOffsets.Add(0);
+	NameSlots.Init(INDEX_NONE, 64);
+
+	// Id 0 is the empty string so unset fields never need a special case.
+	Intern(FString());
+}
+
+FStoreNameId FStoreCatalogBuilder::FindName(FUtf8StringView Name, uint32 Hash) const
+{
+	return NameSlots[StoreCatalogPrivate::ProbeSlot(NameSlots, StringOffsets, StringData.GetData(), Name, Hash)];
+}
+
+void FStoreCatalogBuilder::GrowNameSlots()
+{
+	using namespace StoreCatalogPrivate;
+
+	NameSlots.Init(INDEX_NONE, NameSlots.Num() * 2);
+
+	const int32 NumNames = StringOffsets.Num() - 1;
+	for (FStoreNameId Id = 0; Id < NumNames; ++Id)
+	{
+		const FUtf8StringView Name = NameAt(StringOffsets, StringData.GetData(), Id);
+		NameSlots[ProbeSlot(NameSlots, StringOffsets, StringData.GetData(), Name, HashName(Name))] = Id;
+	}
+}
+
+FStoreNameId FStoreCatalogBuilder::Intern(const FString& Str)
+{
+	using namespace StoreCatalogPrivate;
+
+	TArray<UTF8CHAR, TInlineAllocator<256>> Scratch;
+	const FUtf8StringView Name = ToUtf8(Str, Scratch);
+	const uint32 Hash = HashName(Name);
+
+	const int32 Slot = ProbeSlot(NameSlots, StringOffsets, StringData.GetData(), Name, Hash);
+	if (NameSlots[Slot] != INDEX_NONE)
+	{
+		return NameSlots[Slot];
+	}
+
+	const FStoreNameId Id = StringOffsets.Num() - 1;
+	StringData.Append(Name.GetData(), Name.Len());
+	StringOffsets.Add(StringData.Num());
+	ItemByName.Add(INDEX_NONE);
+	DropTableByName.Add(INDEX_NONE);
+	NameSlots[Slot] = Id;
+
+	// Keep the load factor at or below one half so probes stay short.
+	if ((Id + 1) * 2 > NameSlots.Num())
+	{
+		GrowNameSlots();
+	}
+
+	return Id;
+}
+
+uint16 FStoreCatalogBuilder::InternCurrency(FCurrencyCode Code)
+{
+	const int32 Existing = Currencies.Find(Code);
+	if (Existing != INDEX_NONE)
+	{
+		return static_cast<uint16>(Existing);
+	}
+
+	check(Currencies.Num() < MAX_uint16);
+	return static_cast<uint16>(Currencies.Add(Code));
+}
+
+FStoreSpan FStoreCatalogBuilder::AddNameList(const TArray<FString>& Names)
+{
+	FStoreSpan Span;
+	Span.Start = NameLists.Num();
+	Span.Num = Names.Num();
+
+	for (const FString& Name : Names)
+	{
+		NameLists.Add(Intern(Name));
+	}
+	return Span;
+}
+
+FStoreSpan FStoreCatalogBuilder::AddCurrencyAmounts(const FCurrencyAmounts& Amounts)
+{
+	FStoreSpan Span;
+	Span.Start = CurrencyAmounts.Num();
+	Span.Num = Amounts.Num();
+
+	for (const FCurrencyAmount& Entry : Amounts)
+	{
+		FStoreCurrencyAmount& Amount = CurrencyAmounts.AddDefaulted_GetRef();
+		Amount.Currency = InternCurrency(Entry.Code);
+		Amount.Amount = Entry.Amount;
+	}
+	return Span;
+}
+
+FStoreItemHandle FStoreCatalogBuilder::AddItem(const FStoreItemRecord& Record)
+{
+	const FStoreNameId ItemId = Intern(Record.ItemId);
+	if (ItemByName[ItemId] != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FStoreCatalogBuilder: duplicate ItemId %s skipped"), *Record.ItemId);
+		return FStoreItemHandle();
+	}
+
+	const int32 Index = ItemIds.Add(ItemId);
+	ItemByName[ItemId] = Index;
+
+	DisplayNames.Add(Intern(Record.DisplayName));
+	ItemClasses.Add(Intern(Record.ItemClass));
+	Descriptions.Add(Intern(Record.Description));
+	CustomData.Add(Intern(Record.CustomData));
+	UsagePeriodGroups.Add(Intern(Record.Consumable.UsagePeriodGroup));
+	UsageCounts.Add(Record.Consumable.UsageCount);
+	UsagePeriods.Add(Record.Consumable.UsagePeriod);
+	Tags.Add(AddNameList(Record.Tags));
+	Prices.Add(AddCurrencyAmounts(Record.Prices));
+
+	EStoreItemFlags ItemFlags = EStoreItemFlags::None;
+	if (Record.bIsLimitedEdition) ItemFlags |= EStoreItemFlags::LimitedEdition;
+	if (Record.bIsTokenForCharacterCreation) ItemFlags |= EStoreItemFlags::TokenForCharacterCreation;
+	if (Record.bIsTradable) ItemFlags |= EStoreItemFlags::Tradable;
+	if (Record.bIsStackable) ItemFlags |= EStoreItemFlags::Stackable;
+
+	if (Record.bIsBundle)
+	{
+		ItemFlags |= EStoreItemFlags::Bundle;
+		BundleIndices.Add(BundledItems.Num());
+		BundledItems.Add(AddNameList(Record.Bundle.BundledItems));
+		BundledResultTables.Add(AddNameList(Record.Bundle.BundledResultTables));
+		BundledCurrencies.Add(AddCurrencyAmounts(Record.Bundle.BundledVirtualCurrencies));
+	}
+	else
+	{
+		BundleIndices.Add(INDEX_NONE);
+	}
+
+	if (Record.bIsContainer)
+	{
+		ItemFlags |= EStoreItemFlags::Container;
+		ContainerIndices.Add(ContainerKeyItems.Num());
+		ContainerKeyItems.Add(Intern(Record.Container.KeyItemId));
+		ContainerItems.Add(AddNameList(Record.Container.ItemContents));
+		ContainerResultTables.Add(AddNameList(Record.Container.ResultTableContents));
+		ContainerCurrencies.Add(AddCurrencyAmounts(Record.Container.VirtualCurrencyContents));
+	}
+	else
+	{
+		ContainerIndices.Add(INDEX_NONE);
+	}
+
+	Flags.Add(ItemFlags);
+
+	return FStoreItemHandle(Index);
+}
+
+int32 FStoreCatalogBuilder::AddDropTable(const FDropTableInfo& Table)
+{
+	const FStoreNameId TableId = Intern(Table.TableId);
+	if (DropTableByName[TableId] != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FStoreCatalogBuilder: duplicate TableId %s skipped"), *Table.TableId);
+		return INDEX_NONE;
+	}
+
+	const int32 Index = DropTableIds.Add(TableId);
+	DropTableByName[TableId] = Index;
+
+	FStoreSpan Span;
+	Span.Start = DropNodes.Num();
+	Span.Num = Table.Nodes.Num();
+
+	for (const FDropTableNode& Node : Table.Nodes)
+	{
+		FStoreDropNode& Out = DropNodes.AddDefaulted_GetRef();
+		Out.ResultItemType = Intern(Node.ResultItemType);
+		Out.ResultItem = Intern(Node.ResultItem);
+		Out.Weight = Node.Weight;
+	}
+	DropTableNodes.Add(Span);
+
+	return Index;
+}
+
+TSharedRef<const FStoreCatalog> FStoreCatalogBuilder::Build() const
+{
+	using namespace StoreCatalogPrivate;
+	PFSTORE_SCOPE(CatalogBuild);
+
+	TSharedRef<FStoreCatalog> Catalog = MakeShareable(new FStoreCatalog());
+	TArray<uint8>& Storage = Catalog->Storage;
+
+	auto AddSection = [&Storage, &Catalog](EStoreCatalogSection Section, const auto& Values)
+		{
+			check(Values.GetTypeSize() == GetSectionElementSize(Section));
+
+			const uint32 Bytes = Values.Num() * Values.GetTypeSize();
+			const uint32 Offset = Align(Storage.Num(), SectionAlignment);
+
+			Storage.SetNumZeroed(Offset + Bytes, EAllowShrinking::No);
+			FMemory::Memcpy(Storage.GetData() + Offset, Values.GetData(), Bytes);
+
+			Catalog->Sections[(int32)Section].Offset = Offset;
+			Catalog->Sections[(int32)Section].Num = Values.Num();
+		};
+
+	AddSection(EStoreCatalogSection::StringOffsets, StringOffsets);
+	AddSection(EStoreCatalogSection::StringData, StringData);
+	AddSection(EStoreCatalogSection::NameSlots, NameSlots);
+	AddSection(EStoreCatalogSection::ItemByName, ItemByName);
+
+	AddSection(EStoreCatalogSection::Currencies, Currencies);
+	AddSection(EStoreCatalogSection::NameLists, NameLists);
+	AddSection(EStoreCatalogSection::CurrencyAmounts, CurrencyAmounts);
+
+	AddSection(EStoreCatalogSection::ItemIds, ItemIds);
+	AddSection(EStoreCatalogSection::DisplayNames, DisplayNames);
+	AddSection(EStoreCatalogSection::ItemClasses, ItemClasses);
+	AddSection(EStoreCatalogSection::Descriptions, Descriptions);
+	AddSection(EStoreCatalogSection::CustomData, CustomData);
+	AddSection(EStoreCatalogSection::UsagePeriodGroups, UsagePeriodGroups);
+	AddSection(EStoreCatalogSection::Flags, Flags);
+	AddSection(EStoreCatalogSection::UsageCounts, UsageCounts);
+	AddSection(EStoreCatalogSection::UsagePeriods, UsagePeriods);
+	AddSection(EStoreCatalogSection::Tags, Tags);
+	AddSection(EStoreCatalogSection::Prices, Prices);
+	AddSection(EStoreCatalogSection::BundleIndices, BundleIndices);
+	AddSection(EStoreCatalogSection::ContainerIndices, ContainerIndices);
+
+	AddSection(EStoreCatalogSection::BundledItems, BundledItems);
+	AddSection(EStoreCatalogSection::BundledResultTables, BundledResultTables);
+	AddSection(EStoreCatalogSection::BundledCurrencies, BundledCurrencies);
+
+	AddSection(EStoreCatalogSection::ContainerKeyItems, ContainerKeyItems);
+	AddSection(EStoreCatalogSection::ContainerItems, ContainerItems);
+	AddSection(EStoreCatalogSection::ContainerResultTables, ContainerResultTables);
+	AddSection(EStoreCatalogSection::ContainerCurrencies, ContainerCurrencies);
+
+	AddSection(EStoreCatalogSection::DropTableIds, DropTableIds);
+	AddSection(EStoreCatalogSection::DropTableNodes, DropTableNodes);
+	AddSection(EStoreCatalogSection::DropNodes, DropNodes);
+	AddSection(EStoreCatalogSection::DropTableByName, DropTableByName);
+
+	// Tag dictionary and one bit set per tag, in order of first appearance.
+	{
+		TArray<FStoreNameId> TagNames;
+		TArray<int32> TagByName;
+		TagByName.Init(INDEX_NONE, ItemByName.Num());
+
+		for (const FStoreSpan& Span : Tags)
+		{
+			for (uint32 Index = Span.Start; Index < Span.Start + Span.Num; ++Index)
+			{
+				int32& Tag = TagByName[NameLists[Index]];
+				if (Tag == INDEX_NONE)
+				{
+					Tag = TagNames.Add(NameLists[Index]);
+				}
+			}
+		}
+
+		const int32 NumWords = FStoreItemBitSet::GetNumWords(ItemIds.Num());
+		TArray<uint64> TagBits;
+		TagBits.SetNumZeroed(TagNames.Num() * NumWords);
+
+		for (int32 Item = 0; Item < Tags.Num(); ++Item)
+		{
+			const FStoreSpan& Span = Tags[Item];
+			for (uint32 Index = Span.Start; Index < Span.Start + Span.Num; ++Index)
+			{
+				const int32 Tag = TagByName[NameLists[Index]];
+				TagBits[Tag * NumWords + (Item >> 6)] |= uint64(1) << (Item & 63);
+			}
+		}
+
+		AddSection(EStoreCatalogSection::TagNames, TagNames);
+		AddSection(EStoreCatalogSection::TagByName, TagByName);
+		AddSection(EStoreCatalogSection::TagBits, TagBits);
+	}
+
+	// One dense price column per currency, padding and unpriced items set to NoPrice.
+	{
+		const int32 Stride = FStoreItemBitSet::GetNumWords(ItemIds.Num()) * 64;
+		TArray<int32> PriceColumns;
+		PriceColumns.Init(FStoreCatalog::NoPrice, Currencies.Num() * Stride);
+
+		for (int32 Item = 0; Item < Prices.Num(); ++Item)
+		{
+			const FStoreSpan& Span = Prices[Item];
+			for (uint32 Index = Span.Start; Index < Span.Start + Span.Num; ++Index)
+			{
+				const FStoreCurrencyAmount& Price = CurrencyAmounts[Index];
+				PriceColumns[Price.Currency * Stride + Item] = FMath::Clamp(Price.Amount, 0, FStoreCatalog::NoPrice - 1);
+			}
+		}
+
+		AddSection(EStoreCatalogSection::PriceColumns, PriceColumns);
+	}
+
+	Storage.Shrink();
+	Catalog->Base = Storage.GetData();
+	Catalog->DataSize = Storage.Num();
+	Catalog->TrackMemory();
+
+	return Catalog;
+}
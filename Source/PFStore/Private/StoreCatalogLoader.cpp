@@ -0,0 +1,192 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreCatalogLoader.h"
+
+#include "StoreCatalog.h"
+#include "StoreCatalogBlob.h"
+#include "StoreItemRecord.h"
+#include "StoreDropTableProvider.h"
+#include "StoreStats.h"
+#include "Misc/Paths.h"
+
+#include "Core/PlayFabClientAPI.h"
+#include "Core/PlayFabServerAPI.h"
+#include "PlayFab.h"
+#include "PlayFabCommon.h"
+#include "PlayFabClientDataModels.h"
+#include "PlayFabServerDataModels.h"
+
+namespace StoreCatalogLoaderPrivate
+{
+	static void ToRecord(const PlayFab::ClientModels::FCatalogItem& In, FStoreItemRecord& Out)
+	{
+		Out.ItemId = In.ItemId;
+		Out.DisplayName = In.DisplayName;
+		Out.ItemClass = In.ItemClass;
+		Out.Description = In.Description;
+		Out.CustomData = In.CustomData;
+		Out.Tags = In.Tags;
+		Out.Prices = FCurrencyAmounts::FromMap(In.VirtualCurrencyPrices);
+
+		Out.bIsLimitedEdition = In.IsLimitedEdition;
+		Out.bIsTokenForCharacterCreation = In.CanBecomeCharacter;
+		Out.bIsTradable = In.IsTradable;
+		Out.bIsStackable = In.IsStackable;
+
+		if (In.Consumable.IsValid())
+		{
+			Out.Consumable.UsageCount = In.Consumable->UsageCount.notNull() ? static_cast<int32>(In.Consumable->UsageCount.mValue) : 0;
+			Out.Consumable.UsagePeriod = In.Consumable->UsagePeriod.notNull() ? static_cast<int32>(In.Consumable->UsagePeriod.mValue) : 0;
+			Out.Consumable.UsagePeriodGroup = In.Consumable->UsagePeriodGroup;
+		}
+
+		Out.bIsBundle = In.Bundle.IsValid();
+		if (Out.bIsBundle)
+		{
+			Out.Bundle.BundledItems = In.Bundle->BundledItems;
+			Out.Bundle.BundledResultTables = In.Bundle->BundledResultTables;
+			Out.Bundle.BundledVirtualCurrencies = FCurrencyAmounts::FromMap(In.Bundle->BundledVirtualCurrencies);
+		}
+
+		Out.bIsContainer = In.Container.IsValid();
+		if (Out.bIsContainer)
+		{
+			Out.Container.KeyItemId = In.Container->KeyItemId;
+			Out.Container.ItemContents = In.Container->ItemContents;
+			Out.Container.ResultTableContents = In.Container->ResultTableContents;
+			Out.Container.VirtualCurrencyContents = FCurrencyAmounts::FromMap(In.Container->VirtualCurrencyContents);
+		}
+	}
+
+	static void ToDropTable(const PlayFab::ServerModels::FRandomResultTableListing& In, FDropTableInfo& Out)
+	{
+		Out.TableId = In.TableId;
+		Out.Nodes.Reset(In.Nodes.Num());
+		for (const PlayFab::ServerModels::FResultTableNode& InNode : In.Nodes)
+		{
+			FDropTableNode& Node = Out.Nodes.AddDefaulted_GetRef();
+			Node.ResultItemType = InNode.ResultItemType == PlayFab::ServerModels::ResultTableNodeTypeTableId ? TEXT("TableId") : TEXT("ItemId");
+			Node.ResultItem = InNode.ResultItem;
+			Node.Weight = InNode.Weight;
+		}
+	}
+
+	/**
+	 * Adds the drop tables of CatalogVersion to Builder and then builds. The client API has no
+	 * GetRandomResultTables, so the tables come from the server API, which needs the developer
+	 * secret key; a game client without it gets a catalog without drop tables and a warning.
+	 */
+	static void LoadDropTablesAndBuild(TSharedRef<FStoreCatalogBuilder> Builder, const FString& CatalogVersion, FOnStoreCatalogLoaded OnLoaded)
+	{
+		PlayFabServerPtr ServerAPI = IPlayFabModuleInterface::Get().GetServerAPI();
+		if (!ServerAPI.IsValid() || IPlayFabCommonModuleInterface::Get().GetDeveloperSecretKey().IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No developer secret key, the store catalog from PlayFab has no drop tables"));
+			OnLoaded.ExecuteIfBound(Builder->Build());
+			return;
+		}
+
+		PlayFab::ServerModels::FGetRandomResultTablesRequest Request;
+		Request.CatalogVersion = CatalogVersion;
+
+		PFStoreStats::BeginPlayFabRequest(TEXT("PlayFab GetRandomResultTables"), 0);
+
+		PlayFab::UPlayFabServerAPI::FGetRandomResultTablesDelegate OnSuccess;
+		OnSuccess.BindLambda([Builder, OnLoaded](const PlayFab::ServerModels::FGetRandomResultTablesResult& Response)
+			{
+				PFStoreStats::EndPlayFabRequest(TEXT("PlayFab GetRandomResultTables"), 0);
+				PFSTORE_SCOPE(PlayFabResponse);
+
+				TArray<FString> TableIds;
+				Response.Tables.GetKeys(TableIds);
+				TableIds.Sort();
+
+				FDropTableInfo Table;
+				for (const FString& TableId : TableIds)
+				{
+					ToDropTable(Response.Tables[TableId], Table);
+					Builder->AddDropTable(Table);
+				}
+				OnLoaded.ExecuteIfBound(Builder->Build());
+			});
+
+		PlayFab::FPlayFabErrorDelegate OnError;
+		OnError.BindLambda([OnLoaded](const PlayFab::FPlayFabCppError& Error)
+			{
+				PFStoreStats::EndPlayFabRequest(TEXT("PlayFab GetRandomResultTables"), 0);
+				UE_LOG(LogTemp, Error, TEXT("Failed to get drop tables: %s"), *Error.ErrorMessage);
+				OnLoaded.ExecuteIfBound(nullptr);
+			});
+
+		{
+			PFSTORE_SCOPE(PlayFabRequest);
+			ServerAPI->GetRandomResultTables(Request, OnSuccess, OnError);
+		}
+	}
+}
+
+FString FStoreCatalogLoader::GetDefaultCookedPath()
+{
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("PFStore"), TEXT("StoreCatalog.pfcat"));
+}
+
+void FStoreCatalogLoader::Load(const FString& CookedPath, const FString& CatalogVersion, FOnStoreCatalogLoaded OnLoaded)
+{
+	EStoreCatalogLoadResult Result;
+	// The blob is used in place and its spans and name ids are trusted, so its payload checksum is verified once here.
+	TSharedPtr<const FStoreCatalog> Cooked = FStoreCatalog::LoadCooked(CookedPath, Result, /*bVerifyPayload=*/ true);
+	if (Cooked.IsValid())
+	{
+		OnLoaded.ExecuteIfBound(Cooked);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Cooked store catalog %s not usable (%s), requesting catalog %s from PlayFab"),
+		*CookedPath, LexToString(Result), *CatalogVersion);
+
+	PlayFabClientPtr ClientAPI = IPlayFabModuleInterface::Get().GetClientAPI();
+	if (!ClientAPI.IsValid())
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	PlayFab::ClientModels::FGetCatalogItemsRequest Request;
+	Request.CatalogVersion = CatalogVersion;
+
+	const int64 RequestBytes = UE_TRACE_CHANNELEXPR_IS_ENABLED(PFStoreChannel) ? Request.toJSONString().Len() : 0;
+	PFStoreStats::BeginPlayFabRequest(TEXT("PlayFab GetCatalogItems"), RequestBytes);
+
+	PlayFab::UPlayFabClientAPI::FGetCatalogItemsDelegate OnSuccess;
+	OnSuccess.BindLambda([OnLoaded, CatalogVersion](const PlayFab::ClientModels::FGetCatalogItemsResult& Response)
+		{
+			PFStoreStats::EndPlayFabRequest(TEXT("PlayFab GetCatalogItems"), 0);
+			TSharedRef<FStoreCatalogBuilder> Builder = MakeShared<FStoreCatalogBuilder>();
+			{
+				PFSTORE_SCOPE(PlayFabResponse);
+				PFStoreStats::AddItemsProcessed(Response.Catalog.Num());
+
+				FStoreItemRecord Record;
+				for (const PlayFab::ClientModels::FCatalogItem& Item : Response.Catalog)
+				{
+					Record = FStoreItemRecord();
+					StoreCatalogLoaderPrivate::ToRecord(Item, Record);
+					Builder->AddItem(Record);
+				}
+			}
+			StoreCatalogLoaderPrivate::LoadDropTablesAndBuild(Builder, CatalogVersion, OnLoaded);
+		});
+
+	PlayFab::FPlayFabErrorDelegate OnError;
+	OnError.BindLambda([OnLoaded](const PlayFab::FPlayFabCppError& Error)
+		{
+			PFStoreStats::EndPlayFabRequest(TEXT("PlayFab GetCatalogItems"), 0);
+			UE_LOG(LogTemp, Error, TEXT("Failed to get catalog: %s"), *Error.ErrorMessage);
+			OnLoaded.ExecuteIfBound(nullptr);
+		});
+
+	{
+		PFSTORE_SCOPE(PlayFabRequest);
+		ClientAPI->GetCatalogItems(Request, OnSuccess, OnError);
+	}
+}
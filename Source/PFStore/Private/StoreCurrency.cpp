@@ -0,0 +1,261 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreCurrency.h"
+#include "UObject/PropertyTag.h"
+#include "UObject/UnrealNames.h"
+
+FString FCurrencyCode::ToString() const
+{
+	TCHAR Chars[MaxLen];
+	int32 Len = 0;
+	for (uint32 Rest = Packed; Rest != 0 && Len < MaxLen; Rest >>= 8)
+	{
+		Chars[Len++] = static_cast<TCHAR>(Rest & 0xFF);
+	}
+	return FString(Len, Chars);
+}
+
+const int32* FCurrencyAmounts::Find(FCurrencyCode Code) const
+{
+	for (const FCurrencyAmount& Entry : Entries)
+	{
+		if (Entry.Code == Code)
+		{
+			return &Entry.Amount;
+		}
+	}
+	return nullptr;
+}
+
+int32 FCurrencyAmounts::FindRef(FCurrencyCode Code, int32 Default) const
+{
+	const int32* Amount = Find(Code);
+	return Amount ? *Amount : Default;
+}
+
+void FCurrencyAmounts::Add(FCurrencyCode Code, int32 Amount)
+{
+	if (!Code.IsValid())
+	{
+		return;
+	}
+
+	int32 Index = 0;
+	while (Index < Entries.Num() && Entries[Index].Code < Code)
+	{
+		++Index;
+	}
+
+	if (Index < Entries.Num() && Entries[Index].Code == Code)
+	{
+		Entries[Index].Amount = Amount;
+	}
+	else
+	{
+		Entries.Insert(FCurrencyAmount{ Code, Amount }, Index);
+	}
+}
+
+bool FCurrencyAmounts::Remove(FCurrencyCode Code)
+{
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].Code == Code)
+		{
+			Entries.RemoveAt(Index, 1, EAllowShrinking::No);
+			return true;
+		}
+	}
+	return false;
+}
+
+FString FCurrencyAmounts::ToString() const
+{
+	TStringBuilder<64> Builder;
+	for (const FCurrencyAmount& Entry : Entries)
+	{
+		if (Builder.Len() > 0)
+		{
+			Builder << TEXT(';');
+		}
+		Builder << Entry.Code.ToString() << TEXT(':') << Entry.Amount;
+	}
+	return FString(Builder.ToView());
+}
+
+bool FCurrencyAmounts::Parse(FStringView Text, FCurrencyAmounts& Out)
+{
+	Out.Reset();
+
+	bool bAllValid = true;
+	while (!Text.IsEmpty())
+	{
+		int32 Separator = INDEX_NONE;
+		Text.FindChar(TEXT(';'), Separator);
+
+		const FStringView Pair = (Separator == INDEX_NONE ? Text : Text.Left(Separator)).TrimStartAndEnd();
+		Text = (Separator == INDEX_NONE) ? FStringView() : Text.RightChop(Separator + 1);
+
+		if (Pair.IsEmpty())
+		{
+			continue;
+		}
+
+		int32 Colon = INDEX_NONE;
+		const FCurrencyCode Code = Pair.FindChar(TEXT(':'), Colon)
+			? FCurrencyCode::FromString(Pair.Left(Colon).TrimStartAndEnd())
+			: FCurrencyCode();
+
+		if (!Code.IsValid())
+		{
+			bAllValid = false;
+			continue;
+		}
+
+		Out.Add(Code, FCString::Atoi(*FString(Pair.RightChop(Colon + 1).TrimStartAndEnd())));
+	}
+	return bAllValid;
+}
+
+bool FCurrencyAmounts::operator==(const FCurrencyAmounts& Other) const
+{
+	if (Entries.Num() != Other.Entries.Num())
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].Code != Other.Entries[Index].Code || Entries[Index].Amount != Other.Entries[Index].Amount)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FCurrencyAmounts::Serialize(FArchive& Ar)
+{
+	int32 Count = Entries.Num();
+	Ar << Count;
+
+	if (Ar.IsLoading())
+	{
+		Entries.Reset();
+
+		// Each entry is a uint32 code and an int32 amount.
+		const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+		if (Count < 0 || (Ar.TotalSize() >= 0 && int64(Count) * 8 > Remaining))
+		{
+			Ar.SetError();
+			return true;
+		}
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			uint32 Packed = 0;
+			int32 Amount = 0;
+			Ar << Packed << Amount;
+			Add(FCurrencyCode::FromPacked(Packed), Amount);
+		}
+	}
+	else
+	{
+		for (FCurrencyAmount& Entry : Entries)
+		{
+			uint32 Packed = Entry.Code.GetPacked();
+			Ar << Packed << Entry.Amount;
+		}
+	}
+	return true;
+}
+
+bool FCurrencyAmounts::SerializeFromMismatchedTag(const FPropertyTag& Tag, FArchive& Ar)
+{
+	if (Tag.Type != NAME_MapProperty || Tag.InnerType != NAME_StrProperty || Tag.ValueType != NAME_IntProperty)
+	{
+		return false;
+	}
+
+	// FMapProperty's tagged layout: the keys removed from the default (always none for these
+	// properties, skipped anyway), then the pairs.
+	int32 NumKeysToRemove = 0;
+	Ar << NumKeysToRemove;
+	for (int32 Index = 0; Index < NumKeysToRemove && !Ar.IsError(); ++Index)
+	{
+		FString Key;
+		Ar << Key;
+	}
+
+	int32 NumEntries = 0;
+	Ar << NumEntries;
+	if (NumEntries < 0)
+	{
+		Ar.SetError();
+		return true;
+	}
+
+	TMap<FString, int32> Map;
+	for (int32 Index = 0; Index < NumEntries && !Ar.IsError(); ++Index)
+	{
+		FString Key;
+		int32 Amount = 0;
+		Ar << Key << Amount;
+		Map.Add(MoveTemp(Key), Amount);
+	}
+
+	*this = FromMap(Map);
+	return true;
+}
+
+bool FCurrencyAmounts::ExportTextItem(FString& ValueStr, const FCurrencyAmounts& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
+{
+	ValueStr += ToString();
+	return true;
+}
+
+bool FCurrencyAmounts::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+{
+	// The old TMap<FString, int32> text form, (("GD", 100),("CR", 5)), e.g. from config or an old clipboard.
+	if (*Buffer == TEXT('('))
+	{
+		const TCHAR* Start = Buffer;
+		int32 Depth = 0;
+		do
+		{
+			Depth += *Buffer == TEXT('(') ? 1 : (*Buffer == TEXT(')') ? -1 : 0);
+			++Buffer;
+		}
+		while (*Buffer && Depth > 0);
+
+		FString Text(UE_PTRDIFF_TO_INT32(Buffer - Start), Start);
+		Text.ReplaceCharInline(TEXT('"'), TEXT(' '));
+		Text.ReplaceInline(TEXT("),("), TEXT(";"));
+		Text.ReplaceCharInline(TEXT('('), TEXT(' '));
+		Text.ReplaceCharInline(TEXT(')'), TEXT(' '));
+		Text.ReplaceCharInline(TEXT(','), TEXT(':'));
+
+		if (!Parse(Text, *this) && ErrorText)
+		{
+			ErrorText->Logf(ELogVerbosity::Warning, TEXT("Skipped malformed currency amounts in '%s'"), *FString(UE_PTRDIFF_TO_INT32(Buffer - Start), Start));
+		}
+		return true;
+	}
+
+	// Stop at anything that is not part of the "GD:100;CR:5" format, e.g. the ',' or ')' of an enclosing struct.
+	const TCHAR* Start = Buffer;
+	while (FChar::IsAlnum(*Buffer) || *Buffer == TEXT(':') || *Buffer == TEXT(';') || *Buffer == TEXT('-') || *Buffer == TEXT(' '))
+	{
+		++Buffer;
+	}
+
+	if (!Parse(FStringView(Start, UE_PTRDIFF_TO_INT32(Buffer - Start)), *this) && ErrorText)
+	{
+		ErrorText->Logf(ELogVerbosity::Warning, TEXT("Skipped malformed currency amounts in '%.*s'"),
+			UE_PTRDIFF_TO_INT32(Buffer - Start), Start);
+	}
+	return true;
+}
+
+void FCurrencyAmounts::WarnInvalidCode(const FString& Code)
+{
+	UE_LOG(LogTemp, Warning, TEXT("'%s' is not a valid currency code, skipped"), *Code);
+}
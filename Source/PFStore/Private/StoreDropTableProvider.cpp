@@ -0,0 +1,31 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreDropTableProvider.h"
+
+FArchive& operator<<(FArchive& Ar, FDropTableInfo& Table)
+{
+	Ar << Table.TableId;
+
+	int32 NumNodes = Table.Nodes.Num();
+	Ar << NumNodes;
+	if (Ar.IsLoading())
+	{
+		// A node is at least two empty strings and a weight, 12 bytes; a count that cannot fit in what
+		// is left of the archive is corrupt and must not size the array. TotalSize is -1 when unknown.
+		const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+		if (NumNodes < 0 || Ar.IsError() || (Ar.TotalSize() >= 0 && int64(NumNodes) * 12 > Remaining))
+		{
+			Ar.SetError();
+			return Ar;
+		}
+		Table.Nodes.SetNum(NumNodes);
+	}
+	for (FDropTableNode& Node : Table.Nodes)
+	{
+		Ar << Node.ResultItemType;
+		Ar << Node.ResultItem;
+		Ar << Node.Weight;
+	}
+
+	return Ar;
+}
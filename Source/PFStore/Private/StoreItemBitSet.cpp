@@ -0,0 +1,127 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreItemBitSet.h"
+
+#include "Math/VectorRegister.h"
+
+namespace StoreBitOps
+{
+	enum class EOp : uint8 { Assign, And, Or, AndNot };
+
+	template<EOp Op>
+	static FORCEINLINE uint64 Scalar(uint64 Dst, uint64 Src)
+	{
+		switch (Op)
+		{
+		case EOp::Assign: return Src;
+		case EOp::And:    return Dst & Src;
+		case EOp::Or:     return Dst | Src;
+		default:          return Dst & ~Src;
+		}
+	}
+
+	template<EOp Op>
+	static void Apply(uint64* RESTRICT Dst, const uint64* RESTRICT Src, int32 NumWords)
+	{
+		int32 Index = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+		for (; Index + 2 <= NumWords; Index += 2)
+		{
+			const VectorRegister4Int S = VectorIntLoad(Src + Index);
+			const VectorRegister4Int D = VectorIntLoad(Dst + Index);
+			VectorRegister4Int R;
+			switch (Op)
+			{
+			case EOp::Assign: R = S; break;
+			case EOp::And:    R = VectorIntAnd(D, S); break;
+			case EOp::Or:     R = VectorIntOr(D, S); break;
+			default:          R = VectorIntAndNot(S, D); break; // ~S & D
+			}
+			VectorIntStore(R, Dst + Index);
+		}
+#endif
+
+		for (; Index < NumWords; ++Index)
+		{
+			Dst[Index] = Scalar<Op>(Dst[Index], Src[Index]);
+		}
+	}
+}
+
+void FStoreItemBitSet::Init(int32 InNumItems, bool bValue)
+{
+	NumBits = InNumItems;
+	Words.Init(bValue ? ~uint64(0) : 0, GetNumWords(InNumItems));
+	ClearTail();
+}
+
+void FStoreItemBitSet::ClearTail()
+{
+	const int32 FullWords = NumBits >> 6;
+	const int32 TailBits = NumBits & 63;
+
+	int32 Index = FullWords;
+	if (TailBits != 0)
+	{
+		Words[Index++] &= (uint64(1) << TailBits) - 1;
+	}
+	for (; Index < Words.Num(); ++Index)
+	{
+		Words[Index] = 0;
+	}
+}
+
+void FStoreItemBitSet::Assign(TConstArrayView<uint64> Other)
+{
+	check(Other.Num() == Words.Num());
+	StoreBitOps::Apply<StoreBitOps::EOp::Assign>(Words.GetData(), Other.GetData(), Words.Num());
+}
+
+void FStoreItemBitSet::And(TConstArrayView<uint64> Other)
+{
+	check(Other.Num() == Words.Num());
+	StoreBitOps::Apply<StoreBitOps::EOp::And>(Words.GetData(), Other.GetData(), Words.Num());
+}
+
+void FStoreItemBitSet::Or(TConstArrayView<uint64> Other)
+{
+	check(Other.Num() == Words.Num());
+	StoreBitOps::Apply<StoreBitOps::EOp::Or>(Words.GetData(), Other.GetData(), Words.Num());
+}
+
+void FStoreItemBitSet::AndNot(TConstArrayView<uint64> Other)
+{
+	check(Other.Num() == Words.Num());
+	StoreBitOps::Apply<StoreBitOps::EOp::AndNot>(Words.GetData(), Other.GetData(), Words.Num());
+}
+
+void FStoreItemBitSet::Not()
+{
+	for (uint64& Word : Words)
+	{
+		Word = ~Word;
+	}
+	ClearTail();
+}
+
+void FStoreItemBitSet::Reset()
+{
+	FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+}
+
+int32 FStoreItemBitSet::CountSetBits() const
+{
+	int32 Count = 0;
+	for (const uint64 Word : Words)
+	{
+		Count += (int32)FMath::CountBits(Word);
+	}
+	return Count;
+}
+
+void FStoreItemBitSet::ToHandles(TArray<FStoreItemHandle>& OutItems) const
+{
+	OutItems.Reset(CountSetBits());
+	ForEachSetBit([&OutItems](FStoreItemHandle Item) { OutItems.Add(Item); });
+}
@@ -0,0 +1,526 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreItemDataAsset.h"
+#include "StoreItemRecord.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+namespace StoreItemDataAssetPrivate
+{
+	static const TCHAR* const FieldNames[(int32)EStoreItemField::Count] =
+	{
+		TEXT("ItemId"),
+		TEXT("DisplayName"),
+		TEXT("ItemClass"),
+		TEXT("Description"),
+		TEXT("CustomData"),
+		TEXT("Tags"),
+		TEXT("VirtualCurrencyPrices"),
+		TEXT("IsLimitedEdition"),
+		TEXT("IsTokenForCharacterCreation"),
+		TEXT("IsTradable"),
+		TEXT("IsStackable"),
+		TEXT("Consumable"),
+		TEXT("Bundle"),
+		TEXT("Container"),
+	};
+
+	static bool IsStructOf(const FProperty* Property, const UScriptStruct* Struct)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && StructProperty->Struct == Struct;
+	}
+
+	/** Whether Property has the C++ type EStoreItemField documents for Field. */
+	static bool HasFieldType(const FProperty* Property, EStoreItemField Field)
+	{
+		if (Property->ArrayDim != 1)
+		{
+			return false;
+		}
+
+		switch (Field)
+		{
+		case EStoreItemField::ItemId:
+		case EStoreItemField::DisplayName:
+		case EStoreItemField::ItemClass:
+		case EStoreItemField::Description:
+		case EStoreItemField::CustomData:
+			return Property->IsA<FStrProperty>();
+
+		case EStoreItemField::Tags:
+		{
+			const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+			return ArrayProperty && ArrayProperty->Inner->IsA<FStrProperty>();
+		}
+
+		case EStoreItemField::VirtualCurrencyPrices:
+			return IsStructOf(Property, FCurrencyAmounts::StaticStruct());
+
+		case EStoreItemField::IsLimitedEdition:
+		case EStoreItemField::IsTokenForCharacterCreation:
+		case EStoreItemField::IsTradable:
+		case EStoreItemField::IsStackable:
+			return Property->IsA<FBoolProperty>();
+
+		case EStoreItemField::Consumable:
+			return IsStructOf(Property, FConsumableInfo::StaticStruct());
+
+		case EStoreItemField::Bundle:
+			return IsStructOf(Property, FBundleInfo::StaticStruct());
+
+		case EStoreItemField::Container:
+			return IsStructOf(Property, FContainerInfo::StaticStruct());
+
+		default:
+			return false;
+		}
+	}
+
+	static void MapProperty(const FProperty* Property, EStoreItemField Field, FStoreItemPropertyLayout& Layout)
+	{
+		const int32 Index = (int32)Field;
+		Layout.Offsets[Index] = Property->GetOffset_ForInternal();
+		Layout.Bools[Index] = CastField<FBoolProperty>(Property);
+		Layout.Properties[Index] = Property->GetFName();
+	}
+
+#if !WITH_METADATA
+	/**
+	 * The layout as the editor saved it. A saved property that is gone or changed type means the
+	 * class changed after the assets were saved; the field is left unmapped and logged as an error.
+	 */
+	static void BuildSavedLayout(const UClass* Class, TConstArrayView<FName> SavedProperties, FStoreItemPropertyLayout& Layout)
+	{
+		for (int32 Index = 0; Index < (int32)EStoreItemField::Count; ++Index)
+		{
+			if (SavedProperties[Index].IsNone())
+			{
+				continue;
+			}
+			const FProperty* Property = Class->FindPropertyByName(SavedProperties[Index]);
+			if (!Property || !HasFieldType(Property, (EStoreItemField)Index))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s: StoreField '%s' was saved as property '%s', which is missing or of the wrong type; resave the assets"),
+					*Class->GetName(), FieldNames[Index], *SavedProperties[Index].ToString());
+				continue;
+			}
+			MapProperty(Property, (EStoreItemField)Index, Layout);
+		}
+	}
+#endif
+
+	static void BuildLayout(const UClass* Class, TConstArrayView<FName> SavedProperties, FStoreItemPropertyLayout& Layout)
+	{
+		Layout.bIsBundle = Class->ImplementsInterface(UStoreBundleProvider::StaticClass());
+		Layout.bIsContainer = Class->ImplementsInterface(UStoreContainerProvider::StaticClass());
+
+#if !WITH_METADATA
+		if (SavedProperties.Num() == (int32)EStoreItemField::Count)
+		{
+			BuildSavedLayout(Class, SavedProperties, Layout);
+			return;
+		}
+		if (SavedProperties.Num() > 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: assets saved %d StoreField properties, expected %d; resave the assets. Mapping by property name."),
+				*Class->GetName(), SavedProperties.Num(), (int32)EStoreItemField::Count);
+		}
+#endif
+
+		// A StoreField tag beats a property that merely shares the field's name.
+		bool bTagged[(int32)EStoreItemField::Count] = {};
+
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+		{
+			const FProperty* Property = *It;
+
+			bool bIsTagged = false;
+			EStoreItemField Field = EStoreItemField::Count;
+#if WITH_METADATA
+			if (const FString* Tag = Property->FindMetaData(TEXT("StoreField")))
+			{
+				bIsTagged = true;
+				Field = FStoreItemPropertyLayout::FindField(*Tag);
+				if (Field == EStoreItemField::Count)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s::%s: unknown StoreField '%s'"),
+						*Class->GetName(), *Property->GetName(), **Tag);
+					continue;
+				}
+			}
+#endif
+			if (!bIsTagged)
+			{
+				Field = FStoreItemPropertyLayout::FindField(Property->GetName());
+				if (Field == EStoreItemField::Count)
+				{
+					continue;
+				}
+			}
+
+			const int32 Index = (int32)Field;
+			if (!HasFieldType(Property, Field))
+			{
+				if (bIsTagged)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s::%s: wrong type for StoreField '%s'"),
+						*Class->GetName(), *Property->GetName(), FieldNames[Index]);
+				}
+				continue;
+			}
+			if (bTagged[Index] || (!bIsTagged && Layout.Offsets[Index] != INDEX_NONE))
+			{
+				if (bIsTagged)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s::%s: StoreField '%s' is already mapped"),
+						*Class->GetName(), *Property->GetName(), FieldNames[Index]);
+				}
+				continue;
+			}
+
+			bTagged[Index] = bIsTagged;
+			MapProperty(Property, Field, Layout);
+		}
+	}
+
+	static bool SameStrings(const TArray<FString>& A, const TArray<FString>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (!A[Index].Equals(B[Index], ESearchCase::CaseSensitive))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename StructType>
+	static bool SameStruct(const StructType& A, const StructType& B)
+	{
+		return StructType::StaticStruct()->CompareScriptStruct(&A, &B, PPF_None);
+	}
+
+	/** Fields of Record that Written, the asset as read back after writing it, does not hold. */
+	static void FindDroppedFields(const FStoreItemRecord& Record, const FStoreItemRecord& Written, TArray<FString>& OutFields)
+	{
+		auto Check = [&OutFields](EStoreItemField Field, bool bSame)
+		{
+			if (!bSame)
+			{
+				OutFields.Add(FieldNames[(int32)Field]);
+			}
+		};
+
+		Check(EStoreItemField::ItemId, Record.ItemId.Equals(Written.ItemId, ESearchCase::CaseSensitive));
+		Check(EStoreItemField::DisplayName, Record.DisplayName.Equals(Written.DisplayName, ESearchCase::CaseSensitive));
+		Check(EStoreItemField::ItemClass, Record.ItemClass.Equals(Written.ItemClass, ESearchCase::CaseSensitive));
+		Check(EStoreItemField::Description, Record.Description.Equals(Written.Description, ESearchCase::CaseSensitive));
+		Check(EStoreItemField::CustomData, Record.CustomData.Equals(Written.CustomData, ESearchCase::CaseSensitive));
+		Check(EStoreItemField::Tags, SameStrings(Record.Tags, Written.Tags));
+		Check(EStoreItemField::VirtualCurrencyPrices, Record.Prices == Written.Prices);
+		Check(EStoreItemField::IsLimitedEdition, Record.bIsLimitedEdition == Written.bIsLimitedEdition);
+		Check(EStoreItemField::IsTokenForCharacterCreation, Record.bIsTokenForCharacterCreation == Written.bIsTokenForCharacterCreation);
+		Check(EStoreItemField::IsTradable, Record.bIsTradable == Written.bIsTradable);
+		Check(EStoreItemField::IsStackable, Record.bIsStackable == Written.bIsStackable);
+		Check(EStoreItemField::Consumable, SameStruct(Record.Consumable, Written.Consumable));
+
+		// An asset cannot stop being a bundle or container, so only contents it was given count.
+		Check(EStoreItemField::Bundle, !Record.bIsBundle || (Written.bIsBundle && SameStruct(Record.Bundle, Written.Bundle)));
+		Check(EStoreItemField::Container, !Record.bIsContainer || (Written.bIsContainer && SameStruct(Record.Container, Written.Container)));
+	}
+
+	struct FLayoutCache
+	{
+		FRWLock Lock;
+		TMap<FObjectKey, TUniquePtr<FStoreItemPropertyLayout>> Layouts;
+
+		/** Invalidated layouts, kept so a reference taken before the reload never dangles. */
+		TArray<TUniquePtr<FStoreItemPropertyLayout>> Retired;
+
+		/** The saved properties each class was built from, to rebuild it the same way. */
+		TMap<FObjectKey, TArray<FName>> SavedProperties;
+	};
+
+	static FLayoutCache& GetLayoutCache()
+	{
+		static FLayoutCache Cache;
+		return Cache;
+	}
+}
+
+// ---------- FStoreItemPropertyLayout ----------
+
+FStoreItemPropertyLayout::FStoreItemPropertyLayout()
+{
+	for (int32 Index = 0; Index < (int32)EStoreItemField::Count; ++Index)
+	{
+		Offsets[Index] = INDEX_NONE;
+		Bools[Index] = nullptr;
+	}
+}
+
+bool FStoreItemPropertyLayout::ReadBool(const UObject* Object, EStoreItemField Field) const
+{
+	return Bools[(int32)Field]->GetPropertyValue_InContainer(Object);
+}
+
+void FStoreItemPropertyLayout::WriteBool(UObject* Object, EStoreItemField Field, bool bValue) const
+{
+	Bools[(int32)Field]->SetPropertyValue_InContainer(Object, bValue);
+}
+
+const FStoreItemPropertyLayout& FStoreItemPropertyLayout::Get(const UClass* Class, TConstArrayView<FName> SavedProperties)
+{
+	using namespace StoreItemDataAssetPrivate;
+
+	FLayoutCache& Cache = GetLayoutCache();
+	const FObjectKey Key(Class);
+	TArray<FName> Saved;
+	{
+		FReadScopeLock ReadLock(Cache.Lock);
+		if (const TUniquePtr<FStoreItemPropertyLayout>* Found = Cache.Layouts.Find(Key))
+		{
+			return **Found;
+		}
+		if (SavedProperties.Num() == 0)
+		{
+			if (const TArray<FName>* Found = Cache.SavedProperties.Find(Key))
+			{
+				Saved = *Found;
+				SavedProperties = Saved;
+			}
+		}
+	}
+
+	// Built outside the lock; if two threads race, the first one in keeps its layout.
+	TUniquePtr<FStoreItemPropertyLayout> Layout = MakeUnique<FStoreItemPropertyLayout>();
+	BuildLayout(Class, SavedProperties, *Layout);
+
+	FWriteScopeLock WriteLock(Cache.Lock);
+	if (SavedProperties.Num() > 0 && Saved.Num() == 0)
+	{
+		Cache.SavedProperties.FindOrAdd(Key) = TArray<FName>(SavedProperties);
+	}
+	TUniquePtr<FStoreItemPropertyLayout>& Slot = Cache.Layouts.FindOrAdd(Key);
+	if (!Slot)
+	{
+		Slot = MoveTemp(Layout);
+	}
+	return *Slot;
+}
+
+void FStoreItemPropertyLayout::Invalidate()
+{
+	using namespace StoreItemDataAssetPrivate;
+
+	FLayoutCache& Cache = GetLayoutCache();
+	FWriteScopeLock WriteLock(Cache.Lock);
+	for (TPair<FObjectKey, TUniquePtr<FStoreItemPropertyLayout>>& Pair : Cache.Layouts)
+	{
+		Cache.Retired.Add(MoveTemp(Pair.Value));
+	}
+	Cache.Layouts.Reset();
+}
+
+EStoreItemField FStoreItemPropertyLayout::FindField(FStringView Name)
+{
+	using namespace StoreItemDataAssetPrivate;
+
+	for (int32 Index = 0; Index < (int32)EStoreItemField::Count; ++Index)
+	{
+		if (Name.Equals(FieldNames[Index], ESearchCase::IgnoreCase))
+		{
+			return (EStoreItemField)Index;
+		}
+	}
+
+	// Spellings of the record and the property conventions (bIsTradable).
+	if (Name.Equals(TEXT("Prices"), ESearchCase::IgnoreCase))
+	{
+		return EStoreItemField::VirtualCurrencyPrices;
+	}
+	if (Name.Len() > 1 && (Name[0] == TEXT('b') || Name[0] == TEXT('B')))
+	{
+		const EStoreItemField Field = FindField(Name.RightChop(1));
+		switch (Field)
+		{
+		case EStoreItemField::IsLimitedEdition:
+		case EStoreItemField::IsTokenForCharacterCreation:
+		case EStoreItemField::IsTradable:
+		case EStoreItemField::IsStackable:
+			return Field;
+		default:
+			break;
+		}
+	}
+	return EStoreItemField::Count;
+}
+
+// ---------- UStoreItemDataAsset ----------
+
+FString UStoreItemDataAsset::GetItemId() const
+{
+	const FStoreItemPropertyLayout& Layout = GetStoreLayout();
+	return Layout.IsMapped(EStoreItemField::ItemId) ? Layout.Read<FString>(this, EStoreItemField::ItemId) : GetName();
+}
+
+FString UStoreItemDataAsset::GetDisplayName() const { return ReadStoreField<FString>(EStoreItemField::DisplayName); }
+FString UStoreItemDataAsset::GetItemClass() const { return ReadStoreField<FString>(EStoreItemField::ItemClass); }
+FString UStoreItemDataAsset::GetDescription() const { return ReadStoreField<FString>(EStoreItemField::Description); }
+FCurrencyAmounts UStoreItemDataAsset::GetCurrencyPrices() const { return ReadStoreField<FCurrencyAmounts>(EStoreItemField::VirtualCurrencyPrices); }
+FString UStoreItemDataAsset::GetCustomData() const { return ReadStoreField<FString>(EStoreItemField::CustomData); }
+TArray<FString> UStoreItemDataAsset::GetTags() const { return ReadStoreField<TArray<FString>>(EStoreItemField::Tags); }
+bool UStoreItemDataAsset::GetIsLimitedEdition() const { return ReadStoreBool(EStoreItemField::IsLimitedEdition); }
+bool UStoreItemDataAsset::GetIsTokenForCharacterCreation() const { return ReadStoreBool(EStoreItemField::IsTokenForCharacterCreation); }
+bool UStoreItemDataAsset::GetIsTradable() const { return ReadStoreBool(EStoreItemField::IsTradable); }
+bool UStoreItemDataAsset::GetIsStackable() const { return ReadStoreBool(EStoreItemField::IsStackable); }
+FConsumableInfo UStoreItemDataAsset::GetConsumableInfo() const { return ReadStoreField<FConsumableInfo>(EStoreItemField::Consumable); }
+
+void UStoreItemDataAsset::ToStoreItemRecord(FStoreItemRecord& Out) const
+{
+	const FStoreItemPropertyLayout& Layout = GetStoreLayout();
+
+	auto CopyField = [this, &Layout](EStoreItemField Field, auto& OutValue, auto Getter)
+	{
+		using FValue = typename TDecay<decltype(OutValue)>::Type;
+		OutValue = Layout.IsMapped(Field) ? Layout.Read<FValue>(this, Field) : (this->*Getter)();
+	};
+	auto CopyBool = [this, &Layout](EStoreItemField Field, bool& OutValue, bool (UStoreItemDataAsset::*Getter)() const)
+	{
+		OutValue = Layout.IsMapped(Field) ? Layout.ReadBool(this, Field) : (this->*Getter)();
+	};
+
+	// Unmapped fields still go through the (possibly overridden) getters.
+	CopyField(EStoreItemField::ItemId, Out.ItemId, &UStoreItemDataAsset::GetItemId);
+	CopyField(EStoreItemField::DisplayName, Out.DisplayName, &UStoreItemDataAsset::GetDisplayName);
+	CopyField(EStoreItemField::ItemClass, Out.ItemClass, &UStoreItemDataAsset::GetItemClass);
+	CopyField(EStoreItemField::Description, Out.Description, &UStoreItemDataAsset::GetDescription);
+	CopyField(EStoreItemField::CustomData, Out.CustomData, &UStoreItemDataAsset::GetCustomData);
+	CopyField(EStoreItemField::Tags, Out.Tags, &UStoreItemDataAsset::GetTags);
+	CopyField(EStoreItemField::VirtualCurrencyPrices, Out.Prices, &UStoreItemDataAsset::GetCurrencyPrices);
+
+	CopyBool(EStoreItemField::IsLimitedEdition, Out.bIsLimitedEdition, &UStoreItemDataAsset::GetIsLimitedEdition);
+	CopyBool(EStoreItemField::IsTokenForCharacterCreation, Out.bIsTokenForCharacterCreation, &UStoreItemDataAsset::GetIsTokenForCharacterCreation);
+	CopyBool(EStoreItemField::IsTradable, Out.bIsTradable, &UStoreItemDataAsset::GetIsTradable);
+	CopyBool(EStoreItemField::IsStackable, Out.bIsStackable, &UStoreItemDataAsset::GetIsStackable);
+
+	CopyField(EStoreItemField::Consumable, Out.Consumable, &UStoreItemDataAsset::GetConsumableInfo);
+
+	Out.bIsBundle = Layout.bIsBundle;
+	if (Layout.bIsBundle && Layout.IsMapped(EStoreItemField::Bundle))
+	{
+		Out.Bundle = Layout.Read<FBundleInfo>(this, EStoreItemField::Bundle);
+	}
+	else
+	{
+		const IStoreBundleProvider* BundleProvider = Cast<IStoreBundleProvider>(this);
+		Out.Bundle = BundleProvider ? BundleProvider->GetBundleInfo() : FBundleInfo{};
+	}
+
+	Out.bIsContainer = Layout.bIsContainer;
+	if (Layout.bIsContainer && Layout.IsMapped(EStoreItemField::Container))
+	{
+		Out.Container = Layout.Read<FContainerInfo>(this, EStoreItemField::Container);
+	}
+	else
+	{
+		const IStoreContainerProvider* ContainerProvider = Cast<IStoreContainerProvider>(this);
+		Out.Container = ContainerProvider ? ContainerProvider->GetContainerInfo() : FContainerInfo{};
+	}
+}
+
+bool UStoreItemDataAsset::ApplyStoreItemRecord(const FStoreItemRecord& Record)
+{
+	const FStoreItemPropertyLayout& Layout = GetStoreLayout();
+
+#if WITH_EDITOR
+	// Open details panels show the old values otherwise.
+	PreEditChange(nullptr);
+#endif
+
+	auto WriteField = [this, &Layout](EStoreItemField Field, const auto& Value)
+	{
+		using FValue = typename TDecay<decltype(Value)>::Type;
+		if (Layout.IsMapped(Field))
+		{
+			Layout.Write<FValue>(this, Field) = Value;
+		}
+	};
+	auto WriteBool = [this, &Layout](EStoreItemField Field, bool bValue)
+	{
+		if (Layout.IsMapped(Field))
+		{
+			Layout.WriteBool(this, Field, bValue);
+		}
+	};
+
+	WriteField(EStoreItemField::ItemId, Record.ItemId);
+	WriteField(EStoreItemField::DisplayName, Record.DisplayName);
+	WriteField(EStoreItemField::ItemClass, Record.ItemClass);
+	WriteField(EStoreItemField::Description, Record.Description);
+	WriteField(EStoreItemField::CustomData, Record.CustomData);
+	WriteField(EStoreItemField::Tags, Record.Tags);
+	WriteField(EStoreItemField::VirtualCurrencyPrices, Record.Prices);
+
+	WriteBool(EStoreItemField::IsLimitedEdition, Record.bIsLimitedEdition);
+	WriteBool(EStoreItemField::IsTokenForCharacterCreation, Record.bIsTokenForCharacterCreation);
+	WriteBool(EStoreItemField::IsTradable, Record.bIsTradable);
+	WriteBool(EStoreItemField::IsStackable, Record.bIsStackable);
+
+	WriteField(EStoreItemField::Consumable, Record.Consumable);
+	if (Layout.bIsBundle)
+	{
+		WriteField(EStoreItemField::Bundle, Record.Bundle);
+	}
+	if (Layout.bIsContainer)
+	{
+		WriteField(EStoreItemField::Container, Record.Container);
+	}
+
+#if WITH_EDITOR
+	PostEditChange();
+#endif
+
+	FStoreItemRecord Written;
+	ToStoreItemRecord(Written);
+	TArray<FString> Dropped;
+	StoreItemDataAssetPrivate::FindDroppedFields(Record, Written, Dropped);
+	if (Dropped.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s has no property for %s of %s, left as is"),
+			*GetPathName(), *FString::Join(Dropped, TEXT(", ")), *Record.ItemId);
+		return false;
+	}
+	return true;
+}
+
+void UStoreItemDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+#if !WITH_METADATA
+	// The first asset of a class builds its layout from what the editor resolved.
+	FStoreItemPropertyLayout::Get(GetClass(), StoreFieldProperties);
+#endif
+}
+
+#if WITH_EDITOR
+void UStoreItemDataAsset::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Saved on every save, cooking included, so cooked assets match the class they were cooked with.
+	const FStoreItemPropertyLayout& Layout = GetStoreLayout();
+	StoreFieldProperties = TArray<FName>(Layout.Properties, (int32)EStoreItemField::Count);
+}
+#endif
@@ -0,0 +1,29 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreItemProvider.h"
+
+namespace StoreItemProviderPrivate
+{
+	/** Set while the default GetCurrencyPrices runs, so a provider that overrides neither getter is unpriced instead of recursing. */
+	static thread_local bool bInDefaultPrices = false;
+}
+
+FCurrencyAmounts IStoreItemProvider::GetCurrencyPrices() const
+{
+	using namespace StoreItemProviderPrivate;
+
+	if (bInDefaultPrices)
+	{
+		return FCurrencyAmounts();
+	}
+	TGuardValue<bool> Guard(bInDefaultPrices, true);
+
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	return FCurrencyAmounts::FromMap(GetPrices());
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
+}
+
+TMap<FString, int32> IStoreItemProvider::GetPrices() const
+{
+	return GetCurrencyPrices().ToMap<int32>();
+}
@@ -0,0 +1,828 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreItemQuery.h"
+
+#include "StoreStats.h"
+#include "Async/ParallelFor.h"
+
+namespace StoreItemQueryPrivate
+{
+	/** Items per parallel task, a whole number of bit set words. */
+	static constexpr int32 ChunkSize = 64 * 64;
+
+	/**
+	 * Fills Words with Test over [0, Num), 64 per word and a chunk per task. Test is inlined
+	 * into the word loop, so every predicate is a straight pass over its column.
+	 */
+	template<typename TestType>
+	static void FillBits(TArrayView<uint64> Words, int32 Num, const TestType& Test)
+	{
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, ChunkSize);
+		ParallelFor(TEXT("PFStore.ItemQuery"), NumChunks, 1, [&Words, Num, &Test](int32 Chunk)
+			{
+				const int32 Start = Chunk * ChunkSize;
+				const int32 End = FMath::Min(Start + ChunkSize, Num);
+				for (int32 First = Start; First < End; First += 64)
+				{
+					const int32 Count = FMath::Min(64, End - First);
+					uint64 Mask = 0;
+					for (int32 Lane = 0; Lane < Count; ++Lane)
+					{
+						Mask |= uint64(Test(First + Lane) ? 1 : 0) << Lane;
+					}
+					Words[First >> 6] = Mask;
+				}
+			});
+	}
+
+	template<typename ValueType, typename GetType>
+	static void FillCompare(TArrayView<uint64> Words, int32 Num, FStoreItemQuery::ECompare Compare, ValueType Value, const GetType& Get)
+	{
+		using ECompare = FStoreItemQuery::ECompare;
+
+		// One loop per operator, so the comparison is not decided again for every item.
+		switch (Compare)
+		{
+		case ECompare::Equal: FillBits(Words, Num, [&Get, Value](int32 Item) { return Get(Item) == Value; }); break;
+		case ECompare::NotEqual: FillBits(Words, Num, [&Get, Value](int32 Item) { return Get(Item) != Value; }); break;
+		case ECompare::Less: FillBits(Words, Num, [&Get, Value](int32 Item) { return Get(Item) < Value; }); break;
+		case ECompare::LessEqual: FillBits(Words, Num, [&Get, Value](int32 Item) { return Get(Item) <= Value; }); break;
+		case ECompare::Greater: FillBits(Words, Num, [&Get, Value](int32 Item) { return Get(Item) > Value; }); break;
+		case ECompare::GreaterEqual: FillBits(Words, Num, [&Get, Value](int32 Item) { return Get(Item) >= Value; }); break;
+		// Contains is only compiled for names, which are matched through the name dictionary.
+		case ECompare::Contains: FillBits(Words, Num, [](int32) { return false; }); break;
+		}
+	}
+
+	static bool TestBit(TConstArrayView<uint64> Words, int32 Index)
+	{
+		return Index >= 0 && (Index >> 6) < Words.Num() && ((Words[Index >> 6] >> (Index & 63)) & 1);
+	}
+
+	static ANSICHAR ToLowerAscii(ANSICHAR Char)
+	{
+		return (Char >= 'A' && Char <= 'Z') ? Char + ('a' - 'A') : Char;
+	}
+
+	/** Whether Name contains Text (already lower case), ignoring the case of ASCII letters. */
+	static bool ContainsIgnoreCase(FUtf8StringView Name, const TArray<ANSICHAR>& Text)
+	{
+		const int32 TextLen = Text.Num();
+		const ANSICHAR* Data = reinterpret_cast<const ANSICHAR*>(Name.GetData());
+		for (int32 Start = 0; Start + TextLen <= Name.Len(); ++Start)
+		{
+			int32 Index = 0;
+			while (Index < TextLen && ToLowerAscii(Data[Start + Index]) == Text[Index])
+			{
+				++Index;
+			}
+			if (Index == TextLen)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool ParseUnit(FStringView Unit, int64& OutSeconds)
+	{
+		struct FUnit { const TCHAR* Name; int64 Seconds; };
+		static const FUnit Units[] =
+		{
+			{ TEXT("s"), 1 }, { TEXT("sec"), 1 }, { TEXT("second"), 1 }, { TEXT("seconds"), 1 },
+			{ TEXT("m"), 60 }, { TEXT("min"), 60 }, { TEXT("minute"), 60 }, { TEXT("minutes"), 60 },
+			{ TEXT("h"), 3600 }, { TEXT("hour"), 3600 }, { TEXT("hours"), 3600 },
+			{ TEXT("d"), 86400 }, { TEXT("day"), 86400 }, { TEXT("days"), 86400 },
+			{ TEXT("w"), 604800 }, { TEXT("week"), 604800 }, { TEXT("weeks"), 604800 },
+		};
+		for (const FUnit& Entry : Units)
+		{
+			if (Unit.Equals(Entry.Name, ESearchCase::IgnoreCase))
+			{
+				OutSeconds = Entry.Seconds;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	struct FFieldInfo
+	{
+		const TCHAR* Name;
+		uint8 Kind;
+		uint8 Field;
+	};
+}
+
+/** Recursive descent over: Or := And ('|' And)*, And := Unary ('&' Unary)*, Unary := '!' Unary | '(' Or ')' | Predicate */
+class FStoreItemQueryCompiler
+{
+public:
+	using EFieldKind = FStoreItemQuery::EFieldKind;
+	using ECompare = FStoreItemQuery::ECompare;
+
+	FStoreItemQueryCompiler(const FStoreCatalog& InCatalog, FStringView InExpression, FStoreItemQuery& InQuery)
+		: Catalog(InCatalog)
+		, Expression(InExpression)
+		, Query(InQuery)
+	{
+	}
+
+	bool Run(FString& OutError)
+	{
+		SkipWhitespace();
+		if (Pos == Expression.Len())
+		{
+			return true;
+		}
+
+		if (!ParseOr())
+		{
+			OutError = Error;
+			return false;
+		}
+
+		SkipWhitespace();
+		if (Pos != Expression.Len())
+		{
+			OutError = FString::Printf(TEXT("Unexpected '%c' at %d"), Expression[Pos], Pos);
+			return false;
+		}
+		return true;
+	}
+
+	static TConstArrayView<StoreItemQueryPrivate::FFieldInfo> GetFields()
+	{
+		using StoreItemQueryPrivate::FFieldInfo;
+		auto Section = [](EStoreCatalogSection Value) { return static_cast<uint8>(Value); };
+		auto Flag = [](EStoreItemFlags Value) { return static_cast<uint8>(Value); };
+		auto Kind = [](EFieldKind Value) { return static_cast<uint8>(Value); };
+
+		// Names follow the CSV columns, with the short forms designers type.
+		static const FFieldInfo Fields[] =
+		{
+			{ TEXT("ItemId"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::ItemIds) },
+			{ TEXT("Id"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::ItemIds) },
+			{ TEXT("DisplayName"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::DisplayNames) },
+			{ TEXT("Name"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::DisplayNames) },
+			{ TEXT("ItemClass"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::ItemClasses) },
+			{ TEXT("Class"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::ItemClasses) },
+			{ TEXT("Description"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::Descriptions) },
+			{ TEXT("CustomData"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::CustomData) },
+			{ TEXT("UsagePeriodGroup"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::UsagePeriodGroups) },
+			{ TEXT("KeyItemId"), Kind(EFieldKind::Name), Section(EStoreCatalogSection::ContainerKeyItems) },
+			{ TEXT("UsageCount"), Kind(EFieldKind::Integer), Section(EStoreCatalogSection::UsageCounts) },
+			{ TEXT("UsagePeriod"), Kind(EFieldKind::Integer), Section(EStoreCatalogSection::UsagePeriods) },
+			{ TEXT("Price"), Kind(EFieldKind::Price), 0 },
+			{ TEXT("BundledVirtualCurrencies"), Kind(EFieldKind::Currencies), Section(EStoreCatalogSection::BundledCurrencies) },
+			{ TEXT("VirtualCurrencyContents"), Kind(EFieldKind::Currencies), Section(EStoreCatalogSection::ContainerCurrencies) },
+			{ TEXT("Tags"), Kind(EFieldKind::List), Section(EStoreCatalogSection::Tags) },
+			{ TEXT("Tag"), Kind(EFieldKind::List), Section(EStoreCatalogSection::Tags) },
+			{ TEXT("BundledItems"), Kind(EFieldKind::List), Section(EStoreCatalogSection::BundledItems) },
+			{ TEXT("BundledResultTables"), Kind(EFieldKind::List), Section(EStoreCatalogSection::BundledResultTables) },
+			{ TEXT("ItemContents"), Kind(EFieldKind::List), Section(EStoreCatalogSection::ContainerItems) },
+			{ TEXT("ResultTableContents"), Kind(EFieldKind::List), Section(EStoreCatalogSection::ContainerResultTables) },
+			{ TEXT("LimitedEdition"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::LimitedEdition) },
+			{ TEXT("TokenForCharacterCreation"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::TokenForCharacterCreation) },
+			{ TEXT("Tradable"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::Tradable) },
+			{ TEXT("Stackable"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::Stackable) },
+			{ TEXT("Bundle"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::Bundle) },
+			{ TEXT("Container"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::Container) },
+			{ TEXT("Consumable"), Kind(EFieldKind::Flag), Flag(EStoreItemFlags::None) },
+		};
+		return Fields;
+	}
+
+private:
+	bool ParseOr()
+	{
+		if (!ParseAnd())
+		{
+			return false;
+		}
+		while (ConsumeOperator(TEXT('|')))
+		{
+			if (!ParseAnd())
+			{
+				return false;
+			}
+			Query.Ops.Add({ FStoreItemQuery::EOp::Or, INDEX_NONE });
+		}
+		return true;
+	}
+
+	bool ParseAnd()
+	{
+		if (!ParseUnary())
+		{
+			return false;
+		}
+		while (ConsumeOperator(TEXT('&')))
+		{
+			if (!ParseUnary())
+			{
+				return false;
+			}
+			Query.Ops.Add({ FStoreItemQuery::EOp::And, INDEX_NONE });
+		}
+		return true;
+	}
+
+	bool ParseUnary()
+	{
+		SkipWhitespace();
+		if (Pos < Expression.Len() && Expression[Pos] == TEXT('!') && !IsAt(TEXT("!=")))
+		{
+			++Pos;
+			if (!ParseUnary())
+			{
+				return false;
+			}
+			Query.Ops.Add({ FStoreItemQuery::EOp::Not, INDEX_NONE });
+			return true;
+		}
+
+		if (ConsumeOperator(TEXT('(')))
+		{
+			if (!ParseOr())
+			{
+				return false;
+			}
+			if (!ConsumeOperator(TEXT(')')))
+			{
+				Error = FString::Printf(TEXT("Missing ')' at %d"), Pos);
+				return false;
+			}
+			return true;
+		}
+
+		FStoreItemQuery::FPredicate Predicate;
+		if (!ParsePredicate(Predicate))
+		{
+			return false;
+		}
+		Query.Ops.Add({ FStoreItemQuery::EOp::Push, Query.Predicates.Num() });
+		Query.Predicates.Add(MoveTemp(Predicate));
+		return true;
+	}
+
+	bool ParsePredicate(FStoreItemQuery::FPredicate& Out)
+	{
+		using namespace StoreItemQueryPrivate;
+
+		SkipWhitespace();
+		const int32 FieldPos = Pos;
+		while (Pos < Expression.Len() && (FChar::IsAlnum(Expression[Pos]) || Expression[Pos] == TEXT('_') || Expression[Pos] == TEXT('.')))
+		{
+			++Pos;
+		}
+		FStringView FieldText = Expression.Mid(FieldPos, Pos - FieldPos);
+		if (FieldText.IsEmpty())
+		{
+			Error = FString::Printf(TEXT("Expected a field at %d"), FieldPos);
+			return false;
+		}
+
+		// Price.GD, BundledVirtualCurrencies.GD...
+		FStringView CurrencyText;
+		int32 Dot = INDEX_NONE;
+		if (FieldText.FindChar(TEXT('.'), Dot))
+		{
+			CurrencyText = FieldText.RightChop(Dot + 1);
+			FieldText = FieldText.Left(Dot);
+		}
+		if (FieldText.StartsWith(TEXT("Is"), ESearchCase::CaseSensitive) && FieldText.Len() > 2 && FChar::IsUpper(FieldText[2]))
+		{
+			FieldText.RightChopInline(2);
+		}
+
+		const FFieldInfo* Field = GetFields().FindByPredicate([FieldText](const FFieldInfo& Info)
+			{
+				return FieldText.Equals(Info.Name, ESearchCase::IgnoreCase);
+			});
+		if (!Field)
+		{
+			Error = FString::Printf(TEXT("Unknown field '%.*s' at %d"), FieldText.Len(), FieldText.GetData(), FieldPos);
+			return false;
+		}
+		Out.Kind = static_cast<EFieldKind>(Field->Kind);
+		Out.Field = Field->Field;
+
+		const bool bCurrencyField = Out.Kind == EFieldKind::Price || Out.Kind == EFieldKind::Currencies;
+		if (bCurrencyField != !CurrencyText.IsEmpty())
+		{
+			Error = bCurrencyField
+				? FString::Printf(TEXT("'%s' needs a currency, e.g. %s.GD, at %d"), Field->Name, Field->Name, FieldPos)
+				: FString::Printf(TEXT("'%s' has no sub-fields, at %d"), Field->Name, FieldPos);
+			return false;
+		}
+		if (bCurrencyField)
+		{
+			const FCurrencyCode Code = FCurrencyCode::FromString(CurrencyText);
+			if (!Code.IsValid())
+			{
+				Error = FString::Printf(TEXT("'%.*s' is not a currency code, at %d"), CurrencyText.Len(), CurrencyText.GetData(), FieldPos);
+				return false;
+			}
+			Out.Currency = Catalog.FindCurrency(Code);
+		}
+
+		if (!ParseCompare(Out.Compare))
+		{
+			// A bare flag means the flag is set.
+			if (Out.Kind == EFieldKind::Flag)
+			{
+				Out.Compare = ECompare::Equal;
+				Out.Number = 1;
+				return true;
+			}
+			Error = FString::Printf(TEXT("Expected ==, !=, <, <=, >, >= or ~ after '%s' at %d"), Field->Name, Pos);
+			return false;
+		}
+
+		const int32 ValuePos = Pos;
+		FString Value;
+		if (!ParseValue(Value))
+		{
+			Error = FString::Printf(TEXT("Expected a value at %d"), ValuePos);
+			return false;
+		}
+
+		const bool bOrdered = Out.Compare != ECompare::Equal && Out.Compare != ECompare::NotEqual && Out.Compare != ECompare::Contains;
+		switch (Out.Kind)
+		{
+		case EFieldKind::Flag:
+			if (bOrdered || Out.Compare == ECompare::Contains || !(Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("false"), ESearchCase::IgnoreCase)))
+			{
+				Error = FString::Printf(TEXT("'%s' is a flag: use it alone, or with == true / == false, at %d"), Field->Name, FieldPos);
+				return false;
+			}
+			Out.Number = Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) ? 1 : 0;
+			return true;
+
+		case EFieldKind::Name:
+		case EFieldKind::List:
+			if (bOrdered)
+			{
+				Error = FString::Printf(TEXT("'%s' is text: use ==, != or ~, at %d"), Field->Name, FieldPos);
+				return false;
+			}
+			if (Out.Compare == ECompare::Contains)
+			{
+				MatchNames(Value, Out.NameMatches);
+			}
+			else
+			{
+				Out.Name = Catalog.FindName(FStringView(Value));
+			}
+			return true;
+
+		default:
+			if (Out.Compare == ECompare::Contains)
+			{
+				Error = FString::Printf(TEXT("'%s' is a number: ~ does not apply, at %d"), Field->Name, FieldPos);
+				return false;
+			}
+			if (!FStoreItemQuery::ParseNumber(Value, Out.Number))
+			{
+				Error = FString::Printf(TEXT("'%s' is not a number, at %d"), *Value, ValuePos);
+				return false;
+			}
+			return true;
+		}
+	}
+
+	bool ParseCompare(ECompare& Out)
+	{
+		SkipWhitespace();
+		struct FOperator { const TCHAR* Text; ECompare Compare; };
+		static const FOperator Operators[] =
+		{
+			{ TEXT("=="), ECompare::Equal },
+			{ TEXT("!="), ECompare::NotEqual },
+			{ TEXT("<="), ECompare::LessEqual },
+			{ TEXT(">="), ECompare::GreaterEqual },
+			{ TEXT("<"), ECompare::Less },
+			{ TEXT(">"), ECompare::Greater },
+			{ TEXT("="), ECompare::Equal },
+			{ TEXT("~"), ECompare::Contains },
+		};
+		for (const FOperator& Operator : Operators)
+		{
+			if (IsAt(Operator.Text))
+			{
+				Pos += FCString::Strlen(Operator.Text);
+				Out = Operator.Compare;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** A quoted string, or everything up to whitespace or an operator. Numbers keep a unit such as "1 day". */
+	bool ParseValue(FString& Out)
+	{
+		SkipWhitespace();
+		if (Pos < Expression.Len() && Expression[Pos] == TEXT('"'))
+		{
+			const int32 Start = ++Pos;
+			while (Pos < Expression.Len() && Expression[Pos] != TEXT('"'))
+			{
+				++Pos;
+			}
+			if (Pos == Expression.Len())
+			{
+				return false;
+			}
+			Out = FString(Expression.Mid(Start, Pos++ - Start));
+			return true;
+		}
+
+		const int32 Start = Pos;
+		while (Pos < Expression.Len() && !FChar::IsWhitespace(Expression[Pos]) && !IsOperator(Expression[Pos]))
+		{
+			++Pos;
+		}
+		Out = FString(Expression.Mid(Start, Pos - Start));
+
+		// "1 day": a unit after a number belongs to the value.
+		if (Out.Len() > 0 && FChar::IsDigit(Out[Out.Len() - 1]))
+		{
+			int32 UnitPos = Pos;
+			while (UnitPos < Expression.Len() && FChar::IsWhitespace(Expression[UnitPos]))
+			{
+				++UnitPos;
+			}
+			const int32 UnitStart = UnitPos;
+			while (UnitPos < Expression.Len() && FChar::IsAlpha(Expression[UnitPos]))
+			{
+				++UnitPos;
+			}
+			int64 Unused = 0;
+			if (UnitPos > UnitStart && StoreItemQueryPrivate::ParseUnit(Expression.Mid(UnitStart, UnitPos - UnitStart), Unused))
+			{
+				Out += Expression.Mid(UnitStart, UnitPos - UnitStart);
+				Pos = UnitPos;
+			}
+		}
+		return !Out.IsEmpty();
+	}
+
+	/** Runs ~ over the name dictionary once; items then only test the bit of their name id. */
+	void MatchNames(const FString& Text, TArray<uint64>& OutMatches) const
+	{
+		using namespace StoreItemQueryPrivate;
+
+		const FTCHARToUTF8 Utf8(*Text);
+		TArray<ANSICHAR> Lower;
+		Lower.Reserve(Utf8.Length());
+		for (int32 Index = 0; Index < Utf8.Length(); ++Index)
+		{
+			Lower.Add(ToLowerAscii(Utf8.Get()[Index]));
+		}
+
+		const int32 NumNames = Catalog.NumNames();
+		OutMatches.SetNumZeroed(FMath::DivideAndRoundUp(NumNames, 64));
+		const FStoreCatalog& InCatalog = Catalog;
+		FillBits(OutMatches, NumNames, [&InCatalog, &Lower](int32 Name)
+			{
+				return ContainsIgnoreCase(InCatalog.GetName(Name), Lower);
+			});
+	}
+
+	bool ConsumeOperator(TCHAR Char)
+	{
+		SkipWhitespace();
+		if (Pos < Expression.Len() && Expression[Pos] == Char)
+		{
+			++Pos;
+			if ((Char == TEXT('&') || Char == TEXT('|')) && Pos < Expression.Len() && Expression[Pos] == Char)
+			{
+				++Pos;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	bool IsAt(const TCHAR* Text) const
+	{
+		return Expression.RightChop(Pos).StartsWith(Text, ESearchCase::CaseSensitive);
+	}
+
+	void SkipWhitespace()
+	{
+		while (Pos < Expression.Len() && FChar::IsWhitespace(Expression[Pos]))
+		{
+			++Pos;
+		}
+	}
+
+	static bool IsOperator(TCHAR Char)
+	{
+		return Char == TEXT('&') || Char == TEXT('|') || Char == TEXT('!') || Char == TEXT('(') || Char == TEXT(')') || Char == TEXT('"')
+			|| Char == TEXT('=') || Char == TEXT('<') || Char == TEXT('>') || Char == TEXT('~');
+	}
+
+	const FStoreCatalog& Catalog;
+	FStringView Expression;
+	FStoreItemQuery& Query;
+	int32 Pos = 0;
+	FString Error;
+};
+
+bool FStoreItemQuery::Compile(const FStoreCatalog& Catalog, FStringView Expression, FStoreItemQuery& OutQuery, FString* OutError)
+{
+	OutQuery.Ops.Reset();
+	OutQuery.Predicates.Reset();
+	OutQuery.MaxDepth = 0;
+
+	FString Error;
+	if (!FStoreItemQueryCompiler(Catalog, Expression, OutQuery).Run(Error))
+	{
+		OutQuery.Ops.Reset();
+		OutQuery.Predicates.Reset();
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+		return false;
+	}
+
+	int32 Depth = 0;
+	for (const FOp& Op : OutQuery.Ops)
+	{
+		Depth += (Op.Op == EOp::Push) ? 1 : (Op.Op == EOp::And || Op.Op == EOp::Or) ? -1 : 0;
+		OutQuery.MaxDepth = FMath::Max(OutQuery.MaxDepth, Depth);
+	}
+	return true;
+}
+
+bool FStoreItemQuery::ParseNumber(FStringView Text, int64& OutNumber)
+{
+	Text.TrimStartAndEndInline();
+	int32 End = 0;
+	if (End < Text.Len() && Text[End] == TEXT('-'))
+	{
+		++End;
+	}
+	const int32 DigitsStart = End;
+	while (End < Text.Len() && FChar::IsDigit(Text[End]))
+	{
+		++End;
+	}
+	if (End == DigitsStart || End - DigitsStart > 12)
+	{
+		return false;
+	}
+
+	OutNumber = FCString::Atoi64(*FString(Text.Left(End)));
+	const FStringView Unit = Text.RightChop(End).TrimStart();
+	if (Unit.IsEmpty())
+	{
+		return true;
+	}
+	int64 Scale = 1;
+	if (!StoreItemQueryPrivate::ParseUnit(Unit, Scale))
+	{
+		return false;
+	}
+	OutNumber *= Scale;
+	return true;
+}
+
+FString FStoreItemQuery::GetSyntaxHelp()
+{
+	return TEXT("Flags: Tradable, Stackable, LimitedEdition, TokenForCharacterCreation, Consumable, Bundle, Container\n")
+		TEXT("Text (==, !=, ~ contains): ItemId, DisplayName, ItemClass, Description, CustomData, UsagePeriodGroup, KeyItemId\n")
+		TEXT("Numbers (==, !=, <, <=, >, >=): UsageCount, UsagePeriod (1d, 12h...), Price.GD, BundledVirtualCurrencies.GD, VirtualCurrencyContents.GD\n")
+		TEXT("Lists (== has, != lacks, ~ any contains): Tags, BundledItems, BundledResultTables, ItemContents, ResultTableContents\n")
+		TEXT("Combine with & | ! and ( ), e.g. Tradable & Consumable & Class == Potion & UsagePeriod > 1d & Price.GD < 100");
+}
+
+void FStoreItemQuery::Evaluate(const FStoreCatalog& Catalog, FStoreItemBitSet& OutResult) const
+{
+	PFSTORE_SCOPE(ItemQuery);
+
+	const int32 NumItems = Catalog.NumItems();
+
+	if (Ops.Num() == 0)
+	{
+		OutResult.Init(NumItems, true);
+		return;
+	}
+
+	// The bottom of the stack is the caller's set; deeper levels only exist for the right side of a binary op.
+	TArray<FStoreItemBitSet, TInlineAllocator<4>> Scratch;
+	Scratch.SetNum(FMath::Max(MaxDepth - 1, 0));
+
+	auto Slot = [&OutResult, &Scratch](int32 Index) -> FStoreItemBitSet&
+		{
+			return Index == 0 ? OutResult : Scratch[Index - 1];
+		};
+
+	int32 Depth = 0;
+	for (const FOp& Op : Ops)
+	{
+		switch (Op.Op)
+		{
+		case EOp::Push:
+		{
+			FStoreItemBitSet& Top = Slot(Depth++);
+			if (Top.NumItems() != NumItems || Top.NumWords() != FStoreItemBitSet::GetNumWords(NumItems))
+			{
+				Top.Init(NumItems, false);
+			}
+			EvaluatePredicate(Catalog, Predicates[Op.Predicate], Top);
+			break;
+		}
+		case EOp::Not:
+			Slot(Depth - 1).Not();
+			break;
+		case EOp::And:
+			Slot(Depth - 2).And(Slot(Depth - 1));
+			--Depth;
+			break;
+		case EOp::Or:
+			Slot(Depth - 2).Or(Slot(Depth - 1));
+			--Depth;
+			break;
+		}
+	}
+
+	check(Depth == 1);
+}
+
+void FStoreItemQuery::EvaluatePredicate(const FStoreCatalog& Catalog, const FPredicate& Predicate, FStoreItemBitSet& OutBits) const
+{
+	using namespace StoreItemQueryPrivate;
+
+	const int32 NumItems = Catalog.NumItems();
+	const TArrayView<uint64> Words = OutBits.GetWords();
+	const ECompare Compare = Predicate.Compare;
+	const EStoreCatalogSection Section = static_cast<EStoreCatalogSection>(Predicate.Field);
+
+	switch (Predicate.Kind)
+	{
+	case EFieldKind::Flag:
+	{
+		const bool bWanted = (Predicate.Number != 0) == (Predicate.Compare == ECompare::Equal);
+		if (Predicate.Field == static_cast<uint8>(EStoreItemFlags::None))
+		{
+			// Consumable: PlayFab only sends consumable info that has a count or a period.
+			const int32* Counts = Catalog.GetSection<int32>(EStoreCatalogSection::UsageCounts).GetData();
+			const int32* Periods = Catalog.GetSection<int32>(EStoreCatalogSection::UsagePeriods).GetData();
+			FillBits(Words, NumItems, [Counts, Periods, bWanted](int32 Item) { return ((Counts[Item] > 0) | (Periods[Item] > 0)) == bWanted; });
+		}
+		else
+		{
+			const uint8* Flags = reinterpret_cast<const uint8*>(Catalog.GetSection<EStoreItemFlags>(EStoreCatalogSection::Flags).GetData());
+			const uint8 Flag = Predicate.Field;
+			FillBits(Words, NumItems, [Flags, Flag, bWanted](int32 Item) { return ((Flags[Item] & Flag) != 0) == bWanted; });
+		}
+		break;
+	}
+
+	case EFieldKind::Name:
+	{
+		const FStoreNameId* Column = nullptr;
+		TArray<FStoreNameId> KeyItems;
+		if (Section == EStoreCatalogSection::ContainerKeyItems)
+		{
+			// The only per-container name column; spread it over the items once.
+			KeyItems.SetNumUninitialized(NumItems);
+			for (int32 Item = 0; Item < NumItems; ++Item)
+			{
+				KeyItems[Item] = Catalog.GetContainerKeyItem(FStoreItemHandle(Item));
+			}
+			Column = KeyItems.GetData();
+		}
+		else
+		{
+			Column = Catalog.GetSection<FStoreNameId>(Section).GetData();
+		}
+
+		if (Predicate.Compare == ECompare::Contains)
+		{
+			const TConstArrayView<uint64> Matches = Predicate.NameMatches;
+			FillBits(Words, NumItems, [Column, Matches](int32 Item) { return TestBit(Matches, Column[Item]); });
+		}
+		else
+		{
+			// A name missing from the catalog is INDEX_NONE, which no item holds.
+			FillCompare(Words, NumItems, Compare, Predicate.Name, [Column](int32 Item) { return Column[Item]; });
+		}
+		break;
+	}
+
+	case EFieldKind::Integer:
+	{
+		const int32* Column = Catalog.GetSection<int32>(Section).GetData();
+		FillCompare(Words, NumItems, Compare, Predicate.Number, [Column](int32 Item) { return int64(Column[Item]); });
+		break;
+	}
+
+	case EFieldKind::Price:
+	{
+		if (Predicate.Currency == INDEX_NONE)
+		{
+			OutBits.Reset();
+			break;
+		}
+		// Unpriced items hold NoPrice; they match no price comparison, not even !=.
+		const int32* Column = Catalog.GetPriceColumn(Predicate.Currency).GetData();
+		FillCompare(Words, NumItems, Compare, Predicate.Number, [Column](int32 Item) { return int64(Column[Item]); });
+		FStoreItemBitSet Priced(NumItems, false);
+		FillBits(Priced.GetWords(), NumItems, [Column](int32 Item) { return Column[Item] != FStoreCatalog::NoPrice; });
+		OutBits.And(Priced);
+		break;
+	}
+
+	case EFieldKind::Currencies:
+	{
+		if (Predicate.Currency == INDEX_NONE)
+		{
+			OutBits.Reset();
+			break;
+		}
+		// Items without that currency in their contents do not match, as with prices.
+		const uint16 Currency = static_cast<uint16>(Predicate.Currency);
+		const bool bBundle = Section == EStoreCatalogSection::BundledCurrencies;
+		const int64 Missing = MIN_int64;
+		auto GetAmount = [&Catalog, Currency, bBundle, Missing](int32 Item) -> int64
+			{
+				const FStoreItemHandle Handle(Item);
+				const TConstArrayView<FStoreCurrencyAmount> Amounts = bBundle
+					? Catalog.GetBundledCurrencies(Handle)
+					: Catalog.GetContainerCurrencies(Handle);
+				for (const FStoreCurrencyAmount& Amount : Amounts)
+				{
+					if (Amount.Currency == Currency)
+					{
+						return Amount.Amount;
+					}
+				}
+				return Missing;
+			};
+		FillCompare(Words, NumItems, Compare, Predicate.Number, GetAmount);
+		FStoreItemBitSet Present(NumItems, false);
+		FillBits(Present.GetWords(), NumItems, [&GetAmount, Missing](int32 Item) { return GetAmount(Item) != Missing; });
+		OutBits.And(Present);
+		break;
+	}
+
+	case EFieldKind::List:
+	{
+		// Tags have a bit set per tag already.
+		if (Section == EStoreCatalogSection::Tags && Predicate.Compare != ECompare::Contains)
+		{
+			const int32 Tag = Predicate.Name != INDEX_NONE ? Catalog.FindTag(Catalog.GetNameString(Predicate.Name)) : INDEX_NONE;
+			if (Tag != INDEX_NONE)
+			{
+				OutBits.Assign(Catalog.GetTagBits(Tag));
+			}
+			else
+			{
+				OutBits.Reset();
+			}
+			if (Predicate.Compare == ECompare::NotEqual)
+			{
+				OutBits.Not();
+			}
+			break;
+		}
+
+		auto GetList = [&Catalog, Section](int32 Item) -> TConstArrayView<FStoreNameId>
+			{
+				const FStoreItemHandle Handle(Item);
+				switch (Section)
+				{
+				case EStoreCatalogSection::Tags: return Catalog.GetTags(Handle);
+				case EStoreCatalogSection::BundledItems: return Catalog.GetBundledItems(Handle);
+				case EStoreCatalogSection::BundledResultTables: return Catalog.GetBundledResultTables(Handle);
+				case EStoreCatalogSection::ContainerItems: return Catalog.GetContainerItems(Handle);
+				default: return Catalog.GetContainerResultTables(Handle);
+				}
+			};
+
+		if (Predicate.Compare == ECompare::Contains)
+		{
+			const TConstArrayView<uint64> Matches = Predicate.NameMatches;
+			FillBits(Words, NumItems, [&GetList, Matches](int32 Item)
+				{
+					return GetList(Item).ContainsByPredicate([Matches](FStoreNameId Name) { return TestBit(Matches, Name); });
+				});
+		}
+		else
+		{
+			const FStoreNameId Name = Predicate.Name;
+			const bool bWanted = Predicate.Compare == ECompare::Equal;
+			FillBits(Words, NumItems, [&GetList, Name, bWanted](int32 Item)
+				{
+					return (Name != INDEX_NONE && GetList(Item).Contains(Name)) == bWanted;
+				});
+		}
+		break;
+	}
+	}
+}
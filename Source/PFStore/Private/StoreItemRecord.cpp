@@ -0,0 +1,83 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreItemRecord.h"
+#include "StoreItemDataAsset.h"
+
+bool FStoreItemRecord::FromObject(const UObject* Object, FStoreItemRecord& Out)
+{
+	if (!Object || !Object->GetClass()->ImplementsInterface(UStoreItemProvider::StaticClass()))
+	{
+		return false;
+	}
+
+	// Mapped properties are copied from memory through the cached layout instead of the getters.
+	if (const UStoreItemDataAsset* DataAsset = Cast<UStoreItemDataAsset>(Object))
+	{
+		DataAsset->ToStoreItemRecord(Out);
+		return true;
+	}
+
+	const IStoreItemProvider* Provider = Cast<IStoreItemProvider>(Object);
+	if (!Provider)
+	{
+		return false;
+	}
+
+	Out.ItemId = Provider->GetItemId();
+	Out.DisplayName = Provider->GetDisplayName();
+	Out.ItemClass = Provider->GetItemClass();
+	Out.Description = Provider->GetDescription();
+	Out.CustomData = Provider->GetCustomData();
+	Out.Tags = Provider->GetTags();
+	Out.Prices = Provider->GetCurrencyPrices();
+
+	Out.bIsLimitedEdition = Provider->GetIsLimitedEdition();
+	Out.bIsTokenForCharacterCreation = Provider->GetIsTokenForCharacterCreation();
+	Out.bIsTradable = Provider->GetIsTradable();
+	Out.bIsStackable = Provider->GetIsStackable();
+
+	Out.Consumable = Provider->GetConsumableInfo();
+
+	const IStoreBundleProvider* BundleProvider = Cast<IStoreBundleProvider>(Object);
+	Out.bIsBundle = BundleProvider != nullptr;
+	Out.Bundle = BundleProvider ? BundleProvider->GetBundleInfo() : FBundleInfo{};
+
+	const IStoreContainerProvider* ContainerProvider = Cast<IStoreContainerProvider>(Object);
+	Out.bIsContainer = ContainerProvider != nullptr;
+	Out.Container = ContainerProvider ? ContainerProvider->GetContainerInfo() : FContainerInfo{};
+
+	return true;
+}
+
+FArchive& operator<<(FArchive& Ar, FStoreItemRecord& Record)
+{
+	Ar << Record.ItemId;
+	Ar << Record.DisplayName;
+	Ar << Record.ItemClass;
+	Ar << Record.Description;
+	Ar << Record.CustomData;
+	Ar << Record.Tags;
+	Record.Prices.Serialize(Ar);
+
+	Ar << Record.bIsLimitedEdition;
+	Ar << Record.bIsTokenForCharacterCreation;
+	Ar << Record.bIsTradable;
+	Ar << Record.bIsStackable;
+
+	Ar << Record.Consumable.UsageCount;
+	Ar << Record.Consumable.UsagePeriod;
+	Ar << Record.Consumable.UsagePeriodGroup;
+
+	Ar << Record.bIsBundle;
+	Ar << Record.Bundle.BundledItems;
+	Ar << Record.Bundle.BundledResultTables;
+	Record.Bundle.BundledVirtualCurrencies.Serialize(Ar);
+
+	Ar << Record.bIsContainer;
+	Ar << Record.Container.KeyItemId;
+	Ar << Record.Container.ItemContents;
+	Ar << Record.Container.ResultTableContents;
+	Record.Container.VirtualCurrencyContents.Serialize(Ar);
+
+	return Ar;
+}
@@ -0,0 +1,739 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreJson.h"
+
+#include "Serialization/Archive.h"
+
+namespace StoreJsonPrivate
+{
+	template<typename ArrayType>
+	static void AppendUtf8(ArrayType& Out, uint32 CodePoint)
+	{
+		using ElementType = typename ArrayType::ElementType;
+
+		if (CodePoint < 0x80)
+		{
+			Out.Add(ElementType(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add(ElementType(0xC0 | (CodePoint >> 6)));
+			Out.Add(ElementType(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add(ElementType(0xE0 | (CodePoint >> 12)));
+			Out.Add(ElementType(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(ElementType(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add(ElementType(0xF0 | (CodePoint >> 18)));
+			Out.Add(ElementType(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add(ElementType(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(ElementType(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	static bool IsHighSurrogate(uint32 Char) { return Char >= 0xD800 && Char <= 0xDBFF; }
+	static bool IsLowSurrogate(uint32 Char) { return Char >= 0xDC00 && Char <= 0xDFFF; }
+
+	static uint32 CombineSurrogates(uint32 High, uint32 Low)
+	{
+		return 0x10000 + ((High - 0xD800) << 10) + (Low - 0xDC00);
+	}
+
+	static constexpr uint32 ReplacementChar = 0xFFFD;
+}
+
+// ---------- FStoreJsonWriter ----------
+
+FStoreJsonWriter::FStoreJsonWriter(TArray<uint8>& InBuffer)
+	: Buffer(InBuffer)
+{
+}
+
+FStoreJsonWriter::FStoreJsonWriter(TArray<uint8>& InBuffer, FArchive& InArchive)
+	: Buffer(InBuffer)
+	, Archive(&InArchive)
+{
+	Buffer.Reset();
+	Buffer.Reserve(FlushThreshold + FlushThreshold / 4);
+}
+
+FStoreJsonWriter::~FStoreJsonWriter()
+{
+	Flush();
+}
+
+bool FStoreJsonWriter::Flush()
+{
+	if (Archive)
+	{
+		if (Buffer.Num() > 0)
+		{
+			Archive->Serialize(Buffer.GetData(), Buffer.Num());
+			Buffer.Reset();
+		}
+		return !Archive->IsError();
+	}
+	return true;
+}
+
+void FStoreJsonWriter::BeginValue()
+{
+	if (bAfterIdentifier)
+	{
+		bAfterIdentifier = false;
+		return;
+	}
+
+	if (Scopes.Num() > 0)
+	{
+		if (Scopes.Last())
+		{
+			Buffer.Add(',');
+		}
+		Scopes.Last() = true;
+	}
+}
+
+void FStoreJsonWriter::EndValue()
+{
+	if (Archive && Buffer.Num() >= FlushThreshold)
+	{
+		Flush();
+	}
+}
+
+void FStoreJsonWriter::AppendAscii(const ANSICHAR* Text)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+}
+
+void FStoreJsonWriter::AppendString(FStringView Value)
+{
+	using namespace StoreJsonPrivate;
+
+	static const ANSICHAR* Hex = "0123456789abcdef";
+
+	Buffer.Reserve(Buffer.Num() + Value.Len() + 2);
+	Buffer.Add('"');
+
+	const TCHAR* It = Value.GetData();
+	const TCHAR* const ValueEnd = It + Value.Len();
+	while (It < ValueEnd)
+	{
+		uint32 Char = uint32(*It++);
+		if (Char < 0x80)
+		{
+			switch (Char)
+			{
+			case '"':  AppendAscii("\\\""); break;
+			case '\\': AppendAscii("\\\\"); break;
+			case '\n': AppendAscii("\\n"); break;
+			case '\r': AppendAscii("\\r"); break;
+			case '\t': AppendAscii("\\t"); break;
+			case '\b': AppendAscii("\\b"); break;
+			case '\f': AppendAscii("\\f"); break;
+			default:
+				if (Char < 0x20)
+				{
+					AppendAscii("\\u00");
+					Buffer.Add(Hex[Char >> 4]);
+					Buffer.Add(Hex[Char & 0xF]);
+				}
+				else
+				{
+					Buffer.Add(uint8(Char));
+				}
+				break;
+			}
+			continue;
+		}
+
+		// TCHAR is UTF-16 on some platforms and UTF-32 on others; pairs only show up in the former.
+		if (IsHighSurrogate(Char))
+		{
+			Char = (It < ValueEnd && IsLowSurrogate(uint32(*It))) ? CombineSurrogates(Char, uint32(*It++)) : ReplacementChar;
+		}
+		else if (IsLowSurrogate(Char) || Char > 0x10FFFF)
+		{
+			Char = ReplacementChar;
+		}
+		AppendUtf8(Buffer, Char);
+	}
+
+	Buffer.Add('"');
+}
+
+int64 FStoreJsonWriter::GetStringSize(FStringView Value)
+{
+	using namespace StoreJsonPrivate;
+
+	// Mirrors AppendString.
+	int64 Size = 2;
+	const TCHAR* It = Value.GetData();
+	const TCHAR* const ValueEnd = It + Value.Len();
+	while (It < ValueEnd)
+	{
+		uint32 Char = uint32(*It++);
+		if (Char < 0x80)
+		{
+			switch (Char)
+			{
+			case '"':
+			case '\\':
+			case '\n':
+			case '\r':
+			case '\t':
+			case '\b':
+			case '\f':
+				Size += 2;
+				break;
+			default:
+				Size += Char < 0x20 ? 6 : 1;
+				break;
+			}
+			continue;
+		}
+
+		if (IsHighSurrogate(Char))
+		{
+			Char = (It < ValueEnd && IsLowSurrogate(uint32(*It))) ? CombineSurrogates(Char, uint32(*It++)) : ReplacementChar;
+		}
+		else if (IsLowSurrogate(Char) || Char > 0x10FFFF)
+		{
+			Char = ReplacementChar;
+		}
+		Size += Char < 0x800 ? 2 : Char < 0x10000 ? 3 : 4;
+	}
+	return Size;
+}
+
+int32 FStoreJsonWriter::GetIntegerSize(int64 Value)
+{
+	int32 Size = Value < 0 ? 2 : 1;
+	for (uint64 Magnitude = Value < 0 ? uint64(0) - uint64(Value) : uint64(Value); Magnitude >= 10; Magnitude /= 10)
+	{
+		++Size;
+	}
+	return Size;
+}
+
+void FStoreJsonWriter::WriteIdentifier(const ANSICHAR* Identifier)
+{
+	check(Scopes.Num() > 0 && !bAfterIdentifier);
+
+	BeginValue();
+	Buffer.Add('"');
+	AppendAscii(Identifier);
+	AppendAscii("\":");
+	bAfterIdentifier = true;
+}
+
+void FStoreJsonWriter::WriteObjectStart()
+{
+	BeginValue();
+	Buffer.Add('{');
+	Scopes.Push(false);
+}
+
+void FStoreJsonWriter::WriteObjectStart(const ANSICHAR* Identifier)
+{
+	WriteIdentifier(Identifier);
+	WriteObjectStart();
+}
+
+void FStoreJsonWriter::WriteObjectEnd()
+{
+	check(Scopes.Num() > 0);
+	Scopes.Pop(EAllowShrinking::No);
+	Buffer.Add('}');
+	EndValue();
+}
+
+void FStoreJsonWriter::WriteArrayStart()
+{
+	BeginValue();
+	Buffer.Add('[');
+	Scopes.Push(false);
+}
+
+void FStoreJsonWriter::WriteArrayStart(const ANSICHAR* Identifier)
+{
+	WriteIdentifier(Identifier);
+	WriteArrayStart();
+}
+
+void FStoreJsonWriter::WriteArrayEnd()
+{
+	check(Scopes.Num() > 0);
+	Scopes.Pop(EAllowShrinking::No);
+	Buffer.Add(']');
+	EndValue();
+}
+
+void FStoreJsonWriter::WriteValue(FStringView Value)
+{
+	BeginValue();
+	AppendString(Value);
+	EndValue();
+}
+
+void FStoreJsonWriter::WriteValue(int64 Value)
+{
+	BeginValue();
+
+	ANSICHAR Digits[24];
+	int32 Num = 0;
+	uint64 Magnitude = Value < 0 ? uint64(0) - uint64(Value) : uint64(Value);
+	do
+	{
+		Digits[Num++] = ANSICHAR('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude != 0);
+
+	if (Value < 0)
+	{
+		Buffer.Add('-');
+	}
+	while (Num > 0)
+	{
+		Buffer.Add(uint8(Digits[--Num]));
+	}
+
+	EndValue();
+}
+
+void FStoreJsonWriter::WriteValue(bool Value)
+{
+	BeginValue();
+	AppendAscii(Value ? "true" : "false");
+	EndValue();
+}
+
+void FStoreJsonWriter::WriteNull()
+{
+	BeginValue();
+	AppendAscii("null");
+	EndValue();
+}
+
+void FStoreJsonWriter::WriteStringOrNull(const ANSICHAR* Identifier, const FString& Value)
+{
+	WriteIdentifier(Identifier);
+	if (Value.IsEmpty())
+	{
+		WriteNull();
+	}
+	else
+	{
+		WriteValue(Value);
+	}
+}
+
+void FStoreJsonWriter::WriteRawValue(TConstArrayView<uint8> Json)
+{
+	BeginValue();
+	Buffer.Append(Json.GetData(), Json.Num());
+	EndValue();
+}
+
+// ---------- FStoreJsonReader ----------
+
+FStoreJsonReader::FStoreJsonReader(FArchive& InArchive)
+	: Archive(&InArchive)
+{
+	ChunkStart = Archive->Tell();
+}
+
+FStoreJsonReader::FStoreJsonReader(TConstArrayView<uint8> Data)
+	: ChunkData(Data.GetData())
+	, Pos(Data.GetData())
+	, End(Data.GetData() + Data.Num())
+{
+}
+
+bool FStoreJsonReader::Refill()
+{
+	if (!Archive || bFailed)
+	{
+		return false;
+	}
+
+	const int64 Remaining = Archive->TotalSize() - Archive->Tell();
+	if (Remaining <= 0)
+	{
+		return false;
+	}
+
+	ChunkStart += End - ChunkData;
+
+	const int32 Num = int32(FMath::Min<int64>(Remaining, ChunkSize));
+	Chunk.SetNumUninitialized(Num, EAllowShrinking::No);
+	Archive->Serialize(Chunk.GetData(), Num);
+	if (Archive->IsError())
+	{
+		Fail(TEXT("Read error"));
+		return false;
+	}
+
+	ChunkData = Chunk.GetData();
+	Pos = ChunkData;
+	End = ChunkData + Num;
+	return true;
+}
+
+EStoreJsonToken FStoreJsonReader::Fail(const TCHAR* Message)
+{
+	if (!bFailed)
+	{
+		bFailed = true;
+		Error = FString::Printf(TEXT("%s at byte %lld"), Message, GetOffset());
+	}
+	return EStoreJsonToken::Error;
+}
+
+void FStoreJsonReader::SkipWhitespace()
+{
+	for (;;)
+	{
+		const int32 Char = Peek();
+		if (Char != ' ' && Char != '\n' && Char != '\r' && Char != '\t')
+		{
+			return;
+		}
+		++Pos;
+	}
+}
+
+EStoreJsonToken FStoreJsonReader::Next()
+{
+	if (bFailed)
+	{
+		return EStoreJsonToken::Error;
+	}
+
+	if (!bStarted)
+	{
+		bStarted = true;
+		// Tolerate the BOM some editors put in front of UTF-8 files.
+		if (Peek() == 0xEF && End - Pos >= 3 && Pos[1] == 0xBB && Pos[2] == 0xBF)
+		{
+			Pos += 3;
+		}
+	}
+
+	Identifier.Reset();
+	SkipWhitespace();
+
+	if (Scopes.Num() == 0)
+	{
+		if (bTopLevelDone)
+		{
+			return Peek() < 0 ? EStoreJsonToken::End : Fail(TEXT("Unexpected data after the document"));
+		}
+	}
+	else
+	{
+		int32 Char = Peek();
+
+		FScope& Scope = Scopes.Last();
+		if (Char == (Scope.bObject ? '}' : ']'))
+		{
+			++Pos;
+			const bool bObject = Scope.bObject;
+			Scopes.Pop(EAllowShrinking::No);
+			bTopLevelDone = Scopes.Num() == 0;
+			return bObject ? EStoreJsonToken::ObjectEnd : EStoreJsonToken::ArrayEnd;
+		}
+
+		if (Scope.bHasElements)
+		{
+			if (Char != ',')
+			{
+				return Fail(Scope.bObject ? TEXT("Expected ',' or '}'") : TEXT("Expected ',' or ']'"));
+			}
+			++Pos;
+			SkipWhitespace();
+			Char = Peek();
+		}
+		Scope.bHasElements = true;
+
+		if (Scope.bObject)
+		{
+			if (Char != '"')
+			{
+				return Fail(TEXT("Expected member name"));
+			}
+			++Pos;
+			if (!ReadString(Identifier))
+			{
+				return EStoreJsonToken::Error;
+			}
+			SkipWhitespace();
+			if (Read() != ':')
+			{
+				return Fail(TEXT("Expected ':'"));
+			}
+			SkipWhitespace();
+		}
+	}
+
+	EStoreJsonToken Token;
+	const int32 Char = Read();
+	switch (Char)
+	{
+	case '{':
+		Scopes.Push({ true, false });
+		return EStoreJsonToken::ObjectStart;
+
+	case '[':
+		Scopes.Push({ false, false });
+		return EStoreJsonToken::ArrayStart;
+
+	case '"':
+		if (!ReadString(StringValue))
+		{
+			return EStoreJsonToken::Error;
+		}
+		Token = EStoreJsonToken::String;
+		break;
+
+	case 't':
+		if (!ReadLiteral("rue"))
+		{
+			return EStoreJsonToken::Error;
+		}
+		Token = EStoreJsonToken::True;
+		break;
+
+	case 'f':
+		if (!ReadLiteral("alse"))
+		{
+			return EStoreJsonToken::Error;
+		}
+		Token = EStoreJsonToken::False;
+		break;
+
+	case 'n':
+		if (!ReadLiteral("ull"))
+		{
+			return EStoreJsonToken::Error;
+		}
+		Token = EStoreJsonToken::Null;
+		break;
+
+	case -1:
+		return Fail(TEXT("Unexpected end of document"));
+
+	default:
+		if (Char != '-' && (Char < '0' || Char > '9'))
+		{
+			return Fail(TEXT("Unexpected character"));
+		}
+		if (!ReadNumber(Char))
+		{
+			return EStoreJsonToken::Error;
+		}
+		Token = EStoreJsonToken::Number;
+		break;
+	}
+
+	bTopLevelDone = Scopes.Num() == 0;
+	return Token;
+}
+
+bool FStoreJsonReader::ReadLiteral(const ANSICHAR* Rest)
+{
+	for (; *Rest; ++Rest)
+	{
+		if (Read() != *Rest)
+		{
+			Fail(TEXT("Invalid literal"));
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FStoreJsonReader::ReadNumber(int32 First)
+{
+	int32 Len = 0;
+	NumberText[Len++] = ANSICHAR(First);
+
+	for (;;)
+	{
+		const int32 Char = Peek();
+		const bool bNumberChar = (Char >= '0' && Char <= '9') || Char == '.' || Char == 'e' || Char == 'E' || Char == '+' || Char == '-';
+		if (!bNumberChar)
+		{
+			break;
+		}
+		if (Len == UE_ARRAY_COUNT(NumberText) - 1)
+		{
+			Fail(TEXT("Number too long"));
+			return false;
+		}
+		NumberText[Len++] = ANSICHAR(Char);
+		++Pos;
+	}
+
+	NumberText[Len] = 0;
+	return true;
+}
+
+int64 FStoreJsonReader::GetInt64() const
+{
+	for (const ANSICHAR* It = NumberText; *It; ++It)
+	{
+		if (*It == '.' || *It == 'e' || *It == 'E')
+		{
+			return int64(FCStringAnsi::Atod(NumberText));
+		}
+	}
+	return FCStringAnsi::Strtoi64(NumberText, nullptr, 10);
+}
+
+double FStoreJsonReader::GetDouble() const
+{
+	return FCStringAnsi::Atod(NumberText);
+}
+
+bool FStoreJsonReader::ReadHex4(uint32& Out)
+{
+	Out = 0;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		const int32 Char = Read();
+		uint32 Digit;
+		if (Char >= '0' && Char <= '9')
+		{
+			Digit = Char - '0';
+		}
+		else if (Char >= 'a' && Char <= 'f')
+		{
+			Digit = Char - 'a' + 10;
+		}
+		else if (Char >= 'A' && Char <= 'F')
+		{
+			Digit = Char - 'A' + 10;
+		}
+		else
+		{
+			Fail(TEXT("Invalid \\u escape"));
+			return false;
+		}
+		Out = (Out << 4) | Digit;
+	}
+	return true;
+}
+
+bool FStoreJsonReader::ReadString(FString& Out)
+{
+	using namespace StoreJsonPrivate;
+
+	Scratch.Reset();
+
+	for (;;)
+	{
+		// Copy the plain run inside the current chunk in one go.
+		const uint8* RunStart = Pos;
+		while (Pos < End && *Pos != '"' && *Pos != '\\' && *Pos >= 0x20)
+		{
+			++Pos;
+		}
+		Scratch.Append(reinterpret_cast<const UTF8CHAR*>(RunStart), int32(Pos - RunStart));
+
+		const int32 Char = Read();
+		if (Char == '"')
+		{
+			break;
+		}
+		if (Char < 0)
+		{
+			Fail(TEXT("Unterminated string"));
+			return false;
+		}
+		if (Char != '\\')
+		{
+			if (Char < 0x20)
+			{
+				Fail(TEXT("Control character in string"));
+				return false;
+			}
+			// Only reached when the run stopped at a chunk boundary.
+			Scratch.Add(UTF8CHAR(Char));
+			continue;
+		}
+
+		const int32 Escape = Read();
+		switch (Escape)
+		{
+		case '"':  Scratch.Add(UTF8CHAR('"')); break;
+		case '\\': Scratch.Add(UTF8CHAR('\\')); break;
+		case '/':  Scratch.Add(UTF8CHAR('/')); break;
+		case 'b':  Scratch.Add(UTF8CHAR('\b')); break;
+		case 'f':  Scratch.Add(UTF8CHAR('\f')); break;
+		case 'n':  Scratch.Add(UTF8CHAR('\n')); break;
+		case 'r':  Scratch.Add(UTF8CHAR('\r')); break;
+		case 't':  Scratch.Add(UTF8CHAR('\t')); break;
+		case 'u':
+		{
+			uint32 CodePoint;
+			if (!ReadHex4(CodePoint))
+			{
+				return false;
+			}
+			if (IsHighSurrogate(CodePoint))
+			{
+				uint32 Low = 0;
+				if (Read() != '\\' || Read() != 'u')
+				{
+					Fail(TEXT("Unpaired surrogate"));
+					return false;
+				}
+				if (!ReadHex4(Low))
+				{
+					return false;
+				}
+				CodePoint = IsLowSurrogate(Low) ? CombineSurrogates(CodePoint, Low) : ReplacementChar;
+			}
+			else if (IsLowSurrogate(CodePoint))
+			{
+				CodePoint = ReplacementChar;
+			}
+			AppendUtf8(Scratch, CodePoint);
+			break;
+		}
+		default:
+			Fail(TEXT("Invalid escape"));
+			return false;
+		}
+	}
+
+	Out.Reset();
+	const auto Converted = StringCast<TCHAR>(Scratch.GetData(), Scratch.Num());
+	Out.AppendChars(Converted.Get(), Converted.Length());
+	return true;
+}
+
+bool FStoreJsonReader::SkipValue(EStoreJsonToken Token)
+{
+	if (Token != EStoreJsonToken::ObjectStart && Token != EStoreJsonToken::ArrayStart)
+	{
+		return Token != EStoreJsonToken::Error;
+	}
+
+	const int32 Depth = Scopes.Num() - 1;
+	while (Scopes.Num() > Depth)
+	{
+		if (Next() == EStoreJsonToken::Error)
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,176 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StorePriceQuery.h"
+
+#include "StoreStats.h"
+#include "Math/VectorRegister.h"
+
+namespace StorePriceQueryPrivate
+{
+	/** Bit per lane for the 64 prices of one bit set word that are within Balance. */
+	static FORCEINLINE uint64 AffordableMask(const int32* RESTRICT Prices, int32 Balance)
+	{
+		uint64 Mask = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+		const VectorRegister4Int Limit = VectorIntSet1(Balance);
+		for (int32 Lane = 0; Lane < 64; Lane += 4)
+		{
+			const VectorRegister4Int TooExpensive = VectorIntCompareGT(VectorIntLoad(Prices + Lane), Limit);
+			Mask |= uint64(~VectorMaskBits(VectorCastIntToFloat(TooExpensive)) & 0xF) << Lane;
+		}
+#else
+		for (int32 Lane = 0; Lane < 64; ++Lane)
+		{
+			Mask |= uint64(Prices[Lane] <= Balance) << Lane;
+		}
+#endif
+
+		return Mask;
+	}
+}
+
+void FStoreWallet::SetBalance(const FStoreCatalog& Catalog, FCurrencyCode Code, int32 Amount)
+{
+	const int32 Currency = Catalog.FindCurrency(Code);
+	if (Currency == INDEX_NONE)
+	{
+		return;
+	}
+	if (Balances.Num() != Catalog.NumCurrencies())
+	{
+		Balances.SetNumZeroed(Catalog.NumCurrencies());
+	}
+	Balances[Currency] = Amount;
+}
+
+void FStorePriceQuery::FindAffordable(const FStoreCatalog& Catalog, const FStoreWallet& Wallet, FStoreItemBitSet& OutItems)
+{
+	PFSTORE_SCOPE(PriceQuery);
+
+	const int32 NumItems = Catalog.NumItems();
+	if (OutItems.NumItems() != NumItems)
+	{
+		OutItems.Init(NumItems, false);
+	}
+	else
+	{
+		OutItems.Reset();
+	}
+
+	TArrayView<uint64> Words = OutItems.GetWords();
+	const int32 NumWords = Words.Num();
+
+	for (int32 Currency = 0; Currency < Catalog.NumCurrencies(); ++Currency)
+	{
+		if (!Wallet.Balances.IsValidIndex(Currency) || Wallet.Balances[Currency] < 0)
+		{
+			continue;
+		}
+
+		// Padding and unpriced items hold NoPrice, which no clamped balance reaches.
+		const int32 Balance = FMath::Min(Wallet.Balances[Currency], FStoreCatalog::NoPrice - 1);
+		const int32* Column = Catalog.GetPriceColumn(Currency).GetData();
+
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			Words[Word] |= StorePriceQueryPrivate::AffordableMask(Column + Word * 64, Balance);
+		}
+	}
+}
+
+void FStorePriceQuery::FindCheapest(const FStoreCatalog& Catalog, int32 Currency, int32 Count, TArray<FStoreItemHandle>& OutItems,
+	FStoreNameId ItemClass, const FStoreItemBitSet* Candidates)
+{
+	PFSTORE_SCOPE(PriceQuery);
+
+	OutItems.Reset();
+	if (Count <= 0 || Currency < 0 || Currency >= Catalog.NumCurrencies())
+	{
+		return;
+	}
+
+	struct FEntry
+	{
+		int32 Price;
+		int32 Item;
+	};
+
+	// Max-heap on (price, item) so the current worst pick is always on top.
+	auto MoreExpensive = [](const FEntry& A, const FEntry& B)
+		{
+			return A.Price != B.Price ? A.Price > B.Price : A.Item > B.Item;
+		};
+
+	TArray<FEntry> Heap;
+	Heap.Reserve(Count + 1);
+
+	const TConstArrayView<int32> Column = Catalog.GetPriceColumn(Currency);
+	const TConstArrayView<FStoreNameId> Classes = Catalog.GetSection<FStoreNameId>(EStoreCatalogSection::ItemClasses);
+	const int32 NumItems = Catalog.NumItems();
+
+	for (int32 Item = 0; Item < NumItems; ++Item)
+	{
+		const int32 Price = Column[Item];
+		if (Price == FStoreCatalog::NoPrice)
+		{
+			continue;
+		}
+		if (ItemClass != INDEX_NONE && Classes[Item] != ItemClass)
+		{
+			continue;
+		}
+		if (Candidates && !Candidates->Contains(FStoreItemHandle(Item)))
+		{
+			continue;
+		}
+
+		const FEntry Entry{ Price, Item };
+		if (Heap.Num() < Count)
+		{
+			Heap.HeapPush(Entry, MoreExpensive);
+		}
+		else if (MoreExpensive(Heap.HeapTop(), Entry))
+		{
+			Heap.HeapPopDiscard(MoreExpensive, EAllowShrinking::No);
+			Heap.HeapPush(Entry, MoreExpensive);
+		}
+	}
+
+	Heap.Sort([](const FEntry& A, const FEntry& B)
+		{
+			return A.Price != B.Price ? A.Price < B.Price : A.Item < B.Item;
+		});
+
+	OutItems.Reserve(Heap.Num());
+	for (const FEntry& Entry : Heap)
+	{
+		OutItems.Add(FStoreItemHandle(Entry.Item));
+	}
+}
+
+void FStorePriceQuery::SumPrices(const FStoreCatalog& Catalog, TConstArrayView<FStoreItemHandle> Cart, TArray<int64>& OutTotals)
+{
+	PFSTORE_SCOPE(PriceQuery);
+
+	const int32 NumCurrencies = Catalog.NumCurrencies();
+	OutTotals.Init(0, NumCurrencies);
+
+	for (int32 Currency = 0; Currency < NumCurrencies; ++Currency)
+	{
+		const int32* Column = Catalog.GetPriceColumn(Currency).GetData();
+
+		int64 Total = 0;
+		for (const FStoreItemHandle Item : Cart)
+		{
+			const int32 Price = Column[Item.Index];
+			if (Price == FStoreCatalog::NoPrice)
+			{
+				Total = INDEX_NONE;
+				break;
+			}
+			Total += Price;
+		}
+		OutTotals[Currency] = Total;
+	}
+}
@@ -0,0 +1,60 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreStats.h"
+
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(PFStoreChannel);
+
+LLM_DEFINE_TAG(PFStore);
+
+DEFINE_STAT(STAT_PFStore_AssetDiscovery);
+DEFINE_STAT(STAT_PFStore_ProviderExtraction);
+DEFINE_STAT(STAT_PFStore_CsvWrite);
+DEFINE_STAT(STAT_PFStore_CsvParse);
+DEFINE_STAT(STAT_PFStore_Validate);
+DEFINE_STAT(STAT_PFStore_Diff);
+DEFINE_STAT(STAT_PFStore_Merge);
+DEFINE_STAT(STAT_PFStore_JsonSerialize);
+DEFINE_STAT(STAT_PFStore_JsonParse);
+DEFINE_STAT(STAT_PFStore_PlayFabRequest);
+DEFINE_STAT(STAT_PFStore_PlayFabResponse);
+DEFINE_STAT(STAT_PFStore_CatalogBuild);
+DEFINE_STAT(STAT_PFStore_CatalogCook);
+DEFINE_STAT(STAT_PFStore_CatalogLoad);
+DEFINE_STAT(STAT_PFStore_TagQuery);
+DEFINE_STAT(STAT_PFStore_PriceQuery);
+DEFINE_STAT(STAT_PFStore_ItemQuery);
+DEFINE_STAT(STAT_PFStore_BulkEdit);
+
+DEFINE_STAT(STAT_PFStore_LiveCatalogs);
+DEFINE_STAT(STAT_PFStore_CatalogHeapMemory);
+DEFINE_STAT(STAT_PFStore_CatalogMappedMemory);
+
+TRACE_DECLARE_INT_COUNTER(PFStore_ItemsProcessed, TEXT("PFStore/ItemsProcessed"));
+TRACE_DECLARE_INT_COUNTER(PFStore_PlayFabRequestsInFlight, TEXT("PFStore/PlayFabRequestsInFlight"));
+TRACE_DECLARE_MEMORY_COUNTER(PFStore_PlayFabBytesSent, TEXT("PFStore/PlayFabBytesSent"));
+TRACE_DECLARE_MEMORY_COUNTER(PFStore_PlayFabBytesReceived, TEXT("PFStore/PlayFabBytesReceived"));
+
+namespace PFStoreStats
+{
+	void AddItemsProcessed(int32 NumItems)
+	{
+		TRACE_COUNTER_ADD(PFStore_ItemsProcessed, NumItems);
+	}
+
+	void BeginPlayFabRequest(const TCHAR* Name, int64 RequestBytes)
+	{
+		TRACE_BEGIN_REGION(Name);
+		TRACE_COUNTER_INCREMENT(PFStore_PlayFabRequestsInFlight);
+		TRACE_COUNTER_ADD(PFStore_PlayFabBytesSent, RequestBytes);
+	}
+
+	void EndPlayFabRequest(const TCHAR* Name, int64 ResponseBytes)
+	{
+		TRACE_END_REGION(Name);
+		TRACE_COUNTER_DECREMENT(PFStore_PlayFabRequestsInFlight);
+		TRACE_COUNTER_ADD(PFStore_PlayFabBytesReceived, ResponseBytes);
+	}
+}
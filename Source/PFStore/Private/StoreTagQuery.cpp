@@ -0,0 +1,302 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreTagQuery.h"
+
+#include "StoreStats.h"
+
+/** Recursive descent over: Or := And ('|' And)*, And := Unary ('&' Unary)*, Unary := '!' Unary | '(' Or ')' | Tag */
+class FStoreTagQueryCompiler
+{
+public:
+	FStoreTagQueryCompiler(const FStoreCatalog& InCatalog, FStringView InExpression, FStoreTagQuery& InQuery)
+		: Catalog(InCatalog)
+		, Expression(InExpression)
+		, Query(InQuery)
+	{
+	}
+
+	bool Run(FString& OutError)
+	{
+		SkipWhitespace();
+		if (Pos == Expression.Len())
+		{
+			return true;
+		}
+
+		if (!ParseOr())
+		{
+			OutError = Error;
+			return false;
+		}
+
+		SkipWhitespace();
+		if (Pos != Expression.Len())
+		{
+			OutError = FString::Printf(TEXT("Unexpected '%c' at %d"), Expression[Pos], Pos);
+			return false;
+		}
+		return true;
+	}
+
+private:
+	bool ParseOr()
+	{
+		if (!ParseAnd())
+		{
+			return false;
+		}
+		while (Consume(TEXT('|')))
+		{
+			if (!ParseAnd())
+			{
+				return false;
+			}
+			Query.Emit(FStoreTagQuery::EOp::Or);
+		}
+		return true;
+	}
+
+	bool ParseAnd()
+	{
+		if (!ParseUnary())
+		{
+			return false;
+		}
+		while (Consume(TEXT('&')))
+		{
+			if (!ParseUnary())
+			{
+				return false;
+			}
+			Query.Emit(FStoreTagQuery::EOp::And);
+		}
+		return true;
+	}
+
+	bool ParseUnary()
+	{
+		if (Consume(TEXT('!')))
+		{
+			if (!ParseUnary())
+			{
+				return false;
+			}
+			Query.Emit(FStoreTagQuery::EOp::Not);
+			return true;
+		}
+
+		if (Consume(TEXT('(')))
+		{
+			if (!ParseOr())
+			{
+				return false;
+			}
+			if (!Consume(TEXT(')')))
+			{
+				Error = FString::Printf(TEXT("Missing ')' at %d"), Pos);
+				return false;
+			}
+			return true;
+		}
+
+		FStringView Tag;
+		if (!ParseTag(Tag))
+		{
+			Error = FString::Printf(TEXT("Expected a tag at %d"), Pos);
+			return false;
+		}
+		Query.Emit(FStoreTagQuery::EOp::PushTag, Catalog.FindTag(Tag));
+		return true;
+	}
+
+	bool ParseTag(FStringView& OutTag)
+	{
+		SkipWhitespace();
+
+		if (Pos < Expression.Len() && Expression[Pos] == TEXT('"'))
+		{
+			const int32 Start = ++Pos;
+			while (Pos < Expression.Len() && Expression[Pos] != TEXT('"'))
+			{
+				++Pos;
+			}
+			if (Pos == Expression.Len())
+			{
+				return false;
+			}
+			OutTag = Expression.Mid(Start, Pos++ - Start);
+			return true;
+		}
+
+		const int32 Start = Pos;
+		while (Pos < Expression.Len() && !FChar::IsWhitespace(Expression[Pos]) && !IsOperator(Expression[Pos]))
+		{
+			++Pos;
+		}
+		OutTag = Expression.Mid(Start, Pos - Start);
+		return !OutTag.IsEmpty();
+	}
+
+	/** Accepts both single and doubled operators, so "a && b" reads the same as "a & b". */
+	bool Consume(TCHAR Char)
+	{
+		SkipWhitespace();
+		if (Pos < Expression.Len() && Expression[Pos] == Char)
+		{
+			++Pos;
+			if ((Char == TEXT('&') || Char == TEXT('|')) && Pos < Expression.Len() && Expression[Pos] == Char)
+			{
+				++Pos;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	void SkipWhitespace()
+	{
+		while (Pos < Expression.Len() && FChar::IsWhitespace(Expression[Pos]))
+		{
+			++Pos;
+		}
+	}
+
+	static bool IsOperator(TCHAR Char)
+	{
+		return Char == TEXT('&') || Char == TEXT('|') || Char == TEXT('!') || Char == TEXT('(') || Char == TEXT(')') || Char == TEXT('"');
+	}
+
+	const FStoreCatalog& Catalog;
+	FStringView Expression;
+	FStoreTagQuery& Query;
+	int32 Pos = 0;
+	FString Error;
+};
+
+bool FStoreTagQuery::Compile(const FStoreCatalog& Catalog, FStringView Expression, FStoreTagQuery& OutQuery, FString* OutError)
+{
+	OutQuery.Ops.Reset();
+	OutQuery.MaxDepth = 0;
+
+	FString Error;
+	if (!FStoreTagQueryCompiler(Catalog, Expression, OutQuery).Run(Error))
+	{
+		OutQuery.Ops.Reset();
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+		return false;
+	}
+
+	int32 Depth = 0;
+	for (const FOp& Op : OutQuery.Ops)
+	{
+		Depth += (Op.Op == EOp::PushTag) ? 1 : (Op.Op == EOp::And || Op.Op == EOp::Or) ? -1 : 0;
+		OutQuery.MaxDepth = FMath::Max(OutQuery.MaxDepth, Depth);
+	}
+	return true;
+}
+
+void FStoreTagQuery::Emit(EOp Op, int32 Tag)
+{
+	// Fold a tag operand straight into the binary op so the tag's bits are never copied.
+	const int32 Num = Ops.Num();
+	if (Op == EOp::And && Num >= 2 && Ops[Num - 1].Op == EOp::Not && Ops[Num - 2].Op == EOp::PushTag)
+	{
+		const int32 NotTag = Ops[Num - 2].Tag;
+		Ops.SetNum(Num - 2);
+		Ops.Add({ EOp::AndNotTag, NotTag });
+		return;
+	}
+	if ((Op == EOp::And || Op == EOp::Or) && Num >= 1 && Ops[Num - 1].Op == EOp::PushTag)
+	{
+		const int32 LastTag = Ops[Num - 1].Tag;
+		Ops.Pop();
+		Ops.Add({ Op == EOp::And ? EOp::AndTag : EOp::OrTag, LastTag });
+		return;
+	}
+	Ops.Add({ Op, Tag });
+}
+
+void FStoreTagQuery::Evaluate(const FStoreCatalog& Catalog, FStoreItemBitSet& OutResult) const
+{
+	PFSTORE_SCOPE(TagQuery);
+
+	const int32 NumItems = Catalog.NumItems();
+
+	if (Ops.Num() == 0)
+	{
+		OutResult.Init(NumItems, true);
+		return;
+	}
+
+	// The bottom of the stack is the caller's set; deeper levels only exist for parenthesised ORs.
+	TArray<FStoreItemBitSet, TInlineAllocator<4>> Scratch;
+	Scratch.SetNum(FMath::Max(MaxDepth - 1, 0));
+
+	auto Slot = [&OutResult, &Scratch](int32 Index) -> FStoreItemBitSet&
+		{
+			return Index == 0 ? OutResult : Scratch[Index - 1];
+		};
+
+	int32 Depth = 0;
+	for (const FOp& Op : Ops)
+	{
+		switch (Op.Op)
+		{
+		case EOp::PushTag:
+		{
+			FStoreItemBitSet& Top = Slot(Depth++);
+			if (Top.NumItems() != NumItems || Top.NumWords() != FStoreItemBitSet::GetNumWords(NumItems))
+			{
+				Top.Init(NumItems, false);
+			}
+			if (Op.Tag != INDEX_NONE)
+			{
+				Top.Assign(Catalog.GetTagBits(Op.Tag));
+			}
+			else
+			{
+				Top.Reset();
+			}
+			break;
+		}
+		case EOp::Not:
+			Slot(Depth - 1).Not();
+			break;
+		case EOp::And:
+			Slot(Depth - 2).And(Slot(Depth - 1));
+			--Depth;
+			break;
+		case EOp::Or:
+			Slot(Depth - 2).Or(Slot(Depth - 1));
+			--Depth;
+			break;
+		case EOp::AndTag:
+			if (Op.Tag != INDEX_NONE)
+			{
+				Slot(Depth - 1).And(Catalog.GetTagBits(Op.Tag));
+			}
+			else
+			{
+				Slot(Depth - 1).Reset();
+			}
+			break;
+		case EOp::OrTag:
+			if (Op.Tag != INDEX_NONE)
+			{
+				Slot(Depth - 1).Or(Catalog.GetTagBits(Op.Tag));
+			}
+			break;
+		case EOp::AndNotTag:
+			if (Op.Tag != INDEX_NONE)
+			{
+				Slot(Depth - 1).AndNot(Catalog.GetTagBits(Op.Tag));
+			}
+			break;
+		}
+	}
+
+	check(Depth == 1);
+}
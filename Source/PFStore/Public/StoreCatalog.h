@@ -0,0 +1,358 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreCurrency.h"
+
+struct FStoreItemRecord;
+struct FDropTableInfo;
+class IMappedFileHandle;
+class IMappedFileRegion;
+enum class EStoreCatalogLoadResult : uint8;
+
+/** Dense id of an interned string (item ids, classes, tags, table ids...). 0 is always the empty string. */
+typedef int32 FStoreNameId;
+
+/** Dense index of an item inside an FStoreCatalog. */
+struct FStoreItemHandle
+{
+	int32 Index = INDEX_NONE;
+
+	FStoreItemHandle() = default;
+	explicit FStoreItemHandle(int32 InIndex) : Index(InIndex) {}
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	bool operator==(FStoreItemHandle Other) const { return Index == Other.Index; }
+	bool operator!=(FStoreItemHandle Other) const { return Index != Other.Index; }
+
+	friend uint32 GetTypeHash(FStoreItemHandle Handle) { return ::GetTypeHash(Handle.Index); }
+};
+
+/** Range inside one of the catalog's shared pools. */
+struct FStoreSpan
+{
+	uint32 Start = 0;
+	uint32 Num = 0;
+};
+
+struct FStoreCurrencyAmount
+{
+	/** Index into the catalog's currency table, see FStoreCatalog::GetCurrencyCode. */
+	uint16 Currency = 0;
+	uint16 Reserved = 0;
+	int32 Amount = 0;
+};
+
+struct FStoreDropNode
+{
+	FStoreNameId ResultItemType = 0;
+	FStoreNameId ResultItem = 0;
+	int32 Weight = 0;
+};
+
+enum class EStoreItemFlags : uint8
+{
+	None                      = 0,
+	LimitedEdition            = 1 << 0,
+	TokenForCharacterCreation = 1 << 1,
+	Tradable                  = 1 << 2,
+	Stackable                 = 1 << 3,
+	Bundle                    = 1 << 4,
+	Container                 = 1 << 5,
+};
+ENUM_CLASS_FLAGS(EStoreItemFlags);
+
+/**
+ * Every array the catalog is made of. Each section is a flat run of POD values inside one
+ * contiguous buffer, addressed by offset, so the whole catalog can be copied or mapped as-is.
+ */
+enum class EStoreCatalogSection : uint8
+{
+	// Strings
+	StringOffsets,          // uint32[NumNames + 1], byte offsets into StringData
+	StringData,             // UTF8CHAR[], not null terminated
+	NameSlots,              // FStoreNameId[power of two], open addressed hash of StringData
+	ItemByName,             // int32[NumNames], item index owning that id or INDEX_NONE
+
+	// Shared pools
+	Currencies,             // FCurrencyCode[NumCurrencies]
+	NameLists,              // FStoreNameId[], referenced by FStoreSpan columns
+	CurrencyAmounts,        // FStoreCurrencyAmount[], referenced by FStoreSpan columns
+
+	// Item columns, one value per item
+	ItemIds,                // FStoreNameId
+	DisplayNames,           // FStoreNameId
+	ItemClasses,            // FStoreNameId
+	Descriptions,           // FStoreNameId
+	CustomData,             // FStoreNameId
+	UsagePeriodGroups,      // FStoreNameId
+	Flags,                  // EStoreItemFlags
+	UsageCounts,            // int32
+	UsagePeriods,           // int32
+	Tags,                   // FStoreSpan into NameLists
+	Prices,                 // FStoreSpan into CurrencyAmounts
+	BundleIndices,          // int32 into the bundle columns or INDEX_NONE
+	ContainerIndices,       // int32 into the container columns or INDEX_NONE
+
+	// Bundle columns
+	BundledItems,           // FStoreSpan into NameLists
+	BundledResultTables,    // FStoreSpan into NameLists
+	BundledCurrencies,      // FStoreSpan into CurrencyAmounts
+
+	// Container columns
+	ContainerKeyItems,      // FStoreNameId
+	ContainerItems,         // FStoreSpan into NameLists
+	ContainerResultTables,  // FStoreSpan into NameLists
+	ContainerCurrencies,    // FStoreSpan into CurrencyAmounts
+
+	// Drop tables
+	DropTableIds,           // FStoreNameId
+	DropTableNodes,         // FStoreSpan into DropNodes
+	DropNodes,              // FStoreDropNode[]
+	DropTableByName,        // int32[NumNames], drop table index owning that id or INDEX_NONE
+
+	// Tag index
+	TagNames,               // FStoreNameId[NumTags]
+	TagByName,              // int32[NumNames], tag index for that id or INDEX_NONE
+	TagBits,                // uint64[NumTags * FStoreItemBitSet::GetNumWords(NumItems)], one bit per item
+
+	// Price columns
+	PriceColumns,           // int32[NumCurrencies * GetPriceColumnStride()], FStoreCatalog::NoPrice where unpriced
+
+	Count
+};
+
+struct FStoreCatalogSectionEntry
+{
+	uint32 Offset = 0;
+	uint32 Num = 0;
+};
+
+/**
+ * Read-only store catalog in structure-of-arrays layout.
+ * All ids are interned to FStoreNameId and every list lives in a shared pool, so looking up an
+ * item or walking its bundle contents never hashes an FString or follows a per-item allocation.
+ */
+class PFSTORE_API FStoreCatalog
+{
+public:
+	FStoreCatalog(const FStoreCatalog&) = delete;
+	FStoreCatalog& operator=(const FStoreCatalog&) = delete;
+	~FStoreCatalog();
+
+	/**
+	 * Maps a cooked catalog blob and uses it in place. Only the header and section table are
+	 * validated unless bVerifyPayload is set; section contents are trusted, so set it for any blob
+	 * that did not come straight from WriteCooked in this process. Returns null and fills
+	 * OutResult when the blob is missing, corrupt or was cooked with a different layout version.
+	 */
+	static TSharedPtr<const FStoreCatalog> LoadCooked(const FString& FilePath, EStoreCatalogLoadResult& OutResult, bool bVerifyPayload = false);
+
+	/** Same as LoadCooked, for a blob that is already in memory. */
+	static TSharedPtr<const FStoreCatalog> LoadCooked(TArray<uint8>&& Blob, EStoreCatalogLoadResult& OutResult, bool bVerifyPayload = false);
+
+	/** Writes the versioned, position independent blob LoadCooked reads. */
+	void WriteCooked(TArray<uint8>& OutBlob) const;
+
+	int32 NumItems() const { return Sections[(int32)EStoreCatalogSection::ItemIds].Num; }
+	int32 NumNames() const { return Sections[(int32)EStoreCatalogSection::ItemByName].Num; }
+	int32 NumCurrencies() const { return Sections[(int32)EStoreCatalogSection::Currencies].Num; }
+
+	// Names
+
+	FStoreNameId FindName(FUtf8StringView Name) const;
+	FStoreNameId FindName(FStringView Name) const;
+	FUtf8StringView GetName(FStoreNameId Id) const;
+	FString GetNameString(FStoreNameId Id) const;
+
+	// Lookup
+
+	FStoreItemHandle FindItem(FStringView ItemId) const;
+	FStoreItemHandle FindItemByName(FStoreNameId ItemId) const;
+
+	// Items
+
+	FStoreNameId GetItemId(FStoreItemHandle Item) const { return Column<FStoreNameId>(EStoreCatalogSection::ItemIds, Item); }
+	FStoreNameId GetDisplayName(FStoreItemHandle Item) const { return Column<FStoreNameId>(EStoreCatalogSection::DisplayNames, Item); }
+	FStoreNameId GetItemClass(FStoreItemHandle Item) const { return Column<FStoreNameId>(EStoreCatalogSection::ItemClasses, Item); }
+	FStoreNameId GetDescription(FStoreItemHandle Item) const { return Column<FStoreNameId>(EStoreCatalogSection::Descriptions, Item); }
+	FStoreNameId GetCustomData(FStoreItemHandle Item) const { return Column<FStoreNameId>(EStoreCatalogSection::CustomData, Item); }
+	FStoreNameId GetUsagePeriodGroup(FStoreItemHandle Item) const { return Column<FStoreNameId>(EStoreCatalogSection::UsagePeriodGroups, Item); }
+	EStoreItemFlags GetFlags(FStoreItemHandle Item) const { return Column<EStoreItemFlags>(EStoreCatalogSection::Flags, Item); }
+	int32 GetUsageCount(FStoreItemHandle Item) const { return Column<int32>(EStoreCatalogSection::UsageCounts, Item); }
+	int32 GetUsagePeriod(FStoreItemHandle Item) const { return Column<int32>(EStoreCatalogSection::UsagePeriods, Item); }
+
+	bool HasAnyFlags(FStoreItemHandle Item, EStoreItemFlags InFlags) const { return EnumHasAnyFlags(GetFlags(Item), InFlags); }
+
+	TConstArrayView<FStoreNameId> GetTags(FStoreItemHandle Item) const;
+	TConstArrayView<FStoreCurrencyAmount> GetPrices(FStoreItemHandle Item) const;
+
+	// Currencies
+
+	FCurrencyCode GetCurrencyCode(int32 CurrencyIndex) const { return GetSection<FCurrencyCode>(EStoreCatalogSection::Currencies)[CurrencyIndex]; }
+	int32 FindCurrency(FCurrencyCode Code) const { return GetSection<FCurrencyCode>(EStoreCatalogSection::Currencies).Find(Code); }
+	int32 FindCurrency(FStringView Code) const { return FindCurrency(FCurrencyCode::FromString(Code)); }
+
+	/** Marks items that cannot be bought with a currency in its price column. */
+	static constexpr int32 NoPrice = MAX_int32;
+
+	/** Items per price column, NumItems() padded to whole bit set words so column loops never need a tail. */
+	int32 GetPriceColumnStride() const;
+
+	/** Price of every item in one currency, see FStorePriceQuery. */
+	TConstArrayView<int32> GetPriceColumn(int32 CurrencyIndex) const;
+
+	// Bundles
+
+	bool IsBundle(FStoreItemHandle Item) const { return HasAnyFlags(Item, EStoreItemFlags::Bundle); }
+	TConstArrayView<FStoreNameId> GetBundledItems(FStoreItemHandle Item) const;
+	TConstArrayView<FStoreNameId> GetBundledResultTables(FStoreItemHandle Item) const;
+	TConstArrayView<FStoreCurrencyAmount> GetBundledCurrencies(FStoreItemHandle Item) const;
+
+	// Containers
+
+	bool IsContainer(FStoreItemHandle Item) const { return HasAnyFlags(Item, EStoreItemFlags::Container); }
+	FStoreNameId GetContainerKeyItem(FStoreItemHandle Item) const;
+	TConstArrayView<FStoreNameId> GetContainerItems(FStoreItemHandle Item) const;
+	TConstArrayView<FStoreNameId> GetContainerResultTables(FStoreItemHandle Item) const;
+	TConstArrayView<FStoreCurrencyAmount> GetContainerCurrencies(FStoreItemHandle Item) const;
+
+	// Drop tables
+
+	int32 NumDropTables() const { return Sections[(int32)EStoreCatalogSection::DropTableIds].Num; }
+	int32 FindDropTable(FStringView TableId) const;
+	FStoreNameId GetDropTableId(int32 Table) const { return GetSection<FStoreNameId>(EStoreCatalogSection::DropTableIds)[Table]; }
+	TConstArrayView<FStoreDropNode> GetDropTableNodes(int32 Table) const;
+
+	// Tags
+
+	int32 NumTags() const { return Sections[(int32)EStoreCatalogSection::TagNames].Num; }
+	int32 FindTag(FStringView Tag) const;
+	FStoreNameId GetTagName(int32 Tag) const { return GetSection<FStoreNameId>(EStoreCatalogSection::TagNames)[Tag]; }
+
+	/** Items carrying the tag, as FStoreItemBitSet::GetNumWords(NumItems()) words. See FStoreTagQuery. */
+	TConstArrayView<uint64> GetTagBits(int32 Tag) const;
+
+	/** Raw access to one section of the catalog buffer. */
+	template<typename T>
+	TConstArrayView<T> GetSection(EStoreCatalogSection Section) const
+	{
+		const FStoreCatalogSectionEntry& Entry = Sections[(int32)Section];
+		return TConstArrayView<T>(reinterpret_cast<const T*>(Base + Entry.Offset), Entry.Num);
+	}
+
+	/** Heap bytes held by the catalog. A mapped catalog only pays for what the OS pages in. */
+	SIZE_T GetAllocatedSize() const { return Storage.GetAllocatedSize(); }
+
+	/** Size of the section buffer, wherever it lives. */
+	uint32 GetDataSize() const { return DataSize; }
+
+private:
+	friend class FStoreCatalogBuilder;
+
+	FStoreCatalog();
+
+	static TSharedPtr<const FStoreCatalog> FromBlob(TSharedRef<FStoreCatalog> Catalog, const uint8* Blob, int64 BlobSize,
+		EStoreCatalogLoadResult& OutResult, bool bVerifyPayload);
+
+	/** Reports the catalog to the PFStore memory stats until it is destroyed. */
+	void TrackMemory();
+
+	template<typename T>
+	T Column(EStoreCatalogSection Section, FStoreItemHandle Item) const
+	{
+		return GetSection<T>(Section)[Item.Index];
+	}
+
+	template<typename T>
+	TConstArrayView<T> Pool(EStoreCatalogSection Section, FStoreSpan Span) const
+	{
+		return GetSection<T>(Section).Slice(Span.Start, Span.Num);
+	}
+
+	/** Owns the sections of a built catalog or a blob loaded into memory. */
+	TArray<uint8> Storage;
+
+	/** Keep a mapped blob alive for as long as the catalog points into it. */
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const uint8* Base = nullptr;
+	uint32 DataSize = 0;
+	SIZE_T TrackedHeapBytes = 0;
+	SIZE_T TrackedMappedBytes = 0;
+	bool bTracked = false;
+	FStoreCatalogSectionEntry Sections[(int32)EStoreCatalogSection::Count];
+};
+
+/** Collects item records and lays them out into an FStoreCatalog. */
+class PFSTORE_API FStoreCatalogBuilder
+{
+public:
+	FStoreCatalogBuilder();
+
+	/** Adds one item. Returns an invalid handle if an item with the same id was already added. */
+	FStoreItemHandle AddItem(const FStoreItemRecord& Record);
+
+	/** Adds one drop table. Returns INDEX_NONE if a table with the same id was already added. */
+	int32 AddDropTable(const FDropTableInfo& Table);
+
+	int32 NumItems() const { return ItemIds.Num(); }
+	int32 NumDropTables() const { return DropTableIds.Num(); }
+
+	TSharedRef<const FStoreCatalog> Build() const;
+
+private:
+	FStoreNameId Intern(const FString& Str);
+	FStoreNameId FindName(FUtf8StringView Name, uint32 Hash) const;
+	void GrowNameSlots();
+
+	uint16 InternCurrency(FCurrencyCode Code);
+	FStoreSpan AddNameList(const TArray<FString>& Names);
+	FStoreSpan AddCurrencyAmounts(const FCurrencyAmounts& Amounts);
+
+	// Strings
+	TArray<uint32> StringOffsets;
+	TArray<UTF8CHAR> StringData;
+	TArray<FStoreNameId> NameSlots;
+	TArray<int32> ItemByName;
+	TArray<int32> DropTableByName;
+
+	// Pools
+	TArray<FCurrencyCode> Currencies;
+	TArray<FStoreNameId> NameLists;
+	TArray<FStoreCurrencyAmount> CurrencyAmounts;
+
+	// Items
+	TArray<FStoreNameId> ItemIds;
+	TArray<FStoreNameId> DisplayNames;
+	TArray<FStoreNameId> ItemClasses;
+	TArray<FStoreNameId> Descriptions;
+	TArray<FStoreNameId> CustomData;
+	TArray<FStoreNameId> UsagePeriodGroups;
+	TArray<EStoreItemFlags> Flags;
+	TArray<int32> UsageCounts;
+	TArray<int32> UsagePeriods;
+	TArray<FStoreSpan> Tags;
+	TArray<FStoreSpan> Prices;
+	TArray<int32> BundleIndices;
+	TArray<int32> ContainerIndices;
+
+	// Bundles
+	TArray<FStoreSpan> BundledItems;
+	TArray<FStoreSpan> BundledResultTables;
+	TArray<FStoreSpan> BundledCurrencies;
+
+	// Containers
+	TArray<FStoreNameId> ContainerKeyItems;
+	TArray<FStoreSpan> ContainerItems;
+	TArray<FStoreSpan> ContainerResultTables;
+	TArray<FStoreSpan> ContainerCurrencies;
+
+	// Drop tables
+	TArray<FStoreNameId> DropTableIds;
+	TArray<FStoreSpan> DropTableNodes;
+	TArray<FStoreDropNode> DropNodes;
+};
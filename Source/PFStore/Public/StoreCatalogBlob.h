@@ -0,0 +1,44 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreCatalog.h"
+
+enum class EStoreCatalogLoadResult : uint8
+{
+	Success,
+	FileNotFound,
+	BadHeader,
+	VersionMismatch,
+	ChecksumMismatch,
+};
+
+/**
+ * On-disk layout of a cooked catalog: this header followed by the section buffer, byte for byte
+ * as FStoreCatalog uses it. Section offsets are relative to PayloadOffset, so the blob works at
+ * any address and can be mapped straight from disk.
+ */
+struct FStoreCatalogBlobHeader
+{
+	/** "PFSC" read as a little-endian uint32. */
+	static constexpr uint32 ExpectedMagic = 0x43534650;
+
+	/** Bump whenever EStoreCatalogSection or any section element type changes. */
+	static constexpr uint32 CurrentVersion = 4;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	uint32 NumSections = (uint32)EStoreCatalogSection::Count;
+	uint32 PayloadOffset = 0;
+	uint32 PayloadSize = 0;
+	uint32 PayloadCrc = 0;
+
+	/** Crc of this header with HeaderCrc zeroed, section table included. */
+	uint32 HeaderCrc = 0;
+	uint32 Reserved = 0;
+
+	FStoreCatalogSectionEntry Sections[(int32)EStoreCatalogSection::Count];
+};
+
+PFSTORE_API const TCHAR* LexToString(EStoreCatalogLoadResult Result);
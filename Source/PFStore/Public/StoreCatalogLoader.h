@@ -0,0 +1,30 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FStoreCatalog;
+
+DECLARE_DELEGATE_OneParam(FOnStoreCatalogLoaded, TSharedPtr<const FStoreCatalog> /*Catalog*/);
+
+/**
+ * Game-start entry point for the store catalog. Prefers the cooked blob written by the
+ * PFStoreEditor cook step and only falls back to PlayFab when that blob is missing or stale.
+ */
+class PFSTORE_API FStoreCatalogLoader
+{
+public:
+	/** Where the editor cooks the catalog. Add PFStore to "Additional Non-Asset Directories to Package". */
+	static FString GetDefaultCookedPath();
+
+	/**
+	 * Maps CookedPath and hands it to OnLoaded right away when it is valid for this build and its
+	 * payload checksum matches. Otherwise requests GetCatalogItems for CatalogVersion through the
+	 * PlayFab client API (the player must be logged in) and builds the catalog from that response.
+	 * Drop tables are only available through the server API, so they are fetched only when a
+	 * developer secret key is configured (dedicated servers, tools).
+	 * OnLoaded receives null when both sources fail.
+	 */
+	static void Load(const FString& CookedPath, const FString& CatalogVersion, FOnStoreCatalogLoaded OnLoaded);
+};
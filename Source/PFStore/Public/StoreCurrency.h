@@ -0,0 +1,186 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreCurrency.generated.h"
+
+struct FPropertyTag;
+
+/**
+ * PlayFab virtual currency code ("GD", "CR", "GEM"...) packed into a uint32, one byte per character.
+ * Comparing, hashing and looking up a code is an integer operation.
+ */
+struct FCurrencyCode
+{
+	static constexpr int32 MinLen = 2;
+	static constexpr int32 MaxLen = 3;
+
+	constexpr FCurrencyCode() = default;
+
+	/** Compile-time code, e.g. FCurrencyCode("GD"). An invalid literal fails to compile in a constant expression. */
+	template<int32 N>
+	constexpr explicit FCurrencyCode(const ANSICHAR (&Code)[N])
+		: Packed(TryPack(Code, N - 1) != 0 ? TryPack(Code, N - 1) : RejectInvalidCode())
+	{
+		static_assert(N - 1 >= MinLen && N - 1 <= MaxLen, "Currency codes are two or three characters");
+	}
+
+	static constexpr bool IsValidChar(uint32 Char)
+	{
+		return (Char >= 'A' && Char <= 'Z') || (Char >= '0' && Char <= '9');
+	}
+
+	/** Packed value for Code, or 0 when it is not two or three of A-Z / 0-9. */
+	template<typename CharType>
+	static constexpr uint32 TryPack(const CharType* Code, int32 Len)
+	{
+		if (Len < MinLen || Len > MaxLen)
+		{
+			return 0;
+		}
+
+		uint32 Result = 0;
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			if (!IsValidChar(uint32(Code[Index])))
+			{
+				return 0;
+			}
+			Result |= uint32(Code[Index]) << (8 * Index);
+		}
+		return Result;
+	}
+
+	/** Invalid when Code is not a well-formed currency code. */
+	static FCurrencyCode FromString(FStringView Code) { return FromPacked(TryPack(Code.GetData(), Code.Len())); }
+
+	static constexpr FCurrencyCode FromPacked(uint32 InPacked)
+	{
+		FCurrencyCode Result;
+		Result.Packed = InPacked;
+		return Result;
+	}
+
+	constexpr bool IsValid() const { return Packed != 0; }
+	constexpr uint32 GetPacked() const { return Packed; }
+
+	PFSTORE_API FString ToString() const;
+
+	/** Characters of ToString(): 0 when invalid, otherwise 2 or 3. */
+	constexpr int32 Len() const { return Packed == 0 ? 0 : ((Packed >> 16) & 0xFF) != 0 ? 3 : 2; }
+
+	constexpr bool operator==(FCurrencyCode Other) const { return Packed == Other.Packed; }
+	constexpr bool operator!=(FCurrencyCode Other) const { return Packed != Other.Packed; }
+	constexpr bool operator<(FCurrencyCode Other) const { return Packed < Other.Packed; }
+
+	friend uint32 GetTypeHash(FCurrencyCode Code) { return Code.Packed; }
+
+private:
+	/** Not constexpr on purpose: reaching it during constant evaluation is a compile error. */
+	static uint32 RejectInvalidCode() { return 0; }
+
+	uint32 Packed = 0;
+};
+
+struct FCurrencyAmount
+{
+	FCurrencyCode Code;
+	int32 Amount = 0;
+};
+
+/**
+ * Small currency -> amount map kept sorted by code in inline storage, so the usual one to four
+ * currencies per item never touch the heap. Edited and exported as text in the CSV cell format "GD:100;CR:5".
+ */
+USTRUCT(BlueprintType)
+struct PFSTORE_API FCurrencyAmounts
+{
+	GENERATED_BODY()
+
+	static constexpr int32 InlineCapacity = 4;
+
+	int32 Num() const { return Entries.Num(); }
+	bool IsEmpty() const { return Entries.Num() == 0; }
+
+	const int32* Find(FCurrencyCode Code) const;
+	int32 FindRef(FCurrencyCode Code, int32 Default = 0) const;
+
+	/** Sets or replaces the amount for Code. Invalid codes are ignored. */
+	void Add(FCurrencyCode Code, int32 Amount);
+	bool Remove(FCurrencyCode Code);
+	void Reset() { Entries.Reset(); }
+
+	TConstArrayView<FCurrencyAmount> GetEntries() const { return Entries; }
+	const FCurrencyAmount* begin() const { return Entries.GetData(); }
+	const FCurrencyAmount* end() const { return Entries.GetData() + Entries.Num(); }
+
+	/** "GD:100;CR:5" */
+	FString ToString() const;
+
+	/** Reads ToString's format. Returns false if any entry was malformed; the well-formed ones are still added. */
+	static bool Parse(FStringView Text, FCurrencyAmounts& Out);
+
+	/** From a PlayFab style map. Keys that are not valid currency codes are skipped with a warning. */
+	template<typename ValueType>
+	static FCurrencyAmounts FromMap(const TMap<FString, ValueType>& Map)
+	{
+		FCurrencyAmounts Out;
+		for (const TPair<FString, ValueType>& KV : Map)
+		{
+			const FCurrencyCode Code = FCurrencyCode::FromString(KV.Key);
+			if (Code.IsValid())
+			{
+				Out.Add(Code, static_cast<int32>(KV.Value));
+			}
+			else
+			{
+				WarnInvalidCode(KV.Key);
+			}
+		}
+		return Out;
+	}
+
+	/** To a PlayFab style map. */
+	template<typename ValueType>
+	TMap<FString, ValueType> ToMap() const
+	{
+		TMap<FString, ValueType> Out;
+		Out.Reserve(Entries.Num());
+		for (const FCurrencyAmount& Entry : Entries)
+		{
+			Out.Add(Entry.Code.ToString(), static_cast<ValueType>(Entry.Amount));
+		}
+		return Out;
+	}
+
+	bool operator==(const FCurrencyAmounts& Other) const;
+	bool operator!=(const FCurrencyAmounts& Other) const { return !(*this == Other); }
+
+	// UScriptStruct hooks, see TStructOpsTypeTraits below
+	bool Serialize(FArchive& Ar);
+	bool ExportTextItem(FString& ValueStr, const FCurrencyAmounts& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
+	bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
+	bool Identical(const FCurrencyAmounts* Other, uint32 PortFlags) const { return Other && *this == *Other; }
+
+	/** Loads properties saved as the TMap<FString, int32> this type replaced in FBundleInfo and FContainerInfo. */
+	bool SerializeFromMismatchedTag(const FPropertyTag& Tag, FArchive& Ar);
+
+private:
+	static void WarnInvalidCode(const FString& Code);
+
+	TArray<FCurrencyAmount, TInlineAllocator<InlineCapacity>> Entries;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCurrencyAmounts> : public TStructOpsTypeTraitsBase2<FCurrencyAmounts>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithExportTextItem = true,
+		WithImportTextItem = true,
+		WithIdentical = true,
+		WithSerializeFromMismatchedTag = true,
+	};
+};
@@ -8,7 +8,7 @@
 #include "StoreDropTableProvider.generated.h"
 
 USTRUCT(BlueprintType)
-struct FDropTableNode
+struct PFSTORE_API FDropTableNode
 {
     GENERATED_BODY()
 
@@ -23,7 +23,7 @@ struct FDropTableNode
 };
 
 USTRUCT(BlueprintType)
-struct FDropTableInfo
+struct PFSTORE_API FDropTableInfo
 {
     GENERATED_BODY()
 
@@ -34,17 +34,26 @@ struct FDropTableInfo
     TArray<FDropTableNode> Nodes;
 };
 
+/** Unversioned binary form, see the FStoreItemRecord overload. */
+PFSTORE_API FArchive& operator<<(FArchive& Ar, FDropTableInfo& Table);
+
 UINTERFACE(Blueprintable, meta = (CannotImplementInterfaceInBlueprint))
-class UStoreDropTableProvider : public UInterface
+class PFSTORE_API UStoreDropTableProvider : public UInterface
 {
     GENERATED_BODY()
 };
 
-class IStoreDropTableProvider
+class PFSTORE_API IStoreDropTableProvider
 {
     GENERATED_BODY()
 
 public:
 
     virtual FDropTableInfo GetDropTable() const = 0;
+
+    /** Write-back used by the editor's "Save to Editor", see IStoreItemProvider::ApplyStoreItemRecord. */
+    virtual bool ApplyDropTable(const FDropTableInfo& Table)
+    {
+        return false;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreCatalog.h"
+
+/**
+ * One bit per catalog item. Word count is padded to a whole number of 128-bit vectors so
+ * every boolean operation runs as a straight SIMD loop without a scalar tail.
+ */
+class PFSTORE_API FStoreItemBitSet
+{
+public:
+	FStoreItemBitSet() = default;
+	explicit FStoreItemBitSet(int32 InNumItems, bool bValue = false) { Init(InNumItems, bValue); }
+
+	/** Words a bit set over NumItems items uses. Tag bit sets in the catalog use the same stride. */
+	static int32 GetNumWords(int32 NumItems) { return Align(FMath::DivideAndRoundUp(NumItems, 64), 2); }
+
+	void Init(int32 InNumItems, bool bValue);
+
+	int32 NumItems() const { return NumBits; }
+	int32 NumWords() const { return Words.Num(); }
+
+	TConstArrayView<uint64> GetWords() const { return Words; }
+	TArrayView<uint64> GetWords() { return Words; }
+
+	bool Contains(FStoreItemHandle Item) const { return (Words[Item.Index >> 6] >> (Item.Index & 63)) & 1; }
+	void Add(FStoreItemHandle Item) { Words[Item.Index >> 6] |= uint64(1) << (Item.Index & 63); }
+	void Remove(FStoreItemHandle Item) { Words[Item.Index >> 6] &= ~(uint64(1) << (Item.Index & 63)); }
+
+	void Assign(TConstArrayView<uint64> Other);
+	void And(TConstArrayView<uint64> Other);
+	void Or(TConstArrayView<uint64> Other);
+	/** this &= ~Other */
+	void AndNot(TConstArrayView<uint64> Other);
+	void Not();
+	void Reset();
+
+	void And(const FStoreItemBitSet& Other) { And(Other.GetWords()); }
+	void Or(const FStoreItemBitSet& Other) { Or(Other.GetWords()); }
+	void AndNot(const FStoreItemBitSet& Other) { AndNot(Other.GetWords()); }
+
+	int32 CountSetBits() const;
+
+	template<typename FuncType>
+	void ForEachSetBit(FuncType&& Func) const
+	{
+		const int32 Num = Words.Num();
+		for (int32 WordIndex = 0; WordIndex < Num; ++WordIndex)
+		{
+			for (uint64 Word = Words[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				Func(FStoreItemHandle(WordIndex * 64 + (int32)FMath::CountTrailingZeros64(Word)));
+			}
+		}
+	}
+
+	void ToHandles(TArray<FStoreItemHandle>& OutItems) const;
+
+private:
+	void ClearTail();
+
+	TArray<uint64, TAlignedHeapAllocator<16>> Words;
+	int32 NumBits = 0;
+};
@@ -0,0 +1,179 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "StoreItemProvider.h"
+#include "StoreItemDataAsset.generated.h"
+
+class FBoolProperty;
+
+/** Catalog fields a UStoreItemDataAsset property can be mapped to with meta = (StoreField = "..."). */
+enum class EStoreItemField : uint8
+{
+	ItemId,                     // FString
+	DisplayName,                // FString
+	ItemClass,                  // FString
+	Description,                // FString
+	CustomData,                 // FString
+	Tags,                       // TArray<FString>
+	VirtualCurrencyPrices,      // FCurrencyAmounts
+	IsLimitedEdition,           // bool
+	IsTokenForCharacterCreation,// bool
+	IsTradable,                 // bool
+	IsStackable,                // bool
+	Consumable,                 // FConsumableInfo
+	Bundle,                     // FBundleInfo
+	Container,                  // FContainerInfo
+
+	Count
+};
+
+/**
+ * Where each catalog field lives inside objects of one class, found once from the StoreField
+ * metadata and cached per class. Metadata is stripped from cooked builds, so every
+ * UStoreItemDataAsset saves the property name of each field and the first one loaded builds the
+ * layout of its class from those. Without saved names a property named after its field (ItemId,
+ * Tags...) is used.
+ */
+struct PFSTORE_API FStoreItemPropertyLayout
+{
+	/** Byte offset of the property of each field inside the object, INDEX_NONE if unmapped. */
+	int32 Offsets[(int32)EStoreItemField::Count];
+
+	/** Bool properties may be bitfields, so they are read through the property rather than an offset. */
+	const FBoolProperty* Bools[(int32)EStoreItemField::Count];
+
+	/** Name of the property of each field, NAME_None if unmapped. */
+	FName Properties[(int32)EStoreItemField::Count];
+
+	/** The class implements IStoreBundleProvider / IStoreContainerProvider. */
+	bool bIsBundle = false;
+	bool bIsContainer = false;
+
+	FStoreItemPropertyLayout();
+
+	bool IsMapped(EStoreItemField Field) const { return Offsets[(int32)Field] != INDEX_NONE; }
+
+	template<typename T>
+	const T& Read(const UObject* Object, EStoreItemField Field) const
+	{
+		return *reinterpret_cast<const T*>(reinterpret_cast<const uint8*>(Object) + Offsets[(int32)Field]);
+	}
+
+	template<typename T>
+	T& Write(UObject* Object, EStoreItemField Field) const
+	{
+		return *reinterpret_cast<T*>(reinterpret_cast<uint8*>(Object) + Offsets[(int32)Field]);
+	}
+
+	bool ReadBool(const UObject* Object, EStoreItemField Field) const;
+	void WriteBool(UObject* Object, EStoreItemField Field, bool bValue) const;
+
+	/**
+	 * The cached layout of Class, built on first use. Thread safe. In builds without metadata it
+	 * is built from SavedProperties, the Properties an asset of Class saved in the editor, when
+	 * given; they are ignored once the layout exists.
+	 */
+	static const FStoreItemPropertyLayout& Get(const UClass* Class, TConstArrayView<FName> SavedProperties = {});
+
+	/**
+	 * Drops every cached layout, so the next Get sees the classes as they are now. Called when
+	 * classes are reinstanced (Blueprint compile, Live Coding, hot reload), which moves properties.
+	 */
+	static void Invalidate();
+
+	/** The field a StoreField value or property name stands for, Count if none. Case-insensitive. */
+	static EStoreItemField FindField(FStringView Name);
+};
+
+/**
+ * Optional base for item assets whose catalog fields are plain properties:
+ *
+ *     UPROPERTY(EditAnywhere, meta = (StoreField = "DisplayName"))
+ *     FString Title;
+ *
+ * The getters and ApplyStoreItemRecord read and write the mapped properties, and
+ * FStoreItemRecord::FromObject copies them straight from object memory through the cached
+ * FStoreItemPropertyLayout instead of one virtual call per field. Fields without a property
+ * still go through the getters, which subclasses may override; an unmapped ItemId is the asset name.
+ * The mapping is saved with each asset, so cooked builds read the same properties as the editor.
+ *
+ * PFHelpers::SnapshotItems extracts these assets on all cores, so getter overrides must only
+ * read the asset.
+ */
+UCLASS(Abstract)
+class PFSTORE_API UStoreItemDataAsset : public UPrimaryDataAsset, public IStoreItemProvider
+{
+	GENERATED_BODY()
+
+public:
+	virtual FString GetItemId() const override;
+	virtual FString GetDisplayName() const override;
+	virtual FString GetItemClass() const override;
+	virtual FString GetDescription() const override;
+	virtual FCurrencyAmounts GetCurrencyPrices() const override;
+	virtual FString GetCustomData() const override;
+	virtual TArray<FString> GetTags() const override;
+	virtual bool GetIsLimitedEdition() const override;
+	virtual bool GetIsTokenForCharacterCreation() const override;
+	virtual bool GetIsTradable() const override;
+	virtual bool GetIsStackable() const override;
+	virtual FConsumableInfo GetConsumableInfo() const override;
+
+	/** What FStoreItemRecord::FromObject returns for this asset, copied through the layout. */
+	void ToStoreItemRecord(FStoreItemRecord& Out) const;
+
+	/**
+	 * Writes the mapped fields. Fields without a property are dropped and logged, and then the
+	 * result is false although the other fields were written.
+	 */
+	virtual bool ApplyStoreItemRecord(const FStoreItemRecord& Record) override;
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+#endif
+
+	const FStoreItemPropertyLayout& GetStoreLayout() const { return FStoreItemPropertyLayout::Get(GetClass()); }
+
+protected:
+	template<typename T>
+	T ReadStoreField(EStoreItemField Field) const
+	{
+		const FStoreItemPropertyLayout& Layout = GetStoreLayout();
+		return Layout.IsMapped(Field) ? Layout.Read<T>(this, Field) : T();
+	}
+
+	bool ReadStoreBool(EStoreItemField Field) const
+	{
+		const FStoreItemPropertyLayout& Layout = GetStoreLayout();
+		return Layout.IsMapped(Field) && Layout.ReadBool(this, Field);
+	}
+
+private:
+	/** FStoreItemPropertyLayout::Properties of the class as of the last save, for builds without metadata. */
+	UPROPERTY()
+	TArray<FName> StoreFieldProperties;
+};
+
+/** UStoreItemDataAsset for bundles, with an FBundleInfo property mapped to StoreField = "Bundle". */
+UCLASS(Abstract)
+class PFSTORE_API UStoreBundleDataAsset : public UStoreItemDataAsset, public IStoreBundleProvider
+{
+	GENERATED_BODY()
+
+public:
+	virtual FBundleInfo GetBundleInfo() const override { return ReadStoreField<FBundleInfo>(EStoreItemField::Bundle); }
+};
+
+/** UStoreItemDataAsset for containers, with an FContainerInfo property mapped to StoreField = "Container". */
+UCLASS(Abstract)
+class PFSTORE_API UStoreContainerDataAsset : public UStoreItemDataAsset, public IStoreContainerProvider
+{
+	GENERATED_BODY()
+
+public:
+	virtual FContainerInfo GetContainerInfo() const override { return ReadStoreField<FContainerInfo>(EStoreItemField::Container); }
+};
@@ -5,8 +5,11 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
+#include "StoreCurrency.h"
 #include "StoreItemProvider.generated.h"
 
+struct FStoreItemRecord;
+
 USTRUCT(BlueprintType)
 struct PFSTORE_API FConsumableInfo
 {
@@ -34,7 +37,7 @@ struct PFSTORE_API FBundleInfo
 	TArray<FString> BundledResultTables;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BundleInfo")
-	TMap<FString, int32> BundledVirtualCurrencies;
+	FCurrencyAmounts BundledVirtualCurrencies;
 };
 
 USTRUCT(BlueprintType)
@@ -52,7 +55,7 @@ struct PFSTORE_API FContainerInfo
 	TArray<FString> ResultTableContents;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ContainerInfo")
-	TMap<FString, int32> VirtualCurrencyContents;
+	FCurrencyAmounts VirtualCurrencyContents;
 };
 
 UINTERFACE(Blueprintable)
@@ -71,7 +74,17 @@ public:
 	virtual FString GetDisplayName() const = 0;
 	virtual FString GetItemClass() const = 0;
 	virtual FString GetDescription() const = 0;
-	virtual TMap<FString, int32> GetPrices() const = 0;
+
+	/**
+	 * Prices as the editor and catalog read them. The default converts GetPrices, so providers
+	 * written against the old map keep working; override one of the two.
+	 */
+	virtual FCurrencyAmounts GetCurrencyPrices() const;
+
+	/** The old map form of the prices, kept for existing providers. Defaults to GetCurrencyPrices. */
+	UE_DEPRECATED(5.3, "Override GetCurrencyPrices instead.")
+	virtual TMap<FString, int32> GetPrices() const;
+
 	virtual FString GetCustomData() const = 0;
 	virtual TArray<FString> GetTags() const = 0;
 	virtual bool GetIsLimitedEdition() const = 0;
@@ -82,6 +95,16 @@ public:
 	{
 		return FConsumableInfo{};
 	}
+
+	/**
+	 * Write-back used by the editor's "Save to Editor": copies every field of Record (bundle and
+	 * container info included) into this object. Providers that keep the default are read-only.
+	 * False if any field could not be written; the fields that could may already have been.
+	 */
+	virtual bool ApplyStoreItemRecord(const FStoreItemRecord& Record)
+	{
+		return false;
+	}
 };
 
 UINTERFACE(Blueprintable, meta = (CannotImplementInterfaceInBlueprint))
@@ -0,0 +1,96 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemBitSet.h"
+
+/**
+ * Filter over every item, bundle and container field, e.g.
+ *
+ *     Tradable & Consumable & Class == Potion & UsagePeriod > 1d & Price.GD < 100
+ *
+ * A predicate is a flag (Tradable, Stackable, LimitedEdition, TokenForCharacterCreation,
+ * Consumable, Bundle, Container) or "Field Op Value" with ==, !=, <, <=, >, >= and ~ (contains,
+ * ignoring case), combined with & | ! and parentheses as in FStoreTagQuery. Strings compare by
+ * name id, resolved against the catalog once at compile time; ~ is matched against the name
+ * dictionary once per query, not once per item. Each predicate is one pass over a catalog column
+ * that fills a bit set word per 64 items, in parallel chunks.
+ */
+class PFSTORE_API FStoreItemQuery
+{
+public:
+	static bool Compile(const FStoreCatalog& Catalog, FStringView Expression, FStoreItemQuery& OutQuery, FString* OutError = nullptr);
+
+	/** OutResult receives one bit per matching item. An empty query matches everything. */
+	void Evaluate(const FStoreCatalog& Catalog, FStoreItemBitSet& OutResult) const;
+
+	bool IsEmpty() const { return Ops.Num() == 0; }
+
+	/** One line per field Compile understands, for tooltips. */
+	static FString GetSyntaxHelp();
+
+	/** An integer as Compile reads it, optionally with a time unit: "3600", "1d", "12 hours". Time comes out in seconds. */
+	static bool ParseNumber(FStringView Text, int64& OutNumber);
+
+	/** The operator of a predicate. */
+	enum class ECompare : uint8
+	{
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Contains,
+	};
+
+private:
+	enum class EOp : uint8
+	{
+		Push,   // push the bits of a predicate
+		Not,    // invert top
+		And,    // pop two, push a & b
+		Or,     // pop two, push a | b
+	};
+
+	struct FOp
+	{
+		EOp Op;
+		int32 Predicate;
+	};
+
+	enum class EFieldKind : uint8
+	{
+		Flag,       // EStoreItemFlags bit, or Consumable
+		Name,       // FStoreNameId column
+		Integer,    // int32 column
+		Price,      // per-currency price column
+		Currencies, // currency amounts of a bundle or container
+		List,       // name list of an item, bundle or container
+	};
+
+	struct FPredicate
+	{
+		EFieldKind Kind = EFieldKind::Flag;
+
+		/** Column of the field: EStoreCatalogSection for columns, EStoreItemFlags for flags. */
+		uint8 Field = 0;
+		ECompare Compare = ECompare::Equal;
+
+		int64 Number = 0;
+		FStoreNameId Name = INDEX_NONE;
+		int32 Currency = INDEX_NONE;
+
+		/** For Contains: one bit per catalog name that contains the text. */
+		TArray<uint64> NameMatches;
+	};
+
+	friend class FStoreItemQueryCompiler;
+
+	void EvaluatePredicate(const FStoreCatalog& Catalog, const FPredicate& Predicate, FStoreItemBitSet& OutBits) const;
+
+	TArray<FOp> Ops;
+	TArray<FPredicate> Predicates;
+	int32 MaxDepth = 0;
+};
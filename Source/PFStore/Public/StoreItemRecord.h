@@ -0,0 +1,40 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemProvider.h"
+
+/**
+ * Plain snapshot of everything the provider interfaces expose for one catalog item.
+ * Taken once per asset so later stages never have to go back through the virtual getters.
+ */
+struct PFSTORE_API FStoreItemRecord
+{
+	FString ItemId;
+	FString DisplayName;
+	FString ItemClass;
+	FString Description;
+	FString CustomData;
+	TArray<FString> Tags;
+	FCurrencyAmounts Prices;
+
+	bool bIsLimitedEdition = false;
+	bool bIsTokenForCharacterCreation = false;
+	bool bIsTradable = false;
+	bool bIsStackable = false;
+
+	FConsumableInfo Consumable;
+
+	bool bIsBundle = false;
+	FBundleInfo Bundle;
+
+	bool bIsContainer = false;
+	FContainerInfo Container;
+
+	/** Fills Out from an object implementing IStoreItemProvider. Returns false for any other object. */
+	static bool FromObject(const UObject* Object, FStoreItemRecord& Out);
+};
+
+/** Unversioned binary form for local snapshots and caches. Files holding records carry their own version. */
+PFSTORE_API FArchive& operator<<(FArchive& Ar, FStoreItemRecord& Record);
@@ -0,0 +1,184 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Forward-only UTF-8 JSON writer. Output goes into a caller owned byte buffer which, when an
+ * archive is given, is flushed to it every FlushThreshold bytes, so writing a catalog of any size
+ * needs one buffer and no document tree. Identifiers are expected to be plain ASCII literals.
+ */
+class PFSTORE_API FStoreJsonWriter
+{
+public:
+	static constexpr int32 FlushThreshold = 64 * 1024;
+
+	/** Writes into Buffer only, e.g. for a request body. Buffer is appended to, not reset. */
+	explicit FStoreJsonWriter(TArray<uint8>& InBuffer);
+
+	/** Streams through Buffer into Archive. */
+	FStoreJsonWriter(TArray<uint8>& InBuffer, FArchive& InArchive);
+
+	~FStoreJsonWriter();
+
+	FStoreJsonWriter(const FStoreJsonWriter&) = delete;
+	FStoreJsonWriter& operator=(const FStoreJsonWriter&) = delete;
+
+	void WriteObjectStart();
+	void WriteObjectStart(const ANSICHAR* Identifier);
+	void WriteObjectEnd();
+
+	void WriteArrayStart();
+	void WriteArrayStart(const ANSICHAR* Identifier);
+	void WriteArrayEnd();
+
+	void WriteValue(FStringView Value);
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(int32 Value) { WriteValue(int64(Value)); }
+	void WriteValue(int64 Value);
+	void WriteValue(bool Value);
+	void WriteNull();
+
+	template<typename ValueType>
+	void WriteValue(const ANSICHAR* Identifier, const ValueType& Value)
+	{
+		WriteIdentifier(Identifier);
+		WriteValue(Value);
+	}
+
+	void WriteNull(const ANSICHAR* Identifier)
+	{
+		WriteIdentifier(Identifier);
+		WriteNull();
+	}
+
+	/** Writes the string, or null when it is empty. PlayFab models do the same for unset strings. */
+	void WriteStringOrNull(const ANSICHAR* Identifier, const FString& Value);
+
+	/** Appends an already serialized value (e.g. formatted on another thread) as the next element. */
+	void WriteRawValue(TConstArrayView<uint8> Json);
+
+	void WriteIdentifier(const ANSICHAR* Identifier);
+
+	/** Bytes WriteValue adds for the string, quotes and escapes included, counted without formatting it. */
+	static int64 GetStringSize(FStringView Value);
+
+	/** Bytes WriteValue adds for the integer. */
+	static int32 GetIntegerSize(int64 Value);
+
+	/** Bytes WriteIdentifier adds, quotes and colon included. */
+	static int32 GetIdentifierSize(const ANSICHAR* Identifier) { return FCStringAnsi::Strlen(Identifier) + 3; }
+
+	/** Hands buffered bytes to the archive. Returns false once the archive has failed. */
+	bool Flush();
+
+	bool IsError() const { return Archive && Archive->IsError(); }
+
+private:
+	void BeginValue();
+	void EndValue();
+	void AppendString(FStringView Value);
+	void AppendAscii(const ANSICHAR* Text);
+
+	TArray<uint8>& Buffer;
+	FArchive* Archive = nullptr;
+
+	/** Per open object or array: whether it already has an element, so the next one needs a comma. */
+	TArray<bool, TInlineAllocator<16>> Scopes;
+	bool bAfterIdentifier = false;
+};
+
+enum class EStoreJsonToken : uint8
+{
+	Error,
+	End,
+	ObjectStart,
+	ObjectEnd,
+	ArrayStart,
+	ArrayEnd,
+	String,
+	Number,
+	True,
+	False,
+	Null,
+};
+
+/**
+ * Pull parser for UTF-8 JSON. Each Next() returns one token; inside an object the member name of
+ * that token is in GetIdentifier(). Reads an archive in ChunkSize pieces and reuses its string
+ * buffers, so memory does not grow with the size of the document.
+ */
+class PFSTORE_API FStoreJsonReader
+{
+public:
+	static constexpr int32 ChunkSize = 64 * 1024;
+
+	explicit FStoreJsonReader(FArchive& InArchive);
+
+	/** Parses Data in place. Data must outlive the reader. */
+	explicit FStoreJsonReader(TConstArrayView<uint8> Data);
+
+	EStoreJsonToken Next();
+
+	const FString& GetIdentifier() const { return Identifier; }
+	const FString& GetString() const { return StringValue; }
+	int64 GetInt64() const;
+	double GetDouble() const;
+
+	/** Call with the token just returned: skips the rest of an object or array, no-op for scalars. */
+	bool SkipValue(EStoreJsonToken Token);
+
+	/** Depth of the object or array the last token is in, 0 at the top level. */
+	int32 GetDepth() const { return Scopes.Num(); }
+
+	const FString& GetError() const { return Error; }
+
+	/** Byte offset into the document, for error messages. */
+	int64 GetOffset() const { return ChunkStart + (Pos - ChunkData); }
+
+private:
+	FORCEINLINE int32 Peek()
+	{
+		return (Pos < End || Refill()) ? *Pos : -1;
+	}
+
+	FORCEINLINE int32 Read()
+	{
+		return (Pos < End || Refill()) ? *Pos++ : -1;
+	}
+
+	bool Refill();
+	void SkipWhitespace();
+	bool ReadString(FString& Out);
+	bool ReadNumber(int32 First);
+	bool ReadLiteral(const ANSICHAR* Rest);
+	bool ReadHex4(uint32& Out);
+	EStoreJsonToken Fail(const TCHAR* Message);
+
+	FArchive* Archive = nullptr;
+	TArray<uint8> Chunk;
+	const uint8* ChunkData = nullptr;
+	const uint8* Pos = nullptr;
+	const uint8* End = nullptr;
+	int64 ChunkStart = 0;
+
+	/** Per open container: whether it is an object and whether it already had an element. */
+	struct FScope
+	{
+		bool bObject = false;
+		bool bHasElements = false;
+	};
+	TArray<FScope, TInlineAllocator<16>> Scopes;
+
+	bool bStarted = false;
+	bool bTopLevelDone = false;
+	bool bFailed = false;
+
+	FString Identifier;
+	FString StringValue;
+	TArray<UTF8CHAR> Scratch;
+	ANSICHAR NumberText[64];
+	FString Error;
+};
@@ -0,0 +1,42 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemBitSet.h"
+
+/** Player balances, indexed like the catalog's currency table. */
+struct PFSTORE_API FStoreWallet
+{
+	TArray<int32, TInlineAllocator<8>> Balances;
+
+	void Init(const FStoreCatalog& Catalog) { Balances.Init(0, Catalog.NumCurrencies()); }
+
+	/** Currencies the catalog does not use are ignored. */
+	void SetBalance(const FStoreCatalog& Catalog, FCurrencyCode Code, int32 Amount);
+	void SetBalance(const FStoreCatalog& Catalog, FStringView Code, int32 Amount) { SetBalance(Catalog, FCurrencyCode::FromString(Code), Amount); }
+};
+
+/**
+ * Whole-store price queries over the catalog's per-currency price columns.
+ * Each call is a single pass over dense int32 columns, cheap enough to repeat every frame.
+ */
+class PFSTORE_API FStorePriceQuery
+{
+public:
+	/** Sets the bit of every item the wallet can pay for in at least one of its price currencies. */
+	static void FindAffordable(const FStoreCatalog& Catalog, const FStoreWallet& Wallet, FStoreItemBitSet& OutItems);
+
+	/**
+	 * The Count cheapest items priced in Currency, cheapest first. ItemClass and Candidates
+	 * (for example a tag query result) narrow the search when set.
+	 */
+	static void FindCheapest(const FStoreCatalog& Catalog, int32 Currency, int32 Count, TArray<FStoreItemHandle>& OutItems,
+		FStoreNameId ItemClass = INDEX_NONE, const FStoreItemBitSet* Candidates = nullptr);
+
+	/**
+	 * Cart total per currency, indexed like the currency table. A currency is INDEX_NONE when
+	 * at least one item in the cart cannot be bought with it.
+	 */
+	static void SumPrices(const FStoreCatalog& Catalog, TConstArrayView<FStoreItemHandle> Cart, TArray<int64>& OutTotals);
+};
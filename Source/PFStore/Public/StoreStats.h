@@ -0,0 +1,65 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * Profiling hooks for the catalog pipeline. Enable the channel with -trace=cpu,PFStore (or
+ * "Trace.Enable PFStore") to see PFStore scopes in Unreal Insights, "stat PFStore" for the cycle
+ * and memory counters, and -llm for the PFStore tag.
+ */
+UE_TRACE_CHANNEL_EXTERN(PFStoreChannel, PFSTORE_API);
+
+LLM_DECLARE_TAG_API(PFStore, PFSTORE_API);
+
+DECLARE_STATS_GROUP(TEXT("PFStore"), STATGROUP_PFStore, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Asset Discovery"), STAT_PFStore_AssetDiscovery, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Provider Extraction"), STAT_PFStore_ProviderExtraction, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CSV Write"), STAT_PFStore_CsvWrite, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CSV Parse"), STAT_PFStore_CsvParse, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Validate"), STAT_PFStore_Validate, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Diff"), STAT_PFStore_Diff, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Merge"), STAT_PFStore_Merge, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("JSON Serialize"), STAT_PFStore_JsonSerialize, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("JSON Parse"), STAT_PFStore_JsonParse, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PlayFab Request"), STAT_PFStore_PlayFabRequest, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PlayFab Response"), STAT_PFStore_PlayFabResponse, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Catalog Build"), STAT_PFStore_CatalogBuild, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Catalog Cook"), STAT_PFStore_CatalogCook, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Catalog Load"), STAT_PFStore_CatalogLoad, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tag Query"), STAT_PFStore_TagQuery, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Price Query"), STAT_PFStore_PriceQuery, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Item Query"), STAT_PFStore_ItemQuery, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bulk Edit"), STAT_PFStore_BulkEdit, STATGROUP_PFStore, PFSTORE_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Live Catalogs"), STAT_PFStore_LiveCatalogs, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Catalog Heap Memory"), STAT_PFStore_CatalogHeapMemory, STATGROUP_PFStore, PFSTORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Catalog Mapped Memory"), STAT_PFStore_CatalogMappedMemory, STATGROUP_PFStore, PFSTORE_API);
+
+namespace PFStoreStats
+{
+	/** Adds to the PFStore/ItemsProcessed trace counter. */
+	PFSTORE_API void AddItemsProcessed(int32 NumItems);
+
+	/**
+	 * Opens an Insights timing region named after the PlayFab call and bumps the in-flight and
+	 * bytes-sent counters. Pair with EndPlayFabRequest from the response or error callback.
+	 */
+	PFSTORE_API void BeginPlayFabRequest(const TCHAR* Name, int64 RequestBytes);
+	PFSTORE_API void EndPlayFabRequest(const TCHAR* Name, int64 ResponseBytes);
+}
+
+/**
+ * Times the enclosing scope as PFStore::<Name> on the PFStore trace channel and in
+ * STAT_PFStore_<Name>, and charges its allocations to the PFStore LLM tag.
+ */
+#define PFSTORE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("PFStore::" #Name, PFStoreChannel); \
+	SCOPE_CYCLE_COUNTER(STAT_PFStore_##Name); \
+	LLM_SCOPE_BYTAG(PFStore)
@@ -0,0 +1,48 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemBitSet.h"
+
+/**
+ * Boolean filter over item tags, e.g. "Weapon & Epic & !Limited" or "(Sword | Axe) & !Event".
+ * Tag names are resolved against the catalog's tag dictionary once, at compile time, and the
+ * query runs as word-parallel AND/OR/ANDNOT over the catalog's per-tag bit sets.
+ * Tags containing spaces or operators can be written in double quotes. Unknown tags match nothing.
+ */
+class PFSTORE_API FStoreTagQuery
+{
+public:
+	static bool Compile(const FStoreCatalog& Catalog, FStringView Expression, FStoreTagQuery& OutQuery, FString* OutError = nullptr);
+
+	/** OutResult receives one bit per matching item. */
+	void Evaluate(const FStoreCatalog& Catalog, FStoreItemBitSet& OutResult) const;
+
+	bool IsEmpty() const { return Ops.Num() == 0; }
+
+private:
+	enum class EOp : uint8
+	{
+		PushTag,    // push a copy of a tag's bits
+		Not,        // invert top
+		And,        // pop two, push a & b
+		Or,         // pop two, push a | b
+		AndTag,     // top &= tag
+		OrTag,      // top |= tag
+		AndNotTag,  // top &= ~tag
+	};
+
+	struct FOp
+	{
+		EOp Op;
+		int32 Tag; // INDEX_NONE for tags missing from the catalog
+	};
+
+	friend class FStoreTagQueryCompiler;
+
+	void Emit(EOp Op, int32 Tag = INDEX_NONE);
+
+	TArray<FOp> Ops;
+	int32 MaxDepth = 0;
+};
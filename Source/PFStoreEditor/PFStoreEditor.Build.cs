@@ -50,7 +50,10 @@ public class PFStoreEditor : ModuleRules
                 "JsonUtilities",
                 "PlayFab",
                 "PlayFabCpp",
+                "PlayFabCommon",
+                "HTTP",
                 "Settings",
+                "PropertyEditor",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
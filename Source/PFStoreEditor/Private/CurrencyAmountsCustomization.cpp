@@ -0,0 +1,61 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "CurrencyAmountsCustomization.h"
+#include "StoreCurrency.h"
+#include "DetailLayoutBuilder.h"
+#include "DetailWidgetRow.h"
+#include "PropertyHandle.h"
+#include "Widgets/Input/SEditableTextBox.h"
+
+#define LOCTEXT_NAMESPACE "CurrencyAmountsCustomization"
+
+TSharedRef<IPropertyTypeCustomization> FCurrencyAmountsCustomization::MakeInstance()
+{
+	return MakeShared<FCurrencyAmountsCustomization>();
+}
+
+void FCurrencyAmountsCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
+{
+	Handle = PropertyHandle;
+
+	HeaderRow
+		.NameContent()
+		[
+			PropertyHandle->CreatePropertyNameWidget()
+		]
+		.ValueContent()
+		.MinDesiredWidth(200.f)
+		[
+			SNew(SEditableTextBox)
+				.Text(this, &FCurrencyAmountsCustomization::GetText)
+				.HintText(LOCTEXT("Hint", "GD:100;CR:5"))
+				.ToolTipText(LOCTEXT("Tooltip", "Currency code (2-3 of A-Z, 0-9) and amount pairs separated by ';'"))
+				.OnTextCommitted(this, &FCurrencyAmountsCustomization::OnTextCommitted)
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+		];
+}
+
+FText FCurrencyAmountsCustomization::GetText() const
+{
+	FString Value;
+	if (!Handle.IsValid() || Handle->GetValueAsFormattedString(Value) == FPropertyAccess::MultipleValues)
+	{
+		return LOCTEXT("MultipleValues", "Multiple Values");
+	}
+	return FText::FromString(Value);
+}
+
+void FCurrencyAmountsCustomization::OnTextCommitted(const FText& NewText, ETextCommit::Type CommitType)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	// Round-trip through Parse so what lands in the property is the normalized form.
+	FCurrencyAmounts Amounts;
+	FCurrencyAmounts::Parse(NewText.ToString(), Amounts);
+	Handle->SetValueFromFormattedString(Amounts.ToString());
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -1,6 +1,8 @@
 // MIT Licensed. Copyright (c) 2025 Olga Taranova
 
 #include "ItemDiffWindow.h"
+#include "SStoreTextDiffView.h"
+#include "StoreTextDiff.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SButton.h"
@@ -12,6 +14,7 @@ void SItemDiffWindow::Construct(const FArguments& InArgs)
     Left = InArgs._LeftItem;
     Right = InArgs._RightItem;
     OnResult = InArgs._OnResult;
+    OnChoices = InArgs._OnChoices;
 
     TSet<FString> AllKeys;
     if (Left.IsValid())
@@ -151,6 +154,17 @@ void SItemDiffWindow::Construct(const FArguments& InArgs)
                                 .SelectionMode(ESelectionMode::None)
                         ]
 
+                        + SVerticalBox::Slot()
+                        .FillHeight(0.5f)
+                        .Padding(0, 4, 0, 0)
+                        [
+                            SAssignNew(TextDiffView, SStoreTextDiffView)
+                                .Visibility_Lambda([this]()
+                                    {
+                                        return TextDiffField.IsNone() ? EVisibility::Collapsed : EVisibility::Visible;
+                                    })
+                        ]
+
                         + SVerticalBox::Slot()
                         .AutoHeight()
                         .Padding(0, 4, 0, 4)
@@ -230,14 +244,30 @@ TSharedRef<ITableRow> SItemDiffWindow::OnGenerateRow(
         [
             SNew(SHorizontalBox)
 
-                // Field
+                // Field, with the line diff toggle for long values
                 + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
                 [
                     SNew(SBox)
                         .WidthOverride(160.f)
                         [
-                            SNew(STextBlock)
-                                .Text(FText::FromName(Item->FieldName))
+                            SNew(SHorizontalBox)
+
+                                + SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+                                [
+                                    SNew(STextBlock)
+                                        .Text(FText::FromName(Item->FieldName))
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Diff")))
+                                        .ToolTipText(FText::FromString(TEXT("Show the two values line by line")))
+                                        .Visibility(StoreTextDiff::IsLongText(Item->LeftValue) || StoreTextDiff::IsLongText(Item->RightValue)
+                                            ? EVisibility::Visible
+                                            : EVisibility::Collapsed)
+                                        .OnClicked(this, &SItemDiffWindow::OnTextDiffClicked, Item)
+                                ]
                         ]
                 ]
 
@@ -336,6 +366,19 @@ TSharedRef<ITableRow> SItemDiffWindow::OnGenerateRow(
 
 
 
+FReply SItemDiffWindow::OnTextDiffClicked(FFieldDiffRowPtr Item)
+{
+    if (TextDiffField == Item->FieldName)
+    {
+        TextDiffField = NAME_None;
+        return FReply::Handled();
+    }
+
+    TextDiffField = Item->FieldName;
+    TextDiffView->SetTexts(Item->FieldName, Item->LeftValue, Item->RightValue);
+    return FReply::Handled();
+}
+
 FReply SItemDiffWindow::OnUseAllLeftClicked()
 {
     for (auto& Row : Rows)
@@ -386,6 +429,10 @@ FReply SItemDiffWindow::OnOkClicked()
     {
         OnResult(Result);
     }
+    if (OnChoices)
+    {
+        OnChoices(Rows);
+    }
 
     TSharedPtr<SWindow> Window = FSlateApplication::Get().FindWidgetWindow(AsShared());
     if (Window.IsValid())
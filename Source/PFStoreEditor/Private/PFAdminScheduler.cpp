@@ -0,0 +1,335 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "PFAdminScheduler.h"
+
+#include "PFHelpers.h"
+#include "PFStoreEditorSettings.h"
+#include "Async/Async.h"
+#include "Interfaces/IHttpResponse.h"
+
+FPFAdminScheduler::FOptions FPFAdminScheduler::GetDefaultOptions()
+{
+	const UPFStoreEditorSettings* Settings = GetDefault<UPFStoreEditorSettings>();
+
+	FOptions Out;
+	Out.MaxConcurrent = FMath::Max(1, Settings->MaxConcurrentAdminRequests);
+	Out.RequestsPerSecond = FMath::Max(0.1f, Settings->AdminRequestsPerSecond);
+	Out.Burst = Out.MaxConcurrent;
+	switch (Settings->AdminRequestCompression)
+	{
+	case EPFRequestCompression::Gzip:
+		Out.Compression = NAME_Gzip;
+		break;
+	case EPFRequestCompression::Deflate:
+		Out.Compression = NAME_Zlib;
+		break;
+	default:
+		break;
+	}
+	return Out;
+}
+
+FPFAdminScheduler::FPFAdminScheduler(const FOptions& InOptions)
+	: Options(InOptions)
+{
+	Tokens = Options.Burst;
+	LastRefill = FPlatformTime::Seconds();
+}
+
+FPFAdminScheduler::~FPFAdminScheduler()
+{
+	if (RetryHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RetryHandle);
+	}
+}
+
+FPFAdminScheduler::FTaskId FPFAdminScheduler::Add(const FString& Api, FSerializeBody Serialize, TArray<FTaskId> DependsOn, FOnTaskComplete OnComplete)
+{
+	check(!bRunning);
+
+	const FTaskId Id = Tasks.Num();
+	FTask& Task = Tasks.AddDefaulted_GetRef();
+	Task.Api = Api;
+	Task.Serialize = MoveTemp(Serialize);
+	Task.OnComplete = MoveTemp(OnComplete);
+
+	// Dependencies must already be added, which keeps the graph acyclic and the task list in
+	// dependency order.
+	for (const FTaskId Dependency : DependsOn)
+	{
+		check(Tasks.IsValidIndex(Dependency) && Dependency < Id);
+		Tasks[Dependency].Dependents.Add(Id);
+	}
+	Task.DependsOn = MoveTemp(DependsOn);
+	return Id;
+}
+
+void FPFAdminScheduler::Run(FOnFinished InOnFinished)
+{
+	check(IsInGameThread());
+	check(!bRunning);
+
+	OnFinished = MoveTemp(InOnFinished);
+	bRunning = true;
+	SelfWhileRunning = AsShared();
+	Pump();
+}
+
+void FPFAdminScheduler::Pump()
+{
+	// Responses that complete synchronously land back here from inside Send.
+	if (bPumping)
+	{
+		bPumpAgain = true;
+		return;
+	}
+
+	const TSharedRef<FPFAdminScheduler> KeepAlive = AsShared();
+	bPumping = true;
+	do
+	{
+		bPumpAgain = false;
+		PumpOnce();
+	} while (bPumpAgain && bRunning);
+	bPumping = false;
+}
+
+void FPFAdminScheduler::PumpOnce()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	if (NumDone == Tasks.Num())
+	{
+		bRunning = false;
+		FOnFinished Callback = MoveTemp(OnFinished);
+		SelfWhileRunning.Reset();
+		if (Callback)
+		{
+			Callback(Errors.Num() == 0, Errors);
+		}
+		return;
+	}
+
+	// Serialize ahead in task order, a bounded number of bodies at a time, so the next request
+	// is built while the current ones are in flight. Read-ahead bodies may be waiting on a task
+	// that is itself back to Waiting after a 429, so tasks that could go out now get their own
+	// bound; otherwise blocked bodies could fill MaxBodies and the retry would never be built.
+	const int32 MaxBodies = Options.MaxConcurrent * 2;
+	int32 NumBodies = NumSerializing + NumReady;
+	int32 NumRunnableBodies = 0;
+	for (const FTask& Task : Tasks)
+	{
+		if ((Task.State == ETaskState::Serializing || Task.State == ETaskState::Ready) && IsRunnable(Task))
+		{
+			++NumRunnableBodies;
+		}
+	}
+	for (FTaskId Id = 0; Id < Tasks.Num() && (NumBodies < MaxBodies || NumRunnableBodies < Options.MaxConcurrent); ++Id)
+	{
+		const FTask& Task = Tasks[Id];
+		if (Task.State != ETaskState::Waiting)
+		{
+			continue;
+		}
+		const bool bRunnable = IsRunnable(Task);
+		if (NumBodies < MaxBodies || (bRunnable && NumRunnableBodies < Options.MaxConcurrent))
+		{
+			StartSerialize(Id);
+			++NumBodies;
+			NumRunnableBodies += bRunnable ? 1 : 0;
+		}
+	}
+
+	for (FTaskId Id = 0; Id < Tasks.Num() && NumInFlight < Options.MaxConcurrent; ++Id)
+	{
+		const FTask& Task = Tasks[Id];
+		if (Task.State != ETaskState::Ready || !IsRunnable(Task))
+		{
+			continue;
+		}
+		if (!TakeToken())
+		{
+			PumpLater((1.0 - Tokens) / Options.RequestsPerSecond);
+			break;
+		}
+		Send(Id);
+	}
+
+	// A response, a finished serialization or the ticker must pump again, or the run never ends.
+	if (bRunning && NumInFlight == 0 && NumSerializing == 0 && !RetryHandle.IsValid())
+	{
+		ensureMsgf(false, TEXT("Admin scheduler has %d unfinished tasks and nothing to wait for"), Tasks.Num() - NumDone);
+		PumpLater(1.f);
+	}
+}
+
+void FPFAdminScheduler::StartSerialize(FTaskId Id)
+{
+	FTask& Task = Tasks[Id];
+	Task.State = ETaskState::Serializing;
+	++NumSerializing;
+
+	const TSharedRef<FPFAdminScheduler> This = AsShared();
+	Async(EAsyncExecution::ThreadPool, [This, Id, Serialize = Task.Serialize, Compression = Options.Compression]()
+		{
+			TArray<uint8> Body;
+			Serialize(Body);
+			const TCHAR* ContentEncoding = Compression.IsNone() ? nullptr : PFHelpers::CompressRequestBody(Compression, Body);
+
+			AsyncTask(ENamedThreads::GameThread, [This, Id, Body = MoveTemp(Body), ContentEncoding]() mutable
+				{
+					This->OnSerialized(Id, MoveTemp(Body), ContentEncoding);
+				});
+		});
+}
+
+void FPFAdminScheduler::OnSerialized(FTaskId Id, TArray<uint8>&& Body, const TCHAR* ContentEncoding)
+{
+	--NumSerializing;
+
+	FTask& Task = Tasks[Id];
+	if (Task.State == ETaskState::Serializing)
+	{
+		Task.State = ETaskState::Ready;
+		Task.Body = MoveTemp(Body);
+		Task.ContentEncoding = ContentEncoding;
+		++NumReady;
+	}
+	Pump();
+}
+
+void FPFAdminScheduler::Send(FTaskId Id)
+{
+	FTask& Task = Tasks[Id];
+	Task.State = ETaskState::InFlight;
+	--NumReady;
+	++NumInFlight;
+
+	const TSharedRef<FPFAdminScheduler> This = AsShared();
+	PFHelpers::SendAdminRequest(Options.Endpoint, *Task.Api, MoveTemp(Task.Body), [This, Id](bool bSuccess, const FString& Error, FHttpResponsePtr Response)
+		{
+			const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+			const float RetryAfter = Response.IsValid() ? FCString::Atof(*Response->GetHeader(TEXT("Retry-After"))) : 0.f;
+			This->OnResponse(Id, bSuccess, Error, ResponseCode, RetryAfter);
+		}, Task.ContentEncoding);
+}
+
+void FPFAdminScheduler::OnResponse(FTaskId Id, bool bSuccess, const FString& Error, int32 ResponseCode, float RetryAfter)
+{
+	--NumInFlight;
+
+	FTask& Task = Tasks[Id];
+	if (!bSuccess && ResponseCode == 429 && Task.ThrottleRetries < Options.MaxThrottleRetries)
+	{
+		// The body was moved into the request; serialize again and let the bucket run dry for as
+		// long as PlayFab asked.
+		++Task.ThrottleRetries;
+		Task.State = ETaskState::Waiting;
+		Tokens = FMath::Min<double>(Tokens, -FMath::Max(RetryAfter, 1.f) * Options.RequestsPerSecond);
+		UE_LOG(LogTemp, Warning, TEXT("PlayFab %s throttled, retrying (%d/%d)"), *Task.Api, Task.ThrottleRetries, Options.MaxThrottleRetries);
+	}
+	else
+	{
+		Finish(Id, bSuccess, Error);
+	}
+	Pump();
+}
+
+void FPFAdminScheduler::Finish(FTaskId Id, bool bSuccess, const FString& Error)
+{
+	FTask& Task = Tasks[Id];
+	Task.State = bSuccess ? ETaskState::Succeeded : ETaskState::Failed;
+	++NumDone;
+
+	if (!bSuccess)
+	{
+		Errors.Add(FString::Printf(TEXT("%s: %s"), *Task.Api, *Error));
+		for (const FTaskId Dependent : Task.Dependents)
+		{
+			Skip(Dependent);
+		}
+	}
+
+	if (Task.OnComplete)
+	{
+		Task.OnComplete(bSuccess, Error);
+	}
+}
+
+void FPFAdminScheduler::Skip(FTaskId Id)
+{
+	FTask& Task = Tasks[Id];
+	if (Task.State == ETaskState::Skipped)
+	{
+		return;
+	}
+
+	// A task only goes out once its dependencies succeeded, so a dependent is never in flight.
+	check(Task.State == ETaskState::Waiting || Task.State == ETaskState::Serializing || Task.State == ETaskState::Ready);
+	if (Task.State == ETaskState::Ready)
+	{
+		--NumReady;
+		Task.Body.Empty();
+	}
+	Task.State = ETaskState::Skipped;
+	++NumDone;
+
+	for (const FTaskId Dependent : Task.Dependents)
+	{
+		Skip(Dependent);
+	}
+
+	if (Task.OnComplete)
+	{
+		Task.OnComplete(false, TEXT("Skipped, a request it depends on failed"));
+	}
+}
+
+bool FPFAdminScheduler::IsRunnable(const FTask& Task) const
+{
+	for (const FTaskId Dependency : Task.DependsOn)
+	{
+		if (Tasks[Dependency].State != ETaskState::Succeeded)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FPFAdminScheduler::TakeToken()
+{
+	const double Now = FPlatformTime::Seconds();
+	Tokens = FMath::Min<double>(Options.Burst, Tokens + (Now - LastRefill) * Options.RequestsPerSecond);
+	LastRefill = Now;
+
+	if (Tokens < 1.0)
+	{
+		return false;
+	}
+	Tokens -= 1.0;
+	return true;
+}
+
+void FPFAdminScheduler::PumpLater(float Delay)
+{
+	if (RetryHandle.IsValid())
+	{
+		return;
+	}
+
+	const TWeakPtr<FPFAdminScheduler> WeakThis = AsShared();
+	RetryHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+		{
+			if (const TSharedPtr<FPFAdminScheduler> This = WeakThis.Pin())
+			{
+				This->RetryHandle.Reset();
+				This->Pump();
+			}
+			return false;
+		}), Delay);
+}
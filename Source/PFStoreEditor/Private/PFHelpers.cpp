@@ -3,8 +3,34 @@
 #include "PFHelpers.h"
 
 #include "StoreItemProvider.h"
+#include "StoreDropTableProvider.h"
+#include "StoreItemRecord.h"
+#include "StoreItemDataAsset.h"
+#include "StoreCatalog.h"
+#include "StoreStats.h"
+#include "StoreJson.h"
+#include "PFAdminScheduler.h"
+#include "PFStoreEditorSettings.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+#include "Containers/StaticArray.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/MemoryWriter.h"
+#include "ScopedTransaction.h"
+#include "UObject/UObjectIterator.h"
+
+#include "Core/PlayFabAdminAPI.h"
+#include "PlayFab.h"
+#include "PlayFabCommon.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
 
 namespace PFHelpers
 {
@@ -31,140 +57,491 @@ namespace PFHelpers
 		return Out;
 	}
 
-	static FString EscapeCsv(const FString& In)
+	PlayFab::AdminModels::FCatalogItem ToPlayFabCatalogItem(const FStoreItemRecord& In, const FString& CatalogVersion)
 	{
-		FString Out = In.Replace(TEXT("\""), TEXT("\"\""));
-		return FString::Printf(TEXT("\"%s\""), *Out);
+		PlayFab::AdminModels::FCatalogItem Item;
+
+		Item.ItemId = In.ItemId;
+		Item.DisplayName = In.DisplayName;
+		Item.ItemClass = In.ItemClass;
+		Item.Description = In.Description;
+		Item.CustomData = In.CustomData;
+		Item.Tags = In.Tags;
+		Item.VirtualCurrencyPrices = In.Prices.ToMap<uint32>();
+
+		Item.IsLimitedEdition = In.bIsLimitedEdition;
+		Item.CanBecomeCharacter = In.bIsTokenForCharacterCreation;
+		Item.IsTradable = In.bIsTradable;
+		Item.IsStackable = In.bIsStackable;
+
+		Item.Consumable = MakeShared<PlayFab::AdminModels::FCatalogItemConsumableInfo>(ToPlayFabConsumableInfo(In.Consumable));
+
+		if (In.bIsBundle)
+		{
+			auto BI = MakeShared<PlayFab::AdminModels::FCatalogItemBundleInfo>();
+			BI->BundledItems = In.Bundle.BundledItems;
+			BI->BundledResultTables = In.Bundle.BundledResultTables;
+			BI->BundledVirtualCurrencies = In.Bundle.BundledVirtualCurrencies.ToMap<uint32>();
+			Item.Bundle = BI;
+		}
+
+		if (In.bIsContainer)
+		{
+			auto CI = MakeShared<PlayFab::AdminModels::FCatalogItemContainerInfo>();
+			CI->KeyItemId = In.Container.KeyItemId;
+			CI->ItemContents = In.Container.ItemContents;
+			CI->ResultTableContents = In.Container.ResultTableContents;
+			CI->VirtualCurrencyContents = In.Container.VirtualCurrencyContents.ToMap<uint32>();
+			Item.Container = CI;
+		}
+
+		// Defaults
+		Item.CatalogVersion = CatalogVersion;
+		Item.ItemImageUrl = FString();
+		Item.InitialLimitedEditionCount = 0;
+		Item.RealCurrencyPrices.Empty();
+
+		return Item;
 	}
 
-	static const TCHAR* BoolStr(bool b) { return b ? TEXT("TRUE") : TEXT("FALSE"); }
+	void FromPlayFabCatalogItem(const PlayFab::AdminModels::FCatalogItem& In, FStoreItemRecord& Out)
+	{
+		Out.ItemId = In.ItemId;
+		Out.DisplayName = In.DisplayName;
+		Out.ItemClass = In.ItemClass;
+		Out.Description = In.Description;
+		Out.CustomData = In.CustomData;
+		Out.Tags = In.Tags;
+		Out.Prices = FCurrencyAmounts::FromMap(In.VirtualCurrencyPrices);
 
-	bool ExportToCsv(const TArray<TWeakObjectPtr<UObject>>& Items, const FString& FilePath)
+		Out.bIsLimitedEdition = In.IsLimitedEdition;
+		Out.bIsTokenForCharacterCreation = In.CanBecomeCharacter;
+		Out.bIsTradable = In.IsTradable;
+		Out.bIsStackable = In.IsStackable;
+
+		Out.Consumable = FConsumableInfo();
+		if (In.Consumable.IsValid())
+		{
+			Out.Consumable.UsageCount = In.Consumable->UsageCount.notNull() ? static_cast<int32>(In.Consumable->UsageCount.mValue) : 0;
+			Out.Consumable.UsagePeriod = In.Consumable->UsagePeriod.notNull() ? static_cast<int32>(In.Consumable->UsagePeriod.mValue) : 0;
+			Out.Consumable.UsagePeriodGroup = In.Consumable->UsagePeriodGroup;
+		}
+
+		Out.bIsBundle = In.Bundle.IsValid();
+		Out.Bundle = FBundleInfo();
+		if (Out.bIsBundle)
+		{
+			Out.Bundle.BundledItems = In.Bundle->BundledItems;
+			Out.Bundle.BundledResultTables = In.Bundle->BundledResultTables;
+			Out.Bundle.BundledVirtualCurrencies = FCurrencyAmounts::FromMap(In.Bundle->BundledVirtualCurrencies);
+		}
+
+		Out.bIsContainer = In.Container.IsValid();
+		Out.Container = FContainerInfo();
+		if (Out.bIsContainer)
+		{
+			Out.Container.KeyItemId = In.Container->KeyItemId;
+			Out.Container.ItemContents = In.Container->ItemContents;
+			Out.Container.ResultTableContents = In.Container->ResultTableContents;
+			Out.Container.VirtualCurrencyContents = FCurrencyAmounts::FromMap(In.Container->VirtualCurrencyContents);
+		}
+	}
+
+	PlayFab::AdminModels::FRandomResultTable ToPlayFabRandomResultTable(const FDropTableInfo& In)
 	{
-		TArray<FString> Lines;
+		PlayFab::AdminModels::FRandomResultTable Table;
+		Table.TableId = In.TableId;
+
+		Table.Nodes.Reserve(In.Nodes.Num());
+		for (const FDropTableNode& InNode : In.Nodes)
+		{
+			PlayFab::AdminModels::FResultTableNode& Node = Table.Nodes.AddDefaulted_GetRef();
+			Node.ResultItem = InNode.ResultItem;
+			Node.ResultItemType = PlayFab::AdminModels::readResultTableNodeTypeFromValue(InNode.ResultItemType);
+			Node.Weight = InNode.Weight;
+		}
+
+		return Table;
+	}
 
-		Lines.Add(TEXT("ItemId,DisplayName,ItemClass,Description,CustomData,Tags,")
-			TEXT("IsLimitedEdition,IsTokenForCharacterCreation,IsTradable,IsStackable,")
-			TEXT("UsageCount,UsagePeriod,UsagePeriodGroup,")
-			TEXT("BundledItems,BundledResultTables,BundledVirtualCurrencies,")
-			TEXT("KeyItemId,ItemContents,ResultTableContents,VirtualCurrencyContents"));
+	TArray<TWeakObjectPtr<UObject>> FindAllStoreAssets(const UClass* InterfaceClass)
+	{
+		PFSTORE_SCOPE(AssetDiscovery);
+
+		TArray<TWeakObjectPtr<UObject>> StoreAssets;
 
-		for (const TWeakObjectPtr<UObject>& ItemPtr : Items)
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (IsRunningCommandlet())
 		{
-			UObject* Obj = ItemPtr.Get();
-			if (!Obj) continue;
+			// Without the editor UI nothing has scanned the content folders yet.
+			AssetRegistry.SearchAllAssets(true);
+		}
 
-			if (!Obj->GetClass()->ImplementsInterface(UStoreItemProvider::StaticClass()))
+		// The provider getters are plain C++, so only classes deriving from a native implementer can
+		// provide anything. Asking the registry for those classes loads the catalog assets and nothing else.
+		FARFilter Filter;
+		Filter.bRecursiveClasses = true;
+		Filter.bRecursivePaths = true;
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			if (It->HasAnyClassFlags(CLASS_Native) && !It->HasAnyClassFlags(CLASS_Interface) && It->ImplementsInterface(InterfaceClass))
 			{
-				continue;
+				Filter.ClassPaths.Add(It->GetClassPathName());
 			}
+		}
 
-			IStoreItemProvider* Provider = Cast<IStoreItemProvider>(Obj);
-			if (!Provider) continue;
+		if (Filter.ClassPaths.Num() == 0)
+		{
+			return StoreAssets;
+		}
 
-			const FString ItemId = EscapeCsv(Provider->GetItemId());
-			const FString Name = EscapeCsv(Provider->GetDisplayName());
-			const FString ClassStr = EscapeCsv(Provider->GetItemClass());
-			const FString Desc = EscapeCsv(Provider->GetDescription());
-			const FString Custom = EscapeCsv(Provider->GetCustomData());
+		TArray<FAssetData> AssetDataList;
+		AssetRegistry.GetAssets(Filter, AssetDataList);
 
-			FString Tags;
+		for (const FAssetData& AssetData : AssetDataList)
+		{
+			UObject* Asset = AssetData.GetAsset();
+			if (Asset && Asset->GetClass()->ImplementsInterface(InterfaceClass))
 			{
-				const TArray<FString> RawTags = Provider->GetTags();
-				Tags = EscapeCsv(FString::Join(RawTags, TEXT(";")));
+				StoreAssets.Add(Asset);
 			}
+		}
+
+		return StoreAssets;
+	}
 
-			const FString IsLimited = BoolStr(Provider->GetIsLimitedEdition());
-			const FString IsToken = BoolStr(Provider->GetIsTokenForCharacterCreation());
-			const FString IsTradable = BoolStr(Provider->GetIsTradable());
-			const FString IsStackable = BoolStr(Provider->GetIsStackable());
+	void SnapshotItems(const TArray<TWeakObjectPtr<UObject>>& Items, TArray<FStoreItemRecord>& OutRecords)
+	{
+		PFSTORE_SCOPE(ProviderExtraction);
+		PFStoreStats::AddItemsProcessed(Items.Num());
 
-			// Consumable
-			const FConsumableInfo CI = Provider->GetConsumableInfo();
-			const FString UsageCountStr = (CI.UsageCount > 0) ? FString::FromInt(CI.UsageCount) : TEXT("");
-			const FString UsagePeriodStr = (CI.UsagePeriod > 0) ? FString::FromInt(CI.UsagePeriod) : TEXT("");
-			const FString UsageGroupStr = EscapeCsv(CI.UsagePeriodGroup);
+		// Weak pointers, class layouts and other providers are resolved here; UStoreItemDataAsset records are
+		// plain memory copies through their class layout and are extracted on all cores.
+		TArray<const UStoreItemDataAsset*> DataAssets;
+		DataAssets.SetNumZeroed(Items.Num());
+		TArray<FStoreItemRecord> Records;
+		Records.SetNum(Items.Num());
+		TBitArray<> Valid(false, Items.Num());
 
-			// Bundle
-			FString BundledItemsStr, BundledResultTablesStr, BundledVirtualCurrenciesStr;
-			if (Obj->GetClass()->ImplementsInterface(UStoreBundleProvider::StaticClass()))
+		for (int32 Index = 0; Index < Items.Num(); ++Index)
+		{
+			const UObject* Object = Items[Index].Get();
+			if (const UStoreItemDataAsset* DataAsset = Cast<UStoreItemDataAsset>(Object))
 			{
-				IStoreBundleProvider* BundleProvider = Cast<IStoreBundleProvider>(Obj);
-				if (BundleProvider)
-				{
-					const FBundleInfo BI = BundleProvider->GetBundleInfo();
+				DataAsset->GetStoreLayout();
+				DataAssets[Index] = DataAsset;
+				Valid[Index] = true;
+			}
+			else
+			{
+				Valid[Index] = FStoreItemRecord::FromObject(Object, Records[Index]);
+			}
+		}
 
-					BundledItemsStr = EscapeCsv(FString::Join(BI.BundledItems, TEXT(";")));
-					BundledResultTablesStr = EscapeCsv(FString::Join(BI.BundledResultTables, TEXT(";")));
+		ParallelFor(TEXT("PFStore.SnapshotItems"), Items.Num(), 256, [&DataAssets, &Records](int32 Index)
+		{
+			if (DataAssets[Index])
+			{
+				DataAssets[Index]->ToStoreItemRecord(Records[Index]);
+			}
+		});
 
-					if (BI.BundledVirtualCurrencies.Num() > 0)
-					{
-						TArray<FString> Pairs;
-						Pairs.Reserve(BI.BundledVirtualCurrencies.Num());
-						for (const auto& KV : BI.BundledVirtualCurrencies)
-						{
-							Pairs.Add(KV.Key + TEXT(":") + FString::FromInt(KV.Value));
-						}
-						BundledVirtualCurrenciesStr = EscapeCsv(FString::Join(Pairs, TEXT(";")));
-					}
-					else
-					{
-						BundledVirtualCurrenciesStr = TEXT("");
-					}
-				}
+		OutRecords.Reset(Items.Num());
+		for (int32 Index = 0; Index < Items.Num(); ++Index)
+		{
+			if (Valid[Index])
+			{
+				OutRecords.Add(MoveTemp(Records[Index]));
 			}
-			else
+		}
+	}
+
+	void SnapshotDropTables(const TArray<TWeakObjectPtr<UObject>>& Tables, TArray<FDropTableInfo>& OutTables)
+	{
+		PFSTORE_SCOPE(ProviderExtraction);
+
+		OutTables.Reset(Tables.Num());
+		for (const TWeakObjectPtr<UObject>& TablePtr : Tables)
+		{
+			if (const IStoreDropTableProvider* Provider = Cast<IStoreDropTableProvider>(TablePtr.Get()))
+			{
+				OutTables.Add(Provider->GetDropTable());
+			}
+		}
+	}
+
+	static const TCHAR* BoolStr(bool b) { return b ? TEXT("TRUE") : TEXT("FALSE"); }
+
+	/** Quoted cell with embedded quotes doubled. */
+	static void AppendCsvField(FStringBuilderBase& Out, FStringView Value)
+	{
+		Out << TEXT('"');
+		for (const TCHAR C : Value)
+		{
+			if (C == TEXT('"'))
 			{
-				BundledItemsStr = BundledResultTablesStr = BundledVirtualCurrenciesStr = TEXT("");
+				Out << TEXT('"');
 			}
+			Out << C;
+		}
+		Out << TEXT('"');
+	}
+
+	static void AppendCsvList(FStringBuilderBase& Out, const TArray<FString>& Values)
+	{
+		TStringBuilder<256> Joined;
+		Joined.Join(Values, TEXT(";"));
+		AppendCsvField(Out, Joined.ToView());
+	}
+
+	static void ParseCsvAmounts(const FString& ItemId, const FString& Cell, FCurrencyAmounts& Out)
+	{
+		if (!FCurrencyAmounts::Parse(Cell, Out))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Item %s: malformed currency amounts '%s'"), *ItemId, *Cell);
+		}
+	}
+
+	// ---------- Item CSV columns ----------
+
+	/** Cell formats. Each reads and writes one record member as a CSV cell. */
+	struct FCsvText
+	{
+		static void Encode(FStringBuilderBase& Out, const FString& Value) { AppendCsvField(Out, Value); }
+		static void Decode(const FString& Cell, FString& Value, const FString& ItemId) { Value = Cell; }
+	};
+
+	struct FCsvList
+	{
+		static void Encode(FStringBuilderBase& Out, const TArray<FString>& Value) { AppendCsvList(Out, Value); }
+		static void Decode(const FString& Cell, TArray<FString>& Value, const FString& ItemId) { Cell.ParseIntoArray(Value, TEXT(";"), true); }
+	};
 
-			// Container
-			FString KeyItemIdStr, ItemContentsStr, ResultTableContentsStr, VirtualCurrencyContentsStr;
-			if (Obj->GetClass()->ImplementsInterface(UStoreContainerProvider::StaticClass()))
+	struct FCsvBool
+	{
+		static void Encode(FStringBuilderBase& Out, bool Value) { Out << BoolStr(Value); }
+		static void Decode(const FString& Cell, bool& Value, const FString& ItemId) { Value = Cell.Equals(TEXT("TRUE"), ESearchCase::IgnoreCase); }
+	};
+
+	/** Consumable counts, left empty when not set. */
+	struct FCsvCount
+	{
+		static void Encode(FStringBuilderBase& Out, int32 Value)
+		{
+			if (Value > 0)
 			{
-				IStoreContainerProvider* ContainerProvider = Cast<IStoreContainerProvider>(Obj);
-				if (ContainerProvider)
+				Out << Value;
+			}
+		}
+		static void Decode(const FString& Cell, int32& Value, const FString& ItemId) { Value = FCString::Atoi(*Cell); }
+	};
+
+	struct FCsvAmounts
+	{
+		static void Encode(FStringBuilderBase& Out, const FCurrencyAmounts& Value) { AppendCsvField(Out, Value.ToString()); }
+		static void Decode(const FString& Cell, FCurrencyAmounts& Value, const FString& ItemId) { ParseCsvAmounts(ItemId, Cell, Value); }
+	};
+
+	/**
+	 * Bundle and container cells are written only for bundles and containers. On import any of them
+	 * being set makes one, unless the file has the explicit IsBundle / IsContainer columns, which
+	 * come after them and so have the last word (an empty bundle still round-trips).
+	 */
+	enum class ECsvGroup : uint8
+	{
+		Item,
+		Bundle,
+		Container,
+	};
+
+	/**
+	 * One column: its header name, cell format, group and the record member it maps to. Columns are
+	 * types rather than table rows so the row codec below is unrolled over them at compile time.
+	 */
+#define PFSTORE_CSV_COLUMN(ColumnName, CodecType, ColumnGroup, Member) \
+	struct FCsvColumn_##ColumnName \
+	{ \
+		using FCodec = CodecType; \
+		static constexpr ECsvGroup Group = ECsvGroup::ColumnGroup; \
+		static constexpr const TCHAR* GetName() { return TEXT(#ColumnName); } \
+		static auto& Get(FStoreItemRecord& Record) { return Record.Member; } \
+		static const auto& Get(const FStoreItemRecord& Record) { return Record.Member; } \
+	};
+
+	PFSTORE_CSV_COLUMN(ItemId, FCsvText, Item, ItemId)
+	PFSTORE_CSV_COLUMN(DisplayName, FCsvText, Item, DisplayName)
+	PFSTORE_CSV_COLUMN(ItemClass, FCsvText, Item, ItemClass)
+	PFSTORE_CSV_COLUMN(Description, FCsvText, Item, Description)
+	PFSTORE_CSV_COLUMN(CustomData, FCsvText, Item, CustomData)
+	PFSTORE_CSV_COLUMN(Tags, FCsvList, Item, Tags)
+	PFSTORE_CSV_COLUMN(IsLimitedEdition, FCsvBool, Item, bIsLimitedEdition)
+	PFSTORE_CSV_COLUMN(IsTokenForCharacterCreation, FCsvBool, Item, bIsTokenForCharacterCreation)
+	PFSTORE_CSV_COLUMN(IsTradable, FCsvBool, Item, bIsTradable)
+	PFSTORE_CSV_COLUMN(IsStackable, FCsvBool, Item, bIsStackable)
+	PFSTORE_CSV_COLUMN(UsageCount, FCsvCount, Item, Consumable.UsageCount)
+	PFSTORE_CSV_COLUMN(UsagePeriod, FCsvCount, Item, Consumable.UsagePeriod)
+	PFSTORE_CSV_COLUMN(UsagePeriodGroup, FCsvText, Item, Consumable.UsagePeriodGroup)
+	PFSTORE_CSV_COLUMN(BundledItems, FCsvList, Bundle, Bundle.BundledItems)
+	PFSTORE_CSV_COLUMN(BundledResultTables, FCsvList, Bundle, Bundle.BundledResultTables)
+	PFSTORE_CSV_COLUMN(BundledVirtualCurrencies, FCsvAmounts, Bundle, Bundle.BundledVirtualCurrencies)
+	PFSTORE_CSV_COLUMN(KeyItemId, FCsvText, Container, Container.KeyItemId)
+	PFSTORE_CSV_COLUMN(ItemContents, FCsvList, Container, Container.ItemContents)
+	PFSTORE_CSV_COLUMN(ResultTableContents, FCsvList, Container, Container.ResultTableContents)
+	PFSTORE_CSV_COLUMN(VirtualCurrencyContents, FCsvAmounts, Container, Container.VirtualCurrencyContents)
+	PFSTORE_CSV_COLUMN(VirtualCurrencyPrices, FCsvAmounts, Item, Prices)
+	PFSTORE_CSV_COLUMN(IsBundle, FCsvBool, Item, bIsBundle)
+	PFSTORE_CSV_COLUMN(IsContainer, FCsvBool, Item, bIsContainer)
+
+#undef PFSTORE_CSV_COLUMN
+
+	template<typename... ColumnTypes>
+	struct TCsvColumnList
+	{
+		static constexpr int32 Num = sizeof...(ColumnTypes);
+
+		/** File cell of each column, INDEX_NONE where the file has no such column. */
+		using FPositions = TStaticArray<int32, sizeof...(ColumnTypes)>;
+
+		static const FString& GetHeader()
+		{
+			static const FString Header = []()
 				{
-					const FContainerInfo ContainerInfo = ContainerProvider->GetContainerInfo();
+					const TCHAR* Names[] = { ColumnTypes::GetName()... };
+					return FString::Join(TArrayView<const TCHAR*>(Names), TEXT(","));
+				}();
+			return Header;
+		}
 
-					KeyItemIdStr = EscapeCsv(ContainerInfo.KeyItemId);
-					ItemContentsStr = EscapeCsv(FString::Join(ContainerInfo.ItemContents, TEXT(";")));
-					ResultTableContentsStr = EscapeCsv(FString::Join(ContainerInfo.ResultTableContents, TEXT(";")));
+		static void EncodeRow(FStringBuilderBase& Out, const FStoreItemRecord& Record)
+		{
+			int32 Column = 0;
+			(EncodeCell<ColumnTypes>(Out, Record, Column++), ...);
+		}
 
-					if (ContainerInfo.VirtualCurrencyContents.Num() > 0)
-					{
-						TArray<FString> Pairs;
-						Pairs.Reserve(ContainerInfo.VirtualCurrencyContents.Num());
-						for (const auto& KV : ContainerInfo.VirtualCurrencyContents)
-						{
-							Pairs.Add(KV.Key + TEXT(":") + FString::FromInt(KV.Value));
-						}
-						VirtualCurrencyContentsStr = EscapeCsv(FString::Join(Pairs, TEXT(";")));
-					}
-					else
+		/** Matches header cells to columns by name, ignoring case; columns the file lacks stay empty on import. */
+		static int32 MapHeader(const TArray<FString>& HeaderCells, FPositions& OutPositions)
+		{
+			const TCHAR* Names[] = { ColumnTypes::GetName()... };
+			int32 NumFound = 0;
+			for (int32 Column = 0; Column < Num; ++Column)
+			{
+				OutPositions[Column] = HeaderCells.IndexOfByPredicate([Name = Names[Column]](const FString& Cell)
 					{
-						VirtualCurrencyContentsStr = TEXT("");
-					}
+						return Cell.Equals(Name, ESearchCase::IgnoreCase);
+					});
+				NumFound += OutPositions[Column] != INDEX_NONE ? 1 : 0;
+			}
+			return NumFound;
+		}
+
+		static FPositions GetDefaultPositions()
+		{
+			FPositions Positions;
+			for (int32 Column = 0; Column < Num; ++Column)
+			{
+				Positions[Column] = Column;
+			}
+			return Positions;
+		}
+
+		static void DecodeRow(const TArray<FString>& Cells, const FPositions& Positions, FStoreItemRecord& Out)
+		{
+			int32 Column = 0;
+			(DecodeCell<ColumnTypes>(Cells, Positions[Column++], Out), ...);
+		}
+
+	private:
+		template<typename ColumnType>
+		static void EncodeCell(FStringBuilderBase& Out, const FStoreItemRecord& Record, int32 Column)
+		{
+			if (Column > 0)
+			{
+				Out << TEXT(',');
+			}
+			if constexpr (ColumnType::Group == ECsvGroup::Bundle)
+			{
+				if (!Record.bIsBundle)
+				{
+					return;
 				}
 			}
-			else
+			else if constexpr (ColumnType::Group == ECsvGroup::Container)
+			{
+				if (!Record.bIsContainer)
+				{
+					return;
+				}
+			}
+			ColumnType::FCodec::Encode(Out, ColumnType::Get(Record));
+		}
+
+		template<typename ColumnType>
+		static void DecodeCell(const TArray<FString>& Cells, int32 Position, FStoreItemRecord& Out)
+		{
+			if (!Cells.IsValidIndex(Position) || Cells[Position].IsEmpty())
+			{
+				return;
+			}
+			// ItemId is the first column, so it is known by the time a cell warns about its value.
+			ColumnType::FCodec::Decode(Cells[Position], ColumnType::Get(Out), Out.ItemId);
+			if constexpr (ColumnType::Group == ECsvGroup::Bundle)
+			{
+				Out.bIsBundle = true;
+			}
+			else if constexpr (ColumnType::Group == ECsvGroup::Container)
 			{
-				KeyItemIdStr = ItemContentsStr = ResultTableContentsStr = VirtualCurrencyContentsStr = TEXT("");
+				Out.bIsContainer = true;
 			}
+		}
+	};
+
+	/** The item CSV, in the order ExportRecordsToCsv writes it. */
+	using FItemCsvColumns = TCsvColumnList<
+		FCsvColumn_ItemId, FCsvColumn_DisplayName, FCsvColumn_ItemClass, FCsvColumn_Description, FCsvColumn_CustomData, FCsvColumn_Tags,
+		FCsvColumn_IsLimitedEdition, FCsvColumn_IsTokenForCharacterCreation, FCsvColumn_IsTradable, FCsvColumn_IsStackable,
+		FCsvColumn_UsageCount, FCsvColumn_UsagePeriod, FCsvColumn_UsagePeriodGroup,
+		FCsvColumn_BundledItems, FCsvColumn_BundledResultTables, FCsvColumn_BundledVirtualCurrencies,
+		FCsvColumn_KeyItemId, FCsvColumn_ItemContents, FCsvColumn_ResultTableContents, FCsvColumn_VirtualCurrencyContents,
+		FCsvColumn_VirtualCurrencyPrices, FCsvColumn_IsBundle, FCsvColumn_IsContainer>;
+
+	bool ExportToCsv(const TArray<TWeakObjectPtr<UObject>>& Items, const FString& FilePath)
+	{
+		TArray<FStoreItemRecord> Records;
+		SnapshotItems(Items, Records);
+		return ExportRecordsToCsv(Records, FilePath);
+	}
+
+	bool ExportRecordsToCsv(const TArray<FStoreItemRecord>& Records, const FString& FilePath)
+	{
+		PFSTORE_SCOPE(CsvWrite);
+		PFStoreStats::AddItemsProcessed(Records.Num());
+
+		TArray<FString> Rows;
+		Rows.SetNum(Records.Num());
+
+		ParallelFor(TEXT("PFStore.ExportCsv"), Records.Num(), 64, [&Records, &Rows](int32 Index)
+			{
+				TStringBuilder<1024> Row;
+				FItemCsvColumns::EncodeRow(Row, Records[Index]);
+				Rows[Index] = Row.ToString();
+			});
 
-			const FString Line = FString::Printf(
-				TEXT("%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s"),
-				*ItemId, *Name, *ClassStr, *Desc, *Custom, *Tags,
-				*IsLimited, *IsToken, *IsTradable, *IsStackable,
-				*UsageCountStr, *UsagePeriodStr, *UsageGroupStr,
-				*BundledItemsStr, *BundledResultTablesStr, *BundledVirtualCurrenciesStr,
-				*KeyItemIdStr, *ItemContentsStr, *ResultTableContentsStr, *VirtualCurrencyContentsStr
-			);
+		const FString& CsvHeader = FItemCsvColumns::GetHeader();
+		int32 TotalLen = CsvHeader.Len();
+		for (const FString& Row : Rows)
+		{
+			TotalLen += Row.Len() + 2;
+		}
 
-			Lines.Add(Line);
+		FString CsvContent;
+		CsvContent.Reserve(TotalLen);
+		CsvContent += CsvHeader;
+		for (const FString& Row : Rows)
+		{
+			CsvContent += TEXT("\r\n");
+			CsvContent += Row;
 		}
 
-		const FString CsvContent = FString::Join(Lines, TEXT("\r\n"));
 		return FFileHelper::SaveStringToFile(CsvContent, *FilePath);
 	}
 
@@ -222,9 +599,11 @@ namespace PFHelpers
 		return In;
 	}
 
-	bool ImportItemsFromCsv(const FString& FilePath, TArray<PlayFab::AdminModels::FCatalogItem>& OutItems)
+	bool ImportRecordsFromCsv(const FString& FilePath, TArray<FStoreItemRecord>& OutRecords)
 	{
-		OutItems.Empty();
+		PFSTORE_SCOPE(CsvParse);
+
+		OutRecords.Empty();
 
 		TArray<FString> Lines;
 		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
@@ -238,122 +617,126 @@ namespace PFHelpers
 			return false;
 		}
 
-		for (int32 i = 1; i < Lines.Num(); ++i)
+		// Columns are found by header name, so reordered columns and columns of other tools import too.
+		TArray<FString> HeaderCells;
+		ParseCsvLine(Lines[0].TrimStartAndEnd(), HeaderCells);
+		FItemCsvColumns::FPositions Positions;
+		if (FItemCsvColumns::MapHeader(HeaderCells, Positions) == 0 || Positions[0] == INDEX_NONE)
 		{
-			const FString Line = Lines[i].TrimStartAndEnd();
-			if (Line.IsEmpty()) continue;
+			UE_LOG(LogTemp, Warning, TEXT("CSV %s has no ItemId header, reading the columns in export order."), *FilePath);
+			Positions = FItemCsvColumns::GetDefaultPositions();
+		}
+		const int32 NumHeaderCells = HeaderCells.Num();
 
-			TArray<FString> Fields;
-			ParseCsvLine(Line, Fields);
-			if (Fields.Num() < 20) continue;
+		const int32 NumRows = Lines.Num() - 1;
+		TArray<FStoreItemRecord> Parsed;
+		Parsed.SetNum(NumRows);
+		TArray<bool> bParsed;
+		bParsed.SetNumZeroed(NumRows);
 
-			PlayFab::AdminModels::FCatalogItem Item;
+		ParallelFor(TEXT("PFStore.ImportCsv"), NumRows, 64, [&Lines, &Parsed, &bParsed, &Positions, NumHeaderCells](int32 Index)
+			{
+				const FString Line = Lines[Index + 1].TrimStartAndEnd();
+				if (Line.IsEmpty())
+				{
+					return;
+				}
 
-			Item.ItemId = Fields[0];
-			Item.DisplayName = Fields[1];
-			Item.ItemClass = Fields[2];
-			Item.Description = Fields[3];
-			Item.CustomData = Fields[4];
+				// A row shorter than the header is a broken line, not a row with empty cells.
+				TArray<FString> Cells;
+				ParseCsvLine(Line, Cells);
+				if (Cells.Num() < NumHeaderCells)
+				{
+					return;
+				}
+				FItemCsvColumns::DecodeRow(Cells, Positions, Parsed[Index]);
+				bParsed[Index] = true;
+			});
 
-			// Tags
+		OutRecords.Reserve(NumRows);
+		for (int32 Index = 0; Index < NumRows; ++Index)
+		{
+			if (bParsed[Index])
 			{
-				TArray<FString> Tags;
-				Fields[5].ParseIntoArray(Tags, TEXT(";"), true);
-				Item.Tags = Tags;
+				OutRecords.Add(MoveTemp(Parsed[Index]));
 			}
+		}
 
-			Item.IsLimitedEdition = Fields[6].Equals(TEXT("TRUE"), ESearchCase::IgnoreCase);
-			Item.CanBecomeCharacter = Fields[7].Equals(TEXT("TRUE"), ESearchCase::IgnoreCase);
-			Item.IsTradable = Fields[8].Equals(TEXT("TRUE"), ESearchCase::IgnoreCase);
-			Item.IsStackable = Fields[9].Equals(TEXT("TRUE"), ESearchCase::IgnoreCase);
-
-			// Consumable
-			{
-				auto CI = MakeShared<PlayFab::AdminModels::FCatalogItemConsumableInfo>();
-				const FString& SC = Fields[10];
-				const FString& SP = Fields[11];
+		return true;
+	}
 
-				if (!SC.IsEmpty()) CI->UsageCount = PlayFab::Boxed<uint32>(static_cast<uint32>(FCString::Atoi(*SC)));
-				if (!SP.IsEmpty()) CI->UsagePeriod = PlayFab::Boxed<uint32>(static_cast<uint32>(FCString::Atoi(*SP)));
+	// ---------- Drop table CSV ----------
 
-				CI->UsagePeriodGroup = Fields[12];
-				Item.Consumable = CI;
-			}
+	static const TCHAR* DropTablesCsvHeader = TEXT("TableId,ResultItemType,ResultItem,Weight");
 
-			// Bundle
-			{
-				auto BI = MakeShared<PlayFab::AdminModels::FCatalogItemBundleInfo>();
+	FString GetDropTablesCsvPath(const FString& ItemsCsvPath)
+	{
+		return FPaths::Combine(FPaths::GetPath(ItemsCsvPath), FPaths::GetBaseFilename(ItemsCsvPath) + TEXT("_DropTables.csv"));
+	}
 
-				TArray<FString> Arr;
-				Fields[13].ParseIntoArray(Arr, TEXT(";"), true);
-				BI->BundledItems = Arr;
+	bool ExportDropTablesToCsv(const TArray<FDropTableInfo>& Tables, const FString& FilePath)
+	{
+		PFSTORE_SCOPE(CsvWrite);
+		PFStoreStats::AddItemsProcessed(Tables.Num());
 
-				Arr.Reset();
-				Fields[14].ParseIntoArray(Arr, TEXT(";"), true);
-				BI->BundledResultTables = Arr;
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open %s for writing"), *FilePath);
+			return false;
+		}
 
-				if (!Fields[15].IsEmpty())
-				{
-					TArray<FString> Pairs;
-					Fields[15].ParseIntoArray(Pairs, TEXT(";"), true);
-					for (const FString& P : Pairs)
-					{
-						FString Key, Val;
-						if (P.Split(TEXT(":"), &Key, &Val))
-						{
-							BI->BundledVirtualCurrencies.Add(Key, FCString::Atoi(*Val));
-						}
-					}
-				}
+		// Rows go through a fixed buffer, so the file may be far larger than what is held in memory.
+		constexpr int32 FlushLen = 60 * 1024;
+		TStringBuilder<64 * 1024> Chunk;
+		auto Flush = [&Chunk, &Writer]()
+			{
+				const FTCHARToUTF8 Utf8(Chunk.GetData(), Chunk.Len());
+				Writer->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+				Chunk.Reset();
+			};
 
-				Item.Bundle = BI;
+		Chunk << DropTablesCsvHeader;
+		for (const FDropTableInfo& Table : Tables)
+		{
+			if (Table.Nodes.Num() == 0)
+			{
+				Chunk << TEXT("\r\n");
+				AppendCsvField(Chunk, Table.TableId);
+				Chunk << TEXT(",,,");
 			}
-
-			// Container
+			for (const FDropTableNode& Node : Table.Nodes)
 			{
-				auto CI = MakeShared<PlayFab::AdminModels::FCatalogItemContainerInfo>();
-				CI->KeyItemId = Fields[16];
+				Chunk << TEXT("\r\n");
+				AppendCsvField(Chunk, Table.TableId);
+				Chunk << TEXT(',');
+				AppendCsvField(Chunk, Node.ResultItemType);
+				Chunk << TEXT(',');
+				AppendCsvField(Chunk, Node.ResultItem);
+				Chunk << TEXT(',') << Node.Weight;
 
-				TArray<FString> Arr;
-				Fields[17].ParseIntoArray(Arr, TEXT(";"), true);
-				CI->ItemContents = Arr;
-
-				Arr.Reset();
-				Fields[18].ParseIntoArray(Arr, TEXT(";"), true);
-				CI->ResultTableContents = Arr;
-
-				if (!Fields[19].IsEmpty())
+				if (Chunk.Len() >= FlushLen)
 				{
-					TArray<FString> Pairs;
-					Fields[19].ParseIntoArray(Pairs, TEXT(";"), true);
-					for (const FString& P : Pairs)
-					{
-						FString Key, Val;
-						if (P.Split(TEXT(":"), &Key, &Val))
-						{
-							CI->VirtualCurrencyContents.Add(Key, FCString::Atoi(*Val));
-						}
-					}
+					Flush();
 				}
-
-				Item.Container = CI;
 			}
 
-			// Defaults
-			Item.CatalogVersion = TEXT("Main");
-			Item.ItemImageUrl = FString();
-			Item.InitialLimitedEditionCount = 0;
-			Item.RealCurrencyPrices.Empty();
-
-			OutItems.Add(MoveTemp(Item));
+			// Also per table, so a run of tables without nodes is flushed too.
+			if (Chunk.Len() >= FlushLen)
+			{
+				Flush();
+			}
 		}
+		Flush();
 
-		return true;
+		return Writer->Close();
 	}
 
-	bool ImportDropTablesFromCsv(const FString& FilePath, TArray<PlayFab::AdminModels::FRandomResultTable>& OutItems)
+	bool ImportDropTablesFromCsv(const FString& FilePath, TArray<FDropTableInfo>& OutTables)
 	{
-		OutItems.Empty();
+		PFSTORE_SCOPE(CsvParse);
+
+		OutTables.Reset();
 
 		TArray<FString> Lines;
 		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
@@ -361,21 +744,2140 @@ namespace PFHelpers
 			UE_LOG(LogTemp, Error, TEXT("Failed to load CSV: %s"), *FilePath);
 			return false;
 		}
-		if (Lines.Num() < 2)
+		if (Lines.Num() < 1 || !Lines[0].StartsWith(TEXT("TableId")))
 		{
-			UE_LOG(LogTemp, Error, TEXT("CSV has no data lines."));
+			UE_LOG(LogTemp, Error, TEXT("%s is not a drop table CSV."), *FilePath);
 			return false;
 		}
 
-		for (int32 i = 1; i < Lines.Num(); ++i)
+		struct FRow
+		{
+			FString TableId;
+			FDropTableNode Node;
+			bool bHasNode = false;
+		};
+
+		const int32 NumRows = Lines.Num() - 1;
+		TArray<FRow> Rows;
+		Rows.SetNum(NumRows);
+
+		ParallelFor(TEXT("PFStore.ImportDropTablesCsv"), NumRows, 256, [&Lines, &Rows](int32 Index)
+			{
+				const FString& Line = Lines[Index + 1];
+				if (Line.IsEmpty())
+				{
+					return;
+				}
+
+				TArray<FString> Fields;
+				ParseCsvLine(Line, Fields);
+				if (Fields.Num() < 4)
+				{
+					return;
+				}
+
+				FRow& Row = Rows[Index];
+				Row.TableId = MoveTemp(Fields[0]);
+				Row.bHasNode = !Fields[2].IsEmpty();
+				if (Row.bHasNode)
+				{
+					Row.Node.ResultItemType = MoveTemp(Fields[1]);
+					Row.Node.ResultItem = MoveTemp(Fields[2]);
+					Row.Node.Weight = FCString::Atoi(*Fields[3]);
+				}
+			});
+
+		// One hashed pass assigns rows to tables and counts nodes; the fill pass below only indexes.
+		TMap<FString, int32> TableIndexById;
+		TArray<int32> RowTables;
+		RowTables.SetNumUninitialized(NumRows);
+		TArray<int32> NodeCounts;
+		for (int32 Index = 0; Index < NumRows; ++Index)
+		{
+			FRow& Row = Rows[Index];
+			if (Row.TableId.IsEmpty())
+			{
+				RowTables[Index] = INDEX_NONE;
+				continue;
+			}
+
+			int32& TableIndex = TableIndexById.FindOrAdd(Row.TableId, INDEX_NONE);
+			if (TableIndex == INDEX_NONE)
+			{
+				TableIndex = OutTables.Num();
+				OutTables.AddDefaulted_GetRef().TableId = MoveTemp(Row.TableId);
+				NodeCounts.Add(0);
+			}
+			RowTables[Index] = TableIndex;
+			NodeCounts[TableIndex] += Row.bHasNode ? 1 : 0;
+		}
+
+		for (int32 TableIndex = 0; TableIndex < OutTables.Num(); ++TableIndex)
+		{
+			OutTables[TableIndex].Nodes.Reserve(NodeCounts[TableIndex]);
+		}
+		for (int32 Index = 0; Index < NumRows; ++Index)
+		{
+			if (RowTables[Index] != INDEX_NONE && Rows[Index].bHasNode)
+			{
+				OutTables[RowTables[Index]].Nodes.Add(MoveTemp(Rows[Index].Node));
+			}
+		}
+
+		PFStoreStats::AddItemsProcessed(OutTables.Num());
+		return true;
+	}
+
+	// ---------- PlayFab catalog JSON ----------
+
+	static void WriteStringArray(FStoreJsonWriter& Writer, const ANSICHAR* Identifier, const TArray<FString>& Values)
+	{
+		Writer.WriteArrayStart(Identifier);
+		for (const FString& Value : Values)
 		{
-			const FString Line = Lines[i].TrimStartAndEnd();
-			if (Line.IsEmpty()) continue;
+			Writer.WriteValue(Value);
+		}
+		Writer.WriteArrayEnd();
+	}
 
-			PlayFab::AdminModels::FRandomResultTable Item;
-			OutItems.Add(MoveTemp(Item));
+	static void WriteAmounts(FStoreJsonWriter& Writer, const ANSICHAR* Identifier, const FCurrencyAmounts& Amounts)
+	{
+		Writer.WriteObjectStart(Identifier);
+		for (const FCurrencyAmount& Amount : Amounts)
+		{
+			const FString Code = Amount.Code.ToString();
+			Writer.WriteIdentifier(TCHAR_TO_ANSI(*Code));
+			Writer.WriteValue(Amount.Amount);
+		}
+		Writer.WriteObjectEnd();
+	}
+
+	void WriteCatalogItemJson(FStoreJsonWriter& Writer, const FStoreItemRecord& Record, const FString& CatalogVersion)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue("ItemId", Record.ItemId);
+		Writer.WriteStringOrNull("ItemClass", Record.ItemClass);
+		Writer.WriteValue("CatalogVersion", CatalogVersion);
+		Writer.WriteStringOrNull("DisplayName", Record.DisplayName);
+		Writer.WriteStringOrNull("Description", Record.Description);
+		WriteAmounts(Writer, "VirtualCurrencyPrices", Record.Prices);
+		Writer.WriteObjectStart("RealCurrencyPrices");
+		Writer.WriteObjectEnd();
+		WriteStringArray(Writer, "Tags", Record.Tags);
+		Writer.WriteStringOrNull("CustomData", Record.CustomData);
+
+		Writer.WriteObjectStart("Consumable");
+		if (Record.Consumable.UsageCount > 0)
+		{
+			Writer.WriteValue("UsageCount", Record.Consumable.UsageCount);
+		}
+		else
+		{
+			Writer.WriteNull("UsageCount");
+		}
+		if (Record.Consumable.UsagePeriod > 0)
+		{
+			Writer.WriteValue("UsagePeriod", Record.Consumable.UsagePeriod);
+		}
+		else
+		{
+			Writer.WriteNull("UsagePeriod");
+		}
+		Writer.WriteStringOrNull("UsagePeriodGroup", Record.Consumable.UsagePeriodGroup);
+		Writer.WriteObjectEnd();
+
+		if (Record.bIsContainer)
+		{
+			Writer.WriteObjectStart("Container");
+			Writer.WriteStringOrNull("KeyItemId", Record.Container.KeyItemId);
+			WriteStringArray(Writer, "ItemContents", Record.Container.ItemContents);
+			WriteStringArray(Writer, "ResultTableContents", Record.Container.ResultTableContents);
+			WriteAmounts(Writer, "VirtualCurrencyContents", Record.Container.VirtualCurrencyContents);
+			Writer.WriteObjectEnd();
+		}
+		else
+		{
+			Writer.WriteNull("Container");
+		}
+
+		if (Record.bIsBundle)
+		{
+			Writer.WriteObjectStart("Bundle");
+			WriteStringArray(Writer, "BundledItems", Record.Bundle.BundledItems);
+			WriteStringArray(Writer, "BundledResultTables", Record.Bundle.BundledResultTables);
+			WriteAmounts(Writer, "BundledVirtualCurrencies", Record.Bundle.BundledVirtualCurrencies);
+			Writer.WriteObjectEnd();
+		}
+		else
+		{
+			Writer.WriteNull("Bundle");
+		}
+
+		Writer.WriteValue("CanBecomeCharacter", Record.bIsTokenForCharacterCreation);
+		Writer.WriteValue("IsStackable", Record.bIsStackable);
+		Writer.WriteValue("IsTradable", Record.bIsTradable);
+		Writer.WriteNull("ItemImageUrl");
+		Writer.WriteValue("IsLimitedEdition", Record.bIsLimitedEdition);
+		Writer.WriteValue("InitialLimitedEditionCount", 0);
+		Writer.WriteNull("ActivatedMembership");
+		Writer.WriteObjectEnd();
+	}
+
+	// Sizes of what the writers above produce, counted from the fields. Keep in step with them.
+
+	static int64 JsonMemberSize(const ANSICHAR* Identifier, int64 ValueSize)
+	{
+		return FStoreJsonWriter::GetIdentifierSize(Identifier) + ValueSize;
+	}
+
+	/** Brackets and the commas between NumElements elements. */
+	static int64 JsonContainerSize(int32 NumElements)
+	{
+		return 2 + FMath::Max(0, NumElements - 1);
+	}
+
+	static int64 JsonStringOrNullSize(const FString& Value)
+	{
+		return Value.IsEmpty() ? 4 : FStoreJsonWriter::GetStringSize(Value);
+	}
+
+	static int64 JsonStringArraySize(const TArray<FString>& Values)
+	{
+		int64 Size = JsonContainerSize(Values.Num());
+		for (const FString& Value : Values)
+		{
+			Size += FStoreJsonWriter::GetStringSize(Value);
+		}
+		return Size;
+	}
+
+	static int64 JsonAmountsSize(const FCurrencyAmounts& Amounts)
+	{
+		int64 Size = JsonContainerSize(Amounts.Num());
+		for (const FCurrencyAmount& Amount : Amounts)
+		{
+			Size += Amount.Code.Len() + 3 + FStoreJsonWriter::GetIntegerSize(Amount.Amount);
+		}
+		return Size;
+	}
+
+	static int64 JsonBoolSize(bool Value)
+	{
+		return Value ? 4 : 5;
+	}
+
+	int64 EstimateCatalogItemJsonSize(const FStoreItemRecord& Record, int64 CatalogVersionSize)
+	{
+		const FConsumableInfo& Consumable = Record.Consumable;
+		const int64 ConsumableSize = JsonContainerSize(3)
+			+ JsonMemberSize("UsageCount", Consumable.UsageCount > 0 ? FStoreJsonWriter::GetIntegerSize(Consumable.UsageCount) : 4)
+			+ JsonMemberSize("UsagePeriod", Consumable.UsagePeriod > 0 ? FStoreJsonWriter::GetIntegerSize(Consumable.UsagePeriod) : 4)
+			+ JsonMemberSize("UsagePeriodGroup", JsonStringOrNullSize(Consumable.UsagePeriodGroup));
+
+		const int64 ContainerSize = !Record.bIsContainer ? 4 : JsonContainerSize(4)
+			+ JsonMemberSize("KeyItemId", JsonStringOrNullSize(Record.Container.KeyItemId))
+			+ JsonMemberSize("ItemContents", JsonStringArraySize(Record.Container.ItemContents))
+			+ JsonMemberSize("ResultTableContents", JsonStringArraySize(Record.Container.ResultTableContents))
+			+ JsonMemberSize("VirtualCurrencyContents", JsonAmountsSize(Record.Container.VirtualCurrencyContents));
+
+		const int64 BundleSize = !Record.bIsBundle ? 4 : JsonContainerSize(3)
+			+ JsonMemberSize("BundledItems", JsonStringArraySize(Record.Bundle.BundledItems))
+			+ JsonMemberSize("BundledResultTables", JsonStringArraySize(Record.Bundle.BundledResultTables))
+			+ JsonMemberSize("BundledVirtualCurrencies", JsonAmountsSize(Record.Bundle.BundledVirtualCurrencies));
+
+		return JsonContainerSize(19)
+			+ JsonMemberSize("ItemId", FStoreJsonWriter::GetStringSize(Record.ItemId))
+			+ JsonMemberSize("ItemClass", JsonStringOrNullSize(Record.ItemClass))
+			+ JsonMemberSize("CatalogVersion", CatalogVersionSize)
+			+ JsonMemberSize("DisplayName", JsonStringOrNullSize(Record.DisplayName))
+			+ JsonMemberSize("Description", JsonStringOrNullSize(Record.Description))
+			+ JsonMemberSize("VirtualCurrencyPrices", JsonAmountsSize(Record.Prices))
+			+ JsonMemberSize("RealCurrencyPrices", 2)
+			+ JsonMemberSize("Tags", JsonStringArraySize(Record.Tags))
+			+ JsonMemberSize("CustomData", JsonStringOrNullSize(Record.CustomData))
+			+ JsonMemberSize("Consumable", ConsumableSize)
+			+ JsonMemberSize("Container", ContainerSize)
+			+ JsonMemberSize("Bundle", BundleSize)
+			+ JsonMemberSize("CanBecomeCharacter", JsonBoolSize(Record.bIsTokenForCharacterCreation))
+			+ JsonMemberSize("IsStackable", JsonBoolSize(Record.bIsStackable))
+			+ JsonMemberSize("IsTradable", JsonBoolSize(Record.bIsTradable))
+			+ JsonMemberSize("ItemImageUrl", 4)
+			+ JsonMemberSize("IsLimitedEdition", JsonBoolSize(Record.bIsLimitedEdition))
+			+ JsonMemberSize("InitialLimitedEditionCount", 1)
+			+ JsonMemberSize("ActivatedMembership", 4);
+	}
+
+	int64 GetRequestBodyOverhead(const FString& CatalogVersion)
+	{
+		// {"CatalogVersion":"...","Catalog":[]}, "Tables" being shorter.
+		return JsonContainerSize(2)
+			+ JsonMemberSize("CatalogVersion", FStoreJsonWriter::GetStringSize(CatalogVersion))
+			+ JsonMemberSize("Catalog", 2);
+	}
+
+	int64 GetMaxRequestBodyBytes()
+	{
+		return int64(FMath::Max(16, GetDefault<UPFStoreEditorSettings>()->MaxAdminRequestKilobytes)) * 1024;
+	}
+
+	TArray<int32> PackRequests(TConstArrayView<int64> ElementSizes, int64 BodyOverhead, int64 MaxBodyBytes)
+	{
+		TArray<int32> Requests;
+		int64 Size = BodyOverhead;
+		int32 Num = 0;
+		for (const int64 ElementSize : ElementSizes)
+		{
+			// The comma before every element but the first.
+			const int64 Added = ElementSize + (Num > 0 ? 1 : 0);
+			if (Num > 0 && (Size + Added > MaxBodyBytes || Num == PublishItemsPerRequest))
+			{
+				Requests.Add(Num);
+				Size = BodyOverhead;
+				Num = 0;
+				Size += ElementSize;
+			}
+			else
+			{
+				Size += Added;
+			}
+			++Num;
+		}
+		if (Num > 0)
+		{
+			Requests.Add(Num);
+		}
+		return Requests;
+	}
+
+	void WriteDropTableJson(FStoreJsonWriter& Writer, const FDropTableInfo& Table)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue("TableId", Table.TableId);
+		Writer.WriteArrayStart("Nodes");
+		for (const FDropTableNode& Node : Table.Nodes)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue("ResultItemType", Node.ResultItemType);
+			Writer.WriteValue("ResultItem", Node.ResultItem);
+			Writer.WriteValue("Weight", Node.Weight);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	/**
+	 * Writes the items as the elements of the array Writer is in. Items are formatted on all cores one
+	 * batch at a time, so memory is bounded by the batch and not by the catalog. The fragments keep
+	 * their capacity from batch to batch.
+	 */
+	static void WriteCatalogItemsJson(FStoreJsonWriter& Writer, TConstArrayView<FStoreItemRecord> Records, const FString& CatalogVersion)
+	{
+		constexpr int32 BatchSize = 1024;
+		TArray<TArray<uint8>> Fragments;
+		Fragments.SetNum(FMath::Min(BatchSize, Records.Num()));
+
+		for (int32 BatchStart = 0; BatchStart < Records.Num(); BatchStart += BatchSize)
+		{
+			const int32 BatchNum = FMath::Min(BatchSize, Records.Num() - BatchStart);
+			ParallelFor(TEXT("PFStore.WriteJson"), BatchNum, 64, [&Records, &Fragments, &CatalogVersion, BatchStart](int32 Index)
+				{
+					TArray<uint8>& Fragment = Fragments[Index];
+					Fragment.Reset();
+					FStoreJsonWriter ItemWriter(Fragment);
+					WriteCatalogItemJson(ItemWriter, Records[BatchStart + Index], CatalogVersion);
+				});
+
+			for (int32 Index = 0; Index < BatchNum; ++Index)
+			{
+				Writer.WriteRawValue(Fragments[Index]);
+			}
+		}
+	}
+
+	bool ExportRecordsToJson(const TArray<FStoreItemRecord>& Records, const TArray<FDropTableInfo>& DropTables,
+		const FString& CatalogVersion, const FString& FilePath)
+	{
+		PFSTORE_SCOPE(JsonSerialize);
+		PFStoreStats::AddItemsProcessed(Records.Num());
+
+		TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!File)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open %s for writing"), *FilePath);
+			return false;
+		}
+
+		bool bSuccess;
+		{
+			TArray<uint8> Buffer;
+			FStoreJsonWriter Writer(Buffer, *File);
+
+			Writer.WriteObjectStart();
+			Writer.WriteValue("CatalogVersion", CatalogVersion);
+			Writer.WriteArrayStart("Catalog");
+			WriteCatalogItemsJson(Writer, Records, CatalogVersion);
+			Writer.WriteArrayEnd();
+
+			Writer.WriteArrayStart("Tables");
+			for (const FDropTableInfo& Table : DropTables)
+			{
+				WriteDropTableJson(Writer, Table);
+			}
+			Writer.WriteArrayEnd();
+
+			Writer.WriteObjectEnd();
+			bSuccess = Writer.Flush();
+		}
+
+		bSuccess = File->Close() && bSuccess;
+		if (!bSuccess)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *FilePath);
+		}
+		return bSuccess;
+	}
+
+	/** Maps the PlayFab catalog layout onto records, one token at a time. */
+	class FCatalogJsonParser
+	{
+	public:
+		explicit FCatalogJsonParser(FStoreJsonReader& InReader)
+			: Reader(InReader)
+		{
+		}
+
+		bool ParseDocument(TArray<FStoreItemRecord>& OutRecords, TArray<FDropTableInfo>& OutDropTables)
+		{
+			if (Reader.Next() != EStoreJsonToken::ObjectStart)
+			{
+				return Fail(TEXT("Expected a catalog object"));
+			}
+
+			for (;;)
+			{
+				const EStoreJsonToken Token = Reader.Next();
+				if (Token == EStoreJsonToken::ObjectEnd)
+				{
+					break;
+				}
+
+				const FString& Key = Reader.GetIdentifier();
+				if (Is(Key, TEXT("Catalog")))
+				{
+					if (!ParseArray(Token, [this, &OutRecords](EStoreJsonToken Element)
+						{
+							return ParseItem(Element, OutRecords.AddDefaulted_GetRef());
+						}))
+					{
+						return false;
+					}
+				}
+				// Tables is what UpdateRandomResultTables takes, DropTables what the Game Manager exports.
+				else if (Is(Key, TEXT("Tables")) || Is(Key, TEXT("DropTables")))
+				{
+					if (!ParseArray(Token, [this, &OutDropTables](EStoreJsonToken Element)
+						{
+							return ParseDropTable(Element, OutDropTables.AddDefaulted_GetRef());
+						}))
+					{
+						return false;
+					}
+				}
+				else if (!Skip(Token))
+				{
+					return false;
+				}
+			}
+
+			return Reader.Next() == EStoreJsonToken::End || Fail(TEXT("Unexpected data after the catalog"));
+		}
+
+		/**
+		 * Walks a PlayFab response envelope, { code, status, data: {...} } or { ..., error, errorMessage },
+		 * handing every member of data to ParseDataMember.
+		 */
+		template<typename FunctorType>
+		bool ParseResponse(FunctorType&& ParseDataMember)
+		{
+			FString ErrorMessage;
+			const bool bParsed = ParseObject(Reader.Next(), [this, &ParseDataMember, &ErrorMessage](const FString& Key, EStoreJsonToken Token)
+				{
+					if (Is(Key, TEXT("data")))
+					{
+						return ParseObject(Token, [&ParseDataMember](const FString& DataKey, EStoreJsonToken DataToken)
+							{
+								return ParseDataMember(DataKey, DataToken);
+							});
+					}
+					if (Is(Key, TEXT("errorMessage")))
+					{
+						return ParseString(Token, ErrorMessage);
+					}
+					return Skip(Token);
+				});
+
+			if (bParsed && !ErrorMessage.IsEmpty())
+			{
+				Error = ErrorMessage;
+				return false;
+			}
+			return bParsed;
+		}
+
+		bool ParseCatalogItemsResponse(TArray<FStoreItemRecord>& OutRecords)
+		{
+			return ParseResponse([this, &OutRecords](const FString& Key, EStoreJsonToken Token)
+				{
+					if (!Is(Key, TEXT("Catalog")))
+					{
+						return Skip(Token);
+					}
+					return ParseArray(Token, [this, &OutRecords](EStoreJsonToken Element)
+						{
+							return ParseItem(Element, OutRecords.AddDefaulted_GetRef());
+						});
+				});
+		}
+
+		/** GetRandomResultTables returns the tables as a map keyed by TableId. */
+		bool ParseRandomResultTablesResponse(TArray<FDropTableInfo>& OutDropTables)
+		{
+			return ParseResponse([this, &OutDropTables](const FString& Key, EStoreJsonToken Token)
+				{
+					if (!Is(Key, TEXT("Tables")))
+					{
+						return Skip(Token);
+					}
+					return ParseObject(Token, [this, &OutDropTables](const FString& TableId, EStoreJsonToken Element)
+						{
+							FDropTableInfo& Table = OutDropTables.AddDefaulted_GetRef();
+							Table.TableId = TableId;
+							return ParseDropTable(Element, Table);
+						});
+				});
+		}
+
+		const FString& GetError() const { return Error; }
+
+	private:
+		static bool Is(const FString& Key, const TCHAR* Name)
+		{
+			return Key.Equals(Name, ESearchCase::CaseSensitive);
+		}
+
+		bool Fail(const TCHAR* Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = Reader.GetError().IsEmpty()
+					? FString::Printf(TEXT("%s at byte %lld"), Message, Reader.GetOffset())
+					: Reader.GetError();
+			}
+			return false;
+		}
+
+		bool Skip(EStoreJsonToken Token)
+		{
+			return Reader.SkipValue(Token) || Fail(TEXT("Malformed JSON"));
+		}
+
+		/** Runs ParseElement for every element of the array that starts with Token. Null is an empty array. */
+		template<typename FunctorType>
+		bool ParseArray(EStoreJsonToken Token, FunctorType&& ParseElement)
+		{
+			if (Token == EStoreJsonToken::Null)
+			{
+				return true;
+			}
+			if (Token != EStoreJsonToken::ArrayStart)
+			{
+				return Fail(TEXT("Expected an array"));
+			}
+			for (;;)
+			{
+				const EStoreJsonToken Element = Reader.Next();
+				if (Element == EStoreJsonToken::ArrayEnd)
+				{
+					return true;
+				}
+				if (Element == EStoreJsonToken::Error || !ParseElement(Element))
+				{
+					return Fail(TEXT("Malformed array"));
+				}
+			}
+		}
+
+		/** Runs ParseMember for every member of the object that starts with Token. Null is an empty object. */
+		template<typename FunctorType>
+		bool ParseObject(EStoreJsonToken Token, FunctorType&& ParseMember)
+		{
+			if (Token == EStoreJsonToken::Null)
+			{
+				return true;
+			}
+			if (Token != EStoreJsonToken::ObjectStart)
+			{
+				return Fail(TEXT("Expected an object"));
+			}
+			for (;;)
+			{
+				const EStoreJsonToken Member = Reader.Next();
+				if (Member == EStoreJsonToken::ObjectEnd)
+				{
+					return true;
+				}
+				if (Member == EStoreJsonToken::Error || !ParseMember(Reader.GetIdentifier(), Member))
+				{
+					return Fail(TEXT("Malformed object"));
+				}
+			}
+		}
+
+		bool ParseString(EStoreJsonToken Token, FString& Out)
+		{
+			if (Token == EStoreJsonToken::String)
+			{
+				Out = Reader.GetString();
+				return true;
+			}
+			if (Token == EStoreJsonToken::Null)
+			{
+				Out.Reset();
+				return true;
+			}
+			return Fail(TEXT("Expected a string"));
+		}
+
+		bool ParseInt(EStoreJsonToken Token, int32& Out)
+		{
+			if (Token == EStoreJsonToken::Number)
+			{
+				Out = int32(FMath::Clamp<int64>(Reader.GetInt64(), MIN_int32, MAX_int32));
+				return true;
+			}
+			if (Token == EStoreJsonToken::Null)
+			{
+				Out = 0;
+				return true;
+			}
+			return Fail(TEXT("Expected a number"));
+		}
+
+		bool ParseBool(EStoreJsonToken Token, bool& Out)
+		{
+			if (Token == EStoreJsonToken::True || Token == EStoreJsonToken::False || Token == EStoreJsonToken::Null)
+			{
+				Out = Token == EStoreJsonToken::True;
+				return true;
+			}
+			return Fail(TEXT("Expected a boolean"));
+		}
+
+		bool ParseStrings(EStoreJsonToken Token, TArray<FString>& Out)
+		{
+			Out.Reset();
+			return ParseArray(Token, [this, &Out](EStoreJsonToken Element)
+				{
+					return ParseString(Element, Out.AddDefaulted_GetRef());
+				});
+		}
+
+		bool ParseAmounts(EStoreJsonToken Token, FCurrencyAmounts& Out)
+		{
+			Out.Reset();
+			return ParseObject(Token, [this, &Out](const FString& Code, EStoreJsonToken Member)
+				{
+					int32 Amount = 0;
+					if (!ParseInt(Member, Amount))
+					{
+						return false;
+					}
+
+					const FCurrencyCode Currency = FCurrencyCode::FromString(Code);
+					if (Currency.IsValid())
+					{
+						Out.Add(Currency, Amount);
+					}
+					else
+					{
+						UE_LOG(LogTemp, Warning, TEXT("'%s' is not a valid currency code, skipped"), *Code);
+					}
+					return true;
+				});
+		}
+
+		bool ParseItem(EStoreJsonToken Token, FStoreItemRecord& Out)
+		{
+			return ParseObject(Token, [this, &Out](const FString& Key, EStoreJsonToken Member)
+				{
+					if (Is(Key, TEXT("ItemId")))                { return ParseString(Member, Out.ItemId); }
+					if (Is(Key, TEXT("ItemClass")))             { return ParseString(Member, Out.ItemClass); }
+					if (Is(Key, TEXT("DisplayName")))           { return ParseString(Member, Out.DisplayName); }
+					if (Is(Key, TEXT("Description")))           { return ParseString(Member, Out.Description); }
+					if (Is(Key, TEXT("CustomData")))            { return ParseString(Member, Out.CustomData); }
+					if (Is(Key, TEXT("Tags")))                  { return ParseStrings(Member, Out.Tags); }
+					if (Is(Key, TEXT("VirtualCurrencyPrices"))) { return ParseAmounts(Member, Out.Prices); }
+					if (Is(Key, TEXT("CanBecomeCharacter")))    { return ParseBool(Member, Out.bIsTokenForCharacterCreation); }
+					if (Is(Key, TEXT("IsStackable")))           { return ParseBool(Member, Out.bIsStackable); }
+					if (Is(Key, TEXT("IsTradable")))            { return ParseBool(Member, Out.bIsTradable); }
+					if (Is(Key, TEXT("IsLimitedEdition")))      { return ParseBool(Member, Out.bIsLimitedEdition); }
+
+					if (Is(Key, TEXT("Consumable")))
+					{
+						return ParseObject(Member, [this, &Out](const FString& Field, EStoreJsonToken Value)
+							{
+								if (Is(Field, TEXT("UsageCount")))       { return ParseInt(Value, Out.Consumable.UsageCount); }
+								if (Is(Field, TEXT("UsagePeriod")))      { return ParseInt(Value, Out.Consumable.UsagePeriod); }
+								if (Is(Field, TEXT("UsagePeriodGroup"))) { return ParseString(Value, Out.Consumable.UsagePeriodGroup); }
+								return Skip(Value);
+							});
+					}
+
+					if (Is(Key, TEXT("Bundle")))
+					{
+						Out.bIsBundle = Member == EStoreJsonToken::ObjectStart;
+						return ParseObject(Member, [this, &Out](const FString& Field, EStoreJsonToken Value)
+							{
+								if (Is(Field, TEXT("BundledItems")))             { return ParseStrings(Value, Out.Bundle.BundledItems); }
+								if (Is(Field, TEXT("BundledResultTables")))      { return ParseStrings(Value, Out.Bundle.BundledResultTables); }
+								if (Is(Field, TEXT("BundledVirtualCurrencies"))) { return ParseAmounts(Value, Out.Bundle.BundledVirtualCurrencies); }
+								return Skip(Value);
+							});
+					}
+
+					if (Is(Key, TEXT("Container")))
+					{
+						Out.bIsContainer = Member == EStoreJsonToken::ObjectStart;
+						return ParseObject(Member, [this, &Out](const FString& Field, EStoreJsonToken Value)
+							{
+								if (Is(Field, TEXT("KeyItemId")))               { return ParseString(Value, Out.Container.KeyItemId); }
+								if (Is(Field, TEXT("ItemContents")))            { return ParseStrings(Value, Out.Container.ItemContents); }
+								if (Is(Field, TEXT("ResultTableContents")))     { return ParseStrings(Value, Out.Container.ResultTableContents); }
+								if (Is(Field, TEXT("VirtualCurrencyContents"))) { return ParseAmounts(Value, Out.Container.VirtualCurrencyContents); }
+								return Skip(Value);
+							});
+					}
+
+					// CatalogVersion, RealCurrencyPrices, ItemImageUrl and the rest have no place in a record.
+					return Skip(Member);
+				});
+		}
+
+		bool ParseDropTable(EStoreJsonToken Token, FDropTableInfo& Out)
+		{
+			return ParseObject(Token, [this, &Out](const FString& Key, EStoreJsonToken Member)
+				{
+					if (Is(Key, TEXT("TableId")))
+					{
+						return ParseString(Member, Out.TableId);
+					}
+					if (Is(Key, TEXT("Nodes")))
+					{
+						return ParseArray(Member, [this, &Out](EStoreJsonToken Element)
+							{
+								FDropTableNode& Node = Out.Nodes.AddDefaulted_GetRef();
+								return ParseObject(Element, [this, &Node](const FString& Field, EStoreJsonToken Value)
+									{
+										if (Is(Field, TEXT("ResultItemType"))) { return ParseString(Value, Node.ResultItemType); }
+										if (Is(Field, TEXT("ResultItem")))     { return ParseString(Value, Node.ResultItem); }
+										if (Is(Field, TEXT("Weight")))         { return ParseInt(Value, Node.Weight); }
+										return Skip(Value);
+									});
+							});
+					}
+					return Skip(Member);
+				});
+		}
+
+		FStoreJsonReader& Reader;
+		FString Error;
+	};
+
+	bool ImportRecordsFromJson(const FString& FilePath, TArray<FStoreItemRecord>& OutRecords, TArray<FDropTableInfo>& OutDropTables)
+	{
+		PFSTORE_SCOPE(JsonParse);
+
+		OutRecords.Reset();
+		OutDropTables.Reset();
+
+		TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*FilePath));
+		if (!File)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open %s"), *FilePath);
+			return false;
+		}
+
+		FStoreJsonReader Reader(*File);
+		FCatalogJsonParser Parser(Reader);
+		if (!Parser.ParseDocument(OutRecords, OutDropTables))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to parse %s: %s"), *FilePath, *Parser.GetError());
+			OutRecords.Reset();
+			OutDropTables.Reset();
+			return false;
+		}
+
+		PFStoreStats::AddItemsProcessed(OutRecords.Num());
+		return true;
+	}
+
+	bool ImportRecordsFromFile(const FString& FilePath, TArray<FStoreItemRecord>& OutRecords, TArray<FDropTableInfo>* OutDropTables)
+	{
+		if (FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+		{
+			TArray<FDropTableInfo> DropTables;
+			if (!ImportRecordsFromJson(FilePath, OutRecords, DropTables))
+			{
+				return false;
+			}
+			if (OutDropTables)
+			{
+				*OutDropTables = MoveTemp(DropTables);
+			}
+			return true;
+		}
+		if (!ImportRecordsFromCsv(FilePath, OutRecords))
+		{
+			return false;
+		}
+		const FString DropTablesPath = GetDropTablesCsvPath(FilePath);
+		if (OutDropTables && FPaths::FileExists(DropTablesPath))
+		{
+			return ImportDropTablesFromCsv(DropTablesPath, *OutDropTables);
+		}
+		return true;
+	}
+
+	bool ImportItemsFromCsv(const FString& FilePath, TArray<PlayFab::AdminModels::FCatalogItem>& OutItems)
+	{
+		OutItems.Empty();
+
+		TArray<FStoreItemRecord> Records;
+		if (!ImportRecordsFromCsv(FilePath, Records))
+		{
+			return false;
+		}
+
+		OutItems.Reserve(Records.Num());
+		for (const FStoreItemRecord& Record : Records)
+		{
+			OutItems.Add(ToPlayFabCatalogItem(Record, TEXT("Main")));
+		}
+
+		return true;
+	}
+
+	bool ImportDropTablesFromCsv(const FString& FilePath, TArray<PlayFab::AdminModels::FRandomResultTable>& OutItems)
+	{
+		OutItems.Empty();
+
+		TArray<FDropTableInfo> Tables;
+		if (!ImportDropTablesFromCsv(FilePath, Tables))
+		{
+			return false;
+		}
+
+		OutItems.Reserve(Tables.Num());
+		for (const FDropTableInfo& Table : Tables)
+		{
+			OutItems.Add(ToPlayFabRandomResultTable(Table));
+		}
+
+		return true;
+	}
+
+	int32 ValidateRecords(const TArray<FStoreItemRecord>& Records, TArray<FString>& OutErrors, TArray<FString>& OutWarnings)
+	{
+		PFSTORE_SCOPE(Validate);
+
+		const int32 ErrorsBefore = OutErrors.Num();
+
+		TSet<FString> KnownIds;
+		KnownIds.Reserve(Records.Num());
+		for (const FStoreItemRecord& Record : Records)
+		{
+			bool bAlreadyKnown = false;
+			KnownIds.Add(Record.ItemId, &bAlreadyKnown);
+			if (bAlreadyKnown && !Record.ItemId.IsEmpty())
+			{
+				OutErrors.Add(FString::Printf(TEXT("%s: duplicate ItemId"), *Record.ItemId));
+			}
+		}
+
+		struct FIssues
+		{
+			TArray<FString> Errors;
+			TArray<FString> Warnings;
+		};
+		TArray<FIssues> Issues;
+		Issues.SetNum(Records.Num());
+
+		ParallelFor(TEXT("PFStore.Validate"), Records.Num(), 64, [&Records, &KnownIds, &Issues](int32 Index)
+			{
+				const FStoreItemRecord& Record = Records[Index];
+				FIssues& Out = Issues[Index];
+
+				if (Record.ItemId.IsEmpty())
+				{
+					Out.Errors.Add(FString::Printf(TEXT("Item #%d: empty ItemId"), Index));
+					return;
+				}
+
+				const TCHAR* ItemId = *Record.ItemId;
+
+				auto CheckAmounts = [&Out, ItemId](const FCurrencyAmounts& Amounts, const TCHAR* What)
+					{
+						for (const FCurrencyAmount& Amount : Amounts)
+						{
+							if (Amount.Amount < 0)
+							{
+								Out.Errors.Add(FString::Printf(TEXT("%s: negative %s %s:%d"), ItemId, What, *Amount.Code.ToString(), Amount.Amount));
+							}
+						}
+					};
+
+				auto CheckItems = [&Out, &KnownIds, ItemId](const TArray<FString>& Ids, const TCHAR* What)
+					{
+						for (const FString& Id : Ids)
+						{
+							if (!KnownIds.Contains(Id))
+							{
+								Out.Errors.Add(FString::Printf(TEXT("%s: %s references unknown item %s"), ItemId, What, *Id));
+							}
+						}
+					};
+
+				if (Record.DisplayName.IsEmpty())
+				{
+					Out.Warnings.Add(FString::Printf(TEXT("%s: empty DisplayName"), ItemId));
+				}
+
+				CheckAmounts(Record.Prices, TEXT("price"));
+
+				if (Record.Consumable.UsageCount < 0 || Record.Consumable.UsagePeriod < 0)
+				{
+					Out.Errors.Add(FString::Printf(TEXT("%s: negative consumable usage"), ItemId));
+				}
+				if (!Record.Consumable.UsagePeriodGroup.IsEmpty() && Record.Consumable.UsagePeriod <= 0)
+				{
+					Out.Warnings.Add(FString::Printf(TEXT("%s: UsagePeriodGroup without UsagePeriod"), ItemId));
+				}
+
+				if (Record.bIsBundle)
+				{
+					CheckItems(Record.Bundle.BundledItems, TEXT("bundle"));
+					CheckAmounts(Record.Bundle.BundledVirtualCurrencies, TEXT("bundled currency"));
+				}
+
+				if (Record.bIsContainer)
+				{
+					if (!Record.Container.KeyItemId.IsEmpty() && !KnownIds.Contains(Record.Container.KeyItemId))
+					{
+						Out.Errors.Add(FString::Printf(TEXT("%s: container key references unknown item %s"), ItemId, *Record.Container.KeyItemId));
+					}
+					CheckItems(Record.Container.ItemContents, TEXT("container"));
+					CheckAmounts(Record.Container.VirtualCurrencyContents, TEXT("container currency"));
+				}
+			});
+
+		for (FIssues& Issue : Issues)
+		{
+			OutErrors.Append(MoveTemp(Issue.Errors));
+			OutWarnings.Append(MoveTemp(Issue.Warnings));
+		}
+
+		return OutErrors.Num() - ErrorsBefore;
+	}
+
+	static bool SameString(const FString& A, const FString& B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static bool SameStrings(const TArray<FString>& A, const TArray<FString>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (!SameString(A[Index], B[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename ValueType>
+	static bool SameValue(const ValueType& A, const ValueType& B)
+	{
+		return A == B;
+	}
+
+	static bool SameValue(const FString& A, const FString& B)
+	{
+		return SameString(A, B);
+	}
+
+	static bool SameValue(const TArray<FString>& A, const TArray<FString>& B)
+	{
+		return SameStrings(A, B);
+	}
+
+	template<typename ValueType>
+	static FString FormatValue(const ValueType& Value)
+	{
+		return LexToString(Value);
+	}
+
+	static FString FormatValue(const FString& Value)
+	{
+		return Value;
+	}
+
+	static FString FormatValue(const TArray<FString>& Value)
+	{
+		return FString::Join(Value, TEXT(", "));
+	}
+
+	static FString FormatValue(const FCurrencyAmounts& Value)
+	{
+		return Value.ToString();
+	}
+
+	/** One comparable, copyable field of a record, the unit of diffs and merges. */
+	struct FRecordField
+	{
+		FName Name;
+		FName JsonKey;
+		bool (*Equal)(const FStoreItemRecord& A, const FStoreItemRecord& B);
+		void (*Copy)(const FStoreItemRecord& From, FStoreItemRecord& To);
+		FString (*Format)(const FStoreItemRecord& Record);
+	};
+
+#define PFSTORE_RECORD_FIELD(Name, JsonKey, Member) \
+	FRecordField{ TEXT(Name), TEXT(JsonKey), \
+		[](const FStoreItemRecord& A, const FStoreItemRecord& B) { return SameValue(A.Member, B.Member); }, \
+		[](const FStoreItemRecord& From, FStoreItemRecord& To) { To.Member = From.Member; }, \
+		[](const FStoreItemRecord& Record) { return FormatValue(Record.Member); } }
+
+	/** Built on first use so the FNames are made once, not per compared item. */
+	static TConstArrayView<FRecordField> GetRecordFields()
+	{
+		static const FRecordField Fields[] =
+		{
+			PFSTORE_RECORD_FIELD("DisplayName", "DisplayName", DisplayName),
+			PFSTORE_RECORD_FIELD("ItemClass", "ItemClass", ItemClass),
+			PFSTORE_RECORD_FIELD("Description", "Description", Description),
+			PFSTORE_RECORD_FIELD("CustomData", "CustomData", CustomData),
+			PFSTORE_RECORD_FIELD("Tags", "Tags", Tags),
+			PFSTORE_RECORD_FIELD("VirtualCurrencyPrices", "VirtualCurrencyPrices", Prices),
+
+			PFSTORE_RECORD_FIELD("IsLimitedEdition", "IsLimitedEdition", bIsLimitedEdition),
+			PFSTORE_RECORD_FIELD("IsTokenForCharacterCreation", "CanBecomeCharacter", bIsTokenForCharacterCreation),
+			PFSTORE_RECORD_FIELD("IsTradable", "IsTradable", bIsTradable),
+			PFSTORE_RECORD_FIELD("IsStackable", "IsStackable", bIsStackable),
+
+			PFSTORE_RECORD_FIELD("UsageCount", "Consumable", Consumable.UsageCount),
+			PFSTORE_RECORD_FIELD("UsagePeriod", "Consumable", Consumable.UsagePeriod),
+			PFSTORE_RECORD_FIELD("UsagePeriodGroup", "Consumable", Consumable.UsagePeriodGroup),
+
+			// Records keep default bundle/container info when the item is neither, so contents compare directly.
+			PFSTORE_RECORD_FIELD("IsBundle", "Bundle", bIsBundle),
+			PFSTORE_RECORD_FIELD("BundledItems", "Bundle", Bundle.BundledItems),
+			PFSTORE_RECORD_FIELD("BundledResultTables", "Bundle", Bundle.BundledResultTables),
+			PFSTORE_RECORD_FIELD("BundledVirtualCurrencies", "Bundle", Bundle.BundledVirtualCurrencies),
+
+			PFSTORE_RECORD_FIELD("IsContainer", "Container", bIsContainer),
+			PFSTORE_RECORD_FIELD("KeyItemId", "Container", Container.KeyItemId),
+			PFSTORE_RECORD_FIELD("ItemContents", "Container", Container.ItemContents),
+			PFSTORE_RECORD_FIELD("ResultTableContents", "Container", Container.ResultTableContents),
+			PFSTORE_RECORD_FIELD("VirtualCurrencyContents", "Container", Container.VirtualCurrencyContents),
+		};
+		return Fields;
+	}
+
+#undef PFSTORE_RECORD_FIELD
+
+	void DiffFields(const FStoreItemRecord& A, const FStoreItemRecord& B, TArray<FName>& OutFields)
+	{
+		for (const FRecordField& Field : GetRecordFields())
+		{
+			if (!Field.Equal(A, B))
+			{
+				OutFields.Add(Field.Name);
+			}
+		}
+	}
+
+	static const FRecordField* FindRecordField(FName Name)
+	{
+		for (const FRecordField& Field : GetRecordFields())
+		{
+			if (Field.Name == Name)
+			{
+				return &Field;
+			}
+		}
+		return nullptr;
+	}
+
+	void CopyFields(const FStoreItemRecord& From, FStoreItemRecord& To, TConstArrayView<FName> Fields)
+	{
+		for (const FName Name : Fields)
+		{
+			if (const FRecordField* Field = FindRecordField(Name))
+			{
+				Field->Copy(From, To);
+			}
+		}
+	}
+
+	FString FormatField(const FStoreItemRecord& Record, FName Field)
+	{
+		const FRecordField* Found = FindRecordField(Field);
+		return Found ? Found->Format(Record) : FString();
+	}
+
+	FName GetCatalogJsonKey(FName Field)
+	{
+		const FRecordField* Found = FindRecordField(Field);
+		return Found ? Found->JsonKey : NAME_None;
+	}
+
+	void DiffRecords(const TArray<FStoreItemRecord>& Local, const TArray<FStoreItemRecord>& Remote, FStoreCatalogDiff& OutDiff)
+	{
+		PFSTORE_SCOPE(Diff);
+
+		OutDiff = FStoreCatalogDiff();
+
+		TMap<FString, int32> RemoteById;
+		RemoteById.Reserve(Remote.Num());
+		for (int32 Index = 0; Index < Remote.Num(); ++Index)
+		{
+			RemoteById.Add(Remote[Index].ItemId, Index);
+		}
+
+		TArray<int32> Matches;
+		Matches.Init(INDEX_NONE, Local.Num());
+		TBitArray<> bRemoteMatched(false, Remote.Num());
+		for (int32 Index = 0; Index < Local.Num(); ++Index)
+		{
+			if (const int32* RemoteIndex = RemoteById.Find(Local[Index].ItemId))
+			{
+				Matches[Index] = *RemoteIndex;
+				bRemoteMatched[*RemoteIndex] = true;
+			}
+			else
+			{
+				OutDiff.Added.Add(Local[Index].ItemId);
+			}
+		}
+
+		for (int32 Index = 0; Index < Remote.Num(); ++Index)
+		{
+			if (!bRemoteMatched[Index])
+			{
+				OutDiff.Removed.Add(Remote[Index].ItemId);
+			}
+		}
+
+		TArray<FStoreItemChange> Changes;
+		Changes.SetNum(Local.Num());
+		ParallelFor(TEXT("PFStore.Diff"), Local.Num(), 64, [&Local, &Remote, &Matches, &Changes](int32 Index)
+			{
+				if (Matches[Index] != INDEX_NONE)
+				{
+					DiffFields(Local[Index], Remote[Matches[Index]], Changes[Index].Fields);
+				}
+			});
+
+		for (int32 Index = 0; Index < Local.Num(); ++Index)
+		{
+			if (Changes[Index].Fields.Num() > 0)
+			{
+				Changes[Index].ItemId = Local[Index].ItemId;
+				OutDiff.Changed.Add(MoveTemp(Changes[Index]));
+			}
+		}
+
+		OutDiff.Added.Sort();
+		OutDiff.Removed.Sort();
+		OutDiff.Changed.Sort([](const FStoreItemChange& A, const FStoreItemChange& B) { return A.ItemId < B.ItemId; });
+	}
+
+	void MergeRecords(
+		const TArray<FStoreItemRecord>* BaseItems,
+		const TArray<FStoreItemRecord>& Local,
+		const TArray<FStoreItemRecord>& Remote,
+		FStoreMergeResult& OutResult)
+	{
+		PFSTORE_SCOPE(Merge);
+
+		OutResult = FStoreMergeResult();
+		const bool bHasBase = BaseItems != nullptr;
+		const TArray<FStoreItemRecord> NoBase;
+		const TArray<FStoreItemRecord>& Base = bHasBase ? *BaseItems : NoBase;
+
+		TMap<FString, int32> BaseById;
+		BaseById.Reserve(Base.Num());
+		for (int32 Index = 0; Index < Base.Num(); ++Index)
+		{
+			BaseById.Add(Base[Index].ItemId, Index);
+		}
+		TMap<FString, int32> RemoteById;
+		RemoteById.Reserve(Remote.Num());
+		for (int32 Index = 0; Index < Remote.Num(); ++Index)
+		{
+			RemoteById.Add(Remote[Index].ItemId, Index);
+		}
+
+		// Pair every item with its base and remote version; remote items never seen locally follow.
+		struct FTriple
+		{
+			int32 Base = INDEX_NONE;
+			int32 Local = INDEX_NONE;
+			int32 Remote = INDEX_NONE;
+		};
+		TArray<FTriple> Triples;
+		Triples.Reserve(Local.Num() + Remote.Num());
+		TBitArray<> bRemoteMatched(false, Remote.Num());
+		for (int32 Index = 0; Index < Local.Num(); ++Index)
+		{
+			FTriple& Triple = Triples.AddDefaulted_GetRef();
+			Triple.Local = Index;
+			if (const int32* BaseIndex = BaseById.Find(Local[Index].ItemId))
+			{
+				Triple.Base = *BaseIndex;
+			}
+			if (const int32* RemoteIndex = RemoteById.Find(Local[Index].ItemId))
+			{
+				Triple.Remote = *RemoteIndex;
+				bRemoteMatched[*RemoteIndex] = true;
+			}
+		}
+		for (int32 Index = 0; Index < Remote.Num(); ++Index)
+		{
+			if (!bRemoteMatched[Index])
+			{
+				FTriple& Triple = Triples.AddDefaulted_GetRef();
+				Triple.Remote = Index;
+				if (const int32* BaseIndex = BaseById.Find(Remote[Index].ItemId))
+				{
+					Triple.Base = *BaseIndex;
+				}
+			}
+		}
+
+		struct FOutcome
+		{
+			bool bKeep = false;
+			int32 FromLocal = 0;
+			int32 FromRemote = 0;
+			FStoreItemRecord Merged;
+			FStoreItemConflict Conflict;
+		};
+		TArray<FOutcome> Outcomes;
+		Outcomes.SetNum(Triples.Num());
+
+		TConstArrayView<FRecordField> Fields = GetRecordFields();
+		ParallelFor(TEXT("PFStore.Merge"), Triples.Num(), 64, [&](int32 Index)
+			{
+				const FTriple& Triple = Triples[Index];
+				FOutcome& Out = Outcomes[Index];
+				const FStoreItemRecord* B = Triple.Base != INDEX_NONE ? &Base[Triple.Base] : nullptr;
+				const FStoreItemRecord* L = Triple.Local != INDEX_NONE ? &Local[Triple.Local] : nullptr;
+				const FStoreItemRecord* R = Triple.Remote != INDEX_NONE ? &Remote[Triple.Remote] : nullptr;
+
+				auto SameRecord = [&Fields](const FStoreItemRecord& X, const FStoreItemRecord& Y)
+					{
+						for (const FRecordField& Field : Fields)
+						{
+							if (!Field.Equal(X, Y))
+							{
+								return false;
+							}
+						}
+						return true;
+					};
+
+				Out.Conflict.LocalIndex = Triple.Local;
+				Out.Conflict.RemoteIndex = Triple.Remote;
+
+				if (!L || !R)
+				{
+					// On one side only: new there, or deleted on the other side.
+					const FStoreItemRecord& Present = L ? *L : *R;
+					if (!bHasBase)
+					{
+						// Never synced: new on this side and deleted on the other look the same.
+						Out.bKeep = true;
+						Out.Merged = Present;
+						Out.Conflict.ItemId = Present.ItemId;
+						Out.Conflict.Kind = L ? EStoreMergeConflict::OnlyInEditor : EStoreMergeConflict::OnlyInPlayFab;
+					}
+					else if (!B)
+					{
+						Out.bKeep = true;
+						Out.Merged = Present;
+						(L ? Out.FromLocal : Out.FromRemote) = 1;
+					}
+					else if (!SameRecord(*B, Present))
+					{
+						// Deleted on one side, edited on the other: keep it until someone decides.
+						Out.bKeep = true;
+						Out.Merged = Present;
+						Out.Conflict.ItemId = Present.ItemId;
+						Out.Conflict.Kind = L ? EStoreMergeConflict::DeletedInPlayFab : EStoreMergeConflict::DeletedInEditor;
+					}
+					else
+					{
+						(L ? Out.FromRemote : Out.FromLocal) = 1;
+					}
+					return;
+				}
+
+				Out.bKeep = true;
+				Out.Merged = *L;
+				for (const FRecordField& Field : Fields)
+				{
+					if (Field.Equal(*L, *R))
+					{
+						continue;
+					}
+					const bool bLocalChanged = !B || !Field.Equal(*B, *L);
+					const bool bRemoteChanged = !B || !Field.Equal(*B, *R);
+					if (bLocalChanged && bRemoteChanged)
+					{
+						Out.Conflict.Fields.Add(Field.Name);
+					}
+					else if (bRemoteChanged)
+					{
+						Field.Copy(*R, Out.Merged);
+						++Out.FromRemote;
+					}
+					else
+					{
+						++Out.FromLocal;
+					}
+				}
+				if (Out.Conflict.Fields.Num() > 0)
+				{
+					Out.Conflict.ItemId = L->ItemId;
+					Out.Conflict.Kind = EStoreMergeConflict::Fields;
+				}
+			});
+
+		OutResult.Merged.Reserve(Outcomes.Num());
+		for (FOutcome& Out : Outcomes)
+		{
+			OutResult.FieldsFromLocal += Out.FromLocal;
+			OutResult.FieldsFromRemote += Out.FromRemote;
+			if (!Out.bKeep)
+			{
+				continue;
+			}
+			if (!Out.Conflict.ItemId.IsEmpty())
+			{
+				Out.Conflict.MergedIndex = OutResult.Merged.Num();
+				OutResult.Conflicts.Add(MoveTemp(Out.Conflict));
+			}
+			OutResult.Merged.Add(MoveTemp(Out.Merged));
+		}
+
+		OutResult.Conflicts.Sort([](const FStoreItemConflict& A, const FStoreItemConflict& B) { return A.ItemId < B.ItemId; });
+	}
+
+	/** Null stands for a table missing on that side. */
+	static bool SameDropTableNodes(const FDropTableInfo* A, const FDropTableInfo* B)
+	{
+		if (!A || !B)
+		{
+			return A == B;
+		}
+		if (A->Nodes.Num() != B->Nodes.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A->Nodes.Num(); ++Index)
+		{
+			const FDropTableNode& X = A->Nodes[Index];
+			const FDropTableNode& Y = B->Nodes[Index];
+			if (X.ResultItemType != Y.ResultItemType || X.ResultItem != Y.ResultItem || X.Weight != Y.Weight)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void MergeDropTables(
+		const TArray<FDropTableInfo>* Base,
+		const TArray<FDropTableInfo>& Local,
+		const TArray<FDropTableInfo>& Remote,
+		TArray<FDropTableInfo>& OutMerged,
+		TArray<FString>& OutConflicts)
+	{
+		TMap<FString, const FDropTableInfo*> BaseById;
+		if (Base)
+		{
+			for (const FDropTableInfo& Table : *Base)
+			{
+				BaseById.Add(Table.TableId, &Table);
+			}
+		}
+		TMap<FString, const FDropTableInfo*> RemoteById;
+		for (const FDropTableInfo& Table : Remote)
+		{
+			RemoteById.Add(Table.TableId, &Table);
+		}
+
+		OutMerged.Reset();
+		OutConflicts.Reset();
+
+		// Tables are small and merged whole: a side wins when only it changed since the base.
+		const bool bHasBase = Base != nullptr;
+		auto MergeOne = [&](const FString& TableId, const FDropTableInfo* L, const FDropTableInfo* R)
+			{
+				const FDropTableInfo* const* BasePtr = BaseById.Find(TableId);
+				const FDropTableInfo* B = BasePtr ? *BasePtr : nullptr;
+				const bool bLocalChanged = !SameDropTableNodes(B, L);
+				const bool bRemoteChanged = !SameDropTableNodes(B, R);
+
+				const FDropTableInfo* Winner = bRemoteChanged && !bLocalChanged ? R : L;
+				if ((bLocalChanged && bRemoteChanged && !SameDropTableNodes(L, R)) || (!bHasBase && (!L || !R)))
+				{
+					OutConflicts.Add(TableId);
+					Winner = L ? L : R;
+				}
+				if (Winner)
+				{
+					OutMerged.Add(*Winner);
+				}
+			};
+
+		for (const FDropTableInfo& Table : Local)
+		{
+			const FDropTableInfo* R = nullptr;
+			RemoteById.RemoveAndCopyValue(Table.TableId, R);
+			MergeOne(Table.TableId, &Table, R);
+		}
+		for (const TPair<FString, const FDropTableInfo*>& Pair : RemoteById)
+		{
+			MergeOne(Pair.Key, nullptr, Pair.Value);
+		}
+
+		OutMerged.Sort([](const FDropTableInfo& A, const FDropTableInfo& B) { return A.TableId < B.TableId; });
+		OutConflicts.Sort();
+	}
+
+	bool ApplyRecordsToAssets(
+		TConstArrayView<FStoreItemRecord> Records,
+		TConstArrayView<FDropTableInfo> DropTables,
+		bool bSave,
+		FStoreApplyResult& OutResult,
+		const FText& TransactionName)
+	{
+		OutResult = FStoreApplyResult();
+
+		// Current state of every provider, so only assets that really change are touched.
+		TArray<UObject*> ItemObjects;
+		TArray<FStoreItemRecord> Current;
+		TMap<FString, int32> CurrentById;
+		for (const TWeakObjectPtr<UObject>& Asset : FindAllStoreAssets(UStoreItemProvider::StaticClass()))
+		{
+			FStoreItemRecord Record;
+			if (FStoreItemRecord::FromObject(Asset.Get(), Record))
+			{
+				CurrentById.Add(Record.ItemId, Current.Num());
+				ItemObjects.Add(Asset.Get());
+				Current.Add(MoveTemp(Record));
+			}
+		}
+
+		TArray<int32> Targets;
+		Targets.Init(INDEX_NONE, Records.Num());
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			if (const int32* Found = CurrentById.Find(Records[Index].ItemId))
+			{
+				Targets[Index] = *Found;
+			}
+			else
+			{
+				OutResult.Missing.Add(Records[Index].ItemId);
+			}
+		}
+
+		// One byte per record: workers never share a word, unlike a bit array.
+		TArray<bool> bChanged;
+		bChanged.Init(false, Records.Num());
+		ParallelFor(TEXT("PFStore.ApplyDiff"), Records.Num(), 64, [&](int32 Index)
+			{
+				if (Targets[Index] != INDEX_NONE)
+				{
+					TArray<FName> Fields;
+					DiffFields(Current[Targets[Index]], Records[Index], Fields);
+					bChanged[Index] = Fields.Num() > 0;
+				}
+			});
+
+		TMap<FString, UObject*> TableObjects;
+		TMap<FString, FDropTableInfo> CurrentTables;
+		if (DropTables.Num() > 0)
+		{
+			for (const TWeakObjectPtr<UObject>& Asset : FindAllStoreAssets(UStoreDropTableProvider::StaticClass()))
+			{
+				if (const IStoreDropTableProvider* Provider = Cast<IStoreDropTableProvider>(Asset.Get()))
+				{
+					FDropTableInfo Table = Provider->GetDropTable();
+					TableObjects.Add(Table.TableId, Asset.Get());
+					CurrentTables.Add(Table.TableId, MoveTemp(Table));
+				}
+			}
+		}
+
+		// One transaction for the whole batch, each package dirtied once at the end.
+		TSet<UPackage*> Packages;
+		{
+			const FText Name = TransactionName.IsEmpty() ? NSLOCTEXT("PFStoreEditor", "ApplyMergedCatalog", "Apply Merged Catalog") : TransactionName;
+			FScopedTransaction Transaction(Name);
+
+			for (int32 Index = 0; Index < Records.Num(); ++Index)
+			{
+				if (Targets[Index] == INDEX_NONE)
+				{
+					continue;
+				}
+				if (!bChanged[Index])
+				{
+					++OutResult.Unchanged;
+					continue;
+				}
+
+				UObject* Object = ItemObjects[Targets[Index]];
+				IStoreItemProvider* Provider = Cast<IStoreItemProvider>(Object);
+				Object->Modify(false);
+				if (Provider && Provider->ApplyStoreItemRecord(Records[Index]))
+				{
+					Packages.Add(Object->GetOutermost());
+					++OutResult.Changed;
+					continue;
+				}
+
+				// A provider may write some fields and drop the rest; what it wrote still needs saving.
+				FStoreItemRecord Written;
+				TArray<FName> WrittenFields;
+				if (Provider && FStoreItemRecord::FromObject(Object, Written))
+				{
+					DiffFields(Current[Targets[Index]], Written, WrittenFields);
+				}
+				if (WrittenFields.Num() > 0)
+				{
+					Packages.Add(Object->GetOutermost());
+					++OutResult.Changed;
+					OutResult.Incomplete.Add(Records[Index].ItemId);
+				}
+				else
+				{
+					OutResult.ReadOnly.Add(Records[Index].ItemId);
+				}
+			}
+
+			for (const FDropTableInfo& Table : DropTables)
+			{
+				UObject** Object = TableObjects.Find(Table.TableId);
+				if (!Object)
+				{
+					OutResult.Missing.Add(Table.TableId);
+					continue;
+				}
+
+				if (SameDropTableNodes(&CurrentTables.FindChecked(Table.TableId), &Table))
+				{
+					++OutResult.Unchanged;
+					continue;
+				}
+
+				IStoreDropTableProvider* Provider = Cast<IStoreDropTableProvider>(*Object);
+				(*Object)->Modify(false);
+				if (Provider && Provider->ApplyDropTable(Table))
+				{
+					Packages.Add((*Object)->GetOutermost());
+					++OutResult.Changed;
+				}
+				else
+				{
+					OutResult.ReadOnly.Add(Table.TableId);
+				}
+			}
+
+			if (Packages.Num() == 0)
+			{
+				Transaction.Cancel();
+			}
+		}
+
+		for (UPackage* Package : Packages)
+		{
+			Package->MarkPackageDirty();
+		}
+
+		if (bSave && Packages.Num() > 0)
+		{
+			OutResult.PackagesSaved = SavePackagesBatched(Packages.Array(), OutResult.bCancelled);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("%s: %d changed (%d in part), %d unchanged, %d missing, %d read-only, %d packages saved%s"),
+			TransactionName.IsEmpty() ? TEXT("Applied merged catalog") : *TransactionName.ToString(),
+			OutResult.Changed, OutResult.Incomplete.Num(), OutResult.Unchanged, OutResult.Missing.Num(), OutResult.ReadOnly.Num(), OutResult.PackagesSaved,
+			OutResult.bCancelled ? TEXT(" (cancelled)") : TEXT(""));
+		return OutResult.ReadOnly.Num() == 0 && OutResult.Incomplete.Num() == 0 && !OutResult.bCancelled;
+	}
+
+	int32 SavePackagesBatched(const TArray<UPackage*>& Packages, bool& bOutCancelled)
+	{
+		// Big enough to amortize the per-call checkout and bookkeeping, small enough to cancel promptly.
+		constexpr int32 BatchSize = 64;
+
+		bOutCancelled = false;
+		int32 Saved = 0;
+
+		FScopedSlowTask SlowTask(static_cast<float>(Packages.Num()), NSLOCTEXT("PFStoreEditor", "SavingStoreAssets", "Saving store assets..."));
+		SlowTask.MakeDialog(true);
+
+		for (int32 Start = 0; Start < Packages.Num(); Start += BatchSize)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				bOutCancelled = true;
+				break;
+			}
+
+			const int32 Count = FMath::Min(BatchSize, Packages.Num() - Start);
+			SlowTask.EnterProgressFrame(static_cast<float>(Count), FText::Format(
+				NSLOCTEXT("PFStoreEditor", "SavingStoreAssetsProgress", "Saving store assets ({0} / {1})"),
+				FText::AsNumber(Start + Count), FText::AsNumber(Packages.Num())));
+
+			TArray<UPackage*> Batch(Packages.GetData() + Start, Count);
+			if (UEditorLoadingAndSavingUtils::SavePackages(Batch, true))
+			{
+				Saved += Count;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Failed to save some store assets in batch starting at %d"), Start);
+			}
+		}
+		return Saved;
+	}
+
+	void UploadCatalogItems(const TArray<PlayFab::AdminModels::FCatalogItem>& Items, const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const FString& Error)> OnComplete)
+	{
+		PlayFabAdminPtr AdminAPI = IPlayFabModuleInterface::Get().GetAdminAPI();
+
+		PlayFab::AdminModels::FUpdateCatalogItemsRequest Request;
+		Request.Catalog = Items;
+		Request.CatalogVersion = CatalogVersion;
+
+		// The SDK serializes the request itself; only pay for a second copy when someone is tracing.
+		int64 RequestBytes = 0;
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(PFStoreChannel))
+		{
+			PFSTORE_SCOPE(JsonSerialize);
+			RequestBytes = Request.toJSONString().Len();
+		}
+		PFStoreStats::AddItemsProcessed(Items.Num());
+		PFStoreStats::BeginPlayFabRequest(TEXT("PlayFab UpdateCatalogItems"), RequestBytes);
+
+		PlayFab::FPlayFabErrorDelegate OnError;
+		OnError.BindLambda([OnComplete](const PlayFab::FPlayFabCppError& Error)
+			{
+				PFStoreStats::EndPlayFabRequest(TEXT("PlayFab UpdateCatalogItems"), 0);
+				OnComplete(false, Error.ErrorMessage);
+			});
+
+		PlayFab::UPlayFabAdminAPI::FUpdateCatalogItemsDelegate OnSuccess;
+		OnSuccess.BindLambda([OnComplete](const PlayFab::AdminModels::FUpdateCatalogItemsResult& Result)
+			{
+				PFStoreStats::EndPlayFabRequest(TEXT("PlayFab UpdateCatalogItems"), 0);
+				OnComplete(true, FString());
+			});
+
+		PFSTORE_SCOPE(PlayFabRequest);
+		AdminAPI->UpdateCatalogItems(Request, OnSuccess, OnError);
+	}
+
+	void FetchCatalogItems(const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const TArray<PlayFab::AdminModels::FCatalogItem>& Items, const FString& Error)> OnComplete)
+	{
+		PlayFabAdminPtr AdminAPI = IPlayFabModuleInterface::Get().GetAdminAPI();
+
+		PlayFab::AdminModels::FGetCatalogItemsRequest Request;
+		Request.CatalogVersion = CatalogVersion;
+
+		const int64 RequestBytes = UE_TRACE_CHANNELEXPR_IS_ENABLED(PFStoreChannel) ? Request.toJSONString().Len() : 0;
+		PFStoreStats::BeginPlayFabRequest(TEXT("PlayFab GetCatalogItems"), RequestBytes);
+
+		PlayFab::FPlayFabErrorDelegate OnError;
+		OnError.BindLambda([OnComplete](const PlayFab::FPlayFabCppError& Error)
+			{
+				PFStoreStats::EndPlayFabRequest(TEXT("PlayFab GetCatalogItems"), 0);
+				OnComplete(false, TArray<PlayFab::AdminModels::FCatalogItem>(), Error.ErrorMessage);
+			});
+
+		PlayFab::UPlayFabAdminAPI::FGetCatalogItemsDelegate OnSuccess;
+		OnSuccess.BindLambda([OnComplete](const PlayFab::AdminModels::FGetCatalogItemsResult& Result)
+			{
+				PFStoreStats::EndPlayFabRequest(TEXT("PlayFab GetCatalogItems"), 0);
+				PFSTORE_SCOPE(PlayFabResponse);
+				PFStoreStats::AddItemsProcessed(Result.Catalog.Num());
+				OnComplete(true, Result.Catalog, FString());
+			});
+
+		PFSTORE_SCOPE(PlayFabRequest);
+		AdminAPI->GetCatalogItems(Request, OnSuccess, OnError);
+	}
+
+	void WriteUpdateCatalogItemsBody(TConstArrayView<FStoreItemRecord> Records, const FString& CatalogVersion, TArray<uint8>& OutBody)
+	{
+		PFSTORE_SCOPE(JsonSerialize);
+
+		OutBody.Reset();
+		FStoreJsonWriter Writer(OutBody);
+		Writer.WriteObjectStart();
+		Writer.WriteValue("CatalogVersion", CatalogVersion);
+		Writer.WriteArrayStart("Catalog");
+		WriteCatalogItemsJson(Writer, Records, CatalogVersion);
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	/** Pulls errorMessage (or error) out of a PlayFab response envelope without building a DOM. */
+	static FString ReadPlayFabError(TConstArrayView<uint8> Content)
+	{
+		FString ErrorName;
+		FString ErrorMessage;
+
+		FStoreJsonReader Reader(Content);
+		if (Reader.Next() == EStoreJsonToken::ObjectStart)
+		{
+			for (EStoreJsonToken Token = Reader.Next(); Token != EStoreJsonToken::ObjectEnd; Token = Reader.Next())
+			{
+				if (Token == EStoreJsonToken::String && Reader.GetIdentifier().Equals(TEXT("error"), ESearchCase::CaseSensitive))
+				{
+					ErrorName = Reader.GetString();
+				}
+				else if (Token == EStoreJsonToken::String && Reader.GetIdentifier().Equals(TEXT("errorMessage"), ESearchCase::CaseSensitive))
+				{
+					ErrorMessage = Reader.GetString();
+				}
+				else if (!Reader.SkipValue(Token))
+				{
+					break;
+				}
+			}
+		}
+
+		return ErrorMessage.IsEmpty() ? ErrorName : ErrorMessage;
+	}
+
+	const TCHAR* CompressRequestBody(FName Format, TArray<uint8>& InOutBody)
+	{
+		// Below this the headers outweigh what compression saves.
+		static constexpr int32 MinCompressBytes = 1024;
+
+		const TCHAR* Encoding = Format == NAME_Gzip ? TEXT("gzip") : Format == NAME_Zlib ? TEXT("deflate") : nullptr;
+		if (!Encoding || InOutBody.Num() < MinCompressBytes)
+		{
+			return nullptr;
+		}
+
+		TArray<uint8> Compressed;
+		int32 CompressedSize = FCompression::GetMaximumCompressedSize(Format, InOutBody.Num());
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (!FCompression::CompressMemory(Format, Compressed.GetData(), CompressedSize, InOutBody.GetData(), InOutBody.Num())
+			|| CompressedSize >= InOutBody.Num())
+		{
+			return nullptr;
+		}
+
+		Compressed.SetNum(CompressedSize, EAllowShrinking::No);
+		InOutBody = MoveTemp(Compressed);
+		return Encoding;
+	}
+
+	void SendAdminRequest(const TCHAR* Api, TArray<uint8>&& Body,
+		TFunction<void(bool bSuccess, const FString& Error, FHttpResponsePtr Response)> OnComplete)
+	{
+		SendAdminRequest(FPFAdminEndpoint(), Api, MoveTemp(Body), MoveTemp(OnComplete));
+	}
+
+	void SendAdminRequest(const FPFAdminEndpoint& Endpoint, const TCHAR* Api, TArray<uint8>&& Body,
+		TFunction<void(bool bSuccess, const FString& Error, FHttpResponsePtr Response)> OnComplete, const TCHAR* ContentEncoding)
+	{
+		IPlayFabCommonModuleInterface& PlayFabCommon = IPlayFabCommonModuleInterface::Get();
+		const FString SecretKey = Endpoint.SecretKey.IsEmpty() ? PlayFabCommon.GetDeveloperSecretKey() : Endpoint.SecretKey;
+		if (SecretKey.IsEmpty())
+		{
+			OnComplete(false, TEXT("PlayFab developer secret key is not set"), nullptr);
+			return;
+		}
+
+		const FString TraceName = FString::Printf(TEXT("PlayFab %s"), Api);
+		PFStoreStats::BeginPlayFabRequest(*TraceName, Body.Num());
+
+		// The plugin only knows the title it is set up for; any other title gets its URL built here.
+		const FString Url = Endpoint.TitleId.IsEmpty()
+			? PlayFabCommon.GetUrl(FString::Printf(TEXT("/Admin/%s"), Api))
+			: FString::Printf(TEXT("https://%s.playfabapi.com/Admin/%s"), *Endpoint.TitleId, Api);
+
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+		Request->SetURL(Url);
+		Request->SetVerb(TEXT("POST"));
+		Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+		Request->SetHeader(TEXT("X-SecretKey"), SecretKey);
+		if (ContentEncoding)
+		{
+			Request->SetHeader(TEXT("Content-Encoding"), ContentEncoding);
+		}
+		Request->SetContent(MoveTemp(Body));
+
+		Request->OnProcessRequestComplete().BindLambda([OnComplete, TraceName](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnected)
+			{
+				PFStoreStats::EndPlayFabRequest(*TraceName, Response.IsValid() ? Response->GetContent().Num() : 0);
+
+				if (!bConnected || !Response.IsValid())
+				{
+					OnComplete(false, TEXT("Could not reach PlayFab"), nullptr);
+				}
+				else if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+				{
+					const FString Error = ReadPlayFabError(Response->GetContent());
+					OnComplete(false, Error.IsEmpty() ? FString::Printf(TEXT("HTTP %d"), Response->GetResponseCode()) : Error, Response);
+				}
+				else
+				{
+					OnComplete(true, FString(), Response);
+				}
+			});
+
+		PFSTORE_SCOPE(PlayFabRequest);
+		Request->ProcessRequest();
+	}
+
+	void UploadRecords(TConstArrayView<FStoreItemRecord> Records, const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const FString& Error)> OnComplete)
+	{
+		PFStoreStats::AddItemsProcessed(Records.Num());
+
+		TArray<uint8> Body;
+		WriteUpdateCatalogItemsBody(Records, CatalogVersion, Body);
+		SendAdminRequest(TEXT("UpdateCatalogItems"), MoveTemp(Body), [OnComplete = MoveTemp(OnComplete)](bool bSuccess, const FString& Error, FHttpResponsePtr)
+			{
+				OnComplete(bSuccess, Error);
+			});
+	}
+
+	void WriteUpdateRandomResultTablesBody(TConstArrayView<FDropTableInfo> DropTables, const FString& CatalogVersion, TArray<uint8>& OutBody)
+	{
+		PFSTORE_SCOPE(JsonSerialize);
+
+		OutBody.Reset();
+		FStoreJsonWriter Writer(OutBody);
+		Writer.WriteObjectStart();
+		Writer.WriteValue("CatalogVersion", CatalogVersion);
+		Writer.WriteArrayStart("Tables");
+		for (const FDropTableInfo& Table : DropTables)
+		{
+			WriteDropTableJson(Writer, Table);
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	void UploadDropTables(TConstArrayView<FDropTableInfo> DropTables, const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const FString& Error)> OnComplete)
+	{
+		PFStoreStats::AddItemsProcessed(DropTables.Num());
+
+		TArray<uint8> Body;
+		WriteUpdateRandomResultTablesBody(DropTables, CatalogVersion, Body);
+		SendAdminRequest(TEXT("UpdateRandomResultTables"), MoveTemp(Body), [OnComplete = MoveTemp(OnComplete)](bool bSuccess, const FString& Error, FHttpResponsePtr)
+			{
+				OnComplete(bSuccess, Error);
+			});
+	}
+
+	/** CityHash64 of Value as serialized; the buffer is kept per thread, so hashing in bulk does not allocate. */
+	template<typename ValueType>
+	static uint64 HashSerialized(const ValueType& Value)
+	{
+		static thread_local TArray<uint8> Bytes;
+		Bytes.Reset();
+		FMemoryWriter Writer(Bytes);
+		Writer << const_cast<ValueType&>(Value);
+		return CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+	}
+
+	uint64 HashRecord(const FStoreItemRecord& Record)
+	{
+		return HashSerialized(Record);
+	}
+
+	uint64 HashDropTable(const FDropTableInfo& Table)
+	{
+		return HashSerialized(Table);
+	}
+
+	int32 RemoveLanded(const FPFUploadJournal::FLanded& Landed, TArray<FStoreItemRecord>& Records, TArray<FDropTableInfo>& DropTables)
+	{
+		auto HasLanded = [](const TMap<FString, uint64>& Hashes, const FString& Id, TFunctionRef<uint64()> Hash)
+			{
+				const uint64* LandedHash = Hashes.Find(Id);
+				return LandedHash && *LandedHash == Hash();
+			};
+
+		const int32 Num = Records.Num() + DropTables.Num();
+		Records.RemoveAll([&Landed, &HasLanded](const FStoreItemRecord& Record)
+			{
+				return HasLanded(Landed.Items, Record.ItemId, [&Record]() { return HashRecord(Record); });
+			});
+		DropTables.RemoveAll([&Landed, &HasLanded](const FDropTableInfo& Table)
+			{
+				return HasLanded(Landed.DropTables, Table.TableId, [&Table]() { return HashDropTable(Table); });
+			});
+		return Num - Records.Num() - DropTables.Num();
+	}
+
+	bool ReferencesDropTables(const FStoreItemRecord& Record)
+	{
+		return (Record.bIsBundle && Record.Bundle.BundledResultTables.Num() > 0)
+			|| (Record.bIsContainer && Record.Container.ResultTableContents.Num() > 0);
+	}
+
+	void AddPublishTasks(FPFAdminScheduler& Scheduler, TSharedRef<const TArray<FStoreItemRecord>> Records,
+		TSharedRef<const TArray<FDropTableInfo>> DropTables, const FString& CatalogVersion, TSharedPtr<FPFUploadJournal> Journal)
+	{
+		// Items that hand out tables go last, so they need to be a contiguous range. The copy is
+		// only made when there are such items.
+		TSharedRef<const TArray<FStoreItemRecord>> Ordered = Records;
+		int32 NumPlain = Records->Num();
+		if (Records->ContainsByPredicate(ReferencesDropTables))
+		{
+			TSharedRef<TArray<FStoreItemRecord>> Partitioned = MakeShared<TArray<FStoreItemRecord>>();
+			Partitioned->Reserve(Records->Num());
+			for (const FStoreItemRecord& Record : *Records)
+			{
+				if (!ReferencesDropTables(Record))
+				{
+					Partitioned->Add(Record);
+				}
+			}
+			NumPlain = Partitioned->Num();
+			for (const FStoreItemRecord& Record : *Records)
+			{
+				if (ReferencesDropTables(Record))
+				{
+					Partitioned->Add(Record);
+				}
+			}
+			Ordered = Partitioned;
+		}
+
+		// Requests are packed by size, counted from the fields instead of formatted on trial.
+		const int64 CatalogVersionSize = FStoreJsonWriter::GetStringSize(CatalogVersion);
+		const int64 BodyOverhead = GetRequestBodyOverhead(CatalogVersion);
+		const int64 MaxBodyBytes = GetMaxRequestBodyBytes();
+		TArray<int64> ItemSizes;
+		ItemSizes.SetNumUninitialized(Ordered->Num());
+		ParallelFor(Ordered->Num(), [&Ordered, &ItemSizes, CatalogVersionSize](int32 Index)
+			{
+				ItemSizes[Index] = EstimateCatalogItemJsonSize((*Ordered)[Index], CatalogVersionSize);
+			});
+
+		// The journal plans each request with the ids and hashes it carries, so the hashes are
+		// only computed when there is one.
+		TArray<FString> ItemIds;
+		TArray<uint64> ItemHashes;
+		if (Journal.IsValid())
+		{
+			ItemIds.SetNum(Ordered->Num());
+			ItemHashes.SetNum(Ordered->Num());
+			ParallelFor(Ordered->Num(), [&Ordered, &ItemIds, &ItemHashes](int32 Index)
+				{
+					ItemIds[Index] = (*Ordered)[Index].ItemId;
+					ItemHashes[Index] = HashRecord((*Ordered)[Index]);
+				});
+		}
+
+		// Marks the request landed once its task succeeded.
+		auto OnLanded = [&Journal](int32 Request) -> FPFAdminScheduler::FOnTaskComplete
+			{
+				if (!Journal.IsValid())
+				{
+					return nullptr;
+				}
+				return [Journal, Request](bool bSuccess, const FString&)
+					{
+						if (bSuccess)
+						{
+							Journal->MarkLanded(Request);
+						}
+					};
+			};
+
+		auto AddItemChunks = [&Scheduler, &Ordered, &CatalogVersion, &Journal, &ItemIds, &ItemHashes, &ItemSizes, &OnLanded, BodyOverhead, MaxBodyBytes](int32 Start, int32 End, const TArray<FPFAdminScheduler::FTaskId>& DependsOn)
+			{
+				TArray<FPFAdminScheduler::FTaskId> Ids;
+				int32 ChunkStart = Start;
+				for (const int32 ChunkNum : PackRequests(TConstArrayView<int64>(ItemSizes.GetData() + Start, End - Start), BodyOverhead, MaxBodyBytes))
+				{
+					int64 BodySize = BodyOverhead + ChunkNum - 1;
+					for (int32 Index = ChunkStart; Index < ChunkStart + ChunkNum; ++Index)
+					{
+						BodySize += ItemSizes[Index];
+					}
+
+					const int32 Request = Journal.IsValid()
+						? Journal->AddRequest(false, TConstArrayView<FString>(ItemIds.GetData() + ChunkStart, ChunkNum), TConstArrayView<uint64>(ItemHashes.GetData() + ChunkStart, ChunkNum))
+						: INDEX_NONE;
+					Ids.Add(Scheduler.Add(TEXT("UpdateCatalogItems"), [Ordered, ChunkStart, ChunkNum, CatalogVersion, BodySize](TArray<uint8>& OutBody)
+						{
+							PFStoreStats::AddItemsProcessed(ChunkNum);
+							OutBody.Reserve(BodySize);
+							WriteUpdateCatalogItemsBody(TConstArrayView<FStoreItemRecord>(Ordered->GetData() + ChunkStart, ChunkNum), CatalogVersion, OutBody);
+						}, DependsOn, OnLanded(Request)));
+					ChunkStart += ChunkNum;
+				}
+				return Ids;
+			};
+
+		const TArray<FPFAdminScheduler::FTaskId> PlainIds = AddItemChunks(0, NumPlain, {});
+
+		TArray<FPFAdminScheduler::FTaskId> TableIds = PlainIds;
+		if (DropTables->Num() > 0)
+		{
+			int32 Request = INDEX_NONE;
+			if (Journal.IsValid())
+			{
+				TArray<FString> TableIdList;
+				TArray<uint64> TableHashes;
+				TableIdList.Reserve(DropTables->Num());
+				TableHashes.Reserve(DropTables->Num());
+				for (const FDropTableInfo& Table : *DropTables)
+				{
+					TableIdList.Add(Table.TableId);
+					TableHashes.Add(HashDropTable(Table));
+				}
+				Request = Journal->AddRequest(true, TableIdList, TableHashes);
+			}
+
+			TableIds = { Scheduler.Add(TEXT("UpdateRandomResultTables"), [DropTables, CatalogVersion](TArray<uint8>& OutBody)
+				{
+					PFStoreStats::AddItemsProcessed(DropTables->Num());
+					WriteUpdateRandomResultTablesBody(*DropTables, CatalogVersion, OutBody);
+				}, PlainIds, OnLanded(Request)) };
+		}
+
+		AddItemChunks(NumPlain, Ordered->Num(), TableIds);
+
+		// The plan is on disk before the first request goes out.
+		if (Journal.IsValid())
+		{
+			Journal->Flush();
+		}
+	}
+
+	void WriteCatalogVersionBody(const FString& CatalogVersion, TArray<uint8>& OutBody)
+	{
+		OutBody.Reset();
+		FStoreJsonWriter Writer(OutBody);
+		Writer.WriteObjectStart();
+		Writer.WriteValue("CatalogVersion", CatalogVersion);
+		Writer.WriteObjectEnd();
+	}
+
+	bool ParseGetCatalogItemsResponse(TConstArrayView<uint8> Response, TArray<FStoreItemRecord>& OutRecords, FString& OutError)
+	{
+		PFSTORE_SCOPE(PlayFabResponse);
+
+		OutRecords.Reset();
+		FStoreJsonReader Reader(Response);
+		FCatalogJsonParser Parser(Reader);
+		if (!Parser.ParseCatalogItemsResponse(OutRecords))
+		{
+			OutError = Parser.GetError();
+			OutRecords.Reset();
+			return false;
+		}
+		PFStoreStats::AddItemsProcessed(OutRecords.Num());
+		return true;
+	}
+
+	bool ParseGetRandomResultTablesResponse(TConstArrayView<uint8> Response, TArray<FDropTableInfo>& OutDropTables, FString& OutError)
+	{
+		PFSTORE_SCOPE(PlayFabResponse);
+
+		OutDropTables.Reset();
+		FStoreJsonReader Reader(Response);
+		FCatalogJsonParser Parser(Reader);
+		if (!Parser.ParseRandomResultTablesResponse(OutDropTables))
+		{
+			OutError = Parser.GetError();
+			OutDropTables.Reset();
+			return false;
+		}
+
+		// A map on the wire, so give the tables a stable order.
+		OutDropTables.Sort([](const FDropTableInfo& A, const FDropTableInfo& B) { return A.TableId < B.TableId; });
+		return true;
+	}
+
+	bool CookCatalog(const TArray<TWeakObjectPtr<UObject>>& Items, const TArray<TWeakObjectPtr<UObject>>& DropTables, const FString& FilePath)
+	{
+		TArray<FStoreItemRecord> Records;
+		SnapshotItems(Items, Records);
+
+		TArray<FDropTableInfo> Tables;
+		SnapshotDropTables(DropTables, Tables);
+
+		return CookRecords(Records, Tables, FilePath);
+	}
+
+	bool CookRecords(const TArray<FStoreItemRecord>& Records, const TArray<FDropTableInfo>& DropTables, const FString& FilePath)
+	{
+		PFSTORE_SCOPE(CatalogCook);
+
+		FStoreCatalogBuilder Builder;
+
+		for (const FStoreItemRecord& Record : Records)
+		{
+			Builder.AddItem(Record);
+		}
+
+		for (const FDropTableInfo& Table : DropTables)
+		{
+			Builder.AddDropTable(Table);
+		}
+
+		const TSharedRef<const FStoreCatalog> Catalog = Builder.Build();
+
+		TArray<uint8> Blob;
+		Catalog->WriteCooked(Blob);
+
+		if (!FFileHelper::SaveArrayToFile(Blob, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write cooked catalog: %s"), *FilePath);
+			return false;
 		}
 
+		UE_LOG(LogTemp, Log, TEXT("Cooked %d items and %d drop tables into %s (%d bytes)"),
+			Catalog->NumItems(), Catalog->NumDropTables(), *FilePath, Blob.Num());
 		return true;
 	}
 }
\ No newline at end of file
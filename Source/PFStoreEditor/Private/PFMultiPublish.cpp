@@ -0,0 +1,448 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "PFMultiPublish.h"
+
+#include "PFHelpers.h"
+#include "StoreDropTableProvider.h"
+#include "StoreJson.h"
+#include "StoreStats.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "PlayFabCommon.h"
+
+namespace PFMultiPublishPrivate
+{
+	static constexpr uint32 Magic = 0x53504650; // "PFPS"
+	static constexpr uint32 Version = 1;
+
+	/** What the worker needs of a target, copied so it never reads the statuses. */
+	struct FJob
+	{
+		FString StatePath;
+		FString CatalogVersion;
+		bool bSkip = false;
+	};
+}
+
+FString FPFMultiPublish::FTargetStatus::Describe() const
+{
+	switch (State)
+	{
+	case ETargetState::Preparing:
+		return TEXT("Preparing");
+	case ETargetState::Sending:
+		return FString::Printf(TEXT("Sending, %d of %d requests done"), NumFinished, NumRequests);
+	case ETargetState::UpToDate:
+		return TEXT("Up to date");
+	case ETargetState::Succeeded:
+		return FString::Printf(TEXT("Published %d items, %d drop tables"), NumItems, NumDropTables);
+	case ETargetState::Failed:
+	default:
+		return FString::Printf(TEXT("Failed: %s"), Errors.Num() > 0 ? *Errors[0] : TEXT("unknown error"));
+	}
+}
+
+TArray<FPFPublishTarget> FPFMultiPublish::GetEnabledTargets()
+{
+	return GetDefault<UPFStoreEditorSettings>()->PublishTargets.FilterByPredicate([](const FPFPublishTarget& Target)
+		{
+			return Target.bEnabled;
+		});
+}
+
+FString FPFMultiPublish::GetPublishedStatePath(const FString& TitleId, const FString& CatalogVersion)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PFStore"), TEXT("Published"), TitleId, CatalogVersion + TEXT(".pfpublished"));
+}
+
+FPFMultiPublish::FPFMultiPublish(TArray<FPFPublishTarget> InTargets, bool bInChangesOnly)
+	: bChangesOnly(bInChangesOnly)
+{
+	const FString DefaultCatalogVersion = GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion;
+
+	Statuses.Reserve(InTargets.Num());
+	for (FPFPublishTarget& Target : InTargets)
+	{
+		FTargetStatus& Status = Statuses.AddDefaulted_GetRef();
+		Status.CatalogVersion = Target.CatalogVersion.IsEmpty() ? DefaultCatalogVersion : Target.CatalogVersion;
+		Status.Target = MoveTemp(Target);
+
+		Published.Add(MakeShared<FPFUploadJournal::FLanded>());
+	}
+	Endpoints.SetNum(Statuses.Num());
+}
+
+void FPFMultiPublish::Run(TSharedRef<const TArray<FStoreItemRecord>> InRecords, TSharedRef<const TArray<FDropTableInfo>> InDropTables, FOnFinished InOnFinished)
+{
+	using namespace PFMultiPublishPrivate;
+
+	check(IsInGameThread());
+	check(!bRunning);
+
+	Records = InRecords;
+	DropTables = InDropTables;
+	OnFinished = MoveTemp(InOnFinished);
+	bRunning = true;
+	SelfWhileRunning = AsShared();
+
+	// Credentials are resolved up front; a target without them fails alone.
+	IPlayFabCommonModuleInterface& PlayFabCommon = IPlayFabCommonModuleInterface::Get();
+	TArray<FJob> Jobs;
+	Jobs.SetNum(Statuses.Num());
+	for (int32 Index = 0; Index < Statuses.Num(); ++Index)
+	{
+		FTargetStatus& Status = Statuses[Index];
+		FPFAdminEndpoint& Endpoint = Endpoints[Index];
+		Endpoint.TitleId = Status.Target.TitleId;
+		if (!Status.Target.SecretKeyEnvVar.IsEmpty())
+		{
+			Endpoint.SecretKey = FPlatformMisc::GetEnvironmentVariable(*Status.Target.SecretKeyEnvVar);
+		}
+		else if (Endpoint.TitleId.Equals(PlayFabCommon.GetTitleId(), ESearchCase::IgnoreCase))
+		{
+			Endpoint.SecretKey = PlayFabCommon.GetDeveloperSecretKey();
+		}
+
+		if (Endpoint.TitleId.IsEmpty() || Endpoint.SecretKey.IsEmpty())
+		{
+			Status.State = ETargetState::Failed;
+			Status.Errors.Add(Endpoint.TitleId.IsEmpty()
+				? FString(TEXT("No title id"))
+				: FString::Printf(TEXT("No developer secret, set %s"), Status.Target.SecretKeyEnvVar.IsEmpty() ? TEXT("SecretKeyEnvVar") : *Status.Target.SecretKeyEnvVar));
+			Jobs[Index].bSkip = true;
+			continue;
+		}
+
+		Jobs[Index].StatePath = GetPublishedStatePath(Endpoint.TitleId, Status.CatalogVersion);
+		Jobs[Index].CatalogVersion = Status.CatalogVersion;
+	}
+
+	const TSharedRef<FPFMultiPublish> This = AsShared();
+	Async(EAsyncExecution::ThreadPool, [This, InRecords, InDropTables, Jobs = MoveTemp(Jobs), bChangesOnly = bChangesOnly]()
+		{
+			const TArray<FStoreItemRecord>& Items = *InRecords;
+			const TArray<FDropTableInfo>& Tables = *InDropTables;
+
+			// Hashes and JSON once for all targets.
+			TSharedRef<FSerialized> Serialized = MakeShared<FSerialized>();
+			{
+				PFSTORE_SCOPE(JsonSerialize);
+
+				Serialized->ItemHashes.SetNum(Items.Num());
+				ParallelFor(Items.Num(), [&Items, &Serialized](int32 Index)
+					{
+						Serialized->ItemHashes[Index] = PFHelpers::HashRecord(Items[Index]);
+					});
+
+				Serialized->TableHashes.SetNum(Tables.Num());
+				Serialized->TableJson.SetNum(Tables.Num());
+				ParallelFor(Tables.Num(), [&Tables, &Serialized](int32 Index)
+					{
+						Serialized->TableHashes[Index] = PFHelpers::HashDropTable(Tables[Index]);
+						FStoreJsonWriter Writer(Serialized->TableJson[Index]);
+						PFHelpers::WriteDropTableJson(Writer, Tables[Index]);
+					});
+
+				for (const FJob& Job : Jobs)
+				{
+					if (Job.bSkip || Serialized->ItemJsonByVersion.Contains(Job.CatalogVersion))
+					{
+						continue;
+					}
+					TArray<TArray<uint8>>& Fragments = Serialized->ItemJsonByVersion.Add(Job.CatalogVersion);
+					Fragments.SetNum(Items.Num());
+					ParallelFor(TEXT("PFStore.WriteJson"), Items.Num(), 64, [&Items, &Fragments, &Job](int32 Index)
+						{
+							FStoreJsonWriter Writer(Fragments[Index]);
+							PFHelpers::WriteCatalogItemJson(Writer, Items[Index], Job.CatalogVersion);
+						});
+				}
+			}
+
+			// Each target's delta against what it was last sent.
+			TArray<FTargetPlan> Plans;
+			Plans.SetNum(Jobs.Num());
+			for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+			{
+				if (Jobs[JobIndex].bSkip)
+				{
+					continue;
+				}
+
+				FTargetPlan& Plan = Plans[JobIndex];
+				LoadPublishedState(Jobs[JobIndex].StatePath, Plan.Published);
+
+				auto IsPublished = [bChangesOnly](const TMap<FString, uint64>& Published, const FString& Id, uint64 Hash)
+					{
+						const uint64* PublishedHash = bChangesOnly ? Published.Find(Id) : nullptr;
+						return PublishedHash && *PublishedHash == Hash;
+					};
+
+				for (const bool bReferencesTables : { false, true })
+				{
+					for (int32 Index = 0; Index < Items.Num(); ++Index)
+					{
+						if (PFHelpers::ReferencesDropTables(Items[Index]) == bReferencesTables
+							&& !IsPublished(Plan.Published.Items, Items[Index].ItemId, Serialized->ItemHashes[Index]))
+						{
+							Plan.Items.Add(Index);
+						}
+					}
+					if (!bReferencesTables)
+					{
+						Plan.NumPlainItems = Plan.Items.Num();
+					}
+				}
+
+				for (int32 Index = 0; Index < Tables.Num(); ++Index)
+				{
+					if (!IsPublished(Plan.Published.DropTables, Tables[Index].TableId, Serialized->TableHashes[Index]))
+					{
+						Plan.Tables.Add(Index);
+					}
+				}
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [This, Serialized, Plans = MoveTemp(Plans)]() mutable
+				{
+					This->StartTargets(Serialized, MoveTemp(Plans));
+				});
+		});
+}
+
+void FPFMultiPublish::StartTargets(TSharedRef<const FSerialized> Serialized, TArray<FTargetPlan>&& Plans)
+{
+	const TSharedRef<FPFMultiPublish> This = AsShared();
+
+	// Held until every target started, in case one finishes from inside its Run.
+	++NumRunning;
+
+	for (int32 TargetIndex = 0; TargetIndex < Statuses.Num(); ++TargetIndex)
+	{
+		FTargetStatus& Status = Statuses[TargetIndex];
+		if (Status.State == ETargetState::Failed)
+		{
+			continue;
+		}
+
+		FTargetPlan& Plan = Plans[TargetIndex];
+		*Published[TargetIndex] = MoveTemp(Plan.Published);
+		Status.NumItems = Plan.Items.Num();
+		Status.NumDropTables = Plan.Tables.Num();
+		if (Plan.Items.Num() == 0 && Plan.Tables.Num() == 0)
+		{
+			Status.State = ETargetState::UpToDate;
+			continue;
+		}
+
+		FPFAdminScheduler::FOptions Options = FPFAdminScheduler::GetDefaultOptions();
+		Options.Endpoint = Endpoints[TargetIndex];
+		TSharedRef<FPFAdminScheduler> Scheduler = MakeShared<FPFAdminScheduler>(Options);
+
+		const FString CatalogVersion = Status.CatalogVersion;
+		const TSharedRef<FPFUploadJournal::FLanded> State = Published[TargetIndex];
+		const TSharedRef<const TArray<int32>> Items = MakeShared<const TArray<int32>>(MoveTemp(Plan.Items));
+
+		// Bodies are the shared fragments behind a header; nothing is formatted again per target.
+		// The fragments are formatted already, so requests are packed by their exact sizes.
+		const TArray<TArray<uint8>>& Fragments = Serialized->ItemJsonByVersion.FindChecked(CatalogVersion);
+		TArray<int64> ItemSizes;
+		ItemSizes.Reserve(Items->Num());
+		for (const int32 Item : *Items)
+		{
+			ItemSizes.Add(Fragments[Item].Num());
+		}
+		const int64 BodyOverhead = PFHelpers::GetRequestBodyOverhead(CatalogVersion);
+		const int64 MaxBodyBytes = PFHelpers::GetMaxRequestBodyBytes();
+
+		auto AddItemChunks = [&This, &Scheduler, &Serialized, &CatalogVersion, &State, &Items, &ItemSizes, BodyOverhead, MaxBodyBytes, TargetIndex](int32 Start, int32 End, const TArray<FPFAdminScheduler::FTaskId>& DependsOn)
+			{
+				TArray<FPFAdminScheduler::FTaskId> Ids;
+				int32 ChunkStart = Start;
+				for (const int32 ChunkNum : PFHelpers::PackRequests(TConstArrayView<int64>(ItemSizes.GetData() + Start, End - Start), BodyOverhead, MaxBodyBytes))
+				{
+					Ids.Add(Scheduler->Add(TEXT("UpdateCatalogItems"), [Serialized, CatalogVersion, Items, ChunkStart, ChunkNum](TArray<uint8>& OutBody)
+						{
+							const TArray<TArray<uint8>>& Fragments = Serialized->ItemJsonByVersion.FindChecked(CatalogVersion);
+
+							int64 Size = PFHelpers::GetRequestBodyOverhead(CatalogVersion) + ChunkNum - 1;
+							for (int32 Index = ChunkStart; Index < ChunkStart + ChunkNum; ++Index)
+							{
+								Size += Fragments[(*Items)[Index]].Num();
+							}
+							OutBody.Reset(Size);
+
+							FStoreJsonWriter Writer(OutBody);
+							Writer.WriteObjectStart();
+							Writer.WriteValue("CatalogVersion", CatalogVersion);
+							Writer.WriteArrayStart("Catalog");
+							for (int32 Index = ChunkStart; Index < ChunkStart + ChunkNum; ++Index)
+							{
+								Writer.WriteRawValue(Fragments[(*Items)[Index]]);
+							}
+							Writer.WriteArrayEnd();
+							Writer.WriteObjectEnd();
+							PFStoreStats::AddItemsProcessed(ChunkNum);
+						},
+						DependsOn,
+						[This, Serialized, State, Items, ChunkStart, ChunkNum, TargetIndex](bool bSuccess, const FString&)
+						{
+							++This->Statuses[TargetIndex].NumFinished;
+							if (bSuccess)
+							{
+								for (int32 Index = ChunkStart; Index < ChunkStart + ChunkNum; ++Index)
+								{
+									const int32 Item = (*Items)[Index];
+									State->Items.Add((*This->Records)[Item].ItemId, Serialized->ItemHashes[Item]);
+								}
+							}
+						}));
+					ChunkStart += ChunkNum;
+				}
+				return Ids;
+			};
+
+		const TArray<FPFAdminScheduler::FTaskId> PlainIds = AddItemChunks(0, Plan.NumPlainItems, {});
+
+		TArray<FPFAdminScheduler::FTaskId> TableIds = PlainIds;
+		if (Plan.Tables.Num() > 0)
+		{
+			const TSharedRef<const TArray<int32>> Tables = MakeShared<const TArray<int32>>(MoveTemp(Plan.Tables));
+			TableIds = { Scheduler->Add(TEXT("UpdateRandomResultTables"), [Serialized, CatalogVersion, Tables](TArray<uint8>& OutBody)
+				{
+					FStoreJsonWriter Writer(OutBody);
+					Writer.WriteObjectStart();
+					Writer.WriteValue("CatalogVersion", CatalogVersion);
+					Writer.WriteArrayStart("Tables");
+					for (const int32 Table : *Tables)
+					{
+						Writer.WriteRawValue(Serialized->TableJson[Table]);
+					}
+					Writer.WriteArrayEnd();
+					Writer.WriteObjectEnd();
+					PFStoreStats::AddItemsProcessed(Tables->Num());
+				},
+				PlainIds,
+				[This, Serialized, State, Tables, TargetIndex](bool bSuccess, const FString&)
+				{
+					++This->Statuses[TargetIndex].NumFinished;
+					if (bSuccess)
+					{
+						for (const int32 Table : *Tables)
+						{
+							State->DropTables.Add((*This->DropTables)[Table].TableId, Serialized->TableHashes[Table]);
+						}
+					}
+				}) };
+		}
+
+		AddItemChunks(Plan.NumPlainItems, Items->Num(), TableIds);
+
+		Status.State = ETargetState::Sending;
+		Status.NumRequests = Scheduler->Num();
+		++NumRunning;
+		Scheduler->Run([This, TargetIndex](bool bSuccess, const TArray<FString>& Errors)
+			{
+				This->OnTargetFinished(TargetIndex, bSuccess, Errors);
+			});
+	}
+
+	--NumRunning;
+	FinishIfDone();
+}
+
+void FPFMultiPublish::OnTargetFinished(int32 Target, bool bSuccess, const TArray<FString>& Errors)
+{
+	FTargetStatus& Status = Statuses[Target];
+	Status.State = bSuccess ? ETargetState::Succeeded : ETargetState::Failed;
+	Status.Errors.Append(Errors);
+
+	for (const FString& Error : Errors)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to publish to %s (%s): %s"), *Status.Target.Name, *Status.Target.TitleId, *Error);
+	}
+	if (bSuccess)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Published to %s (%s): %d items, %d drop tables."), *Status.Target.Name, *Status.Target.TitleId, Status.NumItems, Status.NumDropTables);
+	}
+
+	// Also after a failure: what landed is not sent again next time.
+	SavePublishedState(GetPublishedStatePath(Endpoints[Target].TitleId, Status.CatalogVersion), CopyTemp(*Published[Target]));
+
+	--NumRunning;
+	FinishIfDone();
+}
+
+void FPFMultiPublish::FinishIfDone()
+{
+	if (NumRunning > 0 || !bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	const bool bSuccess = !Statuses.ContainsByPredicate([](const FTargetStatus& Status)
+		{
+			return Status.State == ETargetState::Failed;
+		});
+
+	FOnFinished Callback = MoveTemp(OnFinished);
+	const TSharedPtr<FPFMultiPublish> KeepAlive = MoveTemp(SelfWhileRunning);
+	if (Callback)
+	{
+		Callback(bSuccess);
+	}
+}
+
+bool FPFMultiPublish::LoadPublishedState(const FString& Path, FPFUploadJournal::FLanded& OutPublished)
+{
+	using namespace PFMultiPublishPrivate;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (Reader.IsError() || FileMagic != Magic || FileVersion != Version)
+	{
+		return false;
+	}
+
+	Reader << OutPublished.Items << OutPublished.DropTables;
+	if (Reader.IsError())
+	{
+		OutPublished.Items.Reset();
+		OutPublished.DropTables.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FPFMultiPublish::SavePublishedState(const FString& Path, FPFUploadJournal::FLanded&& Published)
+{
+	Async(EAsyncExecution::ThreadPool, [Path, Published = MoveTemp(Published)]() mutable
+		{
+			using namespace PFMultiPublishPrivate;
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			uint32 FileMagic = Magic;
+			uint32 FileVersion = Version;
+			Writer << FileMagic << FileVersion << Published.Items << Published.DropTables;
+
+			if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Could not save %s, the next publish to this title sends everything"), *Path);
+			}
+		});
+}
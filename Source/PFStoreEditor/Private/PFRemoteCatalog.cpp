@@ -0,0 +1,293 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "PFRemoteCatalog.h"
+
+#include "PFHelpers.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace PFRemoteCatalogPrivate
+{
+	static constexpr uint32 Magic = 0x43524650; // "PFRC"
+
+	/** Bump whenever the layout of the file or of the records in it changes. */
+	static constexpr uint32 Version = 1;
+}
+
+// ---------- FPFRemoteCatalog ----------
+
+bool FPFRemoteCatalog::Save(const FString& FilePath) const
+{
+	using namespace PFRemoteCatalogPrivate;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	int64 FetchTicks = FetchTime.GetTicks();
+	uint64 Hash = ContentHash;
+	Writer << FileMagic << FileVersion;
+	Writer << const_cast<FString&>(CatalogVersion);
+	Writer << FetchTicks << Hash;
+	Writer << const_cast<TArray<FStoreItemRecord>&>(Items);
+	Writer << const_cast<TArray<FDropTableInfo>&>(DropTables);
+
+	// Write next to the old file and swap, so a crash never leaves a half written cache behind.
+	const FString TempPath = FilePath + TEXT(".tmp");
+	return FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+}
+
+TSharedPtr<FPFRemoteCatalog> FPFRemoteCatalog::Load(const FString& FilePath)
+{
+	using namespace PFRemoteCatalogPrivate;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+	{
+		return nullptr;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (Reader.IsError() || FileMagic != Magic || FileVersion != Version)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FPFRemoteCatalog> Catalog = MakeShared<FPFRemoteCatalog>();
+	int64 FetchTicks = 0;
+	Reader << Catalog->CatalogVersion;
+	Reader << FetchTicks << Catalog->ContentHash;
+	Reader << Catalog->Items;
+	Reader << Catalog->DropTables;
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring corrupt remote catalog cache %s"), *FilePath);
+		return nullptr;
+	}
+
+	Catalog->FetchTime = FDateTime(FetchTicks);
+	return Catalog;
+}
+
+// ---------- FPFRemoteCatalogCache ----------
+
+FPFRemoteCatalogCache& FPFRemoteCatalogCache::Get()
+{
+	static FPFRemoteCatalogCache Instance;
+	return Instance;
+}
+
+FString FPFRemoteCatalogCache::GetCacheFilePath(const FString& CatalogVersion)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PFStore"), TEXT("RemoteCache"),
+		FPaths::MakeValidFileName(CatalogVersion) + TEXT(".pfremote"));
+}
+
+FString FPFRemoteCatalogCache::GetSyncBaseFilePath(const FString& CatalogVersion)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PFStore"), TEXT("SyncBase"),
+		FPaths::MakeValidFileName(CatalogVersion) + TEXT(".pfremote"));
+}
+
+TSharedPtr<const FPFRemoteCatalog> FPFRemoteCatalogCache::GetSyncBase(const FString& CatalogVersion)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = Entries.FindOrAdd(CatalogVersion);
+	if (!Entry.SyncBase.IsValid() && !Entry.bSyncBaseChecked)
+	{
+		Entry.bSyncBaseChecked = true;
+		Entry.SyncBase = FPFRemoteCatalog::Load(GetSyncBaseFilePath(CatalogVersion));
+	}
+	return Entry.SyncBase;
+}
+
+void FPFRemoteCatalogCache::SetSyncBase(const FString& CatalogVersion, TArray<FStoreItemRecord> Items, const TArray<FDropTableInfo>* DropTables)
+{
+	check(IsInGameThread());
+
+	TSharedPtr<FPFRemoteCatalog> Base = MakeShared<FPFRemoteCatalog>();
+	Base->CatalogVersion = CatalogVersion;
+	Base->FetchTime = FDateTime::UtcNow();
+	Base->Items = MoveTemp(Items);
+	if (DropTables)
+	{
+		Base->DropTables = *DropTables;
+	}
+	else if (TSharedPtr<const FPFRemoteCatalog> Previous = GetSyncBase(CatalogVersion))
+	{
+		Base->DropTables = Previous->DropTables;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(CatalogVersion);
+	Entry.SyncBase = Base;
+	Entry.bSyncBaseChecked = true;
+
+	const FString FilePath = GetSyncBaseFilePath(CatalogVersion);
+	if (!Base->Save(FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write merge base %s"), *FilePath);
+	}
+}
+
+TSharedPtr<const FPFRemoteCatalog> FPFRemoteCatalogCache::GetCached(const FString& CatalogVersion)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = Entries.FindOrAdd(CatalogVersion);
+	if (!Entry.Catalog.IsValid() && !Entry.bDiskChecked)
+	{
+		Entry.bDiskChecked = true;
+		Entry.Catalog = FPFRemoteCatalog::Load(GetCacheFilePath(CatalogVersion));
+	}
+	return Entry.Catalog;
+}
+
+TSharedPtr<const FPFRemoteCatalog> FPFRemoteCatalogCache::GetAndRevalidate(const FString& CatalogVersion, FTimespan MaxAge)
+{
+	TSharedPtr<const FPFRemoteCatalog> Cached = GetCached(CatalogVersion);
+	if (!Cached.IsValid() || FDateTime::UtcNow() - Cached->FetchTime > MaxAge)
+	{
+		Refresh(CatalogVersion);
+	}
+	return Cached;
+}
+
+bool FPFRemoteCatalogCache::IsRefreshing(const FString& CatalogVersion) const
+{
+	const FEntry* Entry = Entries.Find(CatalogVersion);
+	return Entry && Entry->bRefreshing;
+}
+
+void FPFRemoteCatalogCache::Refresh(const FString& CatalogVersion, FOnRefreshComplete OnComplete)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = Entries.FindOrAdd(CatalogVersion);
+	if (OnComplete)
+	{
+		Entry.Waiters.Add(MoveTemp(OnComplete));
+	}
+	if (Entry.bRefreshing)
+	{
+		return;
+	}
+	Entry.bRefreshing = true;
+
+	struct FPending
+	{
+		FHttpResponsePtr Items;
+		FHttpResponsePtr Tables;
+		FString Error;
+		int32 Remaining = 2;
+	};
+	TSharedRef<FPending> Pending = MakeShared<FPending>();
+
+	// Both responses arrive on the game thread; the last one hands them to a worker for parsing.
+	auto OnResponse = [this, CatalogVersion, Pending](FHttpResponsePtr FPending::* Slot, bool bSuccess, const FString& Error, FHttpResponsePtr Response)
+		{
+			(*Pending).*Slot = Response;
+			if (!bSuccess && Pending->Error.IsEmpty())
+			{
+				Pending->Error = Error;
+			}
+			if (--Pending->Remaining > 0)
+			{
+				return;
+			}
+			if (!Pending->Error.IsEmpty())
+			{
+				FinishRefresh(CatalogVersion, nullptr, Pending->Error);
+				return;
+			}
+
+			Async(EAsyncExecution::ThreadPool, [this, CatalogVersion, Pending]()
+				{
+					TSharedPtr<FPFRemoteCatalog> Catalog = MakeShared<FPFRemoteCatalog>();
+					Catalog->CatalogVersion = CatalogVersion;
+					Catalog->FetchTime = FDateTime::UtcNow();
+
+					const TArray<uint8>& ItemsContent = Pending->Items->GetContent();
+					const TArray<uint8>& TablesContent = Pending->Tables->GetContent();
+
+					FString Error;
+					if (PFHelpers::ParseGetCatalogItemsResponse(ItemsContent, Catalog->Items, Error) &&
+						PFHelpers::ParseGetRandomResultTablesResponse(TablesContent, Catalog->DropTables, Error))
+					{
+						Catalog->ContentHash = CityHash64WithSeed(reinterpret_cast<const char*>(TablesContent.GetData()), TablesContent.Num(),
+							CityHash64(reinterpret_cast<const char*>(ItemsContent.GetData()), ItemsContent.Num()));
+
+						const FString FilePath = GetCacheFilePath(CatalogVersion);
+						if (!Catalog->Save(FilePath))
+						{
+							UE_LOG(LogTemp, Warning, TEXT("Failed to write remote catalog cache %s"), *FilePath);
+						}
+					}
+					else
+					{
+						Catalog.Reset();
+					}
+
+					// Let go of the response bodies here rather than on the game thread.
+					Pending->Items.Reset();
+					Pending->Tables.Reset();
+
+					AsyncTask(ENamedThreads::GameThread, [this, CatalogVersion, Catalog, Error]()
+						{
+							FinishRefresh(CatalogVersion, Catalog, Error);
+						});
+				});
+		};
+
+	TArray<uint8> ItemsBody;
+	PFHelpers::WriteCatalogVersionBody(CatalogVersion, ItemsBody);
+	TArray<uint8> TablesBody = ItemsBody;
+
+	PFHelpers::SendAdminRequest(TEXT("GetCatalogItems"), MoveTemp(ItemsBody),
+		[OnResponse](bool bSuccess, const FString& Error, FHttpResponsePtr Response)
+		{
+			OnResponse(&FPending::Items, bSuccess, Error, Response);
+		});
+	PFHelpers::SendAdminRequest(TEXT("GetRandomResultTables"), MoveTemp(TablesBody),
+		[OnResponse](bool bSuccess, const FString& Error, FHttpResponsePtr Response)
+		{
+			OnResponse(&FPending::Tables, bSuccess, Error, Response);
+		});
+}
+
+void FPFRemoteCatalogCache::FinishRefresh(const FString& CatalogVersion, TSharedPtr<FPFRemoteCatalog> Catalog, const FString& Error)
+{
+	FEntry& Entry = Entries.FindOrAdd(CatalogVersion);
+	Entry.bRefreshing = false;
+	TArray<FOnRefreshComplete> Waiters = MoveTemp(Entry.Waiters);
+
+	if (Catalog.IsValid())
+	{
+		const bool bChanged = !Entry.Catalog.IsValid() || Entry.Catalog->ContentHash != Catalog->ContentHash;
+		Entry.Catalog = Catalog;
+		Entry.bDiskChecked = true;
+		if (bChanged)
+		{
+			UpdatedEvent.Broadcast(Catalog.ToSharedRef());
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to refresh PlayFab catalog %s: %s"), *CatalogVersion, *Error);
+	}
+
+	for (FOnRefreshComplete& Waiter : Waiters)
+	{
+		Waiter(Catalog.IsValid(), Error);
+	}
+}
@@ -0,0 +1,586 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "PFStoreBenchmark.h"
+
+#include "PFHelpers.h"
+#include "StoreCatalog.h"
+#include "StoreJson.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include <atomic>
+
+namespace PFStoreBenchmarkPrivate
+{
+	/**
+	 * Forwards everything to the real allocator and counts the requests that pass through. It owns
+	 * no memory, so blocks allocated through it may be freed after it is uninstalled and vice versa.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		std::atomic<uint64> NumAllocs{ 0 };
+		std::atomic<uint64> NumBytes{ 0 };
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Record(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Record(Count);
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			Record(Count);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			Record(Count);
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("PFStoreCountingMalloc"); }
+
+	private:
+		void Record(SIZE_T Count)
+		{
+			NumAllocs.fetch_add(1, std::memory_order_relaxed);
+			NumBytes.fetch_add(Count, std::memory_order_relaxed);
+		}
+
+		FMalloc* Inner;
+	};
+
+	/**
+	 * Puts an FCountingMalloc on top of GMalloc for the lifetime of the scope and restores the
+	 * previous allocator afterwards. The proxy itself is leaked on purpose: another thread may
+	 * still be inside a call it loaded from GMalloc just before the restore.
+	 */
+	class FScopedCountingMalloc
+	{
+	public:
+		FScopedCountingMalloc()
+			: Previous(GMalloc)
+			, Counter(new FCountingMalloc(GMalloc))
+		{
+			GMalloc = Counter;
+		}
+
+		~FScopedCountingMalloc()
+		{
+			// Leave GMalloc alone if something else wrapped it meanwhile; the proxy keeps forwarding.
+			if (GMalloc == Counter)
+			{
+				GMalloc = Previous;
+			}
+		}
+
+		FScopedCountingMalloc(const FScopedCountingMalloc&) = delete;
+		FScopedCountingMalloc& operator=(const FScopedCountingMalloc&) = delete;
+
+		FCountingMalloc& Get() const { return *Counter; }
+
+	private:
+		FMalloc* Previous;
+		FCountingMalloc* Counter;
+	};
+
+	struct FStageResult
+	{
+		FString Name;
+		int32 NumItems = 0;
+		TArray<double> Samples;
+		uint64 AllocsPerRun = 0;
+		uint64 BytesPerRun = 0;
+	};
+
+	template<typename FuncType>
+	static FStageResult Measure(FCountingMalloc& Counter, const TCHAR* Name, int32 NumItems, int32 Iterations, FuncType&& Body)
+	{
+		FStageResult Stage;
+		Stage.Name = Name;
+		Stage.NumItems = NumItems;
+		Stage.Samples.Reserve(Iterations);
+
+		uint64 TotalAllocs = 0;
+		uint64 TotalBytes = 0;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const uint64 AllocsBefore = Counter.NumAllocs.load(std::memory_order_relaxed);
+			const uint64 BytesBefore = Counter.NumBytes.load(std::memory_order_relaxed);
+			const double StartTime = FPlatformTime::Seconds();
+
+			Body();
+
+			Stage.Samples.Add(FPlatformTime::Seconds() - StartTime);
+			TotalAllocs += Counter.NumAllocs.load(std::memory_order_relaxed) - AllocsBefore;
+			TotalBytes += Counter.NumBytes.load(std::memory_order_relaxed) - BytesBefore;
+		}
+
+		Stage.AllocsPerRun = TotalAllocs / FMath::Max(Iterations, 1);
+		Stage.BytesPerRun = TotalBytes / FMath::Max(Iterations, 1);
+		return Stage;
+	}
+
+	static double Percentile(TArray<double> Samples, double Fraction)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0;
+		}
+		Samples.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Samples.Num()) - 1, 0, Samples.Num() - 1);
+		return Samples[Index];
+	}
+
+	/** Below this the timer and scheduler noise dominates, so timings are reported but not compared. */
+	static constexpr double MinComparableSeconds = 0.001;
+
+	static FString MakeStageKey(int32 Size, const FString& Stage)
+	{
+		return FString::Printf(TEXT("%d/%s"), Size, *Stage);
+	}
+}
+
+void FPFStoreSyntheticCatalog::Generate(int32 NumItems, int32 Seed, TArray<FStoreItemRecord>& OutItems, TArray<FDropTableInfo>& OutDropTables)
+{
+	FRandomStream Random(Seed);
+
+	static constexpr FCurrencyCode Currencies[] = { FCurrencyCode("GD"), FCurrencyCode("CR"), FCurrencyCode("GEM") };
+	static const TCHAR* Classes[] = { TEXT("Cosmetic"), TEXT("Consumable"), TEXT("Weapon"), TEXT("Armor"), TEXT("Chest"), TEXT("Key"), TEXT("Bundle"), TEXT("Currency") };
+	constexpr int32 NumTagNames = 256;
+
+	// Small indices are much more likely, like real tag and class usage.
+	auto ZipfIndex = [&Random](int32 Num)
+		{
+			return FMath::Min(Num - 1, FMath::FloorToInt(Num * FMath::Pow(Random.GetFraction(), 3.0f)));
+		};
+
+	// Mostly near Min with a long tail up to Max, like bundle and container fan-out.
+	auto Skewed = [&Random](int32 Min, int32 Max)
+		{
+			return FMath::Min(Max, Min + FMath::FloorToInt((Max - Min + 1) * FMath::Square(Random.GetFraction())));
+		};
+
+	// Log-uniform between 1 and Max, like prices and payload sizes.
+	auto LogUniform = [&Random](int32 Max)
+		{
+			return FMath::Max(1, FMath::FloorToInt(FMath::Exp(Random.FRandRange(0.0f, FMath::Loge(static_cast<float>(Max))))));
+		};
+
+	const int32 NumTables = FMath::Max(1, NumItems / 100);
+	auto TableId = [](int32 Index) { return FString::Printf(TEXT("table_%05d"), Index); };
+	auto ItemId = [](int32 Index) { return FString::Printf(TEXT("item_%07d"), Index); };
+
+	OutItems.Reset(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		FStoreItemRecord& Record = OutItems.AddDefaulted_GetRef();
+
+		Record.ItemId = ItemId(Index);
+		Record.DisplayName = FString::Printf(TEXT("Synthetic Item %d"), Index);
+		Record.ItemClass = Classes[ZipfIndex(UE_ARRAY_COUNT(Classes))];
+		Record.Description = FString::Printf(TEXT("Generated %s number %d, \"quoted\", with commas"), *Record.ItemClass, Index);
+
+		const int32 CustomDataSize = LogUniform(4096) - 1;
+		Record.CustomData = CustomDataSize > 0 ? FString::Printf(TEXT("{\"payload\":\"%s\"}"), *FString::ChrN(CustomDataSize, TEXT('x'))) : FString();
+
+		while (Record.Tags.Num() < 12 && Random.GetFraction() < 0.7f)
+		{
+			Record.Tags.AddUnique(FString::Printf(TEXT("tag_%03d"), ZipfIndex(NumTagNames)));
+		}
+
+		if (Random.GetFraction() < 0.9f)
+		{
+			Record.Prices.Add(Currencies[ZipfIndex(UE_ARRAY_COUNT(Currencies))], LogUniform(100000));
+			if (Random.GetFraction() < 0.25f)
+			{
+				Record.Prices.Add(Currencies[Random.RandHelper(UE_ARRAY_COUNT(Currencies))], LogUniform(100000));
+			}
+		}
+
+		Record.bIsLimitedEdition = Random.GetFraction() < 0.02f;
+		Record.bIsTokenForCharacterCreation = Random.GetFraction() < 0.01f;
+		Record.bIsTradable = Random.GetFraction() < 0.3f;
+		Record.bIsStackable = Random.GetFraction() < 0.4f;
+
+		if (Random.GetFraction() < 0.2f)
+		{
+			Record.Consumable.UsageCount = Random.RandRange(1, 10);
+			if (Random.GetFraction() < 0.3f)
+			{
+				Record.Consumable.UsagePeriod = Random.RandRange(3600, 604800);
+				Record.Consumable.UsagePeriodGroup = FString::Printf(TEXT("group_%d"), ZipfIndex(16));
+			}
+		}
+	}
+
+	// Bundles and containers point at other items, so fill them in once every id exists.
+	for (int32 Index = 0; Index < NumItems && NumItems > 1; ++Index)
+	{
+		FStoreItemRecord& Record = OutItems[Index];
+		const float Roll = Random.GetFraction();
+
+		if (Roll < 0.05f)
+		{
+			Record.bIsBundle = true;
+			const int32 FanOut = Skewed(2, 20);
+			for (int32 Child = 0; Child < FanOut; ++Child)
+			{
+				Record.Bundle.BundledItems.Add(ItemId(Random.RandHelper(NumItems)));
+			}
+			if (Random.GetFraction() < 0.2f)
+			{
+				Record.Bundle.BundledResultTables.Add(TableId(Random.RandHelper(NumTables)));
+			}
+			if (Random.GetFraction() < 0.3f)
+			{
+				Record.Bundle.BundledVirtualCurrencies.Add(Currencies[0], LogUniform(10000));
+			}
+		}
+		else if (Roll < 0.08f)
+		{
+			Record.bIsContainer = true;
+			if (Random.GetFraction() < 0.5f)
+			{
+				Record.Container.KeyItemId = ItemId(Random.RandHelper(NumItems));
+			}
+			const int32 FanOut = Skewed(1, 50);
+			for (int32 Child = 0; Child < FanOut; ++Child)
+			{
+				Record.Container.ItemContents.Add(ItemId(Random.RandHelper(NumItems)));
+			}
+			if (Random.GetFraction() < 0.3f)
+			{
+				Record.Container.ResultTableContents.Add(TableId(Random.RandHelper(NumTables)));
+			}
+			if (Random.GetFraction() < 0.3f)
+			{
+				Record.Container.VirtualCurrencyContents.Add(Currencies[1], LogUniform(1000));
+			}
+		}
+	}
+
+	// Tables sit on four levels and only reference the next level, so nesting is at most four deep.
+	OutDropTables.Reset(NumTables);
+	for (int32 Index = 0; Index < NumTables; ++Index)
+	{
+		FDropTableInfo& Table = OutDropTables.AddDefaulted_GetRef();
+		Table.TableId = TableId(Index);
+
+		const bool bCanNest = (Index % 4) < 3 && Index + 1 < NumTables;
+		const int32 NumNodes = Skewed(2, 30);
+		for (int32 Node = 0; Node < NumNodes; ++Node)
+		{
+			FDropTableNode& Entry = Table.Nodes.AddDefaulted_GetRef();
+			if (bCanNest && Random.GetFraction() < 0.2f)
+			{
+				Entry.ResultItemType = TEXT("TableId");
+				Entry.ResultItem = TableId(Index + 1);
+			}
+			else
+			{
+				Entry.ResultItemType = TEXT("ItemId");
+				Entry.ResultItem = ItemId(Random.RandHelper(NumItems));
+			}
+			Entry.Weight = Random.RandRange(1, 100);
+		}
+	}
+}
+
+int32 FPFStoreBenchmark::Run(const FPFStoreBenchmarkOptions& Options, TSharedRef<FJsonObject> OutResult, TArray<FString>& OutErrors)
+{
+	using namespace PFStoreBenchmarkPrivate;
+
+	const FScopedCountingMalloc CountingMalloc;
+
+	TSharedPtr<FJsonObject> Baseline;
+	if (!Options.BaselinePath.IsEmpty())
+	{
+		FString BaselineText;
+		if (FFileHelper::LoadFileToString(BaselineText, *Options.BaselinePath))
+		{
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline);
+		}
+		if (!Baseline.IsValid())
+		{
+			OutErrors.Add(FString::Printf(TEXT("Failed to read baseline %s"), *Options.BaselinePath));
+		}
+	}
+	const TSharedPtr<FJsonObject>* BaselineStages = nullptr;
+	if (Baseline.IsValid())
+	{
+		Baseline->TryGetObjectField(TEXT("stages"), BaselineStages);
+	}
+
+	const FString TempDir = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("PFStoreBenchmark"));
+	IFileManager::Get().MakeDirectory(*TempDir, true);
+
+	const int32 Iterations = FMath::Max(1, Options.Iterations);
+	TSharedRef<FJsonObject> NewBaselineStages = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Regressions;
+	TArray<TSharedPtr<FJsonValue>> Runs;
+
+	for (const int32 Size : Options.Sizes)
+	{
+		TArray<FStageResult> Stages;
+
+		TArray<FStoreItemRecord> Items;
+		TArray<FDropTableInfo> Tables;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("Generate"), Size, 1, [&]()
+			{
+				FPFStoreSyntheticCatalog::Generate(Size, Options.Seed, Items, Tables);
+			}));
+
+		const FString CsvPath = FPaths::Combine(TempDir, FString::Printf(TEXT("Catalog_%d.csv"), Size));
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ExportCsv"), Size, Iterations, [&]()
+			{
+				PFHelpers::ExportRecordsToCsv(Items, CsvPath);
+			}));
+
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *CsvPath);
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ParseCsvLine"), Lines.Num(), Iterations, [&]()
+			{
+				TArray<FString> Fields;
+				for (const FString& Line : Lines)
+				{
+					PFHelpers::ParseCsvLine(Line, Fields);
+				}
+			}));
+		Lines.Empty();
+
+		TArray<FStoreItemRecord> Imported;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ImportCsv"), Size, Iterations, [&]()
+			{
+				PFHelpers::ImportRecordsFromCsv(CsvPath, Imported);
+			}));
+		IFileManager::Get().Delete(*CsvPath);
+
+		const FString TablesCsvPath = PFHelpers::GetDropTablesCsvPath(CsvPath);
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ExportDropTablesCsv"), Tables.Num(), Iterations, [&]()
+			{
+				PFHelpers::ExportDropTablesToCsv(Tables, TablesCsvPath);
+			}));
+		TArray<FDropTableInfo> ImportedCsvTables;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ImportDropTablesCsv"), Tables.Num(), Iterations, [&]()
+			{
+				PFHelpers::ImportDropTablesFromCsv(TablesCsvPath, ImportedCsvTables);
+			}));
+		IFileManager::Get().Delete(*TablesCsvPath);
+
+		const FString JsonPath = FPaths::Combine(TempDir, FString::Printf(TEXT("Catalog_%d.json"), Size));
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ExportJson"), Size, Iterations, [&]()
+			{
+				PFHelpers::ExportRecordsToJson(Items, Tables, TEXT("Benchmark"), JsonPath);
+			}));
+
+		TArray<FDropTableInfo> ImportedTables;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("ImportJson"), Size, Iterations, [&]()
+			{
+				PFHelpers::ImportRecordsFromJson(JsonPath, Imported, ImportedTables);
+			}));
+		Imported.Empty();
+		ImportedTables.Empty();
+		IFileManager::Get().Delete(*JsonPath);
+
+		// About one percent of the catalog edited, a few items removed: a typical day of changes.
+		TArray<FStoreItemRecord> Remote = Items;
+		for (int32 Index = 0; Index < Remote.Num(); Index += 100)
+		{
+			Remote[Index].DisplayName += TEXT(" (old)");
+			Remote[Index].Prices.Add(FCurrencyCode("GD"), 1);
+		}
+		Remote.SetNum(Remote.Num() - Remote.Num() / 200);
+
+		FStoreCatalogDiff Diff;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("Diff"), Size, Iterations, [&]()
+			{
+				PFHelpers::DiffRecords(Items, Remote, Diff);
+			}));
+
+		// The same remote edits merged against local ones, a few dozen of which collide.
+		TArray<FStoreItemRecord> Local = Items;
+		for (int32 Index = 0; Index < Local.Num(); Index += 150)
+		{
+			Local[Index].Description += TEXT(" (edited)");
+		}
+		for (int32 Index = 0; Index < Local.Num(); Index += 3000)
+		{
+			Local[Index].DisplayName += TEXT(" (new)");
+		}
+
+		FStoreMergeResult Merge;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("Merge"), Size, Iterations, [&]()
+			{
+				PFHelpers::MergeRecords(&Items, Local, Remote, Merge);
+			}));
+		Merge = FStoreMergeResult();
+		Local.Empty();
+		Remote.Empty();
+
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("UploadPrep"), Size, Iterations, [&]()
+			{
+				PlayFab::AdminModels::FUpdateCatalogItemsRequest Request;
+				Request.CatalogVersion = TEXT("Benchmark");
+				Request.Catalog.Reserve(Items.Num());
+				for (const FStoreItemRecord& Record : Items)
+				{
+					Request.Catalog.Add(PFHelpers::ToPlayFabCatalogItem(Record, Request.CatalogVersion));
+				}
+				const FString Payload = Request.toJSONString();
+			}));
+
+		// The direct path Upload takes now, next to the SDK model path above.
+		TArray<uint8> Body;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("UploadBody"), Size, Iterations, [&]()
+			{
+				PFHelpers::WriteUpdateCatalogItemsBody(Items, TEXT("Benchmark"), Body);
+			}));
+
+		// What the publish chunker counts instead of formatting; it has to land on the same bytes.
+		int64 EstimatedSize = 0;
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("EstimateBodySize"), Size, Iterations, [&]()
+			{
+				const int64 VersionSize = FStoreJsonWriter::GetStringSize(TEXT("Benchmark"));
+				EstimatedSize = PFHelpers::GetRequestBodyOverhead(TEXT("Benchmark")) + FMath::Max(0, Items.Num() - 1);
+				for (const FStoreItemRecord& Record : Items)
+				{
+					EstimatedSize += PFHelpers::EstimateCatalogItemJsonSize(Record, VersionSize);
+				}
+			}));
+		// The chunker splits requests by this estimate, so being off is a bug, not noise.
+		if (EstimatedSize != Body.Num())
+		{
+			OutErrors.Add(FString::Printf(TEXT("%d items: estimated body size %lld differs from the written %d bytes"), Size, EstimatedSize, Body.Num()));
+		}
+
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("CompressBody"), Size, Iterations, [&]()
+			{
+				TArray<uint8> Compressed = Body;
+				PFHelpers::CompressRequestBody(NAME_Gzip, Compressed);
+			}));
+		Body.Empty();
+
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("Validate"), Size, Iterations, [&]()
+			{
+				TArray<FString> Errors;
+				TArray<FString> Warnings;
+				PFHelpers::ValidateRecords(Items, Errors, Warnings);
+			}));
+
+		Stages.Add(Measure(CountingMalloc.Get(), TEXT("Cook"), Size, Iterations, [&]()
+			{
+				FStoreCatalogBuilder Builder;
+				for (const FStoreItemRecord& Record : Items)
+				{
+					Builder.AddItem(Record);
+				}
+				for (const FDropTableInfo& Table : Tables)
+				{
+					Builder.AddDropTable(Table);
+				}
+				TArray<uint8> Blob;
+				Builder.Build()->WriteCooked(Blob);
+			}));
+
+		TArray<TSharedPtr<FJsonValue>> StagesJson;
+		for (const FStageResult& Stage : Stages)
+		{
+			const double P50 = Percentile(Stage.Samples, 0.5);
+			const double P99 = Percentile(Stage.Samples, 0.99);
+
+			TSharedRef<FJsonObject> StageJson = MakeShared<FJsonObject>();
+			StageJson->SetStringField(TEXT("stage"), Stage.Name);
+			StageJson->SetNumberField(TEXT("items"), Stage.NumItems);
+			StageJson->SetNumberField(TEXT("iterations"), Stage.Samples.Num());
+			StageJson->SetNumberField(TEXT("p50Ms"), P50 * 1000.0);
+			StageJson->SetNumberField(TEXT("p99Ms"), P99 * 1000.0);
+			StageJson->SetNumberField(TEXT("itemsPerSecond"), P50 > 0.0 ? Stage.NumItems / P50 : 0.0);
+			StageJson->SetNumberField(TEXT("allocs"), static_cast<double>(Stage.AllocsPerRun));
+			StageJson->SetNumberField(TEXT("allocBytes"), static_cast<double>(Stage.BytesPerRun));
+
+			const FString Key = MakeStageKey(Size, Stage.Name);
+
+			TSharedRef<FJsonObject> BaselineEntry = MakeShared<FJsonObject>();
+			BaselineEntry->SetNumberField(TEXT("p50"), P50);
+			BaselineEntry->SetNumberField(TEXT("allocs"), static_cast<double>(Stage.AllocsPerRun));
+			NewBaselineStages->SetObjectField(Key, BaselineEntry);
+
+			const TSharedPtr<FJsonObject>* Previous = nullptr;
+			if (BaselineStages && (*BaselineStages)->TryGetObjectField(Key, Previous))
+			{
+				const double BaseP50 = (*Previous)->GetNumberField(TEXT("p50"));
+				const double BaseAllocs = (*Previous)->GetNumberField(TEXT("allocs"));
+				StageJson->SetNumberField(TEXT("baselineP50Ms"), BaseP50 * 1000.0);
+				StageJson->SetNumberField(TEXT("baselineAllocs"), BaseAllocs);
+
+				const bool bSlower = BaseP50 >= MinComparableSeconds && P50 > BaseP50 * (1.0 + Options.Tolerance);
+				const bool bMoreAllocs = Stage.AllocsPerRun > BaseAllocs * (1.0 + Options.Tolerance) + 16.0;
+				if (bSlower || bMoreAllocs)
+				{
+					StageJson->SetBoolField(TEXT("regression"), true);
+					Regressions.Add(MakeShared<FJsonValueString>(Key));
+					OutErrors.Add(FString::Printf(TEXT("%s regressed: p50 %.2f ms (baseline %.2f ms), %llu allocs (baseline %.0f)"),
+						*Key, P50 * 1000.0, BaseP50 * 1000.0, Stage.AllocsPerRun, BaseAllocs));
+				}
+			}
+
+			StagesJson.Add(MakeShared<FJsonValueObject>(StageJson));
+		}
+
+		TSharedRef<FJsonObject> RunJson = MakeShared<FJsonObject>();
+		RunJson->SetNumberField(TEXT("size"), Size);
+		RunJson->SetNumberField(TEXT("dropTables"), Tables.Num());
+		RunJson->SetArrayField(TEXT("stages"), StagesJson);
+		Runs.Add(MakeShared<FJsonValueObject>(RunJson));
+	}
+
+	OutResult->SetArrayField(TEXT("benchmark"), Runs);
+	OutResult->SetArrayField(TEXT("regressions"), Regressions);
+
+	if (!Options.WriteBaselinePath.IsEmpty())
+	{
+		TSharedRef<FJsonObject> BaselineJson = MakeShared<FJsonObject>();
+		BaselineJson->SetNumberField(TEXT("iterations"), Iterations);
+		BaselineJson->SetNumberField(TEXT("seed"), Options.Seed);
+		BaselineJson->SetObjectField(TEXT("stages"), NewBaselineStages);
+
+		FString BaselineText;
+		FJsonSerializer::Serialize(BaselineJson, TJsonWriterFactory<>::Create(&BaselineText));
+		if (!FFileHelper::SaveStringToFile(BaselineText, *Options.WriteBaselinePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			OutErrors.Add(FString::Printf(TEXT("Failed to write baseline %s"), *Options.WriteBaselinePath));
+		}
+	}
+
+	return Regressions.Num();
+}
@@ -0,0 +1,657 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "PFStoreCommandlet.h"
+
+#include "PFHelpers.h"
+#include "PFAdminScheduler.h"
+#include "PFRemoteCatalog.h"
+#include "PFStoreBenchmark.h"
+#include "PFStoreEditorSettings.h"
+#include "PFUploadJournal.h"
+#include "StoreBulkEdit.h"
+#include "StoreCatalogHistory.h"
+#include "StoreCatalogLoader.h"
+#include "StoreDropTableProvider.h"
+#include "StoreItemRecord.h"
+#include "StoreStats.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+#include "PlayFabCommon.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPFStoreCommandlet, Log, All);
+
+namespace PFStoreCommandletPrivate
+{
+	struct FContext
+	{
+		TArray<FString> Switches;
+		TMap<FString, FString> Params;
+
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		TArray<FString> Errors;
+		TArray<FString> Warnings;
+
+		FString Param(const TCHAR* Name, const FString& Default = FString()) const
+		{
+			const FString* Value = Params.Find(Name);
+			return Value && !Value->IsEmpty() ? Value->TrimQuotes() : Default;
+		}
+
+		bool HasSwitch(const TCHAR* Name) const
+		{
+			return Switches.ContainsByPredicate([Name](const FString& Switch) { return Switch.Equals(Name, ESearchCase::IgnoreCase); });
+		}
+
+		double GetTimeout() const
+		{
+			return FCString::Atod(*Param(TEXT("Timeout"), TEXT("120")));
+		}
+	};
+
+	static TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Values)
+	{
+		TArray<TSharedPtr<FJsonValue>> Out;
+		Out.Reserve(Values.Num());
+		for (const FString& Value : Values)
+		{
+			Out.Add(MakeShared<FJsonValueString>(Value));
+		}
+		return Out;
+	}
+
+	static TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FName>& Values)
+	{
+		TArray<TSharedPtr<FJsonValue>> Out;
+		Out.Reserve(Values.Num());
+		for (const FName Value : Values)
+		{
+			Out.Add(MakeShared<FJsonValueString>(Value.ToString()));
+		}
+		return Out;
+	}
+
+	/**
+	 * Pumps HTTP, the core ticker and game thread tasks, which is all the PlayFab SDK and the remote
+	 * catalog cache need to complete requests without the editor loop.
+	 */
+	static bool WaitFor(const TSharedRef<bool>& bDone, double TimeoutSeconds)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		double LastTime = StartTime;
+
+		while (!*bDone)
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (Now - StartTime > TimeoutSeconds)
+			{
+				return false;
+			}
+
+			const float DeltaTime = static_cast<float>(Now - LastTime);
+			LastTime = Now;
+
+			FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+			FTSTicker::GetCoreTicker().Tick(DeltaTime);
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::Sleep(0.01f);
+		}
+		return true;
+	}
+
+	static bool ConfigurePlayFab(FContext& Context)
+	{
+		IPlayFabCommonModuleInterface& PlayFabCommon = IPlayFabCommonModuleInterface::Get();
+
+		const FString TitleId = Context.Param(TEXT("TitleId"));
+		if (!TitleId.IsEmpty())
+		{
+			PlayFabCommon.SetTitleId(TitleId);
+		}
+
+		// Never on the command line, where it would end up in build logs.
+		const FString SecretEnv = Context.Param(TEXT("SecretEnv"), TEXT("PLAYFAB_DEVELOPER_SECRET"));
+		const FString Secret = FPlatformMisc::GetEnvironmentVariable(*SecretEnv);
+		if (!Secret.IsEmpty())
+		{
+			PlayFabCommon.SetDeveloperSecretKey(Secret);
+		}
+
+		if (PlayFabCommon.GetTitleId().IsEmpty() || PlayFabCommon.GetDeveloperSecretKey().IsEmpty())
+		{
+			Context.Errors.Add(FString::Printf(TEXT("PlayFab title id or developer secret missing (-TitleId, %s)"), *SecretEnv));
+			return false;
+		}
+		return true;
+	}
+
+	static FString GetCatalogVersion(const FContext& Context)
+	{
+		return Context.Param(TEXT("CatalogVersion"), GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion);
+	}
+
+	/**
+	 * The CSV or PlayFab JSON given with -In, or the provider assets of the project. Drop tables
+	 * come from a JSON file, the _DropTables.csv next to a CSV, or else from the drop table assets.
+	 */
+	static bool LoadLocal(FContext& Context, TArray<FStoreItemRecord>& OutRecords, TArray<FDropTableInfo>* OutDropTables = nullptr)
+	{
+		const FString InPath = Context.Param(TEXT("In"));
+		const bool bJson = FPaths::GetExtension(InPath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+		if (OutDropTables && !bJson)
+		{
+			PFHelpers::SnapshotDropTables(PFHelpers::FindAllStoreAssets(UStoreDropTableProvider::StaticClass()), *OutDropTables);
+		}
+
+		if (!InPath.IsEmpty())
+		{
+			Context.Result->SetStringField(TEXT("source"), InPath);
+			if (!PFHelpers::ImportRecordsFromFile(InPath, OutRecords, OutDropTables))
+			{
+				Context.Errors.Add(FString::Printf(TEXT("Failed to read %s"), *InPath));
+				return false;
+			}
+		}
+		else
+		{
+			Context.Result->SetStringField(TEXT("source"), TEXT("Assets"));
+			PFHelpers::SnapshotItems(PFHelpers::FindAllStoreAssets(UStoreItemProvider::StaticClass()), OutRecords);
+		}
+
+		Context.Result->SetNumberField(TEXT("items"), OutRecords.Num());
+		if (OutDropTables)
+		{
+			Context.Result->SetNumberField(TEXT("dropTables"), OutDropTables->Num());
+		}
+		return true;
+	}
+
+	/** Refreshes the remote catalog cache, so a CI run also leaves a current copy for the editor. */
+	static bool FetchRemote(FContext& Context, TArray<FStoreItemRecord>& OutRecords, TArray<FDropTableInfo>* OutDropTables = nullptr)
+	{
+		if (!ConfigurePlayFab(Context))
+		{
+			return false;
+		}
+
+		struct FState
+		{
+			bool bSuccess = false;
+			FString Error;
+		};
+		TSharedRef<FState> State = MakeShared<FState>();
+		TSharedRef<bool> bDone = MakeShared<bool>(false);
+
+		const FString CatalogVersion = GetCatalogVersion(Context);
+		FPFRemoteCatalogCache& Cache = FPFRemoteCatalogCache::Get();
+		Cache.Refresh(CatalogVersion, [State, bDone](bool bSuccess, const FString& Error)
+			{
+				State->bSuccess = bSuccess;
+				State->Error = Error;
+				*bDone = true;
+			});
+
+		// The parse runs on the task graph and reports back through the game thread queue.
+		if (!WaitFor(bDone, Context.GetTimeout()))
+		{
+			Context.Errors.Add(TEXT("Timed out fetching the remote catalog"));
+			return false;
+		}
+		const TSharedPtr<const FPFRemoteCatalog> Remote = Cache.GetCached(CatalogVersion);
+		if (!State->bSuccess || !Remote.IsValid())
+		{
+			Context.Errors.Add(FString::Printf(TEXT("Failed to fetch the remote catalog: %s"), *State->Error));
+			return false;
+		}
+
+		OutRecords = Remote->Items;
+		if (OutDropTables)
+		{
+			*OutDropTables = Remote->DropTables;
+			Context.Result->SetNumberField(TEXT("remoteDropTables"), OutDropTables->Num());
+		}
+		Context.Result->SetNumberField(TEXT("remoteItems"), OutRecords.Num());
+		return true;
+	}
+
+	/** Adds the findings to the result and reports whether the catalog may be published. */
+	static bool Validate(FContext& Context, const TArray<FStoreItemRecord>& Records)
+	{
+		const int32 NumErrors = PFHelpers::ValidateRecords(Records, Context.Errors, Context.Warnings);
+		Context.Result->SetNumberField(TEXT("validationErrors"), NumErrors);
+		return NumErrors == 0;
+	}
+
+	static EPFStoreCommandletResult RunExport(FContext& Context)
+	{
+		const FString OutPath = Context.Param(TEXT("Out"), FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PFStore"), TEXT("StoreCatalog.csv")));
+
+		TArray<FStoreItemRecord> Records;
+		PFHelpers::SnapshotItems(PFHelpers::FindAllStoreAssets(UStoreItemProvider::StaticClass()), Records);
+		Context.Result->SetNumberField(TEXT("items"), Records.Num());
+		Context.Result->SetStringField(TEXT("output"), OutPath);
+
+		TArray<FDropTableInfo> DropTables;
+		PFHelpers::SnapshotDropTables(PFHelpers::FindAllStoreAssets(UStoreDropTableProvider::StaticClass()), DropTables);
+		Context.Result->SetNumberField(TEXT("dropTables"), DropTables.Num());
+
+		bool bWritten;
+		if (FPaths::GetExtension(OutPath).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+		{
+			bWritten = PFHelpers::ExportRecordsToJson(Records, DropTables, GetCatalogVersion(Context), OutPath);
+		}
+		else
+		{
+			const FString DropTablesPath = PFHelpers::GetDropTablesCsvPath(OutPath);
+			Context.Result->SetStringField(TEXT("dropTablesOutput"), DropTablesPath);
+			bWritten = PFHelpers::ExportRecordsToCsv(Records, OutPath) && PFHelpers::ExportDropTablesToCsv(DropTables, DropTablesPath);
+		}
+
+		if (!bWritten)
+		{
+			Context.Errors.Add(FString::Printf(TEXT("Failed to write %s"), *OutPath));
+			return EPFStoreCommandletResult::IoError;
+		}
+		FStoreCatalogHistory::Get().AddSnapshot(GetCatalogVersion(Context), Records, DropTables, EStoreSnapshotSource::Export,
+			FPaths::GetCleanFilename(OutPath));
+		return EPFStoreCommandletResult::Success;
+	}
+
+	static EPFStoreCommandletResult RunCook(FContext& Context)
+	{
+		const FString OutPath = Context.Param(TEXT("Out"), FStoreCatalogLoader::GetDefaultCookedPath());
+
+		TArray<FStoreItemRecord> Records;
+		TArray<FDropTableInfo> DropTables;
+		if (!LoadLocal(Context, Records, &DropTables))
+		{
+			return EPFStoreCommandletResult::IoError;
+		}
+		Context.Result->SetStringField(TEXT("output"), OutPath);
+
+		if (!PFHelpers::CookRecords(Records, DropTables, OutPath))
+		{
+			Context.Errors.Add(FString::Printf(TEXT("Failed to write %s"), *OutPath));
+			return EPFStoreCommandletResult::IoError;
+		}
+		return EPFStoreCommandletResult::Success;
+	}
+
+	static EPFStoreCommandletResult RunImport(FContext& Context)
+	{
+		if (Context.Param(TEXT("In")).IsEmpty())
+		{
+			Context.Errors.Add(TEXT("Import needs -In=<csv|json>"));
+			return EPFStoreCommandletResult::UsageError;
+		}
+
+		TArray<FStoreItemRecord> Records;
+		if (!LoadLocal(Context, Records))
+		{
+			return EPFStoreCommandletResult::IoError;
+		}
+		return Validate(Context, Records) ? EPFStoreCommandletResult::Success : EPFStoreCommandletResult::ValidationFailed;
+	}
+
+	static EPFStoreCommandletResult RunValidate(FContext& Context)
+	{
+		TArray<FStoreItemRecord> Records;
+		if (!LoadLocal(Context, Records))
+		{
+			return EPFStoreCommandletResult::IoError;
+		}
+		return Validate(Context, Records) ? EPFStoreCommandletResult::Success : EPFStoreCommandletResult::ValidationFailed;
+	}
+
+	static EPFStoreCommandletResult RunDiff(FContext& Context)
+	{
+		TArray<FStoreItemRecord> Local;
+		if (!LoadLocal(Context, Local))
+		{
+			return EPFStoreCommandletResult::IoError;
+		}
+
+		const FString Against = Context.Param(TEXT("Against"), TEXT("Remote"));
+		Context.Result->SetStringField(TEXT("against"), Against);
+
+		TArray<FStoreItemRecord> Other;
+		if (Against == TEXT("Remote"))
+		{
+			if (!FetchRemote(Context, Other))
+			{
+				return EPFStoreCommandletResult::RemoteError;
+			}
+		}
+		else if (!PFHelpers::ImportRecordsFromFile(Against, Other))
+		{
+			Context.Errors.Add(FString::Printf(TEXT("Failed to read %s"), *Against));
+			return EPFStoreCommandletResult::IoError;
+		}
+
+		FStoreCatalogDiff Diff;
+		PFHelpers::DiffRecords(Local, Other, Diff);
+
+		TArray<TSharedPtr<FJsonValue>> Changed;
+		Changed.Reserve(Diff.Changed.Num());
+		for (const FStoreItemChange& Change : Diff.Changed)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("itemId"), Change.ItemId);
+			Entry->SetArrayField(TEXT("fields"), ToJsonArray(Change.Fields));
+			Changed.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+
+		TSharedRef<FJsonObject> DiffJson = MakeShared<FJsonObject>();
+		DiffJson->SetArrayField(TEXT("added"), ToJsonArray(Diff.Added));
+		DiffJson->SetArrayField(TEXT("removed"), ToJsonArray(Diff.Removed));
+		DiffJson->SetArrayField(TEXT("changed"), Changed);
+		Context.Result->SetObjectField(TEXT("diff"), DiffJson);
+
+		return Diff.IsEmpty() ? EPFStoreCommandletResult::Success : EPFStoreCommandletResult::DifferencesFound;
+	}
+
+	static EPFStoreCommandletResult RunBulkEdit(FContext& Context)
+	{
+		FStoreBulkEdit Edit;
+		Edit.Where = Context.Param(TEXT("Where"));
+		Context.Param(TEXT("Ids")).ParseIntoArray(Edit.ItemIds, TEXT(","));
+
+		FString Error;
+		if (!Edit.ParseActions(Context.Param(TEXT("Edit")), &Error))
+		{
+			Context.Errors.Add(FString::Printf(TEXT("-Edit: %s"), *Error));
+			return EPFStoreCommandletResult::UsageError;
+		}
+
+		TArray<FStoreItemRecord> Records;
+		PFHelpers::SnapshotItems(PFHelpers::FindAllStoreAssets(UStoreItemProvider::StaticClass()), Records);
+		Context.Result->SetNumberField(TEXT("items"), Records.Num());
+
+		FStoreBulkEditPreview Preview;
+		if (!Edit.Preview(Records, Preview, &Error))
+		{
+			Context.Errors.Add(FString::Printf(TEXT("-Where: %s"), *Error));
+			return EPFStoreCommandletResult::UsageError;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Changed;
+		Changed.Reserve(Preview.Num());
+		for (int32 Index = 0; Index < Preview.Num(); ++Index)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("itemId"), Preview.After[Index].ItemId);
+			Entry->SetArrayField(TEXT("fields"), ToJsonArray(Preview.Fields[Index]));
+			Changed.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+		Context.Result->SetNumberField(TEXT("selected"), Preview.NumSelected);
+		Context.Result->SetNumberField(TEXT("skipped"), Preview.NumSkipped);
+		Context.Result->SetArrayField(TEXT("changed"), Changed);
+
+		if (Context.HasSwitch(TEXT("DryRun")) || Preview.Num() == 0)
+		{
+			return EPFStoreCommandletResult::Success;
+		}
+
+		// Nothing undoes a commandlet run, so the edit is saved unless -NoSave.
+		FStoreApplyResult Result;
+		const bool bApplied = FStoreBulkEdit::Apply(Preview, !Context.HasSwitch(TEXT("NoSave")), Result);
+		Context.Result->SetNumberField(TEXT("assetsChanged"), Result.Changed);
+		Context.Result->SetNumberField(TEXT("packagesSaved"), Result.PackagesSaved);
+		for (const FString& ItemId : Result.ReadOnly)
+		{
+			Context.Errors.Add(FString::Printf(TEXT("%s: the asset does not support write-back"), *ItemId));
+		}
+		for (const FString& ItemId : Result.Incomplete)
+		{
+			Context.Errors.Add(FString::Printf(TEXT("%s: the asset has no property for some fields, see the log"), *ItemId));
+		}
+		return bApplied ? EPFStoreCommandletResult::Success : EPFStoreCommandletResult::IoError;
+	}
+
+	static EPFStoreCommandletResult RunUpload(FContext& Context)
+	{
+		TSharedRef<TArray<FStoreItemRecord>> SharedRecords = MakeShared<TArray<FStoreItemRecord>>();
+		TSharedRef<TArray<FDropTableInfo>> DropTables = MakeShared<TArray<FDropTableInfo>>();
+		TArray<FStoreItemRecord>& Records = *SharedRecords;
+		if (!LoadLocal(Context, Records, &DropTables.Get()))
+		{
+			return EPFStoreCommandletResult::IoError;
+		}
+		if (!Validate(Context, Records) && !Context.HasSwitch(TEXT("Force")))
+		{
+			return EPFStoreCommandletResult::ValidationFailed;
+		}
+
+		const FString CatalogVersion = GetCatalogVersion(Context);
+		Context.Result->SetStringField(TEXT("catalogVersion"), CatalogVersion);
+
+		// The items as one body, for inspection on the build machine. The publish itself serializes
+		// its requests on workers while earlier ones are in flight.
+		const FString OutPath = Context.Param(TEXT("Out"));
+		if (!OutPath.IsEmpty() || Context.HasSwitch(TEXT("DryRun")))
+		{
+			TArray<uint8> Body;
+			PFHelpers::WriteUpdateCatalogItemsBody(Records, CatalogVersion, Body);
+			Context.Result->SetNumberField(TEXT("requestBytes"), Body.Num());
+
+			if (!OutPath.IsEmpty())
+			{
+				if (!FFileHelper::SaveArrayToFile(Body, *OutPath))
+				{
+					Context.Errors.Add(FString::Printf(TEXT("Failed to write %s"), *OutPath));
+					return EPFStoreCommandletResult::IoError;
+				}
+				Context.Result->SetStringField(TEXT("output"), OutPath);
+			}
+		}
+
+		if (Context.HasSwitch(TEXT("DryRun")))
+		{
+			Context.Result->SetBoolField(TEXT("dryRun"), true);
+			return EPFStoreCommandletResult::Success;
+		}
+
+		if (!ConfigurePlayFab(Context))
+		{
+			return EPFStoreCommandletResult::RemoteError;
+		}
+
+		TSharedRef<bool> bDone = MakeShared<bool>(false);
+		TSharedRef<TArray<FString>> Errors = MakeShared<TArray<FString>>();
+
+		// A resumed publish sends what is left; the full set is the sync base once it is done.
+		TSharedRef<const TArray<FStoreItemRecord>> ToSendRecords = SharedRecords;
+		TSharedRef<const TArray<FDropTableInfo>> ToSendTables = DropTables;
+		const bool bResume = Context.HasSwitch(TEXT("Resume"));
+		FPFUploadJournal::FLanded Landed;
+		if (bResume && FPFUploadJournal::ReadLanded(CatalogVersion, Landed))
+		{
+			TSharedRef<TArray<FStoreItemRecord>> RemainingRecords = MakeShared<TArray<FStoreItemRecord>>(Records);
+			TSharedRef<TArray<FDropTableInfo>> RemainingTables = MakeShared<TArray<FDropTableInfo>>(*DropTables);
+			Context.Result->SetNumberField(TEXT("alreadyLanded"), PFHelpers::RemoveLanded(Landed, *RemainingRecords, *RemainingTables));
+			ToSendRecords = RemainingRecords;
+			ToSendTables = RemainingTables;
+		}
+		const TSharedPtr<FPFUploadJournal> Journal = FPFUploadJournal::Begin(CatalogVersion, bResume);
+
+		// Items, drop tables and the items that hand out drop tables, in dependency order.
+		TSharedRef<FPFAdminScheduler> Scheduler = MakeShared<FPFAdminScheduler>();
+		PFHelpers::AddPublishTasks(*Scheduler, ToSendRecords, ToSendTables, CatalogVersion, Journal);
+		Context.Result->SetNumberField(TEXT("requests"), Scheduler->Num());
+		Scheduler->Run([bDone, Errors](bool bSuccess, const TArray<FString>& InErrors)
+			{
+				*Errors = InErrors;
+				*bDone = true;
+			});
+
+		if (!WaitFor(bDone, Context.GetTimeout()))
+		{
+			Context.Errors.Add(TEXT("Timed out uploading the catalog"));
+			return EPFStoreCommandletResult::RemoteError;
+		}
+		if (Errors->Num() > 0)
+		{
+			for (const FString& Error : *Errors)
+			{
+				Context.Errors.Add(FString::Printf(TEXT("Failed to update catalog: %s"), *Error));
+			}
+			return EPFStoreCommandletResult::RemoteError;
+		}
+		if (Journal.IsValid())
+		{
+			Journal->Finish();
+		}
+		FStoreCatalogHistory::Get().AddSnapshot(CatalogVersion, Records, DropTables.Get(), EStoreSnapshotSource::Upload,
+			FPaths::GetCleanFilename(Context.Param(TEXT("In"))));
+
+		// Uploading the assets brings both sides in sync; a file says nothing about the assets.
+		if (Context.Param(TEXT("In")).IsEmpty())
+		{
+			FPFRemoteCatalogCache::Get().SetSyncBase(CatalogVersion, MoveTemp(Records), &DropTables.Get());
+		}
+		return EPFStoreCommandletResult::Success;
+	}
+
+	static EPFStoreCommandletResult RunBenchmark(FContext& Context)
+	{
+		FPFStoreBenchmarkOptions Options;
+
+		const FString Sizes = Context.Param(TEXT("Sizes"));
+		if (!Sizes.IsEmpty())
+		{
+			TArray<FString> SizeStrings;
+			Sizes.ParseIntoArray(SizeStrings, TEXT(","), true);
+
+			Options.Sizes.Reset();
+			for (const FString& Size : SizeStrings)
+			{
+				const int32 NumItems = FCString::Atoi(*Size);
+				if (NumItems > 0)
+				{
+					Options.Sizes.Add(NumItems);
+				}
+			}
+		}
+
+		Options.Iterations = FCString::Atoi(*Context.Param(TEXT("Iterations"), FString::FromInt(Options.Iterations)));
+		Options.Seed = FCString::Atoi(*Context.Param(TEXT("Seed"), FString::FromInt(Options.Seed)));
+		Options.Tolerance = FCString::Atod(*Context.Param(TEXT("Tolerance"), FString::SanitizeFloat(Options.Tolerance)));
+		Options.BaselinePath = Context.Param(TEXT("Baseline"));
+		Options.WriteBaselinePath = Context.Param(TEXT("WriteBaseline"));
+
+		const int32 NumRegressions = FPFStoreBenchmark::Run(Options, Context.Result, Context.Errors);
+		if (NumRegressions > 0)
+		{
+			return EPFStoreCommandletResult::BenchmarkRegression;
+		}
+		return Context.Errors.Num() > 0 ? EPFStoreCommandletResult::IoError : EPFStoreCommandletResult::Success;
+	}
+}
+
+UPFStoreCommandlet::UPFStoreCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+
+	HelpDescription = TEXT("Export, cook, validate, diff, upload and benchmark the PlayFab store catalog without the editor UI.");
+	HelpUsage = TEXT("-run=PFStore -Mode=<Export|Cook|Import|Validate|Diff|BulkEdit|Upload|Benchmark> [-In=<csv|json>] [-Out=<path>] [-Against=<Remote|csv|json>] [-Json=<path>]");
+}
+
+int32 UPFStoreCommandlet::Main(const FString& Params)
+{
+	using namespace PFStoreCommandletPrivate;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FContext Context;
+	TArray<FString> Tokens;
+	ParseCommandLine(*Params, Tokens, Context.Switches, Context.Params);
+
+	const FString Mode = Context.Param(TEXT("Mode"));
+
+	EPFStoreCommandletResult Result;
+	if (Mode == TEXT("Export"))
+	{
+		Result = RunExport(Context);
+	}
+	else if (Mode == TEXT("Cook"))
+	{
+		Result = RunCook(Context);
+	}
+	else if (Mode == TEXT("Import"))
+	{
+		Result = RunImport(Context);
+	}
+	else if (Mode == TEXT("Validate"))
+	{
+		Result = RunValidate(Context);
+	}
+	else if (Mode == TEXT("Diff"))
+	{
+		Result = RunDiff(Context);
+	}
+	else if (Mode == TEXT("BulkEdit"))
+	{
+		Result = RunBulkEdit(Context);
+	}
+	else if (Mode == TEXT("Upload"))
+	{
+		Result = RunUpload(Context);
+	}
+	else if (Mode == TEXT("Benchmark"))
+	{
+		Result = RunBenchmark(Context);
+	}
+	else
+	{
+		Context.Errors.Add(FString::Printf(TEXT("Unknown -Mode '%s'. %s"), *Mode, *HelpUsage));
+		Result = EPFStoreCommandletResult::UsageError;
+	}
+
+	for (const FString& Error : Context.Errors)
+	{
+		UE_LOG(LogPFStoreCommandlet, Error, TEXT("%s"), *Error);
+	}
+	for (const FString& Warning : Context.Warnings)
+	{
+		UE_LOG(LogPFStoreCommandlet, Warning, TEXT("%s"), *Warning);
+	}
+
+	Context.Result->SetStringField(TEXT("mode"), Mode);
+	Context.Result->SetBoolField(TEXT("success"), Result == EPFStoreCommandletResult::Success);
+	Context.Result->SetNumberField(TEXT("exitCode"), static_cast<int32>(Result));
+	Context.Result->SetNumberField(TEXT("seconds"), FPlatformTime::Seconds() - StartTime);
+	Context.Result->SetArrayField(TEXT("errors"), ToJsonArray(Context.Errors));
+	Context.Result->SetArrayField(TEXT("warnings"), ToJsonArray(Context.Warnings));
+
+	FString Json;
+	{
+		PFSTORE_SCOPE(JsonSerialize);
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Context.Result, Writer);
+	}
+
+	const FString JsonPath = Context.Param(TEXT("Json"));
+	if (JsonPath.IsEmpty())
+	{
+		UE_LOG(LogPFStoreCommandlet, Display, TEXT("%s"), *Json);
+	}
+	else if (!FFileHelper::SaveStringToFile(Json, *JsonPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogPFStoreCommandlet, Error, TEXT("Failed to write %s"), *JsonPath);
+		return static_cast<int32>(EPFStoreCommandletResult::IoError);
+	}
+
+	return static_cast<int32>(Result);
+}
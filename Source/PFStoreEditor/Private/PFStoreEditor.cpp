@@ -3,6 +3,9 @@
 #include "PFStoreEditor.h"
 #include "PFStoreEditorStyle.h"
 #include "PFStoreEditorCommands.h"
+#include "CurrencyAmountsCustomization.h"
+#include "StoreCurrency.h"
+#include "PropertyEditorModule.h"
 #include "LevelEditor.h"
 #include "SStoreManagerPanel.h"
 #include "Widgets/Docking/SDockTab.h"
@@ -33,6 +36,10 @@ void FPFStoreEditorModule::StartupModule()
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(PFStoreEditorTabName, FOnSpawnTab::CreateRaw(this, &FPFStoreEditorModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FPFStoreEditorTabTitle", "PFStoreEditor"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	PropertyModule.RegisterCustomPropertyTypeLayout(FCurrencyAmounts::StaticStruct()->GetFName(),
+		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FCurrencyAmountsCustomization::MakeInstance));
 }
 
 void FPFStoreEditorModule::ShutdownModule()
@@ -46,6 +53,11 @@ void FPFStoreEditorModule::ShutdownModule()
 	FPFStoreEditorCommands::Unregister();
 
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(PFStoreEditorTabName);
+
+	if (FPropertyEditorModule* PropertyModule = FModuleManager::GetModulePtr<FPropertyEditorModule>("PropertyEditor"))
+	{
+		PropertyModule->UnregisterCustomPropertyTypeLayout(FCurrencyAmounts::StaticStruct()->GetFName());
+	}
 }
 
 TSharedRef<SDockTab> FPFStoreEditorModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
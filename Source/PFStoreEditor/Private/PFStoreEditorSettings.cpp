@@ -5,4 +5,10 @@
 UPFStoreEditorSettings::UPFStoreEditorSettings()
 {
     DefaultCatalogVersion = TEXT("Main");
+    RemoteCacheMaxAgeMinutes = 10;
+    MaxCatalogHistorySnapshots = 100;
+    MaxConcurrentAdminRequests = 4;
+    AdminRequestsPerSecond = 5.f;
+    MaxAdminRequestKilobytes = 1024;
+    AdminRequestCompression = EPFRequestCompression::None;
 }
\ No newline at end of file
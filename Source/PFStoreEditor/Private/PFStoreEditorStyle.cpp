@@ -6,6 +6,8 @@
 #include "Slate/SlateGameResources.h"
 #include "Interfaces/IPluginManager.h"
 #include "Styling/SlateStyleMacros.h"
+#include "Styling/CoreStyle.h"
+#include "Brushes/SlateColorBrush.h"
 
 #define RootToContentDir Style->RootToContentDir
 
@@ -43,6 +45,19 @@ TSharedRef< FSlateStyleSet > FPFStoreEditorStyle::Create()
 
 	Style->Set("PFStoreEditor.OpenPluginWindow", new IMAGE_BRUSH_SVG(TEXT("PlaceholderButtonIcon"), Icon20x20));
 
+	// Rich text runs of the field text diff
+	const FTextBlockStyle DiffText = FTextBlockStyle(FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText"))
+		.SetFont(DEFAULT_FONT("Mono", 9));
+	const FLinearColor DeletedColor(1.f, 0.45f, 0.45f);
+	const FLinearColor InsertedColor(0.45f, 1.f, 0.5f);
+	Style->Set("PFStoreEditor.Diff.Text", DiffText);
+	Style->Set("PFStoreEditor.Diff.Deleted", FTextBlockStyle(DiffText)
+		.SetColorAndOpacity(DeletedColor)
+		.SetUnderlineBrush(FSlateColorBrush(DeletedColor)));
+	Style->Set("PFStoreEditor.Diff.Inserted", FTextBlockStyle(DiffText)
+		.SetColorAndOpacity(InsertedColor)
+		.SetUnderlineBrush(FSlateColorBrush(InsertedColor)));
+
 	return Style;
 }
 
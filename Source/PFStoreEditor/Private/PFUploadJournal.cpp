@@ -0,0 +1,293 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "PFUploadJournal.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace PFUploadJournalPrivate
+{
+	static constexpr uint32 Magic = 0x4A554650; // "PFUJ"
+
+	/** Bump whenever the record layout changes; older journals are then ignored. */
+	static constexpr uint32 Version = 1;
+
+	enum class ERecord : uint8
+	{
+		Request,
+		Landed,
+	};
+
+	struct FPlannedRequest
+	{
+		bool bDropTables = false;
+		TArray<FString> Ids;
+		TArray<uint64> Hashes;
+	};
+
+	/**
+	 * Walks the records of a journal file. A record cut short by a crash ends the walk without an
+	 * error: everything before it is still valid. OutValidEnd receives the offset right after the
+	 * last valid record, which is where a resumed publish must append.
+	 */
+	static bool ReadJournal(const FString& Path, TMap<int32, FPlannedRequest>& OutRequests, TArray<int32>& OutLanded, int64* OutValidEnd = nullptr)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		FMemoryReader Reader(Bytes);
+		uint32 FileMagic = 0;
+		uint32 FileVersion = 0;
+		if (Bytes.Num() < 8)
+		{
+			return false;
+		}
+		Reader << FileMagic << FileVersion;
+		if (FileMagic != Magic || FileVersion != Version)
+		{
+			return false;
+		}
+		int64 ValidEnd = Reader.Tell();
+
+		while (Reader.Tell() + 5 <= Reader.TotalSize())
+		{
+			uint32 Size = 0;
+			uint8 Type = 0;
+			Reader << Size;
+			if (Size == 0 || Reader.Tell() + Size > Reader.TotalSize())
+			{
+				break;
+			}
+			const int64 End = Reader.Tell() + Size;
+			Reader << Type;
+
+			// Parsed aside and kept only once the whole record checks out.
+			int32 Index = INDEX_NONE;
+			Reader << Index;
+			FPlannedRequest Request;
+			if (Type == static_cast<uint8>(ERecord::Request))
+			{
+				uint8 bDropTables = 0;
+				Reader << bDropTables << Request.Ids << Request.Hashes;
+				Request.bDropTables = bDropTables != 0;
+			}
+			else if (Type != static_cast<uint8>(ERecord::Landed))
+			{
+				break;
+			}
+
+			if (Reader.IsError() || Reader.Tell() != End)
+			{
+				break;
+			}
+			if (Type == static_cast<uint8>(ERecord::Request))
+			{
+				OutRequests.Add(Index, MoveTemp(Request));
+			}
+			else
+			{
+				OutLanded.Add(Index);
+			}
+			ValidEnd = End;
+		}
+
+		if (OutValidEnd)
+		{
+			*OutValidEnd = ValidEnd;
+		}
+		return true;
+	}
+}
+
+FString FPFUploadJournal::GetJournalPath(const FString& CatalogVersion)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PFStore"), TEXT("UploadJournal"), CatalogVersion + TEXT(".pfjournal"));
+}
+
+bool FPFUploadJournal::HasUnfinished(const FString& CatalogVersion)
+{
+	return IFileManager::Get().FileExists(*GetJournalPath(CatalogVersion));
+}
+
+bool FPFUploadJournal::ReadLanded(const FString& CatalogVersion, FLanded& OutLanded)
+{
+	using namespace PFUploadJournalPrivate;
+
+	OutLanded.Items.Reset();
+	OutLanded.DropTables.Reset();
+
+	TMap<int32, FPlannedRequest> Requests;
+	TArray<int32> Landed;
+	if (!ReadJournal(GetJournalPath(CatalogVersion), Requests, Landed))
+	{
+		return false;
+	}
+
+	// In file order, so a record sent again after an edit ends up with the hash that landed last.
+	for (const int32 Index : Landed)
+	{
+		if (const FPlannedRequest* Request = Requests.Find(Index))
+		{
+			TMap<FString, uint64>& Target = Request->bDropTables ? OutLanded.DropTables : OutLanded.Items;
+			for (int32 i = 0; i < Request->Ids.Num() && i < Request->Hashes.Num(); ++i)
+			{
+				Target.Add(Request->Ids[i], Request->Hashes[i]);
+			}
+		}
+	}
+	return true;
+}
+
+TSharedPtr<FPFUploadJournal> FPFUploadJournal::Begin(const FString& CatalogVersion, bool bResume)
+{
+	using namespace PFUploadJournalPrivate;
+
+	TSharedPtr<FPFUploadJournal> Journal = MakeShareable(new FPFUploadJournal());
+	Journal->Path = GetJournalPath(CatalogVersion);
+
+	TMap<int32, FPlannedRequest> Requests;
+	TArray<int32> Landed;
+	int64 ValidEnd = 0;
+	bool bAppend = bResume && ReadJournal(Journal->Path, Requests, Landed, &ValidEnd);
+	for (const TPair<int32, FPlannedRequest>& Pair : Requests)
+	{
+		Journal->NumRequests = FMath::Max(Journal->NumRequests, Pair.Key + 1);
+	}
+
+	// A record torn by the crash would swallow whatever is appended after it; keep only the
+	// valid records before appending, as StoreCatalogHistory does.
+	if (bAppend && ValidEnd < IFileManager::Get().FileSize(*Journal->Path))
+	{
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *Journal->Path, FILEREAD_Silent) && ValidEnd <= Bytes.Num())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Upload journal %s ends in a partial record, dropping it"), *Journal->Path);
+			Bytes.SetNum(static_cast<int32>(ValidEnd));
+			bAppend = FFileHelper::SaveArrayToFile(Bytes, *Journal->Path);
+		}
+		else
+		{
+			bAppend = false;
+		}
+		if (!bAppend)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Could not repair upload journal %s, starting it over"), *Journal->Path);
+			Journal->NumRequests = 0;
+		}
+	}
+
+	Journal->Writer.Reset(IFileManager::Get().CreateFileWriter(*Journal->Path, bAppend ? FILEWRITE_Append : FILEWRITE_None));
+	if (!Journal->Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not open upload journal %s, the publish will not be resumable"), *Journal->Path);
+		return nullptr;
+	}
+
+	if (!bAppend)
+	{
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = Version;
+		*Journal->Writer << FileMagic << FileVersion;
+	}
+	return Journal;
+}
+
+FPFUploadJournal::~FPFUploadJournal()
+{
+	if (FlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+	}
+	if (Writer)
+	{
+		Flush();
+		Writer->Close();
+	}
+}
+
+int32 FPFUploadJournal::AddRequest(bool bDropTables, TConstArrayView<FString> Ids, TConstArrayView<uint64> Hashes)
+{
+	const int32 Index = NumRequests++;
+	Append(static_cast<uint8>(PFUploadJournalPrivate::ERecord::Request), [Index, bDropTables, Ids, Hashes](FArchive& Ar)
+		{
+			int32 OutIndex = Index;
+			uint8 bOutDropTables = bDropTables ? 1 : 0;
+			int32 Num = Ids.Num();
+			Ar << OutIndex << bOutDropTables << Num;
+			for (const FString& Id : Ids)
+			{
+				Ar << const_cast<FString&>(Id);
+			}
+			Num = Hashes.Num();
+			Ar << Num;
+			Ar.Serialize(const_cast<uint64*>(Hashes.GetData()), Hashes.Num() * sizeof(uint64));
+		});
+	return Index;
+}
+
+void FPFUploadJournal::MarkLanded(int32 Request)
+{
+	Append(static_cast<uint8>(PFUploadJournalPrivate::ERecord::Landed), [Request](FArchive& Ar)
+		{
+			int32 Index = Request;
+			Ar << Index;
+		});
+
+	if (!FlushHandle.IsValid())
+	{
+		FlushHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+			{
+				FlushHandle.Reset();
+				Flush();
+				return false;
+			}));
+	}
+}
+
+void FPFUploadJournal::Flush()
+{
+	if (!Writer || Pending.Num() == 0)
+	{
+		return;
+	}
+	Writer->Serialize(Pending.GetData(), Pending.Num());
+	Writer->Flush();
+	Pending.Reset();
+}
+
+void FPFUploadJournal::Finish()
+{
+	if (FlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+		FlushHandle.Reset();
+	}
+	Pending.Reset();
+	if (Writer)
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+	IFileManager::Get().Delete(*Path, false, false, true);
+}
+
+void FPFUploadJournal::Append(uint8 Type, TFunctionRef<void(FArchive&)> Write)
+{
+	// [size][type][payload], the size patched in once the payload is written.
+	FMemoryWriter Ar(Pending, false, true);
+
+	const int64 SizeOffset = Ar.Tell();
+	uint32 Size = 0;
+	Ar << Size << Type;
+	Write(Ar);
+
+	Size = static_cast<uint32>(Ar.Tell() - SizeOffset - sizeof(uint32));
+	Ar.Seek(SizeOffset);
+	Ar << Size;
+}
@@ -4,10 +4,74 @@
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SSplitter.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Misc/MessageDialog.h"
 #include "ItemDiffWindow.h"
+#include "PFHelpers.h"
+#include "PFRemoteCatalog.h"
+#include "PFStoreEditorSettings.h"
+#include "StoreCatalogHistory.h"
+#include "StoreJson.h"
+#include "Algo/Reverse.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace CompareAndMergePrivate
+{
+    enum ETypeTab : int32
+    {
+        Items = 0,
+        Bundles = 1,
+        Containers = 2,
+        DropTables = 3,
+    };
+
+    static int32 GetTypeTab(const FStoreItemRecord& Record)
+    {
+        return Record.bIsBundle ? Bundles : Record.bIsContainer ? Containers : Items;
+    }
+
+    static const TCHAR* GetKindLabel(EStoreMergeConflict Kind)
+    {
+        switch (Kind)
+        {
+        case EStoreMergeConflict::DeletedInEditor:
+            return TEXT("deleted in Editor, changed on PlayFab");
+        case EStoreMergeConflict::DeletedInPlayFab:
+            return TEXT("deleted on PlayFab, changed in Editor");
+        case EStoreMergeConflict::OnlyInEditor:
+            return TEXT("only in Editor (never synced: new in Editor or deleted on PlayFab)");
+        case EStoreMergeConflict::OnlyInPlayFab:
+            return TEXT("only on PlayFab (never synced: new on PlayFab or deleted in Editor)");
+        default:
+            return TEXT("");
+        }
+    }
+
+    /** The diff window works on DOM objects, so round-trip the record through its PlayFab JSON. */
+    static TSharedPtr<FJsonObject> ToJsonObject(const FStoreItemRecord* Record, const FString& CatalogVersion)
+    {
+        TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+        if (!Record)
+        {
+            return Object;
+        }
+
+        TArray<uint8> Bytes;
+        {
+            FStoreJsonWriter Writer(Bytes);
+            PFHelpers::WriteCatalogItemJson(Writer, *Record, CatalogVersion);
+        }
+        const FString Json(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num()));
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        FJsonSerializer::Deserialize(Reader, Object);
+        return Object;
+    }
+}
 
 void SCompareAndMergePanel::Construct(const FArguments& InArgs)
 {
@@ -17,6 +81,9 @@ void SCompareAndMergePanel::Construct(const FArguments& InArgs)
     DiffRows.Empty();
     OnCompareRequest = InArgs._OnCompareRequest;
 
+    RemoteUpdatedHandle = FPFRemoteCatalogCache::Get().OnUpdated().AddSP(this, &SCompareAndMergePanel::OnRemoteCatalogUpdated);
+    RefreshCompareOptions();
+
     ChildSlot
         [
             SNew(SBorder)
@@ -26,12 +93,61 @@ void SCompareAndMergePanel::Construct(const FArguments& InArgs)
 
                         + SVerticalBox::Slot()
                         .AutoHeight()
-                        .HAlign(HAlign_Left)
                         .Padding(0, 0, 0, 4)
                         [
-                            SNew(SButton)
-                                .Text(FText::FromString(TEXT("Show Diffs")))
-                                .OnClicked(this, &SCompareAndMergePanel::OnShowDiffsClicked)
+                            SNew(SHorizontalBox)
+
+                                + SHorizontalBox::Slot().AutoWidth()
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Show Diffs")))
+                                        .OnClicked(this, &SCompareAndMergePanel::OnShowDiffsClicked)
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8, 0, 4, 0)
+                                [
+                                    SNew(STextBlock)
+                                        .Text(FText::FromString(TEXT("against")))
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth()
+                                [
+                                    SNew(SComboBox<TSharedPtr<int32>>)
+                                        .OptionsSource(&CompareOptions)
+                                        .InitiallySelectedItem(SelectedCompareOption)
+                                        .ToolTipText(FText::FromString(TEXT("PlayFab, or a snapshot of the editor's catalog taken at an export, upload or merge")))
+                                        .OnComboBoxOpening(this, &SCompareAndMergePanel::RefreshCompareOptions)
+                                        .OnGenerateWidget_Lambda([this](TSharedPtr<int32> Option)
+                                            {
+                                                return SNew(STextBlock).Text(GetCompareOptionText(Option));
+                                            })
+                                        .OnSelectionChanged_Lambda([this](TSharedPtr<int32> Option, ESelectInfo::Type)
+                                            {
+                                                if (Option.IsValid())
+                                                {
+                                                    SelectedCompareOption = Option;
+                                                }
+                                            })
+                                        [
+                                            SNew(STextBlock)
+                                                .Text_Lambda([this]() { return GetCompareOptionText(SelectedCompareOption); })
+                                        ]
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().Padding(4, 0, 0, 0)
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Resolve All...")))
+                                        .ToolTipText(FText::FromString(TEXT("Every conflicting field of every item in one grid, with bulk decisions")))
+                                        .IsEnabled_Lambda([this]() { return Session.IsValid() && Session->NumUnresolved() > 0; })
+                                        .OnClicked(this, &SCompareAndMergePanel::OnOpenMergeGridClicked)
+                                ]
+
+                                + SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center).Padding(8, 0, 0, 0)
+                                [
+                                    SNew(STextBlock)
+                                        .Text(this, &SCompareAndMergePanel::GetRemoteStatusText)
+                                ]
                         ]
 
                         + SVerticalBox::Slot()
@@ -132,6 +248,8 @@ void SCompareAndMergePanel::Construct(const FArguments& InArgs)
                                                 [
                                                     SNew(SButton)
                                                         .Text(FText::FromString(TEXT("Save to Editor")))
+                                                        .IsEnabled_Lambda([this]() { return Session.IsValid() && Session->Remote.IsValid(); })
+                                                        .OnClicked(this, &SCompareAndMergePanel::OnSaveToEditorClicked)
                                                 ]
                                         ]
                                 ]
@@ -140,37 +258,377 @@ void SCompareAndMergePanel::Construct(const FArguments& InArgs)
         ];
 }
 
+SCompareAndMergePanel::~SCompareAndMergePanel()
+{
+    FPFRemoteCatalogCache::Get().OnUpdated().Remove(RemoteUpdatedHandle);
+}
+
 FReply SCompareAndMergePanel::OnShowDiffsClicked()
 {
     bShowDiffs = true;
+
+    const UPFStoreEditorSettings* Settings = GetDefault<UPFStoreEditorSettings>();
+    CatalogVersion = Settings->DefaultCatalogVersion;
+
+    Session = MakeShared<FStoreMergeSession>();
+    Session->CatalogVersion = CatalogVersion;
+    PFHelpers::SnapshotItems(PFHelpers::FindAllStoreAssets(UStoreItemProvider::StaticClass()), Session->Local);
+    PFHelpers::SnapshotDropTables(PFHelpers::FindAllStoreAssets(UStoreDropTableProvider::StaticClass()), LocalDropTables);
+
+    CompareSnapshot.Reset();
+    SnapshotChangesText.Empty();
+    if (SelectedCompareOption.IsValid() && CompareSnapshots.IsValidIndex(*SelectedCompareOption))
+    {
+        CompareSnapshot = CompareSnapshots[*SelectedCompareOption];
+    }
+
+    if (CompareSnapshot.IsValid())
+    {
+        Remote = CompareSnapshot->ToCatalog(CatalogVersion);
+
+        // Snapshots share unchanged subtrees, so this walks only what changed since.
+        const TArray<TSharedRef<const FStoreCatalogSnapshot>>& Snapshots = FStoreCatalogHistory::Get().GetSnapshots(CatalogVersion);
+        if (Snapshots.Num() > 0 && Snapshots.Last() != CompareSnapshot.ToSharedRef())
+        {
+            int32 Added = 0;
+            int32 Removed = 0;
+            int32 Changed = 0;
+            FStoreItemTrie::Diff(CompareSnapshot->Items, Snapshots.Last()->Items,
+                [&Added, &Removed, &Changed](const FStoreItemRecord* Old, const FStoreItemRecord* New)
+                {
+                    Added += Old ? 0 : 1;
+                    Removed += New ? 0 : 1;
+                    Changed += (Old && New) ? 1 : 0;
+                });
+            SnapshotChangesText = FString::Printf(TEXT(" | up to the latest snapshot: %d added, %d removed, %d changed"), Added, Removed, Changed);
+        }
+    }
+    else
+    {
+        // Diff against the cached copy right away; a newer download arrives through OnRemoteCatalogUpdated.
+        Remote = FPFRemoteCatalogCache::Get().GetAndRevalidate(CatalogVersion, FTimespan::FromMinutes(Settings->RemoteCacheMaxAgeMinutes));
+    }
+    RebuildDiffRows();
+
+    return FReply::Handled();
+}
+
+void SCompareAndMergePanel::OnRemoteCatalogUpdated(TSharedRef<const FPFRemoteCatalog> Catalog)
+{
+    if (bShowDiffs && !CompareSnapshot.IsValid() && Catalog->CatalogVersion == CatalogVersion)
+    {
+        Remote = Catalog;
+        RebuildDiffRows();
+    }
+}
+
+void SCompareAndMergePanel::RebuildDiffRows()
+{
+    MergedDropTables.Empty();
+    DropTableConflicts.Empty();
+    if (!Session.IsValid())
+    {
+        return;
+    }
+
+    // An open merge grid keeps working on its own session; this one starts over.
+    if (Session.GetSharedReferenceCount() > 1)
+    {
+        TSharedPtr<FStoreMergeSession> Next = MakeShared<FStoreMergeSession>();
+        Next->CatalogVersion = Session->CatalogVersion;
+        Next->Local = Session->Local;
+        Session = Next;
+    }
+
+    ++MergeGeneration;
+    Session->Remote = Remote;
+    Session->Result = FStoreMergeResult();
+    if (Remote.IsValid())
+    {
+        // Without a base (never synced) every difference is a conflict, as in a plain two-way diff,
+        // including items on one side only. A snapshot is always diffed that way: it shows what
+        // changed since, whichever side changed it.
+        const TSharedPtr<const FPFRemoteCatalog> Base = CompareSnapshot.IsValid() ? nullptr : FPFRemoteCatalogCache::Get().GetSyncBase(CatalogVersion);
+
+        PFHelpers::MergeRecords(Base.IsValid() ? &Base->Items : nullptr, Session->Local, Remote->Items, Session->Result);
+        PFHelpers::MergeDropTables(Base.IsValid() ? &Base->DropTables : nullptr, LocalDropTables, Remote->DropTables,
+            MergedDropTables, DropTableConflicts);
+    }
+    Session->Removed.Init(false, Session->Result.Merged.Num());
+    Session->Resolved.Init(false, Session->Result.Conflicts.Num());
+
+    RefreshConflictRows();
+}
+
+void SCompareAndMergePanel::RefreshConflictRows()
+{
+    using namespace CompareAndMergePrivate;
+
     AllDiffRows.Empty();
+    if (!Session.IsValid())
     {
-        FCompareDiffRowPtr Row1 = MakeShared<FCompareDiffRow>();
-        Row1->ItemId = TEXT("Item_Sword");
-        AllDiffRows.Add(Row1);
+        ApplyFilter();
+        return;
+    }
 
-        FCompareDiffRowPtr Row2 = MakeShared<FCompareDiffRow>();
-        Row2->ItemId = TEXT("Item_Axe");
-        AllDiffRows.Add(Row2);
+    const FStoreMergeResult& Merge = Session->Result;
+    AllDiffRows.Reserve(Session->NumUnresolved() + DropTableConflicts.Num());
+    for (int32 Index = 0; Index < Merge.Conflicts.Num(); ++Index)
+    {
+        if (Session->Resolved[Index])
+        {
+            continue;
+        }
 
-        FCompareDiffRowPtr Row3 = MakeShared<FCompareDiffRow>();
-        Row3->ItemId = TEXT("Item_Shld");
-        AllDiffRows.Add(Row3);
+        const FStoreItemConflict& Conflict = Merge.Conflicts[Index];
+        FCompareDiffRowPtr Row = MakeShared<FCompareDiffRow>();
+        Row->ItemId = Conflict.ItemId;
+        Row->TypeTab = GetTypeTab(Merge.Merged[Conflict.MergedIndex]);
+        Row->ConflictIndex = Index;
+        AllDiffRows.Add(Row);
+    }
+    for (int32 Index = 0; Index < DropTableConflicts.Num(); ++Index)
+    {
+        FCompareDiffRowPtr Row = MakeShared<FCompareDiffRow>();
+        Row->ItemId = DropTableConflicts[Index];
+        Row->TypeTab = DropTables;
+        Row->ConflictIndex = Index;
+        AllDiffRows.Add(Row);
     }
 
     ApplyFilter();
+}
+
+FReply SCompareAndMergePanel::OnSaveToEditorClicked()
+{
+    if (!Session.IsValid() || !Session->Remote.IsValid())
+    {
+        return FReply::Handled();
+    }
+
+    const int32 Unresolved = Session->NumUnresolved() + DropTableConflicts.Num();
+    if (Unresolved > 0)
+    {
+        const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(FString::Printf(
+            TEXT("%d conflicts are not resolved and will keep their Editor values. Save anyway?"), Unresolved)));
+        if (Answer != EAppReturnType::Yes)
+        {
+            return FReply::Handled();
+        }
+    }
+
+    const FStoreMergeResult& Merge = Session->Result;
+    TArray<FStoreItemRecord> Records;
+    Records.Reserve(Merge.Merged.Num());
+    int32 NumRemoved = 0;
+    for (int32 Index = 0; Index < Merge.Merged.Num(); ++Index)
+    {
+        if (Session->Removed[Index])
+        {
+            ++NumRemoved;
+            continue;
+        }
+        Records.Add(Merge.Merged[Index]);
+    }
+
+    FStoreApplyResult Result;
+    PFHelpers::ApplyRecordsToAssets(Records, MergedDropTables, true, Result);
+    FStoreCatalogHistory::Get().AddSnapshot(CatalogVersion, Records, MergedDropTables, EStoreSnapshotSource::Merge,
+        CompareSnapshot.IsValid() ? TEXT("from snapshot ") + CompareSnapshot->Describe() : FString());
+
+    FString Summary = FString::Printf(TEXT("Updated %d assets (%d already up to date), saved %d packages."),
+        Result.Changed, Result.Unchanged, Result.PackagesSaved);
+    if (Result.bCancelled)
+    {
+        Summary += TEXT("\nSaving was cancelled; the remaining assets are modified but unsaved.");
+    }
+    if (Result.Missing.Num() > 0)
+    {
+        Summary += FString::Printf(TEXT("\n%d items exist only on PlayFab and need assets: %s"),
+            Result.Missing.Num(), *FString::Join(Result.Missing, TEXT(", ")).Left(1000));
+    }
+    if (Result.ReadOnly.Num() > 0)
+    {
+        Summary += FString::Printf(TEXT("\n%d assets do not support write-back: %s"),
+            Result.ReadOnly.Num(), *FString::Join(Result.ReadOnly, TEXT(", ")).Left(1000));
+    }
+    if (Result.Incomplete.Num() > 0)
+    {
+        Summary += FString::Printf(TEXT("\n%d assets have no property for some fields, see the log: %s"),
+            Result.Incomplete.Num(), *FString::Join(Result.Incomplete, TEXT(", ")).Left(1000));
+    }
+    if (NumRemoved > 0)
+    {
+        Summary += FString::Printf(TEXT("\n%d items were dropped by the merge; delete their assets by hand."), NumRemoved);
+    }
+    FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Summary));
+
+    return FReply::Handled();
+}
+
+FReply SCompareAndMergePanel::OnOpenMergeGridClicked()
+{
+    if (!Session.IsValid() || Session->NumUnresolved() == 0)
+    {
+        return FReply::Handled();
+    }
+
+    TSharedRef<SWindow> Window = SNew(SWindow)
+        .Title(FText::FromString(FString::Printf(TEXT("Merge %s"), *CatalogVersion)))
+        .ClientSize(FVector2D(1200.f, 700.f))
+        .SupportsMinimize(false)
+        .SupportsMaximize(true);
+
+    // The grid keeps the session alive; a rebuild here starts a new session and leaves it behind.
+    Window->SetContent(
+        SNew(SStoreMergeGrid)
+        .Session(Session)
+        .OnApplied_Lambda([WeakPanel = TWeakPtr<SCompareAndMergePanel>(SharedThis(this)), GridSession = Session]()
+            {
+                TSharedPtr<SCompareAndMergePanel> Panel = WeakPanel.Pin();
+                if (Panel.IsValid() && Panel->Session == GridSession)
+                {
+                    Panel->RefreshConflictRows();
+                }
+            })
+    );
 
+    FSlateApplication::Get().AddWindow(Window);
     return FReply::Handled();
 }
 
+void SCompareAndMergePanel::ResolveConflict(const FString& ItemId, int32 Generation, const TArray<FFieldDiffRowPtr>& Choices)
+{
+    // A newer remote catalog or snapshot rebuilt the merge while the window was open; its choices
+    // were made against values that may no longer be there.
+    if (Generation != MergeGeneration || !Session.IsValid())
+    {
+        FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(
+            TEXT("The comparison was refreshed while %s was open, so these choices were not applied. Open it again from the list."), *ItemId)));
+        return;
+    }
+
+    // Rows are recreated whenever a conflict is resolved, so the conflict is found by its id.
+    const int32 ConflictIndex = Session->Result.Conflicts.IndexOfByPredicate(
+        [&ItemId](const FStoreItemConflict& Conflict) { return Conflict.ItemId == ItemId; });
+    if (ConflictIndex == INDEX_NONE || Session->Resolved[ConflictIndex])
+    {
+        return;
+    }
+
+    const FStoreItemConflict& Conflict = Session->Result.Conflicts[ConflictIndex];
+    for (const FFieldDiffRowPtr& Choice : Choices)
+    {
+        if (Conflict.Kind != EStoreMergeConflict::Fields)
+        {
+            // Keeping or dropping the whole item is decided by the side its ItemId was taken from.
+            if (Choice->FieldName == TEXT("ItemId"))
+            {
+                Session->Apply(ConflictIndex, NAME_None, Choice->Choice);
+            }
+            continue;
+        }
+
+        // The window shows CatalogItem members; apply the choice to every field under that member.
+        for (const FName Field : Conflict.Fields)
+        {
+            if (PFHelpers::GetCatalogJsonKey(Field) == Choice->FieldName)
+            {
+                Session->Apply(ConflictIndex, Field, Choice->Choice);
+            }
+        }
+    }
+
+    Session->Resolved[ConflictIndex] = true;
+    RefreshConflictRows();
+}
+
+FText SCompareAndMergePanel::GetRemoteStatusText() const
+{
+    if (!bShowDiffs)
+    {
+        return FText::GetEmpty();
+    }
+
+    FString Status;
+    if (CompareSnapshot.IsValid())
+    {
+        Status = FString::Printf(TEXT("Snapshot of '%s' from %s%s | differences: %d"),
+            *CatalogVersion, *CompareSnapshot->Describe(), *SnapshotChangesText, AllDiffRows.Num());
+        return FText::FromString(Status);
+    }
+
+    const bool bRefreshing = FPFRemoteCatalogCache::Get().IsRefreshing(CatalogVersion);
+    Status = Remote.IsValid()
+        ? FString::Printf(TEXT("PlayFab catalog '%s' as of %s"), *CatalogVersion, *Remote->FetchTime.ToString())
+        : FString::Printf(TEXT("PlayFab catalog '%s' not downloaded yet"), *CatalogVersion);
+    if (bRefreshing)
+    {
+        Status += TEXT(" (refreshing...)");
+    }
+    if (Remote.IsValid())
+    {
+        Status += FString::Printf(TEXT(" | merged automatically: %d from Editor, %d from PlayFab | conflicts left: %d"),
+            Session->Result.FieldsFromLocal, Session->Result.FieldsFromRemote, AllDiffRows.Num());
+    }
+    return FText::FromString(Status);
+}
+
+void SCompareAndMergePanel::RefreshCompareOptions()
+{
+    // Newest first; the selection follows its snapshot, or falls back to PlayFab once it was dropped.
+    const FString Version = GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion;
+    TSharedPtr<const FStoreCatalogSnapshot> Selected;
+    if (SelectedCompareOption.IsValid() && CompareSnapshots.IsValidIndex(*SelectedCompareOption))
+    {
+        Selected = CompareSnapshots[*SelectedCompareOption];
+    }
+
+    CompareSnapshots = FStoreCatalogHistory::Get().GetSnapshots(Version);
+    Algo::Reverse(CompareSnapshots);
+
+    CompareOptions.Reset();
+    CompareOptions.Add(MakeShared<int32>(INDEX_NONE));
+    SelectedCompareOption = CompareOptions[0];
+    for (int32 Index = 0; Index < CompareSnapshots.Num(); ++Index)
+    {
+        CompareOptions.Add(MakeShared<int32>(Index));
+        if (CompareSnapshots[Index] == Selected)
+        {
+            SelectedCompareOption = CompareOptions.Last();
+        }
+    }
+}
+
+FText SCompareAndMergePanel::GetCompareOptionText(TSharedPtr<int32> Option) const
+{
+    if (!Option.IsValid() || !CompareSnapshots.IsValidIndex(*Option))
+    {
+        return FText::FromString(TEXT("PlayFab"));
+    }
+    return FText::FromString(CompareSnapshots[*Option]->Describe());
+}
+
 TSharedRef<ITableRow> SCompareAndMergePanel::OnGenerateDiffRow(
     FCompareDiffRowPtr Item,
     const TSharedRef<STableViewBase>& OwnerTable)
 {
     return SNew(STableRow<FCompareDiffRowPtr>, OwnerTable)
         [
-            SNew(STextBlock)
-                .Text(FText::FromString(Item->ItemId))
+            SNew(SHorizontalBox)
+
+                + SHorizontalBox::Slot().FillWidth(1.f)
+                [
+                    SNew(STextBlock)
+                        .Text(FText::FromString(Item->ItemId))
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth().Padding(8, 0, 0, 0)
+                [
+                    SNew(STextBlock)
+                        .Text(FText::FromString(DescribeConflict(*Item)))
+                        .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+                ]
         ];
 }
 
@@ -204,8 +662,9 @@ void SCompareAndMergePanel::ApplyFilter()
 
     for (const FCompareDiffRowPtr& Row : AllDiffRows)
     {
-        if (CurrentFilterText.IsEmpty()
-            || Row->ItemId.Contains(CurrentFilterText, ESearchCase::IgnoreCase))
+        if ((CurrentTypeTabIndex < 0 || Row->TypeTab == CurrentTypeTabIndex)
+            && (CurrentFilterText.IsEmpty()
+            || Row->ItemId.Contains(CurrentFilterText, ESearchCase::IgnoreCase)))
         {
             DiffRows.Add(Row);
         }
@@ -245,12 +704,9 @@ TSharedRef<SWidget> SCompareAndMergePanel::MakeTypeTabButton(const FString& Labe
         .Text(FText::FromString(Label))
         .OnClicked_Lambda([this, Index]()
             {
-                CurrentTypeTabIndex = Index;
-                // TODO: reload DiffRows for selected type
-                if (DiffListView.IsValid())
-                {
-                    DiffListView->RequestListRefresh();
-                }
+                // Clicking the active tab again shows every type.
+                CurrentTypeTabIndex = (CurrentTypeTabIndex == Index) ? -1 : Index;
+                ApplyFilter();
                 return FReply::Handled();
             })
         .ButtonColorAndOpacity_Lambda([this, Index]()
@@ -267,91 +723,53 @@ TSharedRef<SWidget> SCompareAndMergePanel::MakeTypeTabButton(const FString& Labe
             });
 }
 
+FString SCompareAndMergePanel::DescribeConflict(const FCompareDiffRow& Row) const
+{
+    if (Row.TypeTab == CompareAndMergePrivate::DropTables)
+    {
+        return TEXT("Nodes changed on both sides");
+    }
+
+    const FStoreItemConflict& Conflict = Session->Result.Conflicts[Row.ConflictIndex];
+    if (Conflict.Kind != EStoreMergeConflict::Fields)
+    {
+        return CompareAndMergePrivate::GetKindLabel(Conflict.Kind);
+    }
+    return FString::JoinBy(Conflict.Fields, TEXT(", "), [](FName Field) { return Field.ToString(); });
+}
+
 void SCompareAndMergePanel::OnRowDoubleClicked(FCompareDiffRowPtr Item)
 {
     UE_LOG(LogTemp, Log, TEXT("Double clicked on diff row: %s"),
         Item.IsValid() ? *Item->ItemId : TEXT("<none>"));
 
-    const FString LeftJsonStr = TEXT(R"JSON(
-    {
-      "ItemId": "Item1",
-      "ItemClass": "Weapon",
-      "CatalogVersion": "Main",
-      "DisplayName": "Old Sword",
-      "Description": "Old description",
-      "VirtualCurrencyPrices": {},
-      "RealCurrencyPrices": {},
-      "Tags": ["Old", "Basic"],
-      "CustomData": null,
-      "Consumable": {
-        "UsageCount": 5,
-        "UsagePeriod": 2629800,
-        "UsagePeriodGroup": ""
-      },
-      "Container": null,
-      "Bundle": null,
-      "CanBecomeCharacter": false,
-      "IsStackable": false,
-      "IsTradable": false,
-      "ItemImageUrl": null,
-      "IsLimitedEdition": true,
-      "InitialLimitedEditionCount": 100,
-      "ActivatedMembership": null
-    }
-    )JSON");
-
-    const FString RightJsonStr = TEXT(R"JSON(
-    {
-      "ItemId": "Item1",
-      "ItemClass": "Weapon",
-      "CatalogVersion": "Main",
-      "DisplayName": "New Sword",
-      "Description": "New, better description",
-      "VirtualCurrencyPrices": {},
-      "RealCurrencyPrices": {},
-      "Tags": ["New", "Epic"],
-      "CustomData": "{\"Damage\": 50}",
-      "Consumable": {
-        "UsageCount": 10,
-        "UsagePeriod": 2629800,
-        "UsagePeriodGroup": ""
-      },
-      "Container": null,
-      "Bundle": null,
-      "CanBecomeCharacter": false,
-      "IsStackable": true,
-      "IsTradable": true,
-      "ItemImageUrl": null,
-      "IsLimitedEdition": true,
-      "InitialLimitedEditionCount": 200,
-      "ActivatedMembership": null
-    }
-    )JSON");
-
-    TSharedPtr<FJsonObject> LeftObj;
+    // Drop tables have no field level view yet.
+    if (!Item.IsValid() || !Session.IsValid() || Item->TypeTab == CompareAndMergePrivate::DropTables)
     {
-        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LeftJsonStr);
-        if (!FJsonSerializer::Deserialize(Reader, LeftObj) || !LeftObj.IsValid())
-        {
-            FMessageDialog::Open(EAppMsgType::Ok,
-                FText::FromString(TEXT("Failed to parse Left JSON")));
-            return;
-        }
+        return;
     }
 
+    // Left is the merge with the editor's values, Right the same merge with PlayFab's values for
+    // the conflicting fields, so the window lists exactly the conflicts and nothing merged already.
+    const FStoreItemConflict& Conflict = Session->Result.Conflicts[Item->ConflictIndex];
+    TSharedPtr<FJsonObject> LeftObj;
     TSharedPtr<FJsonObject> RightObj;
+    if (Conflict.Kind == EStoreMergeConflict::Fields)
     {
-        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RightJsonStr);
-        if (!FJsonSerializer::Deserialize(Reader, RightObj) || !RightObj.IsValid())
-        {
-            FMessageDialog::Open(EAppMsgType::Ok,
-                FText::FromString(TEXT("Failed to parse Right JSON")));
-            return;
-        }
+        const FStoreItemRecord& Merged = Session->Result.Merged[Conflict.MergedIndex];
+        FStoreItemRecord WithRemote = Merged;
+        PFHelpers::CopyFields(*Session->GetRemote(Conflict), WithRemote, Conflict.Fields);
+        LeftObj = CompareAndMergePrivate::ToJsonObject(&Merged, CatalogVersion);
+        RightObj = CompareAndMergePrivate::ToJsonObject(&WithRemote, CatalogVersion);
+    }
+    else
+    {
+        LeftObj = CompareAndMergePrivate::ToJsonObject(Session->GetLocal(Conflict), CatalogVersion);
+        RightObj = CompareAndMergePrivate::ToJsonObject(Session->GetRemote(Conflict), CatalogVersion);
     }
 
     TSharedRef<SWindow> Window = SNew(SWindow)
-        .Title(FText::FromString(TEXT("Compare Catalog Items (Test)")))
+        .Title(FText::FromString(FString::Printf(TEXT("Compare %s"), *Item->ItemId)))
         .ClientSize(FVector2D(900.f, 600.f))
         .SupportsMinimize(false)
         .SupportsMaximize(true);
@@ -360,13 +778,12 @@ void SCompareAndMergePanel::OnRowDoubleClicked(FCompareDiffRowPtr Item)
         SNew(SItemDiffWindow)
         .LeftItem(LeftObj)
         .RightItem(RightObj)
-        .OnResult([](TSharedPtr<FJsonObject> Merged)
+        .OnChoices([WeakPanel = TWeakPtr<SCompareAndMergePanel>(SharedThis(this)), ItemId = Item->ItemId, Generation = MergeGeneration](const TArray<FFieldDiffRowPtr>& Choices)
             {
-                FString OutStr;
-                const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutStr);
-                FJsonSerializer::Serialize(Merged.ToSharedRef(), Writer);
-
-                UE_LOG(LogTemp, Log, TEXT("Merged JSON:\n%s"), *OutStr);
+                if (TSharedPtr<SCompareAndMergePanel> Panel = WeakPanel.Pin())
+                {
+                    Panel->ResolveConflict(ItemId, Generation, Choices);
+                }
             })
     );
 
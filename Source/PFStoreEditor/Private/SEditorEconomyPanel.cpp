@@ -3,11 +3,20 @@
 #include "SEditorEconomyPanel.h"
 
 #include "PFHelpers.h"
+#include "PFStoreEditorSettings.h"
+#include "SStoreBulkEditPreview.h"
+#include "StoreBulkEdit.h"
+#include "StoreCatalogHistory.h"
+#include "StoreDropTableProvider.h"
+#include "StoreCatalogLoader.h"
+#include "StoreItemBitSet.h"
 
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Images/SThrobber.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Text/STextBlock.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/MessageDialog.h"
 
 #include "Async/Async.h"
 #include "DesktopPlatformModule.h"
@@ -25,28 +34,7 @@
 template<class UInterfaceClass>
 TArray<TWeakObjectPtr<UObject>> FindAllStoreItemAssets()
 {
-	TArray<TWeakObjectPtr<UObject>> StoreItemAssets;
-
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-	FARFilter Filter;
-	Filter.bRecursiveClasses = true;
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(UObject::StaticClass()->GetClassPathName());
-
-	TArray<FAssetData> AssetDataList;
-	AssetRegistryModule.Get().GetAssets(Filter, AssetDataList);
-
-	for (const FAssetData& AssetData : AssetDataList)
-	{
-		UObject* Asset = AssetData.GetAsset();
-		if (Asset && Asset->Implements<UInterfaceClass>())
-		{
-			StoreItemAssets.Add(Cast<UObject>(Asset));
-		}
-	}
-
-	return StoreItemAssets;
+	return PFHelpers::FindAllStoreAssets(UInterfaceClass::StaticClass());
 }
 
 void SEditorEconomyPanel::Construct(const FArguments& InArgs)
@@ -54,6 +42,9 @@ void SEditorEconomyPanel::Construct(const FArguments& InArgs)
 	bShowLocalStore = false;
 	CurrentTypeTabIndex = -1;
 
+	ObjectChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddSP(this, &SEditorEconomyPanel::OnObjectPropertyChanged);
+	AssetRemovedHandle = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().OnAssetRemoved().AddSP(this, &SEditorEconomyPanel::OnAssetRemoved);
+
 	ChildSlot
 		[
 			SNew(SBorder)
@@ -105,6 +96,49 @@ void SEditorEconomyPanel::Construct(const FArguments& InArgs)
 													BuildTypesTabs()
 												]
 
+											+ SVerticalBox::Slot()
+												.AutoHeight()
+												.Padding(0, 0, 0, 4)
+												[
+													SNew(SHorizontalBox)
+
+														+ SHorizontalBox::Slot().FillWidth(1.0f).Padding(4, 0)
+														[
+															SAssignNew(QueryTextBox, SEditableTextBox)
+																.HintText(FText::FromString(TEXT("Filter, e.g. Tradable & Class == Potion & Price.GD < 100")))
+																.ToolTipText(FText::FromString(FStoreItemQuery::GetSyntaxHelp()))
+																.OnTextChanged(this, &SEditorEconomyPanel::OnQueryTextChanged)
+														]
+
+														+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
+														[
+															SNew(STextBlock)
+																.Text_Lambda([this]() { return QueryStatus; })
+														]
+												]
+
+											+ SVerticalBox::Slot()
+												.AutoHeight()
+												.Padding(0, 0, 0, 4)
+												[
+													SNew(SHorizontalBox)
+
+														+ SHorizontalBox::Slot().FillWidth(1.0f).Padding(4, 0)
+														[
+															SAssignNew(BulkEditTextBox, SEditableTextBox)
+																.HintText(FText::FromString(TEXT("Edit the filtered items, e.g. Price.GD += 10%; Tags += Season3")))
+																.ToolTipText(FText::FromString(FStoreBulkEdit::GetSyntaxHelp()))
+														]
+
+														+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
+														[
+															SNew(SButton)
+																.Text(FText::FromString(TEXT("Preview Edit...")))
+																.ToolTipText(FText::FromString(TEXT("Show what the edit would change before anything is written")))
+																.OnClicked(this, &SEditorEconomyPanel::OnBulkEditPreviewClicked)
+														]
+												]
+
 											+ SVerticalBox::Slot()
 												.AutoHeight()
 												.Padding(0, 2, 0, 2)
@@ -238,12 +272,20 @@ void SEditorEconomyPanel::Construct(const FArguments& InArgs)
 														.OnClicked(this, &SEditorEconomyPanel::OnExtractBrowseClicked)
 												]
 
-												+ SHorizontalBox::Slot().AutoWidth()
+												+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 4, 0)
 												[
 													SNew(SButton)
 														.Text(FText::FromString("Extract Editor Economy"))
 														.OnClicked(this, &SEditorEconomyPanel::OnExtractClicked)
 												]
+
+												+ SHorizontalBox::Slot().AutoWidth()
+												[
+													SNew(SButton)
+														.Text(FText::FromString("Cook Catalog"))
+														.ToolTipText(FText::FromString("Write the runtime catalog blob loaded by FStoreCatalogLoader at game start"))
+														.OnClicked(this, &SEditorEconomyPanel::OnCookClicked)
+												]
 										]
 								]
 						]
@@ -251,6 +293,15 @@ void SEditorEconomyPanel::Construct(const FArguments& InArgs)
 		];
 }
 
+SEditorEconomyPanel::~SEditorEconomyPanel()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectChangedHandle);
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnAssetRemoved().Remove(AssetRemovedHandle);
+	}
+}
+
 // ---------- Visibility ----------
 
 EVisibility SEditorEconomyPanel::GetIntroVisibility() const
@@ -291,6 +342,7 @@ bool SEditorEconomyPanel::HandleLoadStoreTick(float DeltaTime)
 		Row->ClassName = Provider->GetItemClass();
 		Row->Asset = Asset;
 
+		LoadedRows.Add(Row);
 		Rows.Add(Row);
 	}
 
@@ -305,9 +357,132 @@ bool SEditorEconomyPanel::HandleLoadStoreTick(float DeltaTime)
 	}
 
 	bIsLoadingStore = false;
+	ApplyQuery();
 	return false;
 }
 
+void SEditorEconomyPanel::OnQueryTextChanged(const FText& Text)
+{
+	ApplyQuery();
+}
+
+void SEditorEconomyPanel::ApplyQuery()
+{
+	const FString Expression = QueryTextBox.IsValid() ? QueryTextBox->GetText().ToString() : FString();
+	if (bIsLoadingStore)
+	{
+		// The loader calls back once every asset is in.
+		QueryStatus = Expression.TrimStartAndEnd().IsEmpty() ? FText::GetEmpty() : FText::FromString(TEXT("Waiting for items..."));
+		return;
+	}
+
+	if (Expression.TrimStartAndEnd().IsEmpty())
+	{
+		Rows = LoadedRows;
+		QueryStatus = FText::GetEmpty();
+	}
+	else
+	{
+		if (!QueryCatalog.IsValid())
+		{
+			BuildQueryCatalog();
+		}
+
+		FString Error;
+		if (!FStoreItemQuery::Compile(*QueryCatalog, Expression, Query, &Error))
+		{
+			// Keep the last result up while the expression is being typed.
+			QueryStatus = FText::FromString(Error);
+			return;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		FStoreItemBitSet Matches;
+		Query.Evaluate(*QueryCatalog, Matches);
+		const double Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Rows.Reset(Matches.CountSetBits());
+		Matches.ForEachSetBit([this](FStoreItemHandle Item)
+			{
+				Rows.Add(QueryRows[Item.Index]);
+			});
+		QueryStatus = FText::FromString(FString::Printf(TEXT("%d of %d items (%.2f ms)"), Rows.Num(), QueryRows.Num(), Milliseconds));
+	}
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SEditorEconomyPanel::BuildQueryCatalog()
+{
+	FStoreCatalogBuilder Builder;
+	QueryRows.Reset();
+
+	for (const FEditorStoreRowPtr& Row : LoadedRows)
+	{
+		FStoreItemRecord Record;
+		if (!FStoreItemRecord::FromObject(Row->Asset.Get(), Record))
+		{
+			continue;
+		}
+		// A duplicate id keeps its first asset; validation reports the others.
+		if (Builder.AddItem(Record).IsValid())
+		{
+			QueryRows.Add(Row);
+		}
+	}
+
+	QueryCatalog = Builder.Build();
+}
+
+void SEditorEconomyPanel::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	// Drags send a change per frame; the catalog is rebuilt once the value is set.
+	if (!Cast<IStoreItemProvider>(Object) || bIsLoadingStore || Event.ChangeType == EPropertyChangeType::Interactive)
+	{
+		return;
+	}
+
+	// A batch apply edits every asset in one frame; rows and query are refreshed once, after it.
+	QueryCatalog.Reset();
+	if (!bQueryRefreshPending)
+	{
+		bQueryRefreshPending = true;
+		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SEditorEconomyPanel::OnRefreshQueryTimer));
+	}
+}
+
+EActiveTimerReturnType SEditorEconomyPanel::OnRefreshQueryTimer(double CurrentTime, float DeltaTime)
+{
+	bQueryRefreshPending = false;
+	for (const FEditorStoreRowPtr& Row : LoadedRows)
+	{
+		if (const IStoreItemProvider* Provider = Cast<IStoreItemProvider>(Row->Asset.Get()))
+		{
+			Row->ItemId = Provider->GetItemId();
+			Row->Name = Provider->GetDisplayName();
+			Row->ClassName = Provider->GetItemClass();
+		}
+	}
+	ApplyQuery();
+	return EActiveTimerReturnType::Stop;
+}
+
+void SEditorEconomyPanel::OnAssetRemoved(const FAssetData& AssetData)
+{
+	const FSoftObjectPath Path = AssetData.GetSoftObjectPath();
+	const int32 NumRemoved = LoadedRows.RemoveAll([&Path](const FEditorStoreRowPtr& Row) { return Row->Asset.ToSoftObjectPath() == Path; });
+	if (NumRemoved == 0 || bIsLoadingStore)
+	{
+		return;
+	}
+
+	QueryCatalog.Reset();
+	ApplyQuery();
+}
+
 EVisibility SEditorEconomyPanel::GetLoadingVisibility() const
 {
 	return bIsLoadingStore ? EVisibility::Visible : EVisibility::Collapsed;
@@ -324,6 +499,9 @@ FReply SEditorEconomyPanel::OnShowLocalStoreClicked()
 	bIsLoadingStore = true;
 
 	Rows.Empty();
+	LoadedRows.Empty();
+	QueryRows.Empty();
+	QueryCatalog.Reset();
 	if (ListView.IsValid())
 	{
 		ListView->RequestListRefresh();
@@ -470,12 +648,91 @@ FReply SEditorEconomyPanel::OnExtractClicked()
         return FReply::Handled();
     }
     const FString FullFilePath = FPaths::Combine(FolderPath, TEXT("StoreCatalog.csv"));
-    TArray<TWeakObjectPtr<UObject>> TStoreItemProvider = FindAllStoreItemAssets<UStoreItemProvider>();
-    PFHelpers::ExportToCsv(TStoreItemProvider, *FullFilePath);
+    TArray<FStoreItemRecord> Records;
+    PFHelpers::SnapshotItems(FindAllStoreItemAssets<UStoreItemProvider>(), Records);
+    const bool bItemsWritten = PFHelpers::ExportRecordsToCsv(Records, FullFilePath);
+
+    TArray<FDropTableInfo> DropTables;
+    PFHelpers::SnapshotDropTables(FindAllStoreItemAssets<UStoreDropTableProvider>(), DropTables);
+    const bool bTablesWritten = PFHelpers::ExportDropTablesToCsv(DropTables, PFHelpers::GetDropTablesCsvPath(FullFilePath));
+
+    if (bItemsWritten && bTablesWritten)
+    {
+        FStoreCatalogHistory::Get().AddSnapshot(GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion, Records, DropTables,
+            EStoreSnapshotSource::Export, FPaths::GetCleanFilename(FullFilePath));
+    }
     //ShowDiffWindow_Test();
     return FReply::Handled();
 }
 
+FReply SEditorEconomyPanel::OnBulkEditPreviewClicked()
+{
+    FStoreBulkEdit Edit;
+    Edit.Where = QueryTextBox.IsValid() ? QueryTextBox->GetText().ToString() : FString();
+
+    FString Error;
+    if (!Edit.ParseActions(BulkEditTextBox->GetText().ToString(), &Error))
+    {
+        FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Error));
+        return FReply::Handled();
+    }
+
+    // From the assets as they are now, not the rows, which may be older than an undo or another edit.
+    TArray<FStoreItemRecord> Records;
+    PFHelpers::SnapshotItems(FindAllStoreItemAssets<UStoreItemProvider>(), Records);
+
+    TSharedRef<FStoreBulkEditPreview> Preview = MakeShared<FStoreBulkEditPreview>();
+    if (!Edit.Preview(Records, *Preview, &Error))
+    {
+        FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Error));
+        return FReply::Handled();
+    }
+
+    TSharedRef<SWindow> Window = SNew(SWindow)
+        .Title(FText::FromString(TEXT("Bulk Edit Preview")))
+        .ClientSize(FVector2D(1000.f, 600.f))
+        .SupportsMinimize(false)
+        .SupportsMaximize(true);
+
+    Window->SetContent(
+        SNew(SStoreBulkEditPreview)
+        .Preview(Preview)
+        .OnApplied_Lambda([WeakPanel = TWeakPtr<SEditorEconomyPanel>(SharedThis(this))](const FStoreApplyResult& Result)
+            {
+                if (TSharedPtr<SEditorEconomyPanel> Panel = WeakPanel.Pin())
+                {
+                    // The rows' names and classes and the query catalog describe the old values.
+                    Panel->QueryCatalog.Reset();
+                    Panel->OnShowLocalStoreClicked();
+                }
+
+                FString Summary = FString::Printf(TEXT("Updated %d assets (%d already up to date), saved %d packages."),
+                    Result.Changed, Result.Unchanged, Result.PackagesSaved);
+                if (Result.ReadOnly.Num() > 0)
+                {
+                    Summary += FString::Printf(TEXT("\n%d assets do not support write-back: %s"),
+                        Result.ReadOnly.Num(), *FString::Join(Result.ReadOnly, TEXT(", ")).Left(1000));
+                }
+                if (Result.Incomplete.Num() > 0)
+                {
+                    Summary += FString::Printf(TEXT("\n%d assets have no property for some fields, see the log: %s"),
+                        Result.Incomplete.Num(), *FString::Join(Result.Incomplete, TEXT(", ")).Left(1000));
+                }
+                FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Summary));
+            }));
+
+    FSlateApplication::Get().AddWindow(Window);
+    return FReply::Handled();
+}
+
+FReply SEditorEconomyPanel::OnCookClicked()
+{
+    TArray<TWeakObjectPtr<UObject>> Items = FindAllStoreItemAssets<UStoreItemProvider>();
+    TArray<TWeakObjectPtr<UObject>> DropTables = FindAllStoreItemAssets<UStoreDropTableProvider>();
+    PFHelpers::CookCatalog(Items, DropTables, FStoreCatalogLoader::GetDefaultCookedPath());
+    return FReply::Handled();
+}
+
 void SEditorEconomyPanel::OnRowDoubleClicked(FEditorStoreRowPtr Item)
 {
 	if (!Item.IsValid())
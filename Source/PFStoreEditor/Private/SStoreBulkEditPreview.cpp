@@ -0,0 +1,203 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "SStoreBulkEditPreview.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+namespace StoreBulkEditPreviewPrivate
+{
+    static const FName ColumnItem(TEXT("Item"));
+    static const FName ColumnField(TEXT("Field"));
+    static const FName ColumnBefore(TEXT("Before"));
+    static const FName ColumnAfter(TEXT("After"));
+}
+
+// ---------- Row ----------
+
+class SBulkEditFieldRowWidget : public SMultiColumnTableRow<FBulkEditFieldRowPtr>
+{
+public:
+    SLATE_BEGIN_ARGS(SBulkEditFieldRowWidget) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable,
+        FBulkEditFieldRowPtr InRow, TSharedPtr<const FStoreBulkEditPreview> InPreview)
+    {
+        Row = InRow;
+        Preview = InPreview;
+        SMultiColumnTableRow<FBulkEditFieldRowPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    // Values are formatted here, so only rows scrolled into view ever pay for it.
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        using namespace StoreBulkEditPreviewPrivate;
+
+        if (ColumnName == ColumnItem)
+        {
+            return SNew(STextBlock).Text(FText::FromString(Preview->After[Row->ItemIndex].ItemId));
+        }
+        if (ColumnName == ColumnField)
+        {
+            return SNew(STextBlock).Text(FText::FromName(Row->Field));
+        }
+        if (ColumnName == ColumnBefore || ColumnName == ColumnAfter)
+        {
+            const TArray<FStoreItemRecord>& Side = ColumnName == ColumnBefore ? Preview->Before : Preview->After;
+            const FString Value = PFHelpers::FormatField(Side[Row->ItemIndex], Row->Field);
+            return SNew(STextBlock)
+                .Text(FText::FromString(Value))
+                .ToolTipText(FText::FromString(Value));
+        }
+        return SNullWidget::NullWidget;
+    }
+
+private:
+    FBulkEditFieldRowPtr Row;
+    TSharedPtr<const FStoreBulkEditPreview> Preview;
+};
+
+// ---------- SStoreBulkEditPreview ----------
+
+void SStoreBulkEditPreview::Construct(const FArguments& InArgs)
+{
+    using namespace StoreBulkEditPreviewPrivate;
+
+    Preview = InArgs._Preview;
+    OnApplied = InArgs._OnApplied;
+
+    if (Preview.IsValid())
+    {
+        Rows.Reserve(Preview->NumFieldChanges());
+        for (int32 ItemIndex = 0; ItemIndex < Preview->Num(); ++ItemIndex)
+        {
+            for (const FName Field : Preview->Fields[ItemIndex])
+            {
+                FBulkEditFieldRowPtr Row = MakeShared<FBulkEditFieldRow>();
+                Row->ItemIndex = ItemIndex;
+                Row->Field = Field;
+                Rows.Add(Row);
+            }
+        }
+    }
+
+    ChildSlot
+        [
+            SNew(SBorder)
+                .Padding(8)
+                [
+                    SNew(SVerticalBox)
+
+                        + SVerticalBox::Slot()
+                        .FillHeight(1.f)
+                        [
+                            SAssignNew(ListView, SListView<FBulkEditFieldRowPtr>)
+                                .ListItemsSource(&Rows)
+                                .OnGenerateRow(this, &SStoreBulkEditPreview::OnGenerateRow)
+                                .SelectionMode(ESelectionMode::None)
+                                .HeaderRow
+                                (
+                                    SNew(SHeaderRow)
+                                        + SHeaderRow::Column(ColumnItem).DefaultLabel(FText::FromString(TEXT("Item"))).FillWidth(0.2f)
+                                        + SHeaderRow::Column(ColumnField).DefaultLabel(FText::FromString(TEXT("Field"))).FillWidth(0.16f)
+                                        + SHeaderRow::Column(ColumnBefore).DefaultLabel(FText::FromString(TEXT("Before"))).FillWidth(0.32f)
+                                        + SHeaderRow::Column(ColumnAfter).DefaultLabel(FText::FromString(TEXT("After"))).FillWidth(0.32f)
+                                )
+                        ]
+
+                        + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0, 4, 0, 0)
+                        [
+                            SNew(SHorizontalBox)
+
+                                + SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+                                [
+                                    SNew(STextBlock)
+                                        .Text(this, &SStoreBulkEditPreview::GetSummaryText)
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 8, 0)
+                                [
+                                    SNew(SCheckBox)
+                                        .IsChecked_Lambda([this]() { return bSave ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                                        .OnCheckStateChanged_Lambda([this](ECheckBoxState NewState) { bSave = NewState == ECheckBoxState::Checked; })
+                                        [
+                                            SNew(STextBlock).Text(FText::FromString(TEXT("Save assets")))
+                                        ]
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 4, 0)
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Apply")))
+                                        .ToolTipText(FText::FromString(TEXT("Write the changes into the assets as one undoable transaction")))
+                                        .IsEnabled_Lambda([this]() { return Rows.Num() > 0; })
+                                        .OnClicked(this, &SStoreBulkEditPreview::OnApplyClicked)
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth()
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Cancel")))
+                                        .OnClicked(this, &SStoreBulkEditPreview::OnCancelClicked)
+                                ]
+                        ]
+                ]
+        ];
+}
+
+TSharedRef<ITableRow> SStoreBulkEditPreview::OnGenerateRow(FBulkEditFieldRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(SBulkEditFieldRowWidget, OwnerTable, Item, Preview);
+}
+
+FText SStoreBulkEditPreview::GetSummaryText() const
+{
+    if (!Preview.IsValid())
+    {
+        return FText::GetEmpty();
+    }
+    FString Summary = FString::Printf(TEXT("%d items selected, %d would change (%d fields)"),
+        Preview->NumSelected, Preview->Num(), Rows.Num());
+    if (Preview->NumSkipped > 0)
+    {
+        Summary += FString::Printf(TEXT(", %d skipped bundle or container fields they do not have"), Preview->NumSkipped);
+    }
+    return FText::FromString(Summary);
+}
+
+FReply SStoreBulkEditPreview::OnApplyClicked()
+{
+    if (!Preview.IsValid())
+    {
+        return FReply::Handled();
+    }
+
+    FStoreApplyResult Result;
+    FStoreBulkEdit::Apply(*Preview, bSave, Result);
+    OnApplied.ExecuteIfBound(Result);
+
+    CloseWindow();
+    return FReply::Handled();
+}
+
+FReply SStoreBulkEditPreview::OnCancelClicked()
+{
+    CloseWindow();
+    return FReply::Handled();
+}
+
+void SStoreBulkEditPreview::CloseWindow()
+{
+    if (TSharedPtr<SWindow> Window = FSlateApplication::Get().FindWidgetWindow(AsShared()))
+    {
+        Window->RequestDestroyWindow();
+    }
+}
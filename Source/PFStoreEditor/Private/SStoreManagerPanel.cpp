@@ -4,6 +4,7 @@
 #include "SlateOptMacros.h"
 #include "Engine/DataTable.h"
 #include "Misc/FileHelper.h"
+#include "Misc/MessageDialog.h"
 #include "Misc/Paths.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
@@ -13,9 +14,16 @@
 #include "IDesktopPlatform.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Views/SListView.h"
 #include "ItemDiffWindow.h"
+#include "PFAdminScheduler.h"
+#include "PFMultiPublish.h"
+#include "PFRemoteCatalog.h"
+#include "PFUploadJournal.h"
 #include "SCompareAndMergePanel.h"
 #include "SEditorEconomyPanel.h"
+#include "StoreCatalogHistory.h"
 #include "PFStoreEditorSettings.h"
 #include "PFHelpers.h"
 
@@ -28,6 +36,8 @@ BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 void SStoreManagerPanel::Construct(const FArguments& InArgs)
 {
+	bHasUnfinishedUpload = FPFUploadJournal::HasUnfinished(GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion);
+
 	auto MakeTabButton = [this](const FString& Label, int32 Index)
 		{
 			return SNew(SButton)
@@ -121,7 +131,7 @@ TSharedRef<SWidget> SStoreManagerPanel::BuildSplitterPanel()
 								+ SHorizontalBox::Slot().FillWidth(1.0f).Padding(0, 0, 4, 0)
 								[
 									SAssignNew(UploadPathTextBox, SEditableTextBox)
-										.HintText(FText::FromString("Select file..."))
+										.HintText(FText::FromString("Project assets, or select a CSV/JSON file..."))
 								]
 
 								// Browse
@@ -144,17 +154,70 @@ TSharedRef<SWidget> SStoreManagerPanel::BuildSplitterPanel()
 								.HintText(FText::FromString("e.g. Main"))
 						]*/
 
-						// Upload button
+						// Upload buttons
 						+ SGridPanel::Slot(1, 2).Padding(2).HAlign(HAlign_Left)
 						[
-							SNew(SButton)
-								.Text(FText::FromString("Upload Economy"))
-								.OnClicked(this, &SStoreManagerPanel::OnUploadClicked)
-								.IsEnabled_Lambda([this]()
-									{
-										return	UploadPathTextBox.IsValid() &&
-												!UploadPathTextBox->GetText().IsEmpty();
-									})
+							SNew(SHorizontalBox)
+
+								+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 4, 0)
+								[
+									SNew(SButton)
+										.Text(FText::FromString("Upload Economy"))
+										.OnClicked(this, &SStoreManagerPanel::OnUploadClicked)
+								]
+
+								// Only what did not land in the publish that was cut short
+								+ SHorizontalBox::Slot().AutoWidth()
+								[
+									SNew(SButton)
+										.Text(FText::FromString("Resume upload"))
+										.ToolTipText(FText::FromString("Send only what did not reach PlayFab in the last, unfinished publish"))
+										.IsEnabled_Lambda([this]() { return bHasUnfinishedUpload; })
+										.OnClicked(this, &SStoreManagerPanel::OnResumeUploadClicked)
+								]
+						]
+
+						// Publish targets
+						+ SGridPanel::Slot(0, 3).Padding(2, 12, 2, 2).VAlign(VAlign_Top)
+						[
+							SNew(STextBlock).Text(FText::FromString("Targets"))
+						]
+						+ SGridPanel::Slot(1, 3).Padding(2, 12, 2, 2)
+						[
+							SNew(SVerticalBox)
+
+								+ SVerticalBox::Slot().AutoHeight()
+								[
+									SNew(SHorizontalBox)
+
+										+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 8, 0)
+										[
+											SNew(SButton)
+												.Text(FText::FromString("Publish to Targets"))
+												.ToolTipText(FText::FromString("Publish to every enabled title of Project Settings > Plugins > PF Store Editor > Publish Targets"))
+												.IsEnabled_Lambda([this]() { return !MultiPublish.IsValid() || !MultiPublish->IsRunning(); })
+												.OnClicked(this, &SStoreManagerPanel::OnPublishToTargetsClicked)
+										]
+
+										+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+										[
+											SNew(SCheckBox)
+												.IsChecked_Lambda([this]() { return bPublishChangesOnly ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+												.OnCheckStateChanged_Lambda([this](ECheckBoxState State) { bPublishChangesOnly = State == ECheckBoxState::Checked; })
+												.ToolTipText(FText::FromString("Send each title only what changed since it was last published from this machine"))
+												[
+													SNew(STextBlock).Text(FText::FromString("Changes only"))
+												]
+										]
+								]
+
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 4, 0, 0)
+								[
+									SAssignNew(TargetListView, SListView<TSharedPtr<int32>>)
+										.ListItemsSource(&TargetRows)
+										.SelectionMode(ESelectionMode::None)
+										.OnGenerateRow(this, &SStoreManagerPanel::GenerateTargetRow)
+								]
 						]
 				]
 		];
@@ -173,10 +236,38 @@ TSharedRef<SWidget> SStoreManagerPanel::BuildEditorEconomyPanel()
 FReply SStoreManagerPanel::OnUploadClicked()
 {
 	const FString Path = UploadPathTextBox->GetText().ToString();
-	UploadCatalogItemsToPlayFab(Path);
+	const FString CatalogVersion = GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion;
+	if (ConfirmProjectWideUpload(Path, FString::Printf(TEXT("catalog %s"), *CatalogVersion)))
+	{
+		UploadCatalogItemsToPlayFab(Path);
+	}
+	return FReply::Handled();
+}
+
+FReply SStoreManagerPanel::OnResumeUploadClicked()
+{
+	const FString Path = UploadPathTextBox->GetText().ToString();
+	const FString CatalogVersion = GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion;
+	if (ConfirmProjectWideUpload(Path, FString::Printf(TEXT("catalog %s"), *CatalogVersion)))
+	{
+		UploadCatalogItemsToPlayFab(Path, true);
+	}
 	return FReply::Handled();
 }
 
+bool SStoreManagerPanel::ConfirmProjectWideUpload(const FString& File, const FString& Destination)
+{
+	if (!File.IsEmpty())
+	{
+		return true;
+	}
+
+	const EAppReturnType::Type Answer = FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(FString::Printf(
+		TEXT("No file is selected, so the items and drop tables of every store asset in the project will be uploaded to %s. Continue?"),
+		*Destination)));
+	return Answer == EAppReturnType::Yes;
+}
+
 bool SStoreManagerPanel::PickFileDialog(const FString& Title, const FString& DefaultPath, const FString& DefaultFile, const FString& FileTypes, FString& OutFile)
 {
 	if (FDesktopPlatformModule::Get())
@@ -209,10 +300,10 @@ FReply SStoreManagerPanel::OnUploadBrowseClicked()
 {
 	FString FilePath;
 	if (PickFileDialog(
-		TEXT("Choose CSV File"),
+		TEXT("Choose Catalog File"),
 		FPaths::ProjectDir(),
 		TEXT(""),
-		TEXT("CSV files (*.csv)|*.csv"),
+		TEXT("Catalog files (*.csv;*.json)|*.csv;*.json|CSV files (*.csv)|*.csv|PlayFab JSON (*.json)|*.json"),
 		FilePath))
 	{
 		UploadPathTextBox->SetText(FText::FromString(FilePath));
@@ -220,62 +311,187 @@ FReply SStoreManagerPanel::OnUploadBrowseClicked()
 	return FReply::Handled();
 }
 
-void SStoreManagerPanel::UploadCatalogItemsToPlayFab(const FString& File)
+FReply SStoreManagerPanel::OnPublishToTargetsClicked()
 {
-	PlayFabAdminPtr adminAPI = IPlayFabModuleInterface::Get().GetAdminAPI();
-	TSharedPtr<PlayFab::AdminModels::FUpdateCatalogItemsRequest> Request = MakeShared<PlayFab::AdminModels::FUpdateCatalogItemsRequest>();
-
-	TArray<PlayFab::AdminModels::FCatalogItem> OutItems;
-	PFHelpers::ImportItemsFromCsv(File, OutItems);
-
-	Request->Catalog = OutItems;
-	// TODO: ? remove
-	//Request->SetAsDefaultCatalog = true;
-	const UPFStoreEditorSettings* Settings = GetDefault<UPFStoreEditorSettings>();
-	Request->CatalogVersion = Settings->DefaultCatalogVersion;
+	const FString Path = UploadPathTextBox->GetText().ToString();
+	if (ConfirmProjectWideUpload(Path, TEXT("every enabled publish target")))
+	{
+		PublishToTargets(Path);
+	}
+	return FReply::Handled();
+}
 
-	PlayFab::FPlayFabErrorDelegate OnError;
-	OnError.BindLambda([](const PlayFab::FPlayFabCppError& Error)
+TSharedRef<ITableRow> SStoreManagerPanel::GenerateTargetRow(TSharedPtr<int32> Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const int32 Index = *Row;
+	auto GetStatus = [this, Index]() -> const FPFMultiPublish::FTargetStatus*
 		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to update catalog: %s"), *Error.ErrorMessage);
-		});
+			return MultiPublish.IsValid() && MultiPublish->GetStatuses().IsValidIndex(Index) ? &MultiPublish->GetStatuses()[Index] : nullptr;
+		};
 
-	PlayFab::UPlayFabAdminAPI::FUpdateCatalogItemsDelegate OnSuccess;
-	OnSuccess.BindLambda([](const PlayFab::AdminModels::FUpdateCatalogItemsResult& Result)
-		{
-			UE_LOG(LogTemp, Log, TEXT("Catalog successfully updated from JSON!"));
-		});
+	const FPFMultiPublish::FTargetStatus* Status = GetStatus();
+	const FString Name = Status ? FString::Printf(TEXT("%s (%s, %s)"), *Status->Target.Name, *Status->Target.TitleId, *Status->CatalogVersion) : FString();
 
+	return SNew(STableRow<TSharedPtr<int32>>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
 
-	adminAPI->UpdateCatalogItems(*Request, OnSuccess, OnError);
+				+ SHorizontalBox::Slot().FillWidth(0.4f).Padding(2)
+				[
+					SNew(STextBlock).Text(FText::FromString(Name))
+				]
+				+ SHorizontalBox::Slot().FillWidth(0.6f).Padding(2)
+				[
+					SNew(STextBlock)
+						.Text_Lambda([GetStatus]()
+							{
+								const FPFMultiPublish::FTargetStatus* Current = GetStatus();
+								return Current ? FText::FromString(Current->Describe()) : FText::GetEmpty();
+							})
+						.ColorAndOpacity_Lambda([GetStatus]()
+							{
+								const FPFMultiPublish::FTargetStatus* Current = GetStatus();
+								return Current && Current->State == FPFMultiPublish::ETargetState::Failed
+									? FSlateColor(FLinearColor(0.9f, 0.2f, 0.2f))
+									: FSlateColor::UseForeground();
+							})
+				]
+		];
 }
 
-void SStoreManagerPanel::UploadCatalogDropTablesToPlayFab(const FString& File)
+bool SStoreManagerPanel::LoadRecordsForUpload(const FString& File, TArray<FStoreItemRecord>& OutRecords)
 {
-	PlayFabAdminPtr adminAPI = IPlayFabModuleInterface::Get().GetAdminAPI();
-	TSharedPtr<PlayFab::AdminModels::FUpdateRandomResultTablesRequest> Request = MakeShared<PlayFab::AdminModels::FUpdateRandomResultTablesRequest>();
+	if (File.IsEmpty())
+	{
+		PFHelpers::SnapshotItems(PFHelpers::FindAllStoreAssets(UStoreItemProvider::StaticClass()), OutRecords);
+		return true;
+	}
+	return PFHelpers::ImportRecordsFromFile(File, OutRecords);
+}
 
-	TArray<PlayFab::AdminModels::FRandomResultTable> OutTables;
-	//MyPlayFabHelpers::ImportDropTablesFromCsv(File, OutTables);
+void SStoreManagerPanel::PublishToTargets(const FString& File)
+{
+	TArray<FPFPublishTarget> Targets = FPFMultiPublish::GetEnabledTargets();
+	if (Targets.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No publish targets, add them in Project Settings > Plugins > PF Store Editor."));
+		return;
+	}
+
+	// Read and snapshotted once, whatever the number of titles.
+	TSharedRef<TArray<FStoreItemRecord>> Records = MakeShared<TArray<FStoreItemRecord>>();
+	if (!LoadRecordsForUpload(File, *Records))
+	{
+		return;
+	}
+	TSharedRef<TArray<FDropTableInfo>> Tables = MakeShared<TArray<FDropTableInfo>>();
+	LoadDropTablesForUpload(File, *Tables);
 
-	Request->Tables = OutTables;
-	const UPFStoreEditorSettings* Settings = GetDefault<UPFStoreEditorSettings>();
-	Request->CatalogVersion = Settings->DefaultCatalogVersion;
+	MultiPublish = MakeShared<FPFMultiPublish>(MoveTemp(Targets), bPublishChangesOnly);
 
-	PlayFab::FPlayFabErrorDelegate OnError;
-	OnError.BindLambda([](const PlayFab::FPlayFabCppError& Error)
+	TargetRows.Reset();
+	for (int32 Index = 0; Index < MultiPublish->GetStatuses().Num(); ++Index)
+	{
+		TargetRows.Add(MakeShared<int32>(Index));
+	}
+	TargetListView->RequestListRefresh();
+
+	MultiPublish->Run(Records, Tables, [](bool bSuccess)
 		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to update catalog: %s"), *Error.ErrorMessage);
+			UE_LOG(LogTemp, Log, TEXT("Publish to targets finished%s."), bSuccess ? TEXT("") : TEXT(" with errors"));
 		});
+}
 
-	PlayFab::UPlayFabAdminAPI::FUpdateRandomResultTablesDelegate OnSuccess;
-	OnSuccess.BindLambda([](const PlayFab::AdminModels::FUpdateRandomResultTablesResult& Result)
+void SStoreManagerPanel::UploadCatalogItemsToPlayFab(const FString& File, bool bResume)
+{
+	TSharedRef<TArray<FStoreItemRecord>> Records = MakeShared<TArray<FStoreItemRecord>>();
+	if (!LoadRecordsForUpload(File, *Records))
+	{
+		return;
+	}
+
+	TSharedRef<TArray<FDropTableInfo>> Tables = MakeShared<TArray<FDropTableInfo>>();
+	LoadDropTablesForUpload(File, *Tables);
+
+	const FString CatalogVersion = GetDefault<UPFStoreEditorSettings>()->DefaultCatalogVersion;
+	const bool bFromAssets = File.IsEmpty();
+
+	// Resuming sends what is left; the full set is still what PlayFab holds once it is done.
+	TSharedRef<const TArray<FStoreItemRecord>> ToSendRecords = Records;
+	TSharedRef<const TArray<FDropTableInfo>> ToSendTables = Tables;
+	FPFUploadJournal::FLanded Landed;
+	if (bResume && FPFUploadJournal::ReadLanded(CatalogVersion, Landed))
+	{
+		TSharedRef<TArray<FStoreItemRecord>> RemainingRecords = MakeShared<TArray<FStoreItemRecord>>(*Records);
+		TSharedRef<TArray<FDropTableInfo>> RemainingTables = MakeShared<TArray<FDropTableInfo>>(*Tables);
+		const int32 NumLanded = PFHelpers::RemoveLanded(Landed, *RemainingRecords, *RemainingTables);
+		UE_LOG(LogTemp, Log, TEXT("Resuming the upload of %s: %d already landed, %d items and %d drop tables left."),
+			*CatalogVersion, NumLanded, RemainingRecords->Num(), RemainingTables->Num());
+		ToSendRecords = RemainingRecords;
+		ToSendTables = RemainingTables;
+	}
+
+	const TSharedPtr<FPFUploadJournal> Journal = FPFUploadJournal::Begin(CatalogVersion, bResume);
+	bHasUnfinishedUpload = Journal.IsValid();
+
+	TSharedRef<FPFAdminScheduler> Scheduler = MakeShared<FPFAdminScheduler>();
+	PFHelpers::AddPublishTasks(*Scheduler, ToSendRecords, ToSendTables, CatalogVersion, Journal);
+
+	const TWeakPtr<SStoreManagerPanel> WeakPanel = SharedThis(this);
+	Scheduler->Run([Records, Tables, CatalogVersion, File, bFromAssets, Journal, WeakPanel](bool bSuccess, const TArray<FString>& Errors)
 		{
-			UE_LOG(LogTemp, Log, TEXT("Catalog successfully updated from JSON!"));
+			if (!bSuccess)
+			{
+				for (const FString& Error : Errors)
+				{
+					UE_LOG(LogTemp, Error, TEXT("Failed to update catalog: %s"), *Error);
+				}
+				if (Journal.IsValid())
+				{
+					UE_LOG(LogTemp, Log, TEXT("What landed is kept in %s, use Resume upload to send the rest."), *FPFUploadJournal::GetJournalPath(CatalogVersion));
+				}
+				return;
+			}
+
+			if (Journal.IsValid())
+			{
+				Journal->Finish();
+			}
+			if (const TSharedPtr<SStoreManagerPanel> Panel = WeakPanel.Pin())
+			{
+				Panel->bHasUnfinishedUpload = false;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("Catalog successfully updated! %d items, %d drop tables."), Records->Num(), Tables->Num());
+			FStoreCatalogHistory::Get().AddSnapshot(CatalogVersion, *Records, *Tables, EStoreSnapshotSource::Upload, FPaths::GetCleanFilename(File));
+
+			// Editor and PlayFab now agree, which makes this the base of the next merge.
+			if (bFromAssets)
+			{
+				FPFRemoteCatalogCache::Get().SetSyncBase(CatalogVersion, MoveTemp(*Records), &Tables.Get());
+			}
 		});
+}
 
+void SStoreManagerPanel::LoadDropTablesForUpload(const FString& File, TArray<FDropTableInfo>& OutTables)
+{
+	if (File.IsEmpty())
+	{
+		PFHelpers::SnapshotDropTables(PFHelpers::FindAllStoreAssets(UStoreDropTableProvider::StaticClass()), OutTables);
+		return;
+	}
 
-	adminAPI->UpdateRandomResultTables(*Request, OnSuccess, OnError);
+	TArray<FStoreItemRecord> Unused;
+	const bool bJson = FPaths::GetExtension(File).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	const FString TablesFile = bJson ? File : PFHelpers::GetDropTablesCsvPath(File);
+	const bool bRead = bJson
+		? PFHelpers::ImportRecordsFromJson(File, Unused, OutTables)
+		: FPaths::FileExists(TablesFile) && PFHelpers::ImportDropTablesFromCsv(TablesFile, OutTables);
+	if (!bRead)
+	{
+		UE_LOG(LogTemp, Log, TEXT("No drop tables to upload, %s not found or unreadable."), *TablesFile);
+		OutTables.Reset();
+	}
 }
 
 void SStoreManagerPanel::ShowDiffWindow(TSharedPtr<FJsonObject> Left, TSharedPtr<FJsonObject> Right)
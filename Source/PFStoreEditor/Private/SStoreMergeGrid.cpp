@@ -0,0 +1,507 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "SStoreMergeGrid.h"
+#include "PFRemoteCatalog.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+namespace StoreMergeGridPrivate
+{
+    static const FName ColumnItem(TEXT("Item"));
+    static const FName ColumnClass(TEXT("Class"));
+    static const FName ColumnField(TEXT("Field"));
+    static const FName ColumnEditor(TEXT("Editor"));
+    static const FName ColumnPlayFab(TEXT("PlayFab"));
+
+    static const TCHAR* AllOption = TEXT("All");
+
+    static const TCHAR* GetTypeName(const FStoreItemRecord& Record)
+    {
+        return Record.bIsBundle ? TEXT("Bundles") : Record.bIsContainer ? TEXT("Containers") : TEXT("Items");
+    }
+}
+
+// ---------- FStoreMergeSession ----------
+
+const FStoreItemRecord* FStoreMergeSession::GetRemote(const FStoreItemConflict& Conflict) const
+{
+    return Remote.IsValid() && Conflict.RemoteIndex != INDEX_NONE ? &Remote->Items[Conflict.RemoteIndex] : nullptr;
+}
+
+void FStoreMergeSession::Apply(int32 ConflictIndex, FName Field, EDiffChoice Choice)
+{
+    const FStoreItemConflict& Conflict = Result.Conflicts[ConflictIndex];
+    const bool bTakePlayFab = Choice == EDiffChoice::Right;
+
+    if (Field.IsNone())
+    {
+        // The item is missing on one side; taking that side drops it.
+        const bool bOnlyInEditor = Conflict.Kind == EStoreMergeConflict::DeletedInPlayFab || Conflict.Kind == EStoreMergeConflict::OnlyInEditor;
+        Removed[Conflict.MergedIndex] = bOnlyInEditor == bTakePlayFab;
+        return;
+    }
+
+    // Merged already holds the editor value of every conflicting field.
+    if (bTakePlayFab)
+    {
+        if (const FStoreItemRecord* RemoteRecord = GetRemote(Conflict))
+        {
+            PFHelpers::CopyFields(*RemoteRecord, Result.Merged[Conflict.MergedIndex], MakeArrayView(&Field, 1));
+        }
+    }
+}
+
+// ---------- Row ----------
+
+class SMergeFieldRowWidget : public SMultiColumnTableRow<FMergeFieldRowPtr>
+{
+public:
+    SLATE_BEGIN_ARGS(SMergeFieldRowWidget) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable,
+        FMergeFieldRowPtr InRow, TSharedPtr<FStoreMergeSession> InSession)
+    {
+        Row = InRow;
+        Session = InSession;
+        SMultiColumnTableRow<FMergeFieldRowPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    // Values are formatted here, so only rows scrolled into view ever pay for it.
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        using namespace StoreMergeGridPrivate;
+
+        const FStoreItemConflict& Conflict = Session->Result.Conflicts[Row->ConflictIndex];
+        const FStoreItemRecord& Merged = Session->Result.Merged[Conflict.MergedIndex];
+
+        if (ColumnName == ColumnItem)
+        {
+            return SNew(STextBlock).Text(FText::FromString(Conflict.ItemId));
+        }
+        if (ColumnName == ColumnClass)
+        {
+            return SNew(STextBlock).Text(FText::FromString(Merged.ItemClass));
+        }
+        if (ColumnName == ColumnField)
+        {
+            return SNew(STextBlock)
+                .Text(FText::FromString(Row->Field.IsNone() ? FString(TEXT("(whole item)")) : Row->Field.ToString()));
+        }
+        if (ColumnName == ColumnEditor)
+        {
+            return MakeSide(Session->GetLocal(Conflict), EDiffChoice::Left);
+        }
+        if (ColumnName == ColumnPlayFab)
+        {
+            return MakeSide(Session->GetRemote(Conflict), EDiffChoice::Right);
+        }
+        return SNullWidget::NullWidget;
+    }
+
+private:
+    TSharedRef<SWidget> MakeSide(const FStoreItemRecord* Record, EDiffChoice Side)
+    {
+        FString Value;
+        if (!Record)
+        {
+            Value = TEXT("(deleted)");
+        }
+        else if (Row->Field.IsNone())
+        {
+            Value = TEXT("(changed)");
+        }
+        else
+        {
+            Value = PFHelpers::FormatField(*Record, Row->Field);
+        }
+
+        FMergeFieldRowPtr RowPtr = Row;
+        return SNew(SHorizontalBox)
+
+            + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 4, 0)
+            [
+                SNew(SCheckBox)
+                    .Style(FCoreStyle::Get(), "RadioButton")
+                    .IsChecked_Lambda([RowPtr, Side]()
+                        {
+                            return RowPtr->bDecided && RowPtr->Choice == Side
+                                ? ECheckBoxState::Checked
+                                : ECheckBoxState::Unchecked;
+                        })
+                    .OnCheckStateChanged_Lambda([RowPtr, Side](ECheckBoxState NewState)
+                        {
+                            if (NewState == ECheckBoxState::Checked)
+                            {
+                                RowPtr->Choice = Side;
+                                RowPtr->bDecided = true;
+                            }
+                        })
+            ]
+
+            + SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+            [
+                SNew(STextBlock)
+                    .Text(FText::FromString(Value))
+                    .ToolTipText(FText::FromString(Value))
+                    .ColorAndOpacity_Lambda([RowPtr, Side]()
+                        {
+                            if (RowPtr->bDecided && RowPtr->Choice != Side)
+                                return FSlateColor(FLinearColor(0.25f, 0.25f, 0.25f));
+                            return FSlateColor(FLinearColor::White);
+                        })
+            ];
+    }
+
+    FMergeFieldRowPtr Row;
+    TSharedPtr<FStoreMergeSession> Session;
+};
+
+// ---------- SStoreMergeGrid ----------
+
+void SStoreMergeGrid::Construct(const FArguments& InArgs)
+{
+    using namespace StoreMergeGridPrivate;
+
+    Session = InArgs._Session;
+    OnApplied = InArgs._OnApplied;
+
+    TypeOptions.Add(MakeShared<FString>(AllOption));
+    TypeOptions.Add(MakeShared<FString>(TEXT("Items")));
+    TypeOptions.Add(MakeShared<FString>(TEXT("Bundles")));
+    TypeOptions.Add(MakeShared<FString>(TEXT("Containers")));
+    TypeFilter = TypeOptions[0];
+
+    BuildRows();
+
+    ChildSlot
+        [
+            SNew(SBorder)
+                .Padding(8)
+                [
+                    SNew(SVerticalBox)
+
+                        // Filters
+                        + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0, 0, 0, 4)
+                        [
+                            SNew(SHorizontalBox)
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 4, 0)
+                                [
+                                    SNew(STextBlock).Text(FText::FromString(TEXT("Field:")))
+                                ]
+                                + SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 12, 0)
+                                [
+                                    MakeFilterCombo(FieldOptions, FieldFilter)
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 4, 0)
+                                [
+                                    SNew(STextBlock).Text(FText::FromString(TEXT("Type:")))
+                                ]
+                                + SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 12, 0)
+                                [
+                                    MakeFilterCombo(TypeOptions, TypeFilter)
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 4, 0)
+                                [
+                                    SNew(STextBlock).Text(FText::FromString(TEXT("Class:")))
+                                ]
+                                + SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 12, 0)
+                                [
+                                    SNew(SEditableTextBox)
+                                        .MinDesiredWidth(120.f)
+                                        .OnTextChanged_Lambda([this](const FText& NewText)
+                                            {
+                                                ClassFilter = NewText.ToString();
+                                                ApplyFilter();
+                                            })
+                                ]
+
+                                + SHorizontalBox::Slot().FillWidth(1.f)
+
+                                + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 4, 0)
+                                [
+                                    SNew(STextBlock).Text(FText::FromString(TEXT("Search:")))
+                                ]
+                                + SHorizontalBox::Slot().AutoWidth()
+                                [
+                                    SNew(SEditableTextBox)
+                                        .MinDesiredWidth(200.f)
+                                        .OnTextChanged_Lambda([this](const FText& NewText)
+                                            {
+                                                SearchText = NewText.ToString();
+                                                ApplyFilter();
+                                            })
+                                ]
+                        ]
+
+                        // Bulk decisions
+                        + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0, 0, 0, 4)
+                        [
+                            SNew(SHorizontalBox)
+
+                                + SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 4, 0)
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Take Editor for all shown")))
+                                        .OnClicked_Lambda([this]()
+                                            {
+                                                DecideFiltered(EDiffChoice::Left);
+                                                return FReply::Handled();
+                                            })
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth()
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Take PlayFab for all shown")))
+                                        .OnClicked_Lambda([this]()
+                                            {
+                                                DecideFiltered(EDiffChoice::Right);
+                                                return FReply::Handled();
+                                            })
+                                ]
+                        ]
+
+                        + SVerticalBox::Slot()
+                        .FillHeight(1.f)
+                        [
+                            SAssignNew(ListView, SListView<FMergeFieldRowPtr>)
+                                .ListItemsSource(&Rows)
+                                .OnGenerateRow(this, &SStoreMergeGrid::OnGenerateRow)
+                                .SelectionMode(ESelectionMode::None)
+                                .HeaderRow
+                                (
+                                    SNew(SHeaderRow)
+                                        + SHeaderRow::Column(ColumnItem).DefaultLabel(FText::FromString(TEXT("Item"))).FillWidth(0.18f)
+                                        + SHeaderRow::Column(ColumnClass).DefaultLabel(FText::FromString(TEXT("Class"))).FillWidth(0.12f)
+                                        + SHeaderRow::Column(ColumnField).DefaultLabel(FText::FromString(TEXT("Field"))).FillWidth(0.14f)
+                                        + SHeaderRow::Column(ColumnEditor).DefaultLabel(FText::FromString(TEXT("Editor"))).FillWidth(0.28f)
+                                        + SHeaderRow::Column(ColumnPlayFab).DefaultLabel(FText::FromString(TEXT("PlayFab"))).FillWidth(0.28f)
+                                )
+                        ]
+
+                        + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0, 4, 0, 0)
+                        [
+                            SNew(SHorizontalBox)
+
+                                + SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+                                [
+                                    SNew(STextBlock)
+                                        .Text(this, &SStoreMergeGrid::GetSummaryText)
+                                ]
+
+                                + SHorizontalBox::Slot().AutoWidth()
+                                [
+                                    SNew(SButton)
+                                        .Text(FText::FromString(TEXT("Apply")))
+                                        .ToolTipText(FText::FromString(TEXT("Resolve every item whose differences are all decided")))
+                                        .OnClicked(this, &SStoreMergeGrid::OnApplyClicked)
+                                ]
+                        ]
+                ]
+        ];
+
+    ApplyFilter();
+}
+
+void SStoreMergeGrid::BuildRows()
+{
+    using namespace StoreMergeGridPrivate;
+
+    AllRows.Reset();
+    TSet<FName> Fields;
+
+    if (Session.IsValid())
+    {
+        const TArray<FStoreItemConflict>& Conflicts = Session->Result.Conflicts;
+        for (int32 Index = 0; Index < Conflicts.Num(); ++Index)
+        {
+            if (Session->Resolved[Index])
+            {
+                continue;
+            }
+
+            const FStoreItemConflict& Conflict = Conflicts[Index];
+            if (Conflict.Kind != EStoreMergeConflict::Fields)
+            {
+                FMergeFieldRowPtr Row = MakeShared<FMergeFieldRow>();
+                Row->ConflictIndex = Index;
+                AllRows.Add(Row);
+                continue;
+            }
+
+            for (const FName Field : Conflict.Fields)
+            {
+                FMergeFieldRowPtr Row = MakeShared<FMergeFieldRow>();
+                Row->ConflictIndex = Index;
+                Row->Field = Field;
+                AllRows.Add(Row);
+                Fields.Add(Field);
+            }
+        }
+    }
+
+    TArray<FString> FieldNames;
+    for (const FName Field : Fields)
+    {
+        FieldNames.Add(Field.ToString());
+    }
+    FieldNames.Sort();
+
+    FieldOptions.Reset();
+    FieldOptions.Add(MakeShared<FString>(AllOption));
+    for (const FString& Name : FieldNames)
+    {
+        FieldOptions.Add(MakeShared<FString>(Name));
+    }
+    FieldFilter = FieldOptions[0];
+}
+
+bool SStoreMergeGrid::PassesFilter(const FMergeFieldRow& Row, FName Field) const
+{
+    using namespace StoreMergeGridPrivate;
+
+    const FStoreItemConflict& Conflict = Session->Result.Conflicts[Row.ConflictIndex];
+    const FStoreItemRecord& Merged = Session->Result.Merged[Conflict.MergedIndex];
+
+    if (!Field.IsNone() && Row.Field != Field)
+    {
+        return false;
+    }
+    if (*TypeFilter != AllOption && *TypeFilter != GetTypeName(Merged))
+    {
+        return false;
+    }
+    if (!ClassFilter.IsEmpty() && !Merged.ItemClass.Contains(ClassFilter, ESearchCase::IgnoreCase))
+    {
+        return false;
+    }
+    return SearchText.IsEmpty() || Conflict.ItemId.Contains(SearchText, ESearchCase::IgnoreCase);
+}
+
+void SStoreMergeGrid::ApplyFilter()
+{
+    using namespace StoreMergeGridPrivate;
+
+    const FName Field = *FieldFilter == AllOption ? NAME_None : FName(**FieldFilter);
+
+    Rows.Reset();
+    for (const FMergeFieldRowPtr& Row : AllRows)
+    {
+        if (PassesFilter(*Row, Field))
+        {
+            Rows.Add(Row);
+        }
+    }
+
+    if (ListView.IsValid())
+    {
+        ListView->RequestListRefresh();
+    }
+}
+
+void SStoreMergeGrid::DecideFiltered(EDiffChoice Choice)
+{
+    // Only data changes; the visible rows pick it up through their attribute lambdas.
+    for (const FMergeFieldRowPtr& Row : Rows)
+    {
+        Row->Choice = Choice;
+        Row->bDecided = true;
+    }
+}
+
+FReply SStoreMergeGrid::OnApplyClicked()
+{
+    if (!Session.IsValid())
+    {
+        return FReply::Handled();
+    }
+
+    // Rows of one conflict are contiguous; a conflict is resolved once all of its rows are decided.
+    int32 Resolved = 0;
+    for (int32 Start = 0; Start < AllRows.Num();)
+    {
+        const int32 ConflictIndex = AllRows[Start]->ConflictIndex;
+        int32 End = Start;
+        bool bAllDecided = true;
+        while (End < AllRows.Num() && AllRows[End]->ConflictIndex == ConflictIndex)
+        {
+            bAllDecided &= AllRows[End]->bDecided;
+            ++End;
+        }
+
+        if (bAllDecided)
+        {
+            for (int32 Index = Start; Index < End; ++Index)
+            {
+                Session->Apply(ConflictIndex, AllRows[Index]->Field, AllRows[Index]->Choice);
+            }
+            Session->Resolved[ConflictIndex] = true;
+            ++Resolved;
+        }
+        Start = End;
+    }
+
+    AllRows.RemoveAll([this](const FMergeFieldRowPtr& Row) { return Session->Resolved[Row->ConflictIndex]; });
+    ApplyFilter();
+
+    UE_LOG(LogTemp, Log, TEXT("Merge grid resolved %d items, %d left"), Resolved, Session->NumUnresolved());
+    OnApplied.ExecuteIfBound();
+    return FReply::Handled();
+}
+
+FText SStoreMergeGrid::GetSummaryText() const
+{
+    int32 Decided = 0;
+    for (const FMergeFieldRowPtr& Row : AllRows)
+    {
+        Decided += Row->bDecided ? 1 : 0;
+    }
+    return FText::FromString(FString::Printf(TEXT("%d differences, %d shown, %d decided"), AllRows.Num(), Rows.Num(), Decided));
+}
+
+TSharedRef<ITableRow> SStoreMergeGrid::OnGenerateRow(FMergeFieldRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(SMergeFieldRowWidget, OwnerTable, Item, Session);
+}
+
+TSharedRef<SWidget> SStoreMergeGrid::MakeFilterCombo(TArray<TSharedPtr<FString>>& Options, TSharedPtr<FString>& Selected)
+{
+    return SNew(SComboBox<TSharedPtr<FString>>)
+        .OptionsSource(&Options)
+        .InitiallySelectedItem(Selected)
+        .OnGenerateWidget_Lambda([](TSharedPtr<FString> Option)
+            {
+                return SNew(STextBlock).Text(FText::FromString(*Option));
+            })
+        .OnSelectionChanged_Lambda([this, &Selected](TSharedPtr<FString> Option, ESelectInfo::Type)
+            {
+                if (Option.IsValid())
+                {
+                    Selected = Option;
+                    ApplyFilter();
+                }
+            })
+        [
+            SNew(STextBlock)
+                .Text_Lambda([&Selected]()
+                    {
+                        return FText::FromString(*Selected);
+                    })
+        ];
+}
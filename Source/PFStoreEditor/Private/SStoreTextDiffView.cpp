@@ -0,0 +1,158 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "SStoreTextDiffView.h"
+#include "PFStoreEditorStyle.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Text/SRichTextBlock.h"
+
+namespace StoreTextDiffViewPrivate
+{
+    static FString EscapeMarkup(const FString& Text)
+    {
+        return Text
+            .Replace(TEXT("&"), TEXT("&amp;"))
+            .Replace(TEXT("<"), TEXT("&lt;"))
+            .Replace(TEXT(">"), TEXT("&gt;"))
+            .Replace(TEXT("\""), TEXT("&quot;"));
+    }
+
+    static FText MakeLineMarkup(const FStoreTextDiffLine& Line)
+    {
+        if (Line.ChangedRanges.Num() == 0)
+        {
+            return FText::FromString(EscapeMarkup(Line.Text));
+        }
+
+        const TCHAR* Tag = Line.Op == EStoreDiffOp::Delete
+            ? TEXT("PFStoreEditor.Diff.Deleted")
+            : TEXT("PFStoreEditor.Diff.Inserted");
+
+        FString Markup;
+        int32 Pos = 0;
+        for (const TPair<int32, int32>& Range : Line.ChangedRanges)
+        {
+            Markup += EscapeMarkup(Line.Text.Mid(Pos, Range.Key - Pos));
+            Markup += FString::Printf(TEXT("<%s>%s</>"), Tag, *EscapeMarkup(Line.Text.Mid(Range.Key, Range.Value)));
+            Pos = Range.Key + Range.Value;
+        }
+        Markup += EscapeMarkup(Line.Text.Mid(Pos));
+        return FText::FromString(Markup);
+    }
+}
+
+void SStoreTextDiffView::Construct(const FArguments& InArgs)
+{
+    ChildSlot
+        [
+            SNew(SVerticalBox)
+
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                .Padding(4, 2)
+                [
+                    SNew(STextBlock)
+                        .Text(this, &SStoreTextDiffView::GetHeaderText)
+                ]
+
+                + SVerticalBox::Slot()
+                .FillHeight(1.f)
+                [
+                    SAssignNew(ListView, SListView<TSharedPtr<FStoreTextDiffLine>>)
+                        .ListItemsSource(&Lines)
+                        .OnGenerateRow(this, &SStoreTextDiffView::OnGenerateLine)
+                        .SelectionMode(ESelectionMode::None)
+                ]
+        ];
+}
+
+void SStoreTextDiffView::SetTexts(FName InField, const FString& Left, const FString& Right)
+{
+    Field = InField;
+    Diff.Reset();
+    Lines.Reset();
+    ListView->RequestListRefresh();
+
+    const uint32 Serial = ++RequestSerial;
+    const TWeakPtr<SStoreTextDiffView> WeakThis = SharedThis(this);
+
+    // CustomData is JSON by convention; anything that does not parse is diffed as plain text.
+    FStoreTextDiffCache::Get().Request(Left, Right, true,
+        [WeakThis, Serial](TSharedRef<const FStoreTextDiff> Result)
+        {
+            const TSharedPtr<SStoreTextDiffView> This = WeakThis.Pin();
+            if (This.IsValid() && This->RequestSerial == Serial)
+            {
+                This->OnDiffReady(Result);
+            }
+        });
+}
+
+void SStoreTextDiffView::OnDiffReady(TSharedRef<const FStoreTextDiff> InDiff)
+{
+    Diff = InDiff;
+    Lines = InDiff->Lines;
+    ListView->RequestListRefresh();
+    ListView->ScrollToTop();
+}
+
+FText SStoreTextDiffView::GetHeaderText() const
+{
+    if (Field.IsNone())
+    {
+        return FText::GetEmpty();
+    }
+    if (!Diff.IsValid())
+    {
+        return FText::FromString(FString::Printf(TEXT("%s: comparing..."), *Field.ToString()));
+    }
+    return FText::FromString(FString::Printf(TEXT("%s: %d line(s) removed, %d added%s"),
+        *Field.ToString(), Diff->NumDeleted, Diff->NumInserted,
+        Diff->bStructuralJson ? TEXT(" (compared as JSON)") : TEXT("")));
+}
+
+TSharedRef<ITableRow> SStoreTextDiffView::OnGenerateLine(
+    TSharedPtr<FStoreTextDiffLine> Line,
+    const TSharedRef<STableViewBase>& OwnerTable)
+{
+    FLinearColor Background = FLinearColor::Transparent;
+    const TCHAR* Prefix = TEXT(" ");
+    if (Line->Op == EStoreDiffOp::Delete)
+    {
+        Background = FLinearColor(0.35f, 0.05f, 0.05f, 0.6f);
+        Prefix = TEXT("-");
+    }
+    else if (Line->Op == EStoreDiffOp::Insert)
+    {
+        Background = FLinearColor(0.05f, 0.3f, 0.08f, 0.6f);
+        Prefix = TEXT("+");
+    }
+
+    return SNew(STableRow<TSharedPtr<FStoreTextDiffLine>>, OwnerTable)
+        [
+            SNew(SBorder)
+                .BorderImage(FCoreStyle::Get().GetBrush("GenericWhiteBox"))
+                .BorderBackgroundColor(Background)
+                .Padding(FMargin(4, 0))
+                [
+                    SNew(SHorizontalBox)
+
+                        + SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 6, 0)
+                        [
+                            SNew(STextBlock)
+                                .Text(FText::FromString(Prefix))
+                                .TextStyle(FPFStoreEditorStyle::Get(), "PFStoreEditor.Diff.Text")
+                        ]
+
+                        + SHorizontalBox::Slot().FillWidth(1.f)
+                        [
+                            SNew(SRichTextBlock)
+                                .Text(StoreTextDiffViewPrivate::MakeLineMarkup(*Line))
+                                .TextStyle(FPFStoreEditorStyle::Get(), "PFStoreEditor.Diff.Text")
+                                .DecoratorStyleSet(&FPFStoreEditorStyle::Get())
+                                .AutoWrapText(true)
+                        ]
+                ]
+        ];
+}
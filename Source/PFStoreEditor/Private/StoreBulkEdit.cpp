@@ -0,0 +1,570 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreBulkEdit.h"
+
+#include "StoreCatalog.h"
+#include "StoreItemBitSet.h"
+#include "StoreItemQuery.h"
+#include "StoreItemRecord.h"
+#include "StoreStats.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/DefaultValueHelper.h"
+
+namespace StoreBulkEditPrivate
+{
+	enum class EFieldKind : uint8
+	{
+		String,
+		List,
+		Flag,
+		Integer,
+		Currencies,
+	};
+
+	/** Which items a field exists on; Bundle and Container fields are skipped on other items. */
+	enum class EEditGroup : uint8
+	{
+		Item,
+		Bundle,
+		Container,
+	};
+
+	/** A record member actions can write, by its diff field name; Get returns the member as Kind's type. */
+	struct FEditField
+	{
+		const TCHAR* Name;
+		const TCHAR* Alias;
+		EFieldKind Kind;
+		EEditGroup Group;
+		void* (*Get)(FStoreItemRecord& Record);
+	};
+
+#define PFSTORE_EDIT_FIELD(Name, Alias, Kind, Group, Member) \
+	FEditField{ TEXT(Name), TEXT(Alias), EFieldKind::Kind, EEditGroup::Group, [](FStoreItemRecord& Record) -> void* { return &Record.Member; } }
+
+	/** Aliases are the short names FStoreItemQuery takes, so a Where and its actions read alike. */
+	static TConstArrayView<FEditField> GetEditFields()
+	{
+		static const FEditField Fields[] =
+		{
+			PFSTORE_EDIT_FIELD("DisplayName", "Name", String, Item, DisplayName),
+			PFSTORE_EDIT_FIELD("ItemClass", "Class", String, Item, ItemClass),
+			PFSTORE_EDIT_FIELD("Description", "", String, Item, Description),
+			PFSTORE_EDIT_FIELD("CustomData", "", String, Item, CustomData),
+			PFSTORE_EDIT_FIELD("Tags", "Tag", List, Item, Tags),
+			PFSTORE_EDIT_FIELD("VirtualCurrencyPrices", "Price", Currencies, Item, Prices),
+
+			PFSTORE_EDIT_FIELD("IsLimitedEdition", "LimitedEdition", Flag, Item, bIsLimitedEdition),
+			PFSTORE_EDIT_FIELD("IsTokenForCharacterCreation", "TokenForCharacterCreation", Flag, Item, bIsTokenForCharacterCreation),
+			PFSTORE_EDIT_FIELD("IsTradable", "Tradable", Flag, Item, bIsTradable),
+			PFSTORE_EDIT_FIELD("IsStackable", "Stackable", Flag, Item, bIsStackable),
+
+			PFSTORE_EDIT_FIELD("UsageCount", "", Integer, Item, Consumable.UsageCount),
+			PFSTORE_EDIT_FIELD("UsagePeriod", "", Integer, Item, Consumable.UsagePeriod),
+			PFSTORE_EDIT_FIELD("UsagePeriodGroup", "", String, Item, Consumable.UsagePeriodGroup),
+
+			PFSTORE_EDIT_FIELD("BundledItems", "", List, Bundle, Bundle.BundledItems),
+			PFSTORE_EDIT_FIELD("BundledResultTables", "", List, Bundle, Bundle.BundledResultTables),
+			PFSTORE_EDIT_FIELD("BundledVirtualCurrencies", "", Currencies, Bundle, Bundle.BundledVirtualCurrencies),
+
+			PFSTORE_EDIT_FIELD("KeyItemId", "", String, Container, Container.KeyItemId),
+			PFSTORE_EDIT_FIELD("ItemContents", "", List, Container, Container.ItemContents),
+			PFSTORE_EDIT_FIELD("ResultTableContents", "", List, Container, Container.ResultTableContents),
+			PFSTORE_EDIT_FIELD("VirtualCurrencyContents", "", Currencies, Container, Container.VirtualCurrencyContents),
+		};
+		return Fields;
+	}
+
+#undef PFSTORE_EDIT_FIELD
+
+	static const FEditField* FindEditField(FStringView Name)
+	{
+		for (const FEditField& Field : GetEditFields())
+		{
+			if (Name.Equals(Field.Name, ESearchCase::IgnoreCase) || Name.Equals(Field.Alias, ESearchCase::IgnoreCase))
+			{
+				return &Field;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Whether Field exists on Record. Writing bundle contents into an item that is not a bundle
+	 * would not make it one, and its asset has nowhere to keep them.
+	 */
+	static bool AppliesTo(const FEditField& Field, const FStoreItemRecord& Record)
+	{
+		switch (Field.Group)
+		{
+		case EEditGroup::Bundle: return Record.bIsBundle;
+		case EEditGroup::Container: return Record.bIsContainer;
+		default: return true;
+		}
+	}
+
+	/**
+	 * Splits Text into statements at ';' and line breaks outside double quotes, so a quoted value
+	 * may contain either.
+	 */
+	static void SplitStatements(FStringView Text, TArray<FStringView>& OutStatements)
+	{
+		bool bInQuotes = false;
+		int32 Start = 0;
+		for (int32 Index = 0; Index <= Text.Len(); ++Index)
+		{
+			const TCHAR Char = Index < Text.Len() ? Text[Index] : TEXT(';');
+			if (Char == TEXT('"'))
+			{
+				bInQuotes = !bInQuotes;
+			}
+			else if (Index == Text.Len() || (!bInQuotes && (Char == TEXT(';') || Char == TEXT('\n') || Char == TEXT('\r'))))
+			{
+				OutStatements.Add(Text.Mid(Start, Index - Start));
+				Start = Index + 1;
+			}
+		}
+	}
+
+	/** Amounts and counts stay within what PlayFab accepts; subtracting past zero stops at zero. */
+	static int32 ClampAmount(int64 Value)
+	{
+		return static_cast<int32>(FMath::Clamp<int64>(Value, 0, MAX_int32));
+	}
+
+	static int32 ScaleAmount(int32 Value, double Factor)
+	{
+		return ClampAmount(FMath::RoundToInt64(Value * Factor));
+	}
+
+	static void ApplyAction(const FEditField& Field, const FStoreBulkEditAction& Action, FStoreItemRecord& Record)
+	{
+		void* const Member = Field.Get(Record);
+		switch (Field.Kind)
+		{
+		case EFieldKind::String:
+			*static_cast<FString*>(Member) = Action.Text;
+			break;
+
+		case EFieldKind::Flag:
+			*static_cast<bool*>(Member) = Action.Number != 0;
+			break;
+
+		case EFieldKind::List:
+		{
+			TArray<FString>& List = *static_cast<TArray<FString>*>(Member);
+			if (Action.Op == EStoreBulkEditOp::Set)
+			{
+				List = Action.Values;
+			}
+			else if (Action.Op == EStoreBulkEditOp::Add)
+			{
+				for (const FString& Value : Action.Values)
+				{
+					List.AddUnique(Value);
+				}
+			}
+			else
+			{
+				List.RemoveAll([&Action](const FString& Value) { return Action.Values.Contains(Value); });
+			}
+			break;
+		}
+
+		case EFieldKind::Integer:
+		{
+			int32& Value = *static_cast<int32*>(Member);
+			switch (Action.Op)
+			{
+			case EStoreBulkEditOp::Set: Value = ClampAmount(Action.Number); break;
+			case EStoreBulkEditOp::Add: Value = ClampAmount(int64(Value) + Action.Number); break;
+			case EStoreBulkEditOp::Subtract: Value = ClampAmount(int64(Value) - Action.Number); break;
+			case EStoreBulkEditOp::Scale: Value = ScaleAmount(Value, Action.Factor); break;
+			}
+			break;
+		}
+
+		case EFieldKind::Currencies:
+		{
+			FCurrencyAmounts& Amounts = *static_cast<FCurrencyAmounts*>(Member);
+			if (Action.bRemove)
+			{
+				Amounts.Remove(Action.Currency);
+				break;
+			}
+
+			// Only Set and Add bring in a currency the item has no amount for.
+			const int32* Current = Amounts.Find(Action.Currency);
+			switch (Action.Op)
+			{
+			case EStoreBulkEditOp::Set:
+				Amounts.Add(Action.Currency, ClampAmount(Action.Number));
+				break;
+			case EStoreBulkEditOp::Add:
+				Amounts.Add(Action.Currency, ClampAmount((Current ? int64(*Current) : 0) + Action.Number));
+				break;
+			case EStoreBulkEditOp::Subtract:
+				if (Current)
+				{
+					Amounts.Add(Action.Currency, ClampAmount(int64(*Current) - Action.Number));
+				}
+				break;
+			case EStoreBulkEditOp::Scale:
+				if (Current)
+				{
+					Amounts.Add(Action.Currency, ScaleAmount(*Current, Action.Factor));
+				}
+				break;
+			}
+			break;
+		}
+		}
+	}
+
+	static bool ParseAction(FStringView Statement, FStoreBulkEditAction& Out, FString& OutError)
+	{
+		struct FOperator { const TCHAR* Text; EStoreBulkEditOp Op; };
+		static const FOperator Operators[] =
+		{
+			{ TEXT("+="), EStoreBulkEditOp::Add },
+			{ TEXT("-="), EStoreBulkEditOp::Subtract },
+			{ TEXT("*="), EStoreBulkEditOp::Scale },
+			{ TEXT("="), EStoreBulkEditOp::Set },
+		};
+
+		// The first '=' ends the operator; a value may contain any character.
+		int32 Equals = INDEX_NONE;
+		if (!Statement.FindChar(TEXT('='), Equals) || Equals == 0)
+		{
+			OutError = FString::Printf(TEXT("'%.*s': expected Field = Value, +=, -= or *="), Statement.Len(), Statement.GetData());
+			return false;
+		}
+		int32 OperatorLen = 1;
+		Out.Op = EStoreBulkEditOp::Set;
+		for (const FOperator& Operator : Operators)
+		{
+			if (Statement.Mid(Equals + 1 - FCString::Strlen(Operator.Text)).StartsWith(Operator.Text))
+			{
+				Out.Op = Operator.Op;
+				OperatorLen = FCString::Strlen(Operator.Text);
+				break;
+			}
+		}
+
+		FStringView FieldText = Statement.Left(Equals + 1 - OperatorLen).TrimStartAndEnd();
+		FStringView Value = Statement.RightChop(Equals + 1).TrimStartAndEnd();
+		if (Value.Len() >= 2 && Value[0] == TEXT('"') && Value[Value.Len() - 1] == TEXT('"'))
+		{
+			Value = Value.Mid(1, Value.Len() - 2);
+		}
+
+		FStringView CurrencyText;
+		int32 Dot = INDEX_NONE;
+		if (FieldText.FindChar(TEXT('.'), Dot))
+		{
+			CurrencyText = FieldText.RightChop(Dot + 1);
+			FieldText = FieldText.Left(Dot);
+		}
+
+		const FEditField* Field = FindEditField(FieldText);
+		if (!Field)
+		{
+			OutError = FString::Printf(TEXT("Unknown field '%.*s'"), FieldText.Len(), FieldText.GetData());
+			return false;
+		}
+		Out.Field = Field->Name;
+
+		if ((Field->Kind == EFieldKind::Currencies) != !CurrencyText.IsEmpty())
+		{
+			OutError = Field->Kind == EFieldKind::Currencies
+				? FString::Printf(TEXT("'%s' needs a currency, e.g. %s.GD"), Field->Name, Field->Name)
+				: FString::Printf(TEXT("'%s' has no sub-fields"), Field->Name);
+			return false;
+		}
+		if (Field->Kind == EFieldKind::Currencies)
+		{
+			Out.Currency = FCurrencyCode::FromString(CurrencyText);
+			if (!Out.Currency.IsValid())
+			{
+				OutError = FString::Printf(TEXT("'%.*s' is not a currency code"), CurrencyText.Len(), CurrencyText.GetData());
+				return false;
+			}
+		}
+
+		const bool bSetOnly = Field->Kind == EFieldKind::String || Field->Kind == EFieldKind::Flag;
+		if (bSetOnly && Out.Op != EStoreBulkEditOp::Set)
+		{
+			OutError = FString::Printf(TEXT("'%s' can only be set with ="), Field->Name);
+			return false;
+		}
+
+		switch (Field->Kind)
+		{
+		case EFieldKind::String:
+			Out.Text = FString(Value);
+			return true;
+
+		case EFieldKind::Flag:
+			if (Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1"))
+			{
+				Out.Number = 1;
+				return true;
+			}
+			if (Value.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Value == TEXT("0"))
+			{
+				Out.Number = 0;
+				return true;
+			}
+			OutError = FString::Printf(TEXT("'%s' takes true or false"), Field->Name);
+			return false;
+
+		case EFieldKind::List:
+			if (Out.Op == EStoreBulkEditOp::Scale)
+			{
+				OutError = FString::Printf(TEXT("'%s' is a list: use =, += or -="), Field->Name);
+				return false;
+			}
+			FString(Value).ParseIntoArray(Out.Values, TEXT(","));
+			for (FString& Entry : Out.Values)
+			{
+				Entry.TrimStartAndEndInline();
+			}
+			Out.Values.RemoveAll([](const FString& Entry) { return Entry.IsEmpty(); });
+			return true;
+
+		default:
+			break;
+		}
+
+		// Integers and currency amounts.
+		if (Field->Kind == EFieldKind::Currencies && Out.Op == EStoreBulkEditOp::Set && Value.Equals(TEXT("none"), ESearchCase::IgnoreCase))
+		{
+			Out.bRemove = true;
+			return true;
+		}
+		if (Value.EndsWith(TEXT('%')))
+		{
+			if (Out.Op != EStoreBulkEditOp::Add && Out.Op != EStoreBulkEditOp::Subtract)
+			{
+				OutError = FString::Printf(TEXT("'%s': percentages go with += or -="), Field->Name);
+				return false;
+			}
+			const FString PercentText(Value.LeftChop(1).TrimEnd());
+			double Percent = 0.0;
+			if (!FDefaultValueHelper::ParseDouble(PercentText, Percent))
+			{
+				OutError = FString::Printf(TEXT("'%s' is not a percentage"), *FString(Value));
+				return false;
+			}
+			Out.Factor = Out.Op == EStoreBulkEditOp::Add ? 1.0 + Percent / 100.0 : 1.0 - Percent / 100.0;
+			Out.Op = EStoreBulkEditOp::Scale;
+			return true;
+		}
+		if (Out.Op == EStoreBulkEditOp::Scale)
+		{
+			const FString Factor(Value);
+			if (!FDefaultValueHelper::ParseDouble(Factor, Out.Factor))
+			{
+				OutError = FString::Printf(TEXT("'%s' is not a number"), *Factor);
+				return false;
+			}
+			return true;
+		}
+		if (!FStoreItemQuery::ParseNumber(Value, Out.Number))
+		{
+			OutError = FString::Printf(TEXT("'%.*s' is not a number"), Value.Len(), Value.GetData());
+			return false;
+		}
+		return true;
+	}
+}
+
+int32 FStoreBulkEditPreview::NumFieldChanges() const
+{
+	int32 Count = 0;
+	for (const TArray<FName>& ItemFields : Fields)
+	{
+		Count += ItemFields.Num();
+	}
+	return Count;
+}
+
+bool FStoreBulkEdit::ParseActions(FStringView Text, FString* OutError)
+{
+	Actions.Reset();
+
+	TArray<FStringView> Statements;
+	StoreBulkEditPrivate::SplitStatements(Text, Statements);
+	for (const FStringView Statement : Statements)
+	{
+		const FStringView Trimmed = Statement.TrimStartAndEnd();
+		if (Trimmed.IsEmpty())
+		{
+			continue;
+		}
+
+		FString Error;
+		FStoreBulkEditAction Action;
+		if (!StoreBulkEditPrivate::ParseAction(Trimmed, Action, Error))
+		{
+			if (OutError)
+			{
+				*OutError = Error;
+			}
+			Actions.Reset();
+			return false;
+		}
+		Actions.Add(MoveTemp(Action));
+	}
+
+	if (Actions.Num() == 0)
+	{
+		if (OutError)
+		{
+			*OutError = TEXT("No edits given");
+		}
+		return false;
+	}
+	return true;
+}
+
+bool FStoreBulkEdit::Preview(TConstArrayView<FStoreItemRecord> Records, FStoreBulkEditPreview& OutPreview, FString* OutError) const
+{
+	using namespace StoreBulkEditPrivate;
+
+	PFSTORE_SCOPE(BulkEdit);
+
+	OutPreview = FStoreBulkEditPreview();
+
+	// Resolved once, so the workers only run the actions.
+	TArray<const FEditField*> Fields;
+	for (const FStoreBulkEditAction& Action : Actions)
+	{
+		const FEditField* Field = FindEditField(Action.Field.ToString());
+		if (!Field)
+		{
+			if (OutError)
+			{
+				*OutError = FString::Printf(TEXT("Unknown field '%s'"), *Action.Field.ToString());
+			}
+			return false;
+		}
+		Fields.Add(Field);
+	}
+
+	TArray<int32> Selected;
+	if (!Where.TrimStartAndEnd().IsEmpty())
+	{
+		// Same query engine as the Editor Economy panel, over a catalog of the snapshot.
+		FStoreCatalogBuilder Builder;
+		TArray<int32> RecordOfItem;
+		RecordOfItem.Reserve(Records.Num());
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			if (Builder.AddItem(Records[Index]).IsValid())
+			{
+				RecordOfItem.Add(Index);
+			}
+		}
+		const TSharedRef<const FStoreCatalog> Catalog = Builder.Build();
+
+		FStoreItemQuery Query;
+		if (!FStoreItemQuery::Compile(*Catalog, Where, Query, OutError))
+		{
+			return false;
+		}
+		FStoreItemBitSet Matches;
+		Query.Evaluate(*Catalog, Matches);
+
+		Selected.Reserve(Matches.CountSetBits());
+		Matches.ForEachSetBit([&Selected, &RecordOfItem](FStoreItemHandle Item)
+			{
+				Selected.Add(RecordOfItem[Item.Index]);
+			});
+	}
+	else
+	{
+		Selected.Reserve(Records.Num());
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			Selected.Add(Index);
+		}
+	}
+
+	if (ItemIds.Num() > 0)
+	{
+		const TSet<FString> Ids(ItemIds);
+		Selected.RemoveAll([&Records, &Ids](int32 Index) { return !Ids.Contains(Records[Index].ItemId); });
+	}
+	OutPreview.NumSelected = Selected.Num();
+
+	// Each worker edits its own copies and fills its own slots; nothing is shared but the input.
+	TArray<FStoreItemRecord> Edited;
+	Edited.SetNum(Selected.Num());
+	TArray<TArray<FName>> Changed;
+	Changed.SetNum(Selected.Num());
+	TArray<bool> Skipped;
+	Skipped.SetNumZeroed(Selected.Num());
+	ParallelFor(TEXT("PFStore.BulkEdit"), Selected.Num(), 64, [&](int32 Index)
+		{
+			const FStoreItemRecord& Source = Records[Selected[Index]];
+			FStoreItemRecord Record = Source;
+			for (int32 ActionIndex = 0; ActionIndex < Actions.Num(); ++ActionIndex)
+			{
+				if (!AppliesTo(*Fields[ActionIndex], Record))
+				{
+					Skipped[Index] = true;
+					continue;
+				}
+				ApplyAction(*Fields[ActionIndex], Actions[ActionIndex], Record);
+			}
+			PFHelpers::DiffFields(Source, Record, Changed[Index]);
+			if (Changed[Index].Num() > 0)
+			{
+				Edited[Index] = MoveTemp(Record);
+			}
+		});
+
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < Selected.Num(); ++Index)
+	{
+		OutPreview.NumSkipped += Skipped[Index] ? 1 : 0;
+		if (Changed[Index].Num() > 0)
+		{
+			Order.Add(Index);
+		}
+	}
+	Order.Sort([&Records, &Selected](int32 A, int32 B) { return Records[Selected[A]].ItemId < Records[Selected[B]].ItemId; });
+
+	OutPreview.Before.Reserve(Order.Num());
+	OutPreview.After.Reserve(Order.Num());
+	OutPreview.Fields.Reserve(Order.Num());
+	for (const int32 Index : Order)
+	{
+		OutPreview.Before.Add(Records[Selected[Index]]);
+		OutPreview.After.Add(MoveTemp(Edited[Index]));
+		OutPreview.Fields.Add(MoveTemp(Changed[Index]));
+	}
+	return true;
+}
+
+bool FStoreBulkEdit::Apply(const FStoreBulkEditPreview& Preview, bool bSave, FStoreApplyResult& OutResult)
+{
+	// ApplyRecordsToAssets compares with the assets again, so an asset edited since the preview
+	// gets the previewed record as a whole and an unchanged one is not touched.
+	return PFHelpers::ApplyRecordsToAssets(Preview.After, {}, bSave, OutResult,
+		NSLOCTEXT("PFStoreEditor", "BulkEditCatalog", "Bulk Edit Catalog"));
+}
+
+FString FStoreBulkEdit::GetSyntaxHelp()
+{
+	return TEXT("One edit per line or separated by ';', values with ';' in double quotes:\n")
+		TEXT("  Text (=): DisplayName, ItemClass, Description, CustomData, UsagePeriodGroup, KeyItemId\n")
+		TEXT("  Flags (= true/false): IsTradable, IsStackable, IsLimitedEdition, IsTokenForCharacterCreation\n")
+		TEXT("  Numbers (=, +=, -=, *=, += 10%): UsageCount, UsagePeriod (1d, 12h...)\n")
+		TEXT("  Currencies (the same, or = none): Price.GD, BundledVirtualCurrencies.GD, VirtualCurrencyContents.GD\n")
+		TEXT("  Lists (= a, b / += a / -= a): Tags, BundledItems, BundledResultTables, ItemContents, ResultTableContents\n")
+		TEXT("Bundle and container fields only change bundles and containers.\n")
+		TEXT("e.g. Price.GD += 10%; Tags += Season3");
+}
@@ -0,0 +1,998 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreCatalogHistory.h"
+
+#include "PFHelpers.h"
+#include "PFRemoteCatalog.h"
+#include "PFStoreEditorSettings.h"
+#include "StoreStats.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace StoreCatalogHistoryPrivate
+{
+	static constexpr int32 BitsPerLevel = 5;
+	static constexpr uint32 BranchMask = (1u << BitsPerLevel) - 1;
+
+	/** Levels that branch on the id hash. Ids whose hashes agree on all of them share a bucket. */
+	static constexpr int32 MaxDepth = 12;
+
+	static uint64 HashId(const FString& ItemId)
+	{
+		return CityHash64(reinterpret_cast<const char*>(*ItemId), ItemId.Len() * sizeof(TCHAR));
+	}
+
+	/** Node hashes are sums of these, so a bucket hashes the same in any order. */
+	static uint64 HashLeaf(uint64 IdHash, uint64 ContentHash)
+	{
+		return CityHash128to64(Uint128_64(IdHash, ContentHash));
+	}
+
+	static int32 GetBranch(uint64 IdHash, int32 Depth)
+	{
+		return static_cast<int32>((IdHash >> (Depth * BitsPerLevel)) & BranchMask);
+	}
+
+	static int32 GetSlotIndex(uint32 Bitmap, int32 Branch)
+	{
+		return static_cast<int32>(FMath::CountBits(Bitmap & ((1u << Branch) - 1)));
+	}
+}
+
+struct FStoreItemTrie::FNode
+{
+	/** A record, or a child node one level down. */
+	struct FSlot
+	{
+		TSharedPtr<const FNode> Child;
+		TSharedPtr<const FStoreItemRecord> Record;
+		uint64 IdHash = 0;
+		uint64 ContentHash = 0;
+
+		bool IsLeaf() const { return Record.IsValid(); }
+
+		bool IsSameItem(const FSlot& Other) const
+		{
+			return IdHash == Other.IdHash && Record->ItemId.Equals(Other.Record->ItemId, ESearchCase::CaseSensitive);
+		}
+	};
+
+	/** Which of the 32 branches are taken, Slots holds them in branch order. Unused in buckets. */
+	uint32 Bitmap = 0;
+	TArray<FSlot> Slots;
+
+	/** Sum of the leaf hashes below, and their number. */
+	uint64 Hash = 0;
+	int32 Num = 0;
+
+	void Finish()
+	{
+		Hash = 0;
+		Num = 0;
+		for (const FSlot& Slot : Slots)
+		{
+			Hash += Slot.IsLeaf() ? StoreCatalogHistoryPrivate::HashLeaf(Slot.IdHash, Slot.ContentHash) : Slot.Child->Hash;
+			Num += Slot.IsLeaf() ? 1 : Slot.Child->Num;
+		}
+	}
+};
+
+namespace StoreCatalogHistoryPrivate
+{
+	using FNode = FStoreItemTrie::FNode;
+	using FSlot = FNode::FSlot;
+	using FVisit = TFunctionRef<void(const FStoreItemRecord* Old, const FStoreItemRecord* New)>;
+
+	static FSlot MakeLeaf(TSharedRef<const FStoreItemRecord> Record, uint64 ContentHash)
+	{
+		FSlot Leaf;
+		Leaf.IdHash = HashId(Record->ItemId);
+		Leaf.ContentHash = ContentHash;
+		Leaf.Record = MoveTemp(Record);
+		return Leaf;
+	}
+
+	/** Puts Leaf into a bucket, replacing the record with its id. */
+	static void AddToBucket(FNode& Bucket, const FSlot& Leaf)
+	{
+		if (FSlot* Existing = Bucket.Slots.FindByPredicate([&Leaf](const FSlot& Slot) { return Slot.IsSameItem(Leaf); }))
+		{
+			*Existing = Leaf;
+		}
+		else
+		{
+			Bucket.Slots.Add(Leaf);
+		}
+	}
+
+	/** A child that holds a single record is kept as that record in its parent's slot. */
+	static FSlot MakeChildSlot(TSharedRef<const FNode> Child)
+	{
+		if (Child->Slots.Num() == 1 && Child->Slots[0].IsLeaf())
+		{
+			return Child->Slots[0];
+		}
+		FSlot Slot;
+		Slot.Child = MoveTemp(Child);
+		return Slot;
+	}
+
+	static const FSlot* FindSlot(const FNode* Node, uint64 IdHash, const FString& ItemId)
+	{
+		for (int32 Depth = 0; Node; ++Depth)
+		{
+			const FSlot* Slot = nullptr;
+			if (Depth >= MaxDepth)
+			{
+				Slot = Node->Slots.FindByPredicate([IdHash, &ItemId](const FSlot& Candidate)
+					{
+						return Candidate.IdHash == IdHash && Candidate.Record->ItemId.Equals(ItemId, ESearchCase::CaseSensitive);
+					});
+				return Slot;
+			}
+
+			const int32 Branch = GetBranch(IdHash, Depth);
+			if (!(Node->Bitmap & (1u << Branch)))
+			{
+				return nullptr;
+			}
+			Slot = &Node->Slots[GetSlotIndex(Node->Bitmap, Branch)];
+			if (Slot->IsLeaf())
+			{
+				return Slot->IdHash == IdHash && Slot->Record->ItemId.Equals(ItemId, ESearchCase::CaseSensitive) ? Slot : nullptr;
+			}
+			Node = Slot->Child.Get();
+		}
+		return nullptr;
+	}
+
+	/** Copies the path down to Leaf's place; everything beside it stays shared. */
+	static TSharedRef<const FNode> Insert(const FNode* Node, int32 Depth, const FSlot& Leaf)
+	{
+		TSharedRef<FNode> Result = Node ? MakeShared<FNode>(*Node) : MakeShared<FNode>();
+		if (Depth >= MaxDepth)
+		{
+			AddToBucket(*Result, Leaf);
+		}
+		else
+		{
+			const int32 Branch = GetBranch(Leaf.IdHash, Depth);
+			const int32 Index = GetSlotIndex(Result->Bitmap, Branch);
+			if (!(Result->Bitmap & (1u << Branch)))
+			{
+				Result->Bitmap |= 1u << Branch;
+				Result->Slots.Insert(Leaf, Index);
+			}
+			else if (!Result->Slots[Index].IsLeaf())
+			{
+				Result->Slots[Index].Child = Insert(Result->Slots[Index].Child.Get(), Depth + 1, Leaf);
+			}
+			else if (Result->Slots[Index].IsSameItem(Leaf))
+			{
+				Result->Slots[Index] = Leaf;
+			}
+			else
+			{
+				// Two items on one branch: both move a level down.
+				const TSharedRef<const FNode> Single = Insert(nullptr, Depth + 1, Result->Slots[Index]);
+				FSlot Down;
+				Down.Child = Insert(&Single.Get(), Depth + 1, Leaf);
+				Result->Slots[Index] = MoveTemp(Down);
+			}
+		}
+		Result->Finish();
+		return Result;
+	}
+
+	/** Returns Node itself when the item is not there, null when nothing is left. */
+	static TSharedPtr<const FNode> Erase(const TSharedRef<const FNode>& Node, int32 Depth, uint64 IdHash, const FString& ItemId)
+	{
+		auto IsItem = [IdHash, &ItemId](const FSlot& Slot)
+			{
+				return Slot.IsLeaf() && Slot.IdHash == IdHash && Slot.Record->ItemId.Equals(ItemId, ESearchCase::CaseSensitive);
+			};
+
+		int32 Index = INDEX_NONE;
+		int32 Branch = INDEX_NONE;
+		FSlot Replacement;
+		bool bRemoveSlot = false;
+		if (Depth >= MaxDepth)
+		{
+			Index = Node->Slots.IndexOfByPredicate(IsItem);
+			if (Index == INDEX_NONE)
+			{
+				return Node;
+			}
+			bRemoveSlot = true;
+		}
+		else
+		{
+			Branch = GetBranch(IdHash, Depth);
+			if (!(Node->Bitmap & (1u << Branch)))
+			{
+				return Node;
+			}
+			Index = GetSlotIndex(Node->Bitmap, Branch);
+			const FSlot& Slot = Node->Slots[Index];
+			if (Slot.IsLeaf())
+			{
+				if (!IsItem(Slot))
+				{
+					return Node;
+				}
+				bRemoveSlot = true;
+			}
+			else
+			{
+				const TSharedPtr<const FNode> Child = Erase(Slot.Child.ToSharedRef(), Depth + 1, IdHash, ItemId);
+				if (Child == Slot.Child)
+				{
+					return Node;
+				}
+				bRemoveSlot = !Child.IsValid();
+				if (Child.IsValid())
+				{
+					Replacement = MakeChildSlot(Child.ToSharedRef());
+				}
+			}
+		}
+
+		TSharedRef<FNode> Result = MakeShared<FNode>(*Node);
+		if (bRemoveSlot)
+		{
+			Result->Slots.RemoveAt(Index);
+			if (Branch != INDEX_NONE)
+			{
+				Result->Bitmap &= ~(1u << Branch);
+			}
+		}
+		else
+		{
+			Result->Slots[Index] = MoveTemp(Replacement);
+		}
+
+		if (Result->Slots.Num() == 0)
+		{
+			return nullptr;
+		}
+		Result->Finish();
+		return Result;
+	}
+
+	/** Leaves sorted by BuildKey, so every branch at every level is one contiguous range. */
+	static TSharedRef<const FNode> BuildNode(TArrayView<const FSlot> Leaves, int32 Depth)
+	{
+		TSharedRef<FNode> Node = MakeShared<FNode>();
+		if (Depth >= MaxDepth)
+		{
+			for (const FSlot& Leaf : Leaves)
+			{
+				AddToBucket(*Node, Leaf);
+			}
+		}
+		else
+		{
+			for (int32 Start = 0; Start < Leaves.Num();)
+			{
+				const int32 Branch = GetBranch(Leaves[Start].IdHash, Depth);
+				int32 End = Start + 1;
+				while (End < Leaves.Num() && GetBranch(Leaves[End].IdHash, Depth) == Branch)
+				{
+					++End;
+				}
+
+				Node->Bitmap |= 1u << Branch;
+				Node->Slots.Add(End - Start == 1 ? Leaves[Start] : MakeChildSlot(BuildNode(Leaves.Slice(Start, End - Start), Depth + 1)));
+				Start = End;
+			}
+		}
+		Node->Finish();
+		return Node;
+	}
+
+	/** The branches of all levels, the first level most significant. */
+	static uint64 BuildKey(uint64 IdHash)
+	{
+		uint64 Key = 0;
+		for (int32 Depth = 0; Depth < MaxDepth; ++Depth)
+		{
+			Key = (Key << BitsPerLevel) | GetBranch(IdHash, Depth);
+		}
+		return Key;
+	}
+
+	static void ForEachLeaf(const FNode& Node, TFunctionRef<void(const FSlot&)> Visit)
+	{
+		for (const FSlot& Slot : Node.Slots)
+		{
+			if (Slot.IsLeaf())
+			{
+				Visit(Slot);
+			}
+			else
+			{
+				ForEachLeaf(*Slot.Child, Visit);
+			}
+		}
+	}
+
+	static void VisitAll(const FSlot& Slot, bool bOld, FVisit Visit)
+	{
+		auto VisitLeaf = [bOld, &Visit](const FSlot& Leaf)
+			{
+				bOld ? Visit(Leaf.Record.Get(), nullptr) : Visit(nullptr, Leaf.Record.Get());
+			};
+		if (Slot.IsLeaf())
+		{
+			VisitLeaf(Slot);
+		}
+		else
+		{
+			ForEachLeaf(*Slot.Child, VisitLeaf);
+		}
+	}
+
+	/** A record on one side, a subtree on the other: the record matches at most one item there. */
+	static void DiffLeafAgainst(const FSlot& Leaf, const FNode& Node, bool bLeafIsOld, FVisit Visit)
+	{
+		bool bMatched = false;
+		ForEachLeaf(Node, [&Leaf, &bMatched, bLeafIsOld, &Visit](const FSlot& Other)
+			{
+				if (!bMatched && Leaf.IsSameItem(Other))
+				{
+					bMatched = true;
+					if (Leaf.ContentHash != Other.ContentHash)
+					{
+						bLeafIsOld ? Visit(Leaf.Record.Get(), Other.Record.Get()) : Visit(Other.Record.Get(), Leaf.Record.Get());
+					}
+				}
+				else
+				{
+					bLeafIsOld ? Visit(nullptr, Other.Record.Get()) : Visit(Other.Record.Get(), nullptr);
+				}
+			});
+		if (!bMatched)
+		{
+			bLeafIsOld ? Visit(Leaf.Record.Get(), nullptr) : Visit(nullptr, Leaf.Record.Get());
+		}
+	}
+
+	static void DiffNodes(const FNode& Old, const FNode& New, int32 Depth, FVisit Visit);
+
+	static void DiffSlots(const FSlot* Old, const FSlot* New, int32 Depth, FVisit Visit)
+	{
+		if (!Old || !New)
+		{
+			VisitAll(Old ? *Old : *New, Old != nullptr, Visit);
+		}
+		else if (Old->IsLeaf() && New->IsLeaf())
+		{
+			if (!Old->IsSameItem(*New))
+			{
+				Visit(Old->Record.Get(), nullptr);
+				Visit(nullptr, New->Record.Get());
+			}
+			else if (Old->ContentHash != New->ContentHash)
+			{
+				Visit(Old->Record.Get(), New->Record.Get());
+			}
+		}
+		else if (Old->IsLeaf())
+		{
+			DiffLeafAgainst(*Old, *New->Child, true, Visit);
+		}
+		else if (New->IsLeaf())
+		{
+			DiffLeafAgainst(*New, *Old->Child, false, Visit);
+		}
+		else
+		{
+			DiffNodes(*Old->Child, *New->Child, Depth + 1, Visit);
+		}
+	}
+
+	static void DiffNodes(const FNode& Old, const FNode& New, int32 Depth, FVisit Visit)
+	{
+		// Shared or equal subtrees end the walk; that is what keeps diffs of close versions cheap.
+		if (&Old == &New || (Old.Hash == New.Hash && Old.Num == New.Num))
+		{
+			return;
+		}
+
+		if (Depth >= MaxDepth)
+		{
+			for (const FSlot& OldSlot : Old.Slots)
+			{
+				const FSlot* NewSlot = New.Slots.FindByPredicate([&OldSlot](const FSlot& Slot) { return Slot.IsSameItem(OldSlot); });
+				if (!NewSlot || NewSlot->ContentHash != OldSlot.ContentHash)
+				{
+					Visit(OldSlot.Record.Get(), NewSlot ? NewSlot->Record.Get() : nullptr);
+				}
+			}
+			for (const FSlot& NewSlot : New.Slots)
+			{
+				if (!Old.Slots.ContainsByPredicate([&NewSlot](const FSlot& Slot) { return Slot.IsSameItem(NewSlot); }))
+				{
+					Visit(nullptr, NewSlot.Record.Get());
+				}
+			}
+			return;
+		}
+
+		for (uint32 Bits = Old.Bitmap | New.Bitmap; Bits != 0; Bits &= Bits - 1)
+		{
+			const int32 Branch = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+			const uint32 Bit = 1u << Branch;
+			const FSlot* OldSlot = (Old.Bitmap & Bit) ? &Old.Slots[GetSlotIndex(Old.Bitmap, Branch)] : nullptr;
+			const FSlot* NewSlot = (New.Bitmap & Bit) ? &New.Slots[GetSlotIndex(New.Bitmap, Branch)] : nullptr;
+			DiffSlots(OldSlot, NewSlot, Depth, Visit);
+		}
+	}
+}
+
+// ---------- FStoreItemTrie ----------
+
+int32 FStoreItemTrie::Num() const
+{
+	return Root.IsValid() ? Root->Num : 0;
+}
+
+const FStoreItemRecord* FStoreItemTrie::Find(const FString& ItemId, uint64* OutContentHash) const
+{
+	const StoreCatalogHistoryPrivate::FSlot* Slot = StoreCatalogHistoryPrivate::FindSlot(Root.Get(), StoreCatalogHistoryPrivate::HashId(ItemId), ItemId);
+	if (Slot && OutContentHash)
+	{
+		*OutContentHash = Slot->ContentHash;
+	}
+	return Slot ? Slot->Record.Get() : nullptr;
+}
+
+FStoreItemTrie FStoreItemTrie::Set(FRecordRef Record, uint64 ContentHash) const
+{
+	FStoreItemTrie Result;
+	Result.Root = StoreCatalogHistoryPrivate::Insert(Root.Get(), 0, StoreCatalogHistoryPrivate::MakeLeaf(MoveTemp(Record), ContentHash));
+	return Result;
+}
+
+FStoreItemTrie FStoreItemTrie::Remove(const FString& ItemId) const
+{
+	if (!Root.IsValid())
+	{
+		return *this;
+	}
+	FStoreItemTrie Result;
+	Result.Root = StoreCatalogHistoryPrivate::Erase(Root.ToSharedRef(), 0, StoreCatalogHistoryPrivate::HashId(ItemId), ItemId);
+	return Result;
+}
+
+FStoreItemTrie FStoreItemTrie::Build(TConstArrayView<FRecordRef> Records, TConstArrayView<uint64> ContentHashes)
+{
+	using namespace StoreCatalogHistoryPrivate;
+	check(Records.Num() == ContentHashes.Num());
+
+	FStoreItemTrie Result;
+	if (Records.Num() == 0)
+	{
+		return Result;
+	}
+
+	TArray<FSlot> Leaves;
+	Leaves.SetNum(Records.Num());
+	TArray<uint64> Keys;
+	Keys.SetNumUninitialized(Records.Num());
+	ParallelFor(TEXT("PFStore.HistoryBuild"), Records.Num(), 256, [&Records, &ContentHashes, &Leaves, &Keys](int32 Index)
+		{
+			Leaves[Index] = MakeLeaf(Records[Index], ContentHashes[Index]);
+			Keys[Index] = BuildKey(Leaves[Index].IdHash);
+		});
+
+	// Stable, so of two records with one id the later one wins, as with Set.
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Leaves.Num());
+	for (int32 Index = 0; Index < Order.Num(); ++Index)
+	{
+		Order[Index] = Index;
+	}
+	Order.StableSort([&Keys](int32 A, int32 B) { return Keys[A] < Keys[B]; });
+
+	TArray<FSlot> Sorted;
+	Sorted.Reserve(Leaves.Num());
+	for (const int32 Index : Order)
+	{
+		Sorted.Add(MoveTemp(Leaves[Index]));
+	}
+
+	Result.Root = BuildNode(Sorted, 0);
+	return Result;
+}
+
+void FStoreItemTrie::ForEach(TFunctionRef<void(const FRecordRef& Record, uint64 ContentHash)> Visit) const
+{
+	if (Root.IsValid())
+	{
+		StoreCatalogHistoryPrivate::ForEachLeaf(*Root, [&Visit](const StoreCatalogHistoryPrivate::FSlot& Leaf)
+			{
+				Visit(Leaf.Record.ToSharedRef(), Leaf.ContentHash);
+			});
+	}
+}
+
+TArray<FStoreItemRecord> FStoreItemTrie::ToArray() const
+{
+	TArray<FStoreItemRecord> Records;
+	Records.Reserve(Num());
+	ForEach([&Records](const FRecordRef& Record, uint64)
+		{
+			Records.Add(*Record);
+		});
+	Records.Sort([](const FStoreItemRecord& A, const FStoreItemRecord& B) { return A.ItemId < B.ItemId; });
+	return Records;
+}
+
+void FStoreItemTrie::Diff(const FStoreItemTrie& From, const FStoreItemTrie& To,
+	TFunctionRef<void(const FStoreItemRecord* Old, const FStoreItemRecord* New)> Visit)
+{
+	using namespace StoreCatalogHistoryPrivate;
+
+	if (From.Root.IsValid() && To.Root.IsValid())
+	{
+		DiffNodes(*From.Root, *To.Root, 0, Visit);
+	}
+	else if (From.Root.IsValid() || To.Root.IsValid())
+	{
+		const bool bOld = From.Root.IsValid();
+		ForEachLeaf(bOld ? *From.Root : *To.Root, [bOld, &Visit](const FSlot& Leaf)
+			{
+				bOld ? Visit(Leaf.Record.Get(), nullptr) : Visit(nullptr, Leaf.Record.Get());
+			});
+	}
+}
+
+void FStoreItemTrie::Diff(const FStoreItemTrie& From, const FStoreItemTrie& To, FStoreCatalogDiff& OutDiff)
+{
+	PFSTORE_SCOPE(Diff);
+
+	OutDiff = FStoreCatalogDiff();
+
+	TArray<TPair<const FStoreItemRecord*, const FStoreItemRecord*>> Changed;
+	Diff(From, To, [&OutDiff, &Changed](const FStoreItemRecord* Old, const FStoreItemRecord* New)
+		{
+			if (!Old)
+			{
+				OutDiff.Added.Add(New->ItemId);
+			}
+			else if (!New)
+			{
+				OutDiff.Removed.Add(Old->ItemId);
+			}
+			else
+			{
+				Changed.Emplace(Old, New);
+			}
+		});
+
+	OutDiff.Changed.SetNum(Changed.Num());
+	ParallelFor(TEXT("PFStore.HistoryDiff"), Changed.Num(), 64, [&Changed, &OutDiff](int32 Index)
+		{
+			FStoreItemChange& Change = OutDiff.Changed[Index];
+			Change.ItemId = Changed[Index].Value->ItemId;
+			PFHelpers::DiffFields(*Changed[Index].Value, *Changed[Index].Key, Change.Fields);
+		});
+	OutDiff.Changed.RemoveAll([](const FStoreItemChange& Change) { return Change.Fields.Num() == 0; });
+
+	OutDiff.Added.Sort();
+	OutDiff.Removed.Sort();
+	OutDiff.Changed.Sort([](const FStoreItemChange& A, const FStoreItemChange& B) { return A.ItemId < B.ItemId; });
+}
+
+// ---------- FStoreCatalogSnapshot ----------
+
+FString FStoreCatalogSnapshot::Describe() const
+{
+	static const TCHAR* SourceNames[] = { TEXT("Export"), TEXT("Upload"), TEXT("Merge") };
+	FString Text = FString::Printf(TEXT("%s %s (%d items)"),
+		*Time.ToString(TEXT("%Y-%m-%d %H:%M")), SourceNames[static_cast<uint8>(Source)], Items.Num());
+	if (!Label.IsEmpty())
+	{
+		Text += TEXT(" ") + Label;
+	}
+	return Text;
+}
+
+TSharedRef<const FPFRemoteCatalog> FStoreCatalogSnapshot::ToCatalog(const FString& CatalogVersion) const
+{
+	TSharedRef<FPFRemoteCatalog> Catalog = MakeShared<FPFRemoteCatalog>();
+	Catalog->CatalogVersion = CatalogVersion;
+	Catalog->FetchTime = Time;
+	Catalog->Items = Items.ToArray();
+	Catalog->DropTables = *DropTables;
+	return Catalog;
+}
+
+// ---------- FStoreCatalogHistory ----------
+
+namespace StoreCatalogHistoryPrivate
+{
+	static constexpr uint32 Magic = 0x48534650; // "PFSH"
+
+	/** Bump whenever the record layout changes; older histories are then started over. */
+	static constexpr uint32 Version = 1;
+
+	static uint64 HashDropTables(const TArray<FDropTableInfo>& Tables)
+	{
+		uint64 Hash = Tables.Num();
+		for (const FDropTableInfo& Table : Tables)
+		{
+			Hash = CityHash128to64(Uint128_64(Hash, PFHelpers::HashDropTable(Table)));
+		}
+		return Hash;
+	}
+
+	/** [size][time][source][label][upserted records][removed ids][drop tables if they changed] */
+	static void WriteSnapshot(TArray<uint8>& Bytes, const FStoreCatalogSnapshot* Previous, const FStoreCatalogSnapshot& Snapshot)
+	{
+		TArray<const FStoreItemRecord*> Upserted;
+		TArray<const FString*> Removed;
+		FStoreItemTrie::Diff(Previous ? Previous->Items : FStoreItemTrie(), Snapshot.Items,
+			[&Upserted, &Removed](const FStoreItemRecord* Old, const FStoreItemRecord* New)
+			{
+				if (New)
+				{
+					Upserted.Add(New);
+				}
+				else
+				{
+					Removed.Add(&Old->ItemId);
+				}
+			});
+
+		FMemoryWriter Ar(Bytes, false, true);
+		const int64 SizeOffset = Ar.Tell();
+		uint32 Size = 0;
+		int64 Ticks = Snapshot.Time.GetTicks();
+		uint8 Source = static_cast<uint8>(Snapshot.Source);
+		Ar << Size << Ticks << Source << const_cast<FString&>(Snapshot.Label);
+
+		int32 Num = Upserted.Num();
+		Ar << Num;
+		for (const FStoreItemRecord* Record : Upserted)
+		{
+			uint64 ContentHash = 0;
+			Snapshot.Items.Find(Record->ItemId, &ContentHash);
+			Ar << const_cast<FStoreItemRecord&>(*Record) << ContentHash;
+		}
+
+		Num = Removed.Num();
+		Ar << Num;
+		for (const FString* ItemId : Removed)
+		{
+			Ar << const_cast<FString&>(*ItemId);
+		}
+
+		uint8 bDropTables = (!Previous || Previous->DropTablesHash != Snapshot.DropTablesHash) ? 1 : 0;
+		Ar << bDropTables;
+		if (bDropTables)
+		{
+			uint64 Hash = Snapshot.DropTablesHash;
+			Ar << Hash << const_cast<TArray<FDropTableInfo>&>(*Snapshot.DropTables);
+		}
+
+		Size = static_cast<uint32>(Ar.Tell() - SizeOffset - sizeof(uint32));
+		Ar.Seek(SizeOffset);
+		Ar << Size;
+	}
+
+	/**
+	 * Applies one snapshot record, which ends at End, to the one before it. False if the record is
+	 * cut short or its counts cannot fit in it.
+	 */
+	static bool ReadSnapshot(FMemoryReader& Reader, int64 End, const FStoreCatalogSnapshot* Previous, FStoreCatalogSnapshot& OutSnapshot)
+	{
+		int64 Ticks = 0;
+		uint8 Source = 0;
+		Reader << Ticks << Source << OutSnapshot.Label;
+		OutSnapshot.Time = FDateTime(Ticks);
+		OutSnapshot.Source = static_cast<EStoreSnapshotSource>(FMath::Min<uint8>(Source, static_cast<uint8>(EStoreSnapshotSource::Merge)));
+
+		// Each upserted item takes at least its content hash and each removed id its length, so
+		// a count the rest of the record cannot hold is garbage and must not size an allocation.
+		int32 Num = 0;
+		Reader << Num;
+		if (Reader.IsError() || Num < 0 || Num > (End - Reader.Tell()) / static_cast<int64>(sizeof(uint64)))
+		{
+			return false;
+		}
+		TArray<FStoreItemTrie::FRecordRef> Upserted;
+		TArray<uint64> Hashes;
+		Upserted.Reserve(Num);
+		Hashes.Reserve(Num);
+		for (int32 Index = 0; Index < Num && !Reader.IsError(); ++Index)
+		{
+			TSharedRef<FStoreItemRecord> Record = MakeShared<FStoreItemRecord>();
+			uint64 ContentHash = 0;
+			Reader << *Record << ContentHash;
+			Upserted.Add(Record);
+			Hashes.Add(ContentHash);
+		}
+
+		Reader << Num;
+		if (Reader.IsError() || Num < 0 || Num > (End - Reader.Tell()) / static_cast<int64>(sizeof(int32)))
+		{
+			return false;
+		}
+		TArray<FString> Removed;
+		Removed.SetNum(Num);
+		for (FString& ItemId : Removed)
+		{
+			Reader << ItemId;
+		}
+
+		uint8 bDropTables = 0;
+		Reader << bDropTables;
+		if (bDropTables)
+		{
+			TSharedRef<TArray<FDropTableInfo>> Tables = MakeShared<TArray<FDropTableInfo>>();
+			Reader << OutSnapshot.DropTablesHash << *Tables;
+			OutSnapshot.DropTables = Tables;
+		}
+		else if (Previous)
+		{
+			OutSnapshot.DropTables = Previous->DropTables;
+			OutSnapshot.DropTablesHash = Previous->DropTablesHash;
+		}
+		if (Reader.IsError() || Reader.Tell() > End)
+		{
+			return false;
+		}
+
+		if (!Previous || Previous->Items.IsEmpty())
+		{
+			OutSnapshot.Items = FStoreItemTrie::Build(Upserted, Hashes);
+			return true;
+		}
+		OutSnapshot.Items = Previous->Items;
+		for (int32 Index = 0; Index < Upserted.Num(); ++Index)
+		{
+			OutSnapshot.Items = OutSnapshot.Items.Set(Upserted[Index], Hashes[Index]);
+		}
+		for (const FString& ItemId : Removed)
+		{
+			OutSnapshot.Items = OutSnapshot.Items.Remove(ItemId);
+		}
+		return true;
+	}
+}
+
+FStoreCatalogHistory& FStoreCatalogHistory::Get()
+{
+	static FStoreCatalogHistory Instance;
+	return Instance;
+}
+
+FString FStoreCatalogHistory::GetHistoryFilePath(const FString& CatalogVersion)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PFStore"), TEXT("History"),
+		FPaths::MakeValidFileName(CatalogVersion) + TEXT(".pfhistory"));
+}
+
+FStoreCatalogHistory::FEntry& FStoreCatalogHistory::GetEntry(const FString& CatalogVersion)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = Entries.FindOrAdd(CatalogVersion);
+	if (!Entry.bLoaded)
+	{
+		Entry.bLoaded = true;
+		Load(GetHistoryFilePath(CatalogVersion), Entry.Snapshots);
+	}
+	return Entry;
+}
+
+const TArray<TSharedRef<const FStoreCatalogSnapshot>>& FStoreCatalogHistory::GetSnapshots(const FString& CatalogVersion)
+{
+	return GetEntry(CatalogVersion).Snapshots;
+}
+
+TSharedRef<const FStoreCatalogSnapshot> FStoreCatalogHistory::AddSnapshot(const FString& CatalogVersion, const TArray<FStoreItemRecord>& Records,
+	const TArray<FDropTableInfo>& DropTables, EStoreSnapshotSource Source, const FString& Label)
+{
+	using namespace StoreCatalogHistoryPrivate;
+
+	FEntry& Entry = GetEntry(CatalogVersion);
+	TSharedPtr<const FStoreCatalogSnapshot> Previous;
+	if (Entry.Snapshots.Num() > 0)
+	{
+		Previous = Entry.Snapshots.Last();
+	}
+
+	TArray<uint64> Hashes;
+	Hashes.SetNumUninitialized(Records.Num());
+	ParallelFor(TEXT("PFStore.HistoryHash"), Records.Num(), 256, [&Records, &Hashes](int32 Index)
+		{
+			Hashes[Index] = PFHelpers::HashRecord(Records[Index]);
+		});
+
+	TSharedRef<FStoreCatalogSnapshot> Snapshot = MakeShared<FStoreCatalogSnapshot>();
+	Snapshot->Time = FDateTime::UtcNow();
+	Snapshot->Source = Source;
+	Snapshot->Label = Label;
+
+	if (!Previous.IsValid() || Previous->Items.IsEmpty())
+	{
+		TArray<FStoreItemTrie::FRecordRef> Refs;
+		Refs.Reserve(Records.Num());
+		for (const FStoreItemRecord& Record : Records)
+		{
+			Refs.Add(MakeShared<FStoreItemRecord>(Record));
+		}
+		Snapshot->Items = FStoreItemTrie::Build(Refs, Hashes);
+	}
+	else
+	{
+		// Only what changed is copied; the rest stays shared with the previous snapshot.
+		FStoreItemTrie Items = Previous->Items;
+		TSet<FString> Ids;
+		Ids.Reserve(Records.Num());
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			const FStoreItemRecord& Record = Records[Index];
+			Ids.Add(Record.ItemId);
+
+			uint64 PreviousHash = 0;
+			if (!Items.Find(Record.ItemId, &PreviousHash) || PreviousHash != Hashes[Index])
+			{
+				Items = Items.Set(MakeShared<FStoreItemRecord>(Record), Hashes[Index]);
+			}
+		}
+
+		TArray<FString> Removed;
+		Previous->Items.ForEach([&Ids, &Removed](const FStoreItemTrie::FRecordRef& Record, uint64)
+			{
+				if (!Ids.Contains(Record->ItemId))
+				{
+					Removed.Add(Record->ItemId);
+				}
+			});
+		for (const FString& ItemId : Removed)
+		{
+			Items = Items.Remove(ItemId);
+		}
+		Snapshot->Items = MoveTemp(Items);
+	}
+
+	Snapshot->DropTablesHash = HashDropTables(DropTables);
+	if (Previous.IsValid() && Previous->DropTablesHash == Snapshot->DropTablesHash)
+	{
+		Snapshot->DropTables = Previous->DropTables;
+	}
+	else
+	{
+		Snapshot->DropTables = MakeShared<TArray<FDropTableInfo>>(DropTables);
+	}
+
+	Entry.Snapshots.Add(Snapshot);
+
+	const FString FilePath = GetHistoryFilePath(CatalogVersion);
+	const int32 MaxSnapshots = FMath::Max(2, GetDefault<UPFStoreEditorSettings>()->MaxCatalogHistorySnapshots);
+	bool bWritten;
+	if (Entry.Snapshots.Num() > MaxSnapshots || (Previous.IsValid() && !IFileManager::Get().FileExists(*FilePath)))
+	{
+		Entry.Snapshots.RemoveAt(0, FMath::Max(0, Entry.Snapshots.Num() - MaxSnapshots));
+		bWritten = RewriteFile(FilePath, Entry.Snapshots);
+	}
+	else
+	{
+		bWritten = AppendToFile(FilePath, Previous.Get(), *Snapshot);
+	}
+	if (!bWritten)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write catalog history %s"), *FilePath);
+	}
+
+	return Snapshot;
+}
+
+bool FStoreCatalogHistory::AppendToFile(const FString& FilePath, const FStoreCatalogSnapshot* Previous, const FStoreCatalogSnapshot& Snapshot)
+{
+	using namespace StoreCatalogHistoryPrivate;
+
+	TArray<uint8> Bytes;
+	if (!Previous)
+	{
+		FMemoryWriter Header(Bytes);
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = Version;
+		Header << FileMagic << FileVersion;
+	}
+	WriteSnapshot(Bytes, Previous, Snapshot);
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath, Previous ? FILEWRITE_Append : FILEWRITE_None));
+	if (!Writer)
+	{
+		return false;
+	}
+	Writer->Serialize(Bytes.GetData(), Bytes.Num());
+	return Writer->Close();
+}
+
+bool FStoreCatalogHistory::RewriteFile(const FString& FilePath, const TArray<TSharedRef<const FStoreCatalogSnapshot>>& Snapshots)
+{
+	using namespace StoreCatalogHistoryPrivate;
+
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Header(Bytes);
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = Version;
+		Header << FileMagic << FileVersion;
+	}
+	for (int32 Index = 0; Index < Snapshots.Num(); ++Index)
+	{
+		WriteSnapshot(Bytes, Index > 0 ? &Snapshots[Index - 1].Get() : nullptr, *Snapshots[Index]);
+	}
+
+	// Write next to the old file and swap, so a crash never loses the history.
+	const FString TempPath = FilePath + TEXT(".tmp");
+	return FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+}
+
+void FStoreCatalogHistory::Load(const FString& FilePath, TArray<TSharedRef<const FStoreCatalogSnapshot>>& OutSnapshots)
+{
+	using namespace StoreCatalogHistoryPrivate;
+
+	OutSnapshots.Reset();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent) || Bytes.Num() < 8)
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (FileMagic != Magic || FileVersion != Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring catalog history %s from another version"), *FilePath);
+		return;
+	}
+
+	while (Reader.Tell() + static_cast<int64>(sizeof(uint32)) <= Reader.TotalSize())
+	{
+		uint32 Size = 0;
+		Reader << Size;
+		if (Size == 0 || Reader.Tell() + Size > Reader.TotalSize())
+		{
+			break;
+		}
+		const int64 End = Reader.Tell() + Size;
+
+		TSharedRef<FStoreCatalogSnapshot> Snapshot = MakeShared<FStoreCatalogSnapshot>();
+		if (!ReadSnapshot(Reader, End, OutSnapshots.Num() > 0 ? &OutSnapshots.Last().Get() : nullptr, *Snapshot))
+		{
+			break;
+		}
+		OutSnapshots.Add(Snapshot);
+		Reader.Seek(End);
+	}
+
+	// A snapshot cut short by a crash would hide everything appended after it.
+	if (Reader.Tell() != Reader.TotalSize())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Catalog history %s ends in a partial snapshot, keeping the %d before it"), *FilePath, OutSnapshots.Num());
+		if (OutSnapshots.Num() > 0)
+		{
+			RewriteFile(FilePath, OutSnapshots);
+		}
+		else
+		{
+			IFileManager::Get().Delete(*FilePath, false, false, true);
+		}
+	}
+}
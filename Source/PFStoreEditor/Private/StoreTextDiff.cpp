@@ -0,0 +1,486 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#include "StoreTextDiff.h"
+
+#include "Algo/Reverse.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Hash/CityHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace StoreTextDiffPrivate
+{
+	/** Longer values, or any with a line break, get the line diff view. */
+	static constexpr int32 LongTextLen = 80;
+
+	/** Word diffs inside a replaced line; past this the whole line is marked. */
+	static constexpr int32 MaxWordCost = 256;
+
+	struct FToken
+	{
+		int32 Start = 0;
+		int32 Len = 0;
+	};
+
+	static uint64 HashChars(const TCHAR* Chars, int32 Len)
+	{
+		return CityHash64(reinterpret_cast<const char*>(Chars), Len * sizeof(TCHAR));
+	}
+
+	/** Myers' forward search, keeping each step's frontier so the path can be walked back. */
+	static bool ShortestEditScript(TConstArrayView<uint64> A, TConstArrayView<uint64> B, int32 MaxCost, TArray<EStoreDiffOp>& OutOps)
+	{
+		const int32 N = A.Num();
+		const int32 M = B.Num();
+		const int32 MaxD = FMath::Min(N + M, MaxCost);
+		const int32 Offset = MaxD + 1;
+
+		TArray<int32> V;
+		V.SetNumZeroed(2 * MaxD + 3);
+
+		// Trace[D] is V[-D-1 .. D+1] as it was before step D.
+		TArray<TArray<int32>> Trace;
+
+		for (int32 D = 0; D <= MaxD; ++D)
+		{
+			Trace.Emplace(&V[Offset - D - 1], 2 * D + 3);
+
+			for (int32 K = -D; K <= D; K += 2)
+			{
+				int32 X = (K == -D || (K != D && V[Offset + K - 1] < V[Offset + K + 1]))
+					? V[Offset + K + 1]
+					: V[Offset + K - 1] + 1;
+				int32 Y = X - K;
+				while (X < N && Y < M && A[X] == B[Y])
+				{
+					++X;
+					++Y;
+				}
+				V[Offset + K] = X;
+
+				if (X < N || Y < M)
+				{
+					continue;
+				}
+
+				OutOps.Reset();
+				OutOps.Reserve(N + M);
+				X = N;
+				Y = M;
+				for (int32 Step = D; Step > 0; --Step)
+				{
+					const TArray<int32>& Prev = Trace[Step];
+					const int32 Base = Step + 1;
+					const int32 StepK = X - Y;
+					const bool bDown = StepK == -Step || (StepK != Step && Prev[Base + StepK - 1] < Prev[Base + StepK + 1]);
+					const int32 PrevK = bDown ? StepK + 1 : StepK - 1;
+					const int32 PrevX = Prev[Base + PrevK];
+					const int32 PrevY = PrevX - PrevK;
+
+					while (X > PrevX + (bDown ? 0 : 1) && Y > PrevY + (bDown ? 1 : 0))
+					{
+						OutOps.Add(EStoreDiffOp::Equal);
+						--X;
+						--Y;
+					}
+					OutOps.Add(bDown ? EStoreDiffOp::Insert : EStoreDiffOp::Delete);
+					X = PrevX;
+					Y = PrevY;
+				}
+				while (X > 0 && Y > 0)
+				{
+					OutOps.Add(EStoreDiffOp::Equal);
+					--X;
+					--Y;
+				}
+				Algo::Reverse(OutOps);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void AddRun(TArray<FStoreDiffRun>& Runs, EStoreDiffOp Op, int32 LeftStart, int32 RightStart, int32 Len)
+	{
+		if (Len <= 0)
+		{
+			return;
+		}
+		if (Runs.Num() > 0 && Runs.Last().Op == Op)
+		{
+			Runs.Last().Len += Len;
+			return;
+		}
+		Runs.Add({ Op, LeftStart, RightStart, Len });
+	}
+
+	static void SplitLines(const FString& Text, TArray<FStringView>& OutLines, TArray<uint64>& OutHashes)
+	{
+		const TCHAR* Chars = *Text;
+		const int32 Len = Text.Len();
+		int32 LineStart = 0;
+		for (int32 i = 0; i <= Len; ++i)
+		{
+			if (i < Len && Chars[i] != TEXT('\n'))
+			{
+				continue;
+			}
+			int32 LineEnd = i;
+			if (LineEnd > LineStart && Chars[LineEnd - 1] == TEXT('\r'))
+			{
+				--LineEnd;
+			}
+			OutLines.Add(FStringView(Chars + LineStart, LineEnd - LineStart));
+			OutHashes.Add(HashChars(Chars + LineStart, LineEnd - LineStart));
+			LineStart = i + 1;
+		}
+	}
+
+	/** Identifier-like runs, whitespace runs and single punctuation characters. */
+	static void SplitWords(FStringView Line, TArray<FToken>& OutTokens, TArray<uint64>& OutHashes)
+	{
+		int32 i = 0;
+		while (i < Line.Len())
+		{
+			const int32 Start = i;
+			const TCHAR C = Line[i];
+			if (FChar::IsAlnum(C) || C == TEXT('_'))
+			{
+				while (i < Line.Len() && (FChar::IsAlnum(Line[i]) || Line[i] == TEXT('_')))
+				{
+					++i;
+				}
+			}
+			else if (FChar::IsWhitespace(C))
+			{
+				while (i < Line.Len() && FChar::IsWhitespace(Line[i]))
+				{
+					++i;
+				}
+			}
+			else
+			{
+				++i;
+			}
+			OutTokens.Add({ Start, i - Start });
+			OutHashes.Add(HashChars(Line.GetData() + Start, i - Start));
+		}
+	}
+
+	static void DiffWords(FStringView LeftLine, FStringView RightLine, FStoreTextDiffLine& OutLeft, FStoreTextDiffLine& OutRight)
+	{
+		TArray<FToken> LeftTokens, RightTokens;
+		TArray<uint64> LeftHashes, RightHashes;
+		SplitWords(LeftLine, LeftTokens, LeftHashes);
+		SplitWords(RightLine, RightTokens, RightHashes);
+
+		TArray<FStoreDiffRun> Runs;
+		StoreTextDiff::DiffTokens(LeftHashes, RightHashes, Runs, MaxWordCost);
+
+		for (const FStoreDiffRun& Run : Runs)
+		{
+			if (Run.Op == EStoreDiffOp::Delete)
+			{
+				const int32 Start = LeftTokens[Run.LeftStart].Start;
+				const FToken& Last = LeftTokens[Run.LeftStart + Run.Len - 1];
+				OutLeft.ChangedRanges.Emplace(Start, Last.Start + Last.Len - Start);
+			}
+			else if (Run.Op == EStoreDiffOp::Insert)
+			{
+				const int32 Start = RightTokens[Run.RightStart].Start;
+				const FToken& Last = RightTokens[Run.RightStart + Run.Len - 1];
+				OutRight.ChangedRanges.Emplace(Start, Last.Start + Last.Len - Start);
+			}
+		}
+	}
+
+	static void AppendJsonString(const FString& Value, FString& Out)
+	{
+		Out += TEXT('"');
+		Out += Value.ReplaceCharWithEscapedChar();
+		Out += TEXT('"');
+	}
+
+	/** Sorted keys, two-space indent, one scalar per line: equal documents print identically. */
+	static void WriteCanonicalJson(const FJsonValue& Value, int32 Depth, FString& Out)
+	{
+		const FString Indent = FString::ChrN((Depth + 1) * 2, TEXT(' '));
+		switch (Value.Type)
+		{
+		case EJson::Object:
+		{
+			const TSharedPtr<FJsonObject> Object = Value.AsObject();
+			TArray<FString> Keys;
+			Object->Values.GetKeys(Keys);
+			Keys.Sort();
+			if (Keys.Num() == 0)
+			{
+				Out += TEXT("{}");
+				break;
+			}
+			Out += TEXT("{\n");
+			for (int32 i = 0; i < Keys.Num(); ++i)
+			{
+				Out += Indent;
+				AppendJsonString(Keys[i], Out);
+				Out += TEXT(": ");
+				WriteCanonicalJson(*Object->Values[Keys[i]], Depth + 1, Out);
+				Out += i + 1 < Keys.Num() ? TEXT(",\n") : TEXT("\n");
+			}
+			Out += FString::ChrN(Depth * 2, TEXT(' '));
+			Out += TEXT('}');
+			break;
+		}
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value.AsArray();
+			if (Items.Num() == 0)
+			{
+				Out += TEXT("[]");
+				break;
+			}
+			Out += TEXT("[\n");
+			for (int32 i = 0; i < Items.Num(); ++i)
+			{
+				Out += Indent;
+				WriteCanonicalJson(*Items[i], Depth + 1, Out);
+				Out += i + 1 < Items.Num() ? TEXT(",\n") : TEXT("\n");
+			}
+			Out += FString::ChrN(Depth * 2, TEXT(' '));
+			Out += TEXT(']');
+			break;
+		}
+		case EJson::String:
+			AppendJsonString(Value.AsString(), Out);
+			break;
+		case EJson::Number:
+		{
+			const double Number = Value.AsNumber();
+			if (FMath::Abs(Number) < 9007199254740992.0 && Number == FMath::RoundToDouble(Number))
+			{
+				Out += FString::Printf(TEXT("%lld"), static_cast<int64>(Number));
+			}
+			else
+			{
+				Out += FString::SanitizeFloat(Number);
+			}
+			break;
+		}
+		case EJson::Boolean:
+			Out += Value.AsBool() ? TEXT("true") : TEXT("false");
+			break;
+		default:
+			Out += TEXT("null");
+			break;
+		}
+	}
+
+	static bool TryCanonicalJson(const FString& Text, FString& Out)
+	{
+		int32 First = 0;
+		while (First < Text.Len() && FChar::IsWhitespace(Text[First]))
+		{
+			++First;
+		}
+		if (First == Text.Len() || (Text[First] != TEXT('{') && Text[First] != TEXT('[')))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonValue> Value;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		if (!FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+		{
+			return false;
+		}
+		WriteCanonicalJson(*Value, 0, Out);
+		return true;
+	}
+}
+
+// ---------- StoreTextDiff ----------
+
+void StoreTextDiff::DiffTokens(TConstArrayView<uint64> Left, TConstArrayView<uint64> Right, TArray<FStoreDiffRun>& OutRuns, int32 MaxCost)
+{
+	using namespace StoreTextDiffPrivate;
+
+	OutRuns.Reset();
+
+	const int32 N = Left.Num();
+	const int32 M = Right.Num();
+
+	// Common ends cost nothing to find and keep the O(ND) part to the region that changed.
+	int32 Prefix = 0;
+	while (Prefix < N && Prefix < M && Left[Prefix] == Right[Prefix])
+	{
+		++Prefix;
+	}
+	int32 Suffix = 0;
+	while (Suffix < N - Prefix && Suffix < M - Prefix && Left[N - 1 - Suffix] == Right[M - 1 - Suffix])
+	{
+		++Suffix;
+	}
+
+	AddRun(OutRuns, EStoreDiffOp::Equal, 0, 0, Prefix);
+
+	const TConstArrayView<uint64> A = Left.Slice(Prefix, N - Prefix - Suffix);
+	const TConstArrayView<uint64> B = Right.Slice(Prefix, M - Prefix - Suffix);
+
+	TArray<EStoreDiffOp> Ops;
+	if (A.Num() > 0 && B.Num() > 0 && ShortestEditScript(A, B, MaxCost, Ops))
+	{
+		int32 X = Prefix;
+		int32 Y = Prefix;
+		for (const EStoreDiffOp Op : Ops)
+		{
+			AddRun(OutRuns, Op, X, Y, 1);
+			X += Op != EStoreDiffOp::Insert ? 1 : 0;
+			Y += Op != EStoreDiffOp::Delete ? 1 : 0;
+		}
+	}
+	else
+	{
+		AddRun(OutRuns, EStoreDiffOp::Delete, Prefix, Prefix, A.Num());
+		AddRun(OutRuns, EStoreDiffOp::Insert, Prefix + A.Num(), Prefix, B.Num());
+	}
+
+	AddRun(OutRuns, EStoreDiffOp::Equal, N - Suffix, M - Suffix, Suffix);
+}
+
+TSharedRef<const FStoreTextDiff> StoreTextDiff::DiffText(const FString& Left, const FString& Right, bool bTryJson)
+{
+	using namespace StoreTextDiffPrivate;
+
+	TSharedRef<FStoreTextDiff> Diff = MakeShared<FStoreTextDiff>();
+
+	FString LeftJson, RightJson;
+	Diff->bStructuralJson = bTryJson && TryCanonicalJson(Left, LeftJson) && TryCanonicalJson(Right, RightJson);
+	const FString& LeftText = Diff->bStructuralJson ? LeftJson : Left;
+	const FString& RightText = Diff->bStructuralJson ? RightJson : Right;
+
+	TArray<FStringView> LeftLines, RightLines;
+	TArray<uint64> LeftHashes, RightHashes;
+	SplitLines(LeftText, LeftLines, LeftHashes);
+	SplitLines(RightText, RightLines, RightHashes);
+
+	TArray<FStoreDiffRun> Runs;
+	DiffTokens(LeftHashes, RightHashes, Runs);
+
+	auto AddLine = [&Diff](EStoreDiffOp Op, FStringView Text) -> FStoreTextDiffLine&
+	{
+		TSharedPtr<FStoreTextDiffLine> Line = MakeShared<FStoreTextDiffLine>();
+		Line->Op = Op;
+		Line->Text = FString(Text);
+		Diff->Lines.Add(Line);
+		return *Line;
+	};
+
+	for (int32 RunIndex = 0; RunIndex < Runs.Num(); ++RunIndex)
+	{
+		const FStoreDiffRun& Run = Runs[RunIndex];
+		if (Run.Op == EStoreDiffOp::Equal)
+		{
+			for (int32 i = 0; i < Run.Len; ++i)
+			{
+				AddLine(EStoreDiffOp::Equal, LeftLines[Run.LeftStart + i]);
+			}
+			continue;
+		}
+
+		// A delete next to an insert is a replaced block: deleted lines first, each paired with the
+		// inserted line at the same position for the word diff.
+		const FStoreDiffRun* Deleted = Run.Op == EStoreDiffOp::Delete ? &Run : nullptr;
+		const FStoreDiffRun* Inserted = Run.Op == EStoreDiffOp::Insert ? &Run : nullptr;
+		if (RunIndex + 1 < Runs.Num() && Runs[RunIndex + 1].Op != EStoreDiffOp::Equal)
+		{
+			const FStoreDiffRun& Next = Runs[++RunIndex];
+			if (Next.Op == EStoreDiffOp::Delete)
+			{
+				Deleted = &Next;
+			}
+			else
+			{
+				Inserted = &Next;
+			}
+		}
+
+		const int32 NumDeleted = Deleted ? Deleted->Len : 0;
+		const int32 NumInserted = Inserted ? Inserted->Len : 0;
+		const int32 FirstDeleted = Diff->Lines.Num();
+		for (int32 i = 0; i < NumDeleted; ++i)
+		{
+			AddLine(EStoreDiffOp::Delete, LeftLines[Deleted->LeftStart + i]);
+		}
+		const int32 FirstInserted = Diff->Lines.Num();
+		for (int32 i = 0; i < NumInserted; ++i)
+		{
+			AddLine(EStoreDiffOp::Insert, RightLines[Inserted->RightStart + i]);
+		}
+		for (int32 i = 0; i < FMath::Min(NumDeleted, NumInserted); ++i)
+		{
+			DiffWords(LeftLines[Deleted->LeftStart + i], RightLines[Inserted->RightStart + i],
+				*Diff->Lines[FirstDeleted + i], *Diff->Lines[FirstInserted + i]);
+		}
+		Diff->NumDeleted += NumDeleted;
+		Diff->NumInserted += NumInserted;
+	}
+
+	return Diff;
+}
+
+bool StoreTextDiff::IsLongText(const FString& Value)
+{
+	int32 Index;
+	return Value.Len() > StoreTextDiffPrivate::LongTextLen || Value.FindChar(TEXT('\n'), Index);
+}
+
+// ---------- FStoreTextDiffCache ----------
+
+FStoreTextDiffCache& FStoreTextDiffCache::Get()
+{
+	static FStoreTextDiffCache Instance;
+	return Instance;
+}
+
+void FStoreTextDiffCache::Request(const FString& Left, const FString& Right, bool bTryJson, FOnDiffReady OnReady)
+{
+	using namespace StoreTextDiffPrivate;
+
+	check(IsInGameThread());
+
+	const FKey Key(HashChars(*Left, Left.Len()), HashChars(*Right, Right.Len()), bTryJson);
+	if (const TSharedPtr<const FStoreTextDiff>* Found = Results.Find(Key))
+	{
+		OnReady(Found->ToSharedRef());
+		return;
+	}
+	if (TArray<FOnDiffReady>* Waiters = Pending.Find(Key))
+	{
+		Waiters->Add(MoveTemp(OnReady));
+		return;
+	}
+	Pending.Add(Key).Add(MoveTemp(OnReady));
+
+	Async(EAsyncExecution::ThreadPool, [this, Key, Left, Right, bTryJson]()
+	{
+		TSharedRef<const FStoreTextDiff> Diff = StoreTextDiff::DiffText(Left, Right, bTryJson);
+
+		AsyncTask(ENamedThreads::GameThread, [this, Key, Diff]()
+		{
+			if (Results.Num() >= MaxEntries)
+			{
+				Results.Reset();
+			}
+			Results.Add(Key, Diff);
+
+			TArray<FOnDiffReady> Waiters;
+			Pending.RemoveAndCopyValue(Key, Waiters);
+			for (FOnDiffReady& Waiter : Waiters)
+			{
+				Waiter(Diff);
+			}
+		});
+	});
+}
@@ -0,0 +1,22 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IPropertyTypeCustomization.h"
+
+/** Shows FCurrencyAmounts as one "GD:100;CR:5" text box instead of an opaque struct. */
+class FCurrencyAmountsCustomization : public IPropertyTypeCustomization
+{
+public:
+	static TSharedRef<IPropertyTypeCustomization> MakeInstance();
+
+	virtual void CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
+	virtual void CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils) override {}
+
+private:
+	FText GetText() const;
+	void OnTextCommitted(const FText& NewText, ETextCommit::Type CommitType);
+
+	TSharedPtr<IPropertyHandle> Handle;
+};
@@ -8,6 +8,8 @@
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "DiffChoice.h"
 
+class SStoreTextDiffView;
+
 class SItemDiffWindow : public SCompoundWidget
 {
 public:
@@ -15,6 +17,8 @@ public:
         SLATE_ARGUMENT(TSharedPtr<FJsonObject>, LeftItem)
         SLATE_ARGUMENT(TSharedPtr<FJsonObject>, RightItem)
         SLATE_ARGUMENT(TFunction<void(TSharedPtr<FJsonObject>)>, OnResult)
+        /** Called on OK with the per-field choices, for callers that apply them to records themselves. */
+        SLATE_ARGUMENT(TFunction<void(const TArray<FFieldDiffRowPtr>&)>, OnChoices)
     SLATE_END_ARGS()
 
         void Construct(const FArguments& InArgs);
@@ -23,15 +27,21 @@ private:
     TArray<FFieldDiffRowPtr> Rows;
     TSharedPtr<SListView<FFieldDiffRowPtr>> ListView;
     TSharedPtr<SListView<FFieldDiffRowPtr>> ResultListView;
+    TSharedPtr<SStoreTextDiffView> TextDiffView;
+
+    /** Field whose line diff is shown, None when the diff view is closed. */
+    FName TextDiffField;
 
     TSharedPtr<FJsonObject> Left;
     TSharedPtr<FJsonObject> Right;
     TFunction<void(TSharedPtr<FJsonObject>)> OnResult;
+    TFunction<void(const TArray<FFieldDiffRowPtr>&)> OnChoices;
 
 
     TSharedRef<ITableRow> OnGenerateRow(FFieldDiffRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
     TSharedRef<ITableRow> OnGenerateResultRow(FFieldDiffRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
 
+    FReply OnTextDiffClicked(FFieldDiffRowPtr Item);
     FReply OnUseAllLeftClicked();
     FReply OnUseAllRightClicked();
     FReply OnOkClicked();
@@ -0,0 +1,128 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/** Where admin requests go. Empty fields fall back to the title and secret of the PlayFab plugin settings. */
+struct FPFAdminEndpoint
+{
+	FString TitleId;
+	FString SecretKey;
+};
+
+/**
+ * Runs a set of PlayFab admin calls that depend on each other, e.g. a whole economy publish.
+ * A task is sent once every task it depends on has succeeded; independent tasks are in flight
+ * together up to MaxConcurrent, and a token bucket keeps the request rate under PlayFab's limit.
+ * Bodies are serialized on worker threads ahead of time, so the next request is usually ready
+ * by the time a slot frees up. If a task fails, everything that depends on it is skipped.
+ */
+class PFSTOREEDITOR_API FPFAdminScheduler : public TSharedFromThis<FPFAdminScheduler>
+{
+public:
+	using FTaskId = int32;
+	using FSerializeBody = TFunction<void(TArray<uint8>& OutBody)>;
+	using FOnTaskComplete = TFunction<void(bool bSuccess, const FString& Error)>;
+	using FOnFinished = TFunction<void(bool bSuccess, const TArray<FString>& Errors)>;
+
+	struct FOptions
+	{
+		int32 MaxConcurrent = 4;
+		float RequestsPerSecond = 5.f;
+
+		/** Requests that may go out back to back before the rate applies. */
+		int32 Burst = 4;
+
+		/** Retries of a task PlayFab answered with 429 Too Many Requests. */
+		int32 MaxThrottleRetries = 3;
+
+		/** The title the tasks go to. Limits apply per scheduler, so per title. */
+		FPFAdminEndpoint Endpoint;
+
+		/** NAME_Gzip or NAME_Zlib to compress bodies right after they are serialized, on the same worker. */
+		FName Compression = NAME_None;
+	};
+
+	/** Options from the editor settings. */
+	static FOptions GetDefaultOptions();
+
+	explicit FPFAdminScheduler(const FOptions& InOptions = GetDefaultOptions());
+	~FPFAdminScheduler();
+
+	/**
+	 * Adds a POST to /Admin/<Api>. Serialize runs on a worker thread and must only read data that
+	 * stays unchanged until the scheduler finishes. OnComplete runs on the game thread.
+	 */
+	FTaskId Add(const FString& Api, FSerializeBody Serialize, TArray<FTaskId> DependsOn = TArray<FTaskId>(), FOnTaskComplete OnComplete = nullptr);
+
+	/**
+	 * Starts the tasks; the scheduler keeps itself alive until OnFinished has run on the game thread.
+	 * The scheduler must be owned by a shared pointer.
+	 */
+	void Run(FOnFinished OnFinished);
+
+	int32 Num() const { return Tasks.Num(); }
+	int32 NumFinished() const { return NumDone; }
+
+private:
+	enum class ETaskState : uint8
+	{
+		Waiting,
+		Serializing,
+		Ready,
+		InFlight,
+		Succeeded,
+		Failed,
+		Skipped,
+	};
+
+	struct FTask
+	{
+		FString Api;
+		FSerializeBody Serialize;
+		TArray<FTaskId> DependsOn;
+		TArray<FTaskId> Dependents;
+		FOnTaskComplete OnComplete;
+
+		ETaskState State = ETaskState::Waiting;
+		TArray<uint8> Body;
+		const TCHAR* ContentEncoding = nullptr;
+		int32 ThrottleRetries = 0;
+	};
+
+	/** Starts serializations and sends whatever may go now. Game thread only. */
+	void Pump();
+	void PumpOnce();
+	void StartSerialize(FTaskId Id);
+	void OnSerialized(FTaskId Id, TArray<uint8>&& Body, const TCHAR* ContentEncoding);
+	void Send(FTaskId Id);
+	void OnResponse(FTaskId Id, bool bSuccess, const FString& Error, int32 ResponseCode, float RetryAfter);
+	void Finish(FTaskId Id, bool bSuccess, const FString& Error);
+	void Skip(FTaskId Id);
+
+	bool IsRunnable(const FTask& Task) const;
+	bool TakeToken();
+	void PumpLater(float Delay);
+
+	FOptions Options;
+	TArray<FTask> Tasks;
+	FOnFinished OnFinished;
+	TArray<FString> Errors;
+
+	int32 NumInFlight = 0;
+	int32 NumSerializing = 0;
+	int32 NumReady = 0;
+	int32 NumDone = 0;
+	bool bRunning = false;
+	bool bPumping = false;
+	bool bPumpAgain = false;
+
+	double Tokens = 0.0;
+	double LastRefill = 0.0;
+	FTSTicker::FDelegateHandle RetryHandle;
+
+	/** Holds the scheduler alive from Run until OnFinished. */
+	TSharedPtr<FPFAdminScheduler> SelfWhileRunning;
+};
@@ -4,24 +4,208 @@
 
 #include "CoreMinimal.h"
 #include "StoreItemProvider.h"
+#include "StoreItemRecord.h"
+#include "PFUploadJournal.h"
 
 #include "PlayFabAdminDataModels.h"
 
+struct FDropTableInfo;
+class FPFAdminScheduler;
+struct FPFAdminEndpoint;
+class FStoreJsonWriter;
+class IHttpResponse;
+class UPackage;
+
+/** One item present on both sides of a diff whose fields differ. */
+struct FStoreItemChange
+{
+	FString ItemId;
+	TArray<FName> Fields;
+};
+
+/** Item level differences between a local and a remote (or second local) catalog, sorted by ItemId. */
+struct FStoreCatalogDiff
+{
+	TArray<FString> Added;
+	TArray<FString> Removed;
+	TArray<FStoreItemChange> Changed;
+
+	bool IsEmpty() const { return Added.Num() == 0 && Removed.Num() == 0 && Changed.Num() == 0; }
+};
+
+enum class EStoreMergeConflict : uint8
+{
+	/** Both sides changed the listed fields to different values. */
+	Fields,
+	/** Removed from the editor, edited on PlayFab. */
+	DeletedInEditor,
+	/** Removed from PlayFab, edited in the editor. */
+	DeletedInPlayFab,
+	/** Without a base: in the editor only, either new there or deleted on PlayFab. */
+	OnlyInEditor,
+	/** Without a base: on PlayFab only, either new there or deleted in the editor. */
+	OnlyInPlayFab,
+};
+
+/** What a three-way merge could not decide on its own. */
+struct FStoreItemConflict
+{
+	FString ItemId;
+	EStoreMergeConflict Kind = EStoreMergeConflict::Fields;
+	TArray<FName> Fields;
+
+	/** Into the local and remote inputs of the merge (INDEX_NONE when missing there) and into Merged. */
+	int32 LocalIndex = INDEX_NONE;
+	int32 RemoteIndex = INDEX_NONE;
+	int32 MergedIndex = INDEX_NONE;
+};
+
+/**
+ * Result of merging local and remote against the last synced base. Merged holds every surviving
+ * item with all one-sided changes applied; conflicting fields keep the local value until resolved.
+ */
+struct FStoreMergeResult
+{
+	TArray<FStoreItemRecord> Merged;
+	TArray<FStoreItemConflict> Conflicts;
+
+	/** Field (or whole item) changes taken over automatically, per side. */
+	int32 FieldsFromLocal = 0;
+	int32 FieldsFromRemote = 0;
+};
+
+/** Outcome of writing records back into provider assets. */
+struct FStoreApplyResult
+{
+	int32 Changed = 0;
+	int32 Unchanged = 0;
+
+	/** Ids with no asset to write to; creating assets is left to the user. */
+	TArray<FString> Missing;
+
+	/** Ids whose provider does not implement the write-back. */
+	TArray<FString> ReadOnly;
+
+	/** Ids whose asset took only some fields, the others having nowhere to go; counted in Changed. */
+	TArray<FString> Incomplete;
+
+	int32 PackagesSaved = 0;
+	bool bCancelled = false;
+};
+
 namespace PFHelpers
 {
 	PFSTOREEDITOR_API PlayFab::AdminModels::FCatalogItemConsumableInfo
 		ToPlayFabConsumableInfo(const FConsumableInfo& In);
 
+	PFSTOREEDITOR_API PlayFab::AdminModels::FCatalogItem
+		ToPlayFabCatalogItem(const FStoreItemRecord& In, const FString& CatalogVersion);
+
+	PFSTOREEDITOR_API void FromPlayFabCatalogItem(
+		const PlayFab::AdminModels::FCatalogItem& In,
+		FStoreItemRecord& Out);
+
+	PFSTOREEDITOR_API PlayFab::AdminModels::FRandomResultTable
+		ToPlayFabRandomResultTable(const FDropTableInfo& In);
+
+	/**
+	 * Every asset whose class derives from a native class implementing InterfaceClass; only those
+	 * assets are loaded, not the whole project. The interfaces are Blueprintable, but a Blueprint
+	 * that adds one itself has none of the C++ getters behind it and is not returned.
+	 */
+	PFSTOREEDITOR_API TArray<TWeakObjectPtr<UObject>> FindAllStoreAssets(const UClass* InterfaceClass);
+
+	/** Reads the provider interfaces of Items once; everything downstream works on the records. */
+	PFSTOREEDITOR_API void SnapshotItems(
+		const TArray<TWeakObjectPtr<UObject>>& Items,
+		TArray<FStoreItemRecord>& OutRecords);
+
+	/** Reads the drop table provider interfaces once, like SnapshotItems. */
+	PFSTOREEDITOR_API void SnapshotDropTables(
+		const TArray<TWeakObjectPtr<UObject>>& Tables,
+		TArray<FDropTableInfo>& OutTables);
+
 	PFSTOREEDITOR_API bool ExportToCsv(
 		const TArray<TWeakObjectPtr<UObject>>& Items,
 		const FString& FilePath);
 
+	/** Formats the rows on all cores, then writes the file once. */
+	PFSTOREEDITOR_API bool ExportRecordsToCsv(
+		const TArray<FStoreItemRecord>& Records,
+		const FString& FilePath);
+
 	PFSTOREEDITOR_API void ParseCsvLine(
 		const FString& Line,
 		TArray<FString>& OutFields);
 
 	PFSTOREEDITOR_API FString Unescape(const FString& In);
 
+	/**
+	 * Reads what ExportRecordsToCsv writes. Columns are matched to the header by name, so files
+	 * with reordered, missing or extra columns import as well; missing columns stay empty. Files
+	 * without the IsBundle / IsContainer columns make a bundle or container of any row with a
+	 * bundle or container cell set.
+	 */
+	PFSTOREEDITOR_API bool ImportRecordsFromCsv(
+		const FString& FilePath,
+		TArray<FStoreItemRecord>& OutRecords);
+
+	/** Drop tables of an items CSV are written next to it: StoreCatalog.csv -> StoreCatalog_DropTables.csv. */
+	PFSTOREEDITOR_API FString GetDropTablesCsvPath(const FString& ItemsCsvPath);
+
+	/**
+	 * One row per node (TableId, ResultItemType, ResultItem, Weight); a table without nodes gets a
+	 * row with only its id. Rows are streamed to the file in chunks, never held as one string.
+	 */
+	PFSTOREEDITOR_API bool ExportDropTablesToCsv(
+		const TArray<FDropTableInfo>& Tables,
+		const FString& FilePath);
+
+	/**
+	 * Reads what ExportDropTablesToCsv writes. Rows are parsed on all cores and grouped by TableId
+	 * in file order, so the rows of a table need not be adjacent.
+	 */
+	PFSTOREEDITOR_API bool ImportDropTablesFromCsv(
+		const FString& FilePath,
+		TArray<FDropTableInfo>& OutTables);
+
+	/** Writes one item in PlayFab's CatalogItem layout. */
+	PFSTOREEDITOR_API void WriteCatalogItemJson(
+		FStoreJsonWriter& Writer,
+		const FStoreItemRecord& Record,
+		const FString& CatalogVersion);
+
+	/** Writes one drop table in PlayFab's RandomResultTable layout. */
+	PFSTOREEDITOR_API void WriteDropTableJson(
+		FStoreJsonWriter& Writer,
+		const FDropTableInfo& Table);
+
+	/**
+	 * Writes the catalog in PlayFab's own format: { "CatalogVersion", "Catalog": [CatalogItem...],
+	 * "Tables": [RandomResultTable...] }. Unlike the CSV it keeps every field of the records.
+	 * Items are formatted on all cores a batch at a time and streamed to the file.
+	 */
+	PFSTOREEDITOR_API bool ExportRecordsToJson(
+		const TArray<FStoreItemRecord>& Records,
+		const TArray<FDropTableInfo>& DropTables,
+		const FString& CatalogVersion,
+		const FString& FilePath);
+
+	/** Reads what ExportRecordsToJson writes (or a Game Manager export) with a pull parser, no DOM. */
+	PFSTOREEDITOR_API bool ImportRecordsFromJson(
+		const FString& FilePath,
+		TArray<FStoreItemRecord>& OutRecords,
+		TArray<FDropTableInfo>& OutDropTables);
+
+	/**
+	 * ImportRecordsFromJson for .json files, ImportRecordsFromCsv otherwise. A CSV takes its drop
+	 * tables from the GetDropTablesCsvPath file when there is one and leaves OutDropTables alone if not.
+	 */
+	PFSTOREEDITOR_API bool ImportRecordsFromFile(
+		const FString& FilePath,
+		TArray<FStoreItemRecord>& OutRecords,
+		TArray<FDropTableInfo>* OutDropTables = nullptr);
+
 	PFSTOREEDITOR_API bool ImportItemsFromCsv(
 		const FString& FilePath,
 		TArray<PlayFab::AdminModels::FCatalogItem>& OutItems);
@@ -29,4 +213,236 @@ namespace PFHelpers
 	PFSTOREEDITOR_API bool ImportDropTablesFromCsv(
 		const FString& FilePath,
 		TArray<PlayFab::AdminModels::FRandomResultTable>& OutItems);
-}
\ No newline at end of file
+
+	/**
+	 * Checks the things PlayFab would reject or silently get wrong: missing and duplicate ids,
+	 * negative amounts, bundles and containers pointing at items that are not in the catalog.
+	 * Returns the number of errors.
+	 */
+	PFSTOREEDITOR_API int32 ValidateRecords(
+		const TArray<FStoreItemRecord>& Records,
+		TArray<FString>& OutErrors,
+		TArray<FString>& OutWarnings);
+
+	PFSTOREEDITOR_API void DiffRecords(
+		const TArray<FStoreItemRecord>& Local,
+		const TArray<FStoreItemRecord>& Remote,
+		FStoreCatalogDiff& OutDiff);
+
+	/** Appends the names of the fields A and B disagree on, in the order of the field table. */
+	PFSTOREEDITOR_API void DiffFields(const FStoreItemRecord& A, const FStoreItemRecord& B, TArray<FName>& OutFields);
+
+	/**
+	 * Three-way merge of local and remote items against Base, the catalog both sides last agreed
+	 * on. A field changed on one side only takes that side; only fields both sides changed to
+	 * different values become conflicts. A null Base means the sides never synced: then every
+	 * field that differs is a conflict, and so is every item on one side only (OnlyInEditor /
+	 * OnlyInPlayFab), since a new item cannot be told from a deleted one. An empty Base is a sync
+	 * of an empty catalog, against which every item is new.
+	 */
+	PFSTOREEDITOR_API void MergeRecords(
+		const TArray<FStoreItemRecord>* Base,
+		const TArray<FStoreItemRecord>& Local,
+		const TArray<FStoreItemRecord>& Remote,
+		FStoreMergeResult& OutResult);
+
+	/**
+	 * MergeRecords for drop tables, each table as a whole, with the same rules for a null Base.
+	 * Conflicting tables keep the local version, or the remote one when there is no local one.
+	 */
+	PFSTOREEDITOR_API void MergeDropTables(
+		const TArray<FDropTableInfo>* Base,
+		const TArray<FDropTableInfo>& Local,
+		const TArray<FDropTableInfo>& Remote,
+		TArray<FDropTableInfo>& OutMerged,
+		TArray<FString>& OutConflicts);
+
+	/** Copies the named diff fields (as in FStoreItemChange::Fields) from one record to another. */
+	PFSTOREEDITOR_API void CopyFields(
+		const FStoreItemRecord& From,
+		FStoreItemRecord& To,
+		TConstArrayView<FName> Fields);
+
+	/** One diff field of Record as display text, e.g. "GD:100;CR:5" for VirtualCurrencyPrices. */
+	PFSTOREEDITOR_API FString FormatField(
+		const FStoreItemRecord& Record,
+		FName Field);
+
+	/** The top level CatalogItem JSON member a diff field is written under, e.g. UsageCount -> Consumable. */
+	PFSTOREEDITOR_API FName GetCatalogJsonKey(FName Field);
+
+	/**
+	 * Writes records (and drop tables) into the provider assets with the same id. Only assets whose
+	 * values differ are modified, all in one undoable transaction, and each package is dirtied
+	 * once. With bSave the packages are saved in batches behind a cancellable progress dialog.
+	 * Returns false if anything was read-only or the save was cancelled. TransactionName is what
+	 * Undo shows, "Apply Merged Catalog" when empty.
+	 */
+	PFSTOREEDITOR_API bool ApplyRecordsToAssets(
+		TConstArrayView<FStoreItemRecord> Records,
+		TConstArrayView<FDropTableInfo> DropTables,
+		bool bSave,
+		FStoreApplyResult& OutResult,
+		const FText& TransactionName = FText::GetEmpty());
+
+	/** Saves Packages a batch at a time with progress and cancel. Returns the number saved. */
+	PFSTOREEDITOR_API int32 SavePackagesBatched(
+		const TArray<UPackage*>& Packages,
+		bool& bOutCancelled);
+
+	/** UpdateCatalogItems through the admin API. OnComplete runs on the game thread. */
+	PFSTOREEDITOR_API void UploadCatalogItems(
+		const TArray<PlayFab::AdminModels::FCatalogItem>& Items,
+		const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const FString& Error)> OnComplete);
+
+	/** GetCatalogItems through the admin API. OnComplete runs on the game thread. */
+	PFSTOREEDITOR_API void FetchCatalogItems(
+		const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const TArray<PlayFab::AdminModels::FCatalogItem>& Items, const FString& Error)> OnComplete);
+
+	/** The UpdateCatalogItems request body for the records, items formatted on all cores. */
+	PFSTOREEDITOR_API void WriteUpdateCatalogItemsBody(
+		TConstArrayView<FStoreItemRecord> Records,
+		const FString& CatalogVersion,
+		TArray<uint8>& OutBody);
+
+	/**
+	 * POSTs an already serialized body to /Admin/<Api> with the developer secret key. The body is
+	 * moved into the HTTP request, never copied or parsed again. OnComplete runs on the game thread.
+	 */
+	PFSTOREEDITOR_API void SendAdminRequest(
+		const TCHAR* Api,
+		TArray<uint8>&& Body,
+		TFunction<void(bool bSuccess, const FString& Error, TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> Response)> OnComplete);
+
+	/**
+	 * SendAdminRequest to another title than the one of the PlayFab plugin settings. A body that
+	 * CompressRequestBody compressed is sent with its ContentEncoding.
+	 */
+	PFSTOREEDITOR_API void SendAdminRequest(
+		const FPFAdminEndpoint& Endpoint,
+		const TCHAR* Api,
+		TArray<uint8>&& Body,
+		TFunction<void(bool bSuccess, const FString& Error, TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> Response)> OnComplete,
+		const TCHAR* ContentEncoding = nullptr);
+
+	/**
+	 * Compresses a request body in place as gzip or deflate (NAME_Gzip, NAME_Zlib). Returns the
+	 * Content-Encoding to send it with, or null when the body was left as is: too small to bother,
+	 * or not smaller once compressed. Safe to call off the game thread.
+	 */
+	PFSTOREEDITOR_API const TCHAR* CompressRequestBody(
+		FName Format,
+		TArray<uint8>& InOutBody);
+
+	/**
+	 * UpdateCatalogItems straight from records: no CSV, no FCatalogItem copies, nothing lost on the
+	 * way (prices included). OnComplete runs on the game thread.
+	 */
+	PFSTOREEDITOR_API void UploadRecords(
+		TConstArrayView<FStoreItemRecord> Records,
+		const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const FString& Error)> OnComplete);
+
+	/** The UpdateRandomResultTables request body for the drop tables. */
+	PFSTOREEDITOR_API void WriteUpdateRandomResultTablesBody(
+		TConstArrayView<FDropTableInfo> DropTables,
+		const FString& CatalogVersion,
+		TArray<uint8>& OutBody);
+
+	/** UpdateRandomResultTables straight from drop tables, like UploadRecords. OnComplete runs on the game thread. */
+	PFSTOREEDITOR_API void UploadDropTables(
+		TConstArrayView<FDropTableInfo> DropTables,
+		const FString& CatalogVersion,
+		TFunction<void(bool bSuccess, const FString& Error)> OnComplete);
+
+	/** Content hash of a record's binary form, e.g. to tell whether the version that reached PlayFab is still current. */
+	PFSTOREEDITOR_API uint64 HashRecord(const FStoreItemRecord& Record);
+
+	/** Content hash of a drop table, see HashRecord. */
+	PFSTOREEDITOR_API uint64 HashDropTable(const FDropTableInfo& Table);
+
+	/**
+	 * Drops the records and tables that already landed in an unfinished publish, by id and content
+	 * hash: anything edited since it landed stays in. Returns how many were removed.
+	 */
+	PFSTOREEDITOR_API int32 RemoveLanded(
+		const FPFUploadJournal::FLanded& Landed,
+		TArray<FStoreItemRecord>& Records,
+		TArray<FDropTableInfo>& DropTables);
+
+	/** Requests of a publish carry at most this many items. */
+	constexpr int32 PublishItemsPerRequest = 1000;
+
+	/**
+	 * Bytes WriteCatalogItemJson writes for the record, counted from its field lengths without
+	 * formatting anything. CatalogVersionSize is FStoreJsonWriter::GetStringSize of the version.
+	 */
+	PFSTOREEDITOR_API int64 EstimateCatalogItemJsonSize(
+		const FStoreItemRecord& Record,
+		int64 CatalogVersionSize);
+
+	/** Bytes of an UpdateCatalogItems body around its items. */
+	PFSTOREEDITOR_API int64 GetRequestBodyOverhead(const FString& CatalogVersion);
+
+	/**
+	 * Splits consecutive array elements of the given JSON sizes into requests that stay under
+	 * MaxBodyBytes and PublishItemsPerRequest elements, an element larger than the budget going
+	 * alone. Returns the number of elements of each request.
+	 */
+	PFSTOREEDITOR_API TArray<int32> PackRequests(
+		TConstArrayView<int64> ElementSizes,
+		int64 BodyOverhead,
+		int64 MaxBodyBytes);
+
+	/** MaxAdminRequestKilobytes of the editor settings, in bytes. */
+	PFSTOREEDITOR_API int64 GetMaxRequestBodyBytes();
+
+	/** Bundles and containers that hand out drop tables, which must be published after them. */
+	PFSTOREEDITOR_API bool ReferencesDropTables(const FStoreItemRecord& Record);
+
+	/**
+	 * Adds a whole economy publish to Scheduler in as few round trips as the references allow:
+	 * items that reference no drop table, in requests packed up to GetMaxRequestBodyBytes and sent
+	 * side by side; then the drop tables, which
+	 * drop those items; then the bundles and containers that hand out drop tables. Bodies are
+	 * serialized from Records and DropTables, which must not change until the scheduler finishes.
+	 * With a Journal, every request is planned in it with the ids and hashes it carries and marked
+	 * once it lands; the plan is flushed before this returns.
+	 */
+	PFSTOREEDITOR_API void AddPublishTasks(
+		FPFAdminScheduler& Scheduler,
+		TSharedRef<const TArray<FStoreItemRecord>> Records,
+		TSharedRef<const TArray<FDropTableInfo>> DropTables,
+		const FString& CatalogVersion,
+		TSharedPtr<FPFUploadJournal> Journal = nullptr);
+
+	/** { "CatalogVersion": ... }, the body of GetCatalogItems and GetRandomResultTables. */
+	PFSTOREEDITOR_API void WriteCatalogVersionBody(
+		const FString& CatalogVersion,
+		TArray<uint8>& OutBody);
+
+	/** Reads data.Catalog of a GetCatalogItems response into records. Safe to call off the game thread. */
+	PFSTOREEDITOR_API bool ParseGetCatalogItemsResponse(
+		TConstArrayView<uint8> Response,
+		TArray<FStoreItemRecord>& OutRecords,
+		FString& OutError);
+
+	/** Reads data.Tables of a GetRandomResultTables response, sorted by TableId. Safe to call off the game thread. */
+	PFSTOREEDITOR_API bool ParseGetRandomResultTablesResponse(
+		TConstArrayView<uint8> Response,
+		TArray<FDropTableInfo>& OutDropTables,
+		FString& OutError);
+
+	/** Builds the runtime FStoreCatalog from the given provider assets and writes it as a cooked blob. */
+	PFSTOREEDITOR_API bool CookCatalog(
+		const TArray<TWeakObjectPtr<UObject>>& Items,
+		const TArray<TWeakObjectPtr<UObject>>& DropTables,
+		const FString& FilePath);
+
+	PFSTOREEDITOR_API bool CookRecords(
+		const TArray<FStoreItemRecord>& Records,
+		const TArray<FDropTableInfo>& DropTables,
+		const FString& FilePath);
+}
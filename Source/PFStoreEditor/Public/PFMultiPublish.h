@@ -0,0 +1,110 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PFAdminScheduler.h"
+#include "PFStoreEditorSettings.h"
+#include "PFUploadJournal.h"
+#include "StoreItemRecord.h"
+
+struct FDropTableInfo;
+
+/**
+ * Publishes one economy to several PlayFab titles at once, e.g. dev, staging and prod. Every item
+ * and drop table is formatted once (once per catalog version for items, which carry it) into an
+ * immutable fragment shared by all targets; a request body is only those fragments copied behind
+ * a short header. Each target gets what changed since its last publish from this machine, tracked
+ * by content hash in Saved/PFStore/Published, and runs its own admin request schedule, so the
+ * titles are published side by side, each within its own rate limit.
+ */
+class PFSTOREEDITOR_API FPFMultiPublish : public TSharedFromThis<FPFMultiPublish>
+{
+public:
+	enum class ETargetState : uint8
+	{
+		Preparing,
+		Sending,
+		UpToDate,
+		Succeeded,
+		Failed,
+	};
+
+	struct FTargetStatus
+	{
+		FPFPublishTarget Target;
+		FString CatalogVersion;
+		ETargetState State = ETargetState::Preparing;
+		int32 NumItems = 0;
+		int32 NumDropTables = 0;
+		int32 NumRequests = 0;
+		int32 NumFinished = 0;
+		TArray<FString> Errors;
+
+		/** One line for the Upload tab. */
+		FString Describe() const;
+	};
+
+	using FOnFinished = TFunction<void(bool bSuccess)>;
+
+	/** The enabled targets of the editor settings. */
+	static TArray<FPFPublishTarget> GetEnabledTargets();
+
+	/** Id -> content hash of everything this machine published to the title and catalog version. */
+	static FString GetPublishedStatePath(const FString& TitleId, const FString& CatalogVersion);
+
+	/** Without bChangesOnly every target gets everything, e.g. after a title was edited elsewhere. */
+	FPFMultiPublish(TArray<FPFPublishTarget> InTargets, bool bInChangesOnly);
+
+	/**
+	 * Starts publishing; the object keeps itself alive until OnFinished has run on the game thread.
+	 * Records and DropTables must not change until then.
+	 */
+	void Run(TSharedRef<const TArray<FStoreItemRecord>> Records, TSharedRef<const TArray<FDropTableInfo>> DropTables, FOnFinished InOnFinished);
+
+	const TArray<FTargetStatus>& GetStatuses() const { return Statuses; }
+	bool IsRunning() const { return bRunning; }
+
+private:
+	/** Formatted once on a worker, then only read. */
+	struct FSerialized
+	{
+		TArray<uint64> ItemHashes;
+		TArray<uint64> TableHashes;
+		TMap<FString, TArray<TArray<uint8>>> ItemJsonByVersion;
+		TArray<TArray<uint8>> TableJson;
+	};
+
+	/** What one target gets: indices into the records and tables, items without table references first. */
+	struct FTargetPlan
+	{
+		TArray<int32> Items;
+		int32 NumPlainItems = 0;
+		TArray<int32> Tables;
+		FPFUploadJournal::FLanded Published;
+	};
+
+	void StartTargets(TSharedRef<const FSerialized> Serialized, TArray<FTargetPlan>&& Plans);
+	void OnTargetFinished(int32 Target, bool bSuccess, const TArray<FString>& Errors);
+	void FinishIfDone();
+
+	static bool LoadPublishedState(const FString& Path, FPFUploadJournal::FLanded& OutPublished);
+	static void SavePublishedState(const FString& Path, FPFUploadJournal::FLanded&& Published);
+
+	TArray<FTargetStatus> Statuses;
+	TArray<FPFAdminEndpoint> Endpoints;
+	bool bChangesOnly = true;
+
+	TSharedPtr<const TArray<FStoreItemRecord>> Records;
+	TSharedPtr<const TArray<FDropTableInfo>> DropTables;
+
+	/** Per target, updated as its requests land and saved once it finishes. */
+	TArray<TSharedRef<FPFUploadJournal::FLanded>> Published;
+
+	FOnFinished OnFinished;
+	int32 NumRunning = 0;
+	bool bRunning = false;
+
+	/** Holds the publish alive from Run until OnFinished. */
+	TSharedPtr<FPFMultiPublish> SelfWhileRunning;
+};
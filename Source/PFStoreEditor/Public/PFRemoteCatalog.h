@@ -0,0 +1,92 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemRecord.h"
+#include "StoreDropTableProvider.h"
+
+/** One download of a PlayFab catalog version. */
+struct PFSTOREEDITOR_API FPFRemoteCatalog
+{
+	FString CatalogVersion;
+	FDateTime FetchTime;
+
+	/** Hash of the two responses, so a refresh that brings nothing new is told apart cheaply. */
+	uint64 ContentHash = 0;
+
+	TArray<FStoreItemRecord> Items;
+	TArray<FDropTableInfo> DropTables;
+
+	bool Save(const FString& FilePath) const;
+
+	/** Null if the file is missing, corrupt or from another cache version. */
+	static TSharedPtr<FPFRemoteCatalog> Load(const FString& FilePath);
+};
+
+/**
+ * Local, versioned copy of the PlayFab catalogs, one binary file per catalog version under
+ * Saved/PFStore/RemoteCache. Readers get the cached copy immediately and a refresh runs in the
+ * background (stale-while-revalidate); responses are parsed into records on a worker thread.
+ */
+class PFSTOREEDITOR_API FPFRemoteCatalogCache
+{
+public:
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnRemoteCatalogUpdated, TSharedRef<const FPFRemoteCatalog>);
+	using FOnRefreshComplete = TFunction<void(bool bSuccess, const FString& Error)>;
+
+	static FPFRemoteCatalogCache& Get();
+
+	/** The cached catalog from memory or disk, null if this version was never fetched. */
+	TSharedPtr<const FPFRemoteCatalog> GetCached(const FString& CatalogVersion);
+
+	/**
+	 * Returns GetCached right away and, when that is missing or older than MaxAge, starts a refresh.
+	 * OnUpdated fires when the refresh brings different content.
+	 */
+	TSharedPtr<const FPFRemoteCatalog> GetAndRevalidate(const FString& CatalogVersion, FTimespan MaxAge);
+
+	/**
+	 * Downloads GetCatalogItems and GetRandomResultTables and replaces the cache. A refresh already
+	 * running for the version is joined, not repeated. OnComplete runs on the game thread.
+	 */
+	void Refresh(const FString& CatalogVersion, FOnRefreshComplete OnComplete = nullptr);
+
+	bool IsRefreshing(const FString& CatalogVersion) const;
+
+	FOnRemoteCatalogUpdated& OnUpdated() { return UpdatedEvent; }
+
+	static FString GetCacheFilePath(const FString& CatalogVersion);
+
+	/**
+	 * The catalog the editor and PlayFab last agreed on, the base of three-way merges. Null before
+	 * the first sync of the version; merges then treat every difference as a conflict, items
+	 * present on one side only included.
+	 */
+	TSharedPtr<const FPFRemoteCatalog> GetSyncBase(const FString& CatalogVersion);
+
+	/**
+	 * Records Items as synced, e.g. after uploading the editor's catalog or applying a merge to both
+	 * sides. DropTables null keeps those of the previous base.
+	 */
+	void SetSyncBase(const FString& CatalogVersion, TArray<FStoreItemRecord> Items, const TArray<FDropTableInfo>* DropTables = nullptr);
+
+	static FString GetSyncBaseFilePath(const FString& CatalogVersion);
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<const FPFRemoteCatalog> Catalog;
+		bool bDiskChecked = false;
+		bool bRefreshing = false;
+		TArray<FOnRefreshComplete> Waiters;
+
+		TSharedPtr<const FPFRemoteCatalog> SyncBase;
+		bool bSyncBaseChecked = false;
+	};
+
+	void FinishRefresh(const FString& CatalogVersion, TSharedPtr<FPFRemoteCatalog> Catalog, const FString& Error);
+
+	TMap<FString, FEntry> Entries;
+	FOnRemoteCatalogUpdated UpdatedEvent;
+};
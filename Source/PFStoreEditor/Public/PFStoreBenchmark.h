@@ -0,0 +1,48 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemRecord.h"
+#include "StoreDropTableProvider.h"
+
+class FJsonObject;
+
+/**
+ * Deterministic synthetic catalogs shaped like production ones: Zipf-distributed tags, a few
+ * bundles and containers with skewed fan-out, drop tables nested a few levels deep and CustomData
+ * from a handful of bytes up to a few kilobytes.
+ */
+struct PFSTOREEDITOR_API FPFStoreSyntheticCatalog
+{
+	static void Generate(int32 NumItems, int32 Seed, TArray<FStoreItemRecord>& OutItems, TArray<FDropTableInfo>& OutDropTables);
+};
+
+struct FPFStoreBenchmarkOptions
+{
+	TArray<int32> Sizes = { 1000, 10000, 100000 };
+	int32 Iterations = 5;
+	int32 Seed = 1;
+
+	/** Stage results from a previous run to compare against, empty to skip the comparison. */
+	FString BaselinePath;
+
+	/** Where to store this run as the new baseline, empty to skip. */
+	FString WriteBaselinePath;
+
+	/** Allowed slowdown or allocation growth relative to the baseline, 0.2 = 20%. */
+	double Tolerance = 0.2;
+};
+
+/**
+ * Times each stage of the catalog pipeline (CSV and JSON export and import, diff, upload request
+ * preparation through the SDK models and directly, validation, cook) on synthetic catalogs.
+ * Reports throughput, p50/p99 latency and allocation counts per stage, and flags stages that
+ * regressed against a baseline.
+ */
+class PFSTOREEDITOR_API FPFStoreBenchmark
+{
+public:
+	/** Fills OutResult with the report. Returns the number of regressions against the baseline. */
+	static int32 Run(const FPFStoreBenchmarkOptions& Options, TSharedRef<FJsonObject> OutResult, TArray<FString>& OutErrors);
+};
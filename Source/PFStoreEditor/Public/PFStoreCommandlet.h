@@ -0,0 +1,56 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PFStoreCommandlet.generated.h"
+
+/** Process exit codes of the PFStore commandlet, stable for CI scripts. */
+enum class EPFStoreCommandletResult : int32
+{
+	Success = 0,
+	UsageError = 1,
+	ValidationFailed = 2,
+	DifferencesFound = 3,
+	IoError = 4,
+	RemoteError = 5,
+	BenchmarkRegression = 6,
+};
+
+/**
+ * Headless catalog pipeline for build machines:
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=PFStore -Mode=<Mode> [options] [-Json=Result.json]
+ *
+ * Modes
+ *   Export    -Out=Catalog.csv|.json        provider assets to CSV or PlayFab catalog JSON
+ *   Cook      -Out=StoreCatalog.pfcat       provider assets (or -In=file) to the runtime blob
+ *   Import    -In=Catalog.csv|.json         parse and validate a file as Upload would send it
+ *   Validate  [-In=file]                    check assets or a file
+ *   Diff      [-In=file] -Against=Remote|file
+ *                                           local catalog against PlayFab or another file
+ *   BulkEdit  -Edit="Price.GD += 10%" [-Where=<query>] [-Ids=a,b] [-DryRun] [-NoSave]
+ *                                           edit the provider assets the query selects, see FStoreBulkEdit
+ *   Upload    [-In=file] [-DryRun] [-Force] [-Out=Body.json] [-Resume]
+ *                                           validate, then UpdateCatalogItems; -Resume sends
+ *                                           only what an unfinished publish did not land
+ *   Benchmark [-Sizes=1000,10000,100000] [-Iterations=5] [-Seed=1] [-Baseline=in.json]
+ *             [-WriteBaseline=out.json] [-Tolerance=0.2]
+ *                                           time every pipeline stage on synthetic catalogs
+ *
+ * Files are CSV, or PlayFab catalog JSON when the extension is .json.
+ * Remote modes take -CatalogVersion (defaults to the editor settings), -TitleId and the developer
+ * secret from the environment variable named by -SecretEnv (PLAYFAB_DEVELOPER_SECRET by default).
+ * The result is one JSON object, written to -Json or the log.
+ */
+UCLASS()
+class PFSTOREEDITOR_API UPFStoreCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPFStoreCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -6,6 +6,42 @@
 #include "Engine/DeveloperSettings.h"
 #include "PFStoreEditorSettings.generated.h"
 
+/** Content-Encoding of admin request bodies. */
+UENUM()
+enum class EPFRequestCompression : uint8
+{
+    None,
+    Gzip,
+    Deflate,
+};
+
+/** A PlayFab title the economy can be published to alongside the others, e.g. dev, staging and prod. */
+USTRUCT()
+struct PFSTOREEDITOR_API FPFPublishTarget
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, config, Category = "PublishTarget")
+    FString Name;
+
+    UPROPERTY(EditAnywhere, config, Category = "PublishTarget")
+    FString TitleId;
+
+    /**
+     * Environment variable holding the title's developer secret key, which is never stored in config.
+     * When empty, the secret of the PlayFab plugin settings is used for the title configured there.
+     */
+    UPROPERTY(EditAnywhere, config, Category = "PublishTarget")
+    FString SecretKeyEnvVar;
+
+    /** Empty publishes to DefaultCatalogVersion. */
+    UPROPERTY(EditAnywhere, config, Category = "PublishTarget")
+    FString CatalogVersion;
+
+    UPROPERTY(EditAnywhere, config, Category = "PublishTarget")
+    bool bEnabled = true;
+};
+
 UCLASS(config = Game, defaultconfig, meta = (DisplayName = "PF Store Editor"))
 class PFSTOREEDITOR_API UPFStoreEditorSettings : public UDeveloperSettings
 {
@@ -33,4 +69,32 @@ public:
 
     UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings")
     FString DefaultCatalogVersion;
+
+    /** Compare & Merge shows the cached remote catalog and refetches it in the background once it is older than this. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings", meta = (ClampMin = "0", Units = "Minutes"))
+    int32 RemoteCacheMaxAgeMinutes;
+
+    /** Catalog snapshots kept per catalog version, one per export, upload and merge; older ones are dropped. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings", meta = (ClampMin = "2"))
+    int32 MaxCatalogHistorySnapshots;
+
+    /** Admin requests of a publish that may be in flight at once. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings", meta = (ClampMin = "1", ClampMax = "16"))
+    int32 MaxConcurrentAdminRequests;
+
+    /** Sustained admin request rate of a publish, kept under the title's PlayFab rate limit. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings", meta = (ClampMin = "0.1"))
+    float AdminRequestsPerSecond;
+
+    /** Publish requests are packed up to this size, measured before compression. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings", meta = (ClampMin = "16", Units = "Kilobytes"))
+    int32 MaxAdminRequestKilobytes;
+
+    /** Compresses admin request bodies on worker threads before they are sent; catalog JSON shrinks several times over. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings")
+    EPFRequestCompression AdminRequestCompression;
+
+    /** Titles "Publish to Targets" sends the economy to, each with its own credentials and catalog version. */
+    UPROPERTY(EditAnywhere, config, Category = "PFStoreEditorSettings", meta = (TitleProperty = "Name"))
+    TArray<FPFPublishTarget> PublishTargets;
 };
\ No newline at end of file
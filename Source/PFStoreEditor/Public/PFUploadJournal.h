@@ -0,0 +1,63 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Append-only record of a publish in progress, one file per catalog version under
+ * Saved/PFStore/UploadJournal. It holds every planned request with the ids and content hashes it
+ * carries, then a line per request that landed. A successful publish deletes the file, so a file
+ * left behind is a publish that was cut short and can be resumed: records whose id and hash show
+ * up in a landed request are not sent again.
+ */
+class PFSTOREEDITOR_API FPFUploadJournal
+{
+public:
+	/** What already reached PlayFab: id -> content hash of the version that landed. */
+	struct FLanded
+	{
+		TMap<FString, uint64> Items;
+		TMap<FString, uint64> DropTables;
+	};
+
+	static FString GetJournalPath(const FString& CatalogVersion);
+
+	/** Whether a publish of CatalogVersion was left unfinished. */
+	static bool HasUnfinished(const FString& CatalogVersion);
+
+	/** Reads what landed in the unfinished publish; false if there is none or the file is unreadable. */
+	static bool ReadLanded(const FString& CatalogVersion, FLanded& OutLanded);
+
+	/**
+	 * Opens the journal for a publish. A fresh publish starts a new file; bResume appends to the
+	 * unfinished one so what landed before stays on record. Null if the file cannot be written.
+	 */
+	static TSharedPtr<FPFUploadJournal> Begin(const FString& CatalogVersion, bool bResume);
+
+	~FPFUploadJournal();
+
+	/** Plans one request and returns its index for MarkLanded. Ids and Hashes are parallel. */
+	int32 AddRequest(bool bDropTables, TConstArrayView<FString> Ids, TConstArrayView<uint64> Hashes);
+
+	/** Landed marks of one frame are written together on the next tick. */
+	void MarkLanded(int32 Request);
+
+	/** Writes what is buffered, e.g. the plan right before the first request goes out. */
+	void Flush();
+
+	/** The publish succeeded: the journal is deleted. */
+	void Finish();
+
+private:
+	FPFUploadJournal() = default;
+
+	void Append(uint8 Type, TFunctionRef<void(FArchive&)> Write);
+
+	FString Path;
+	TUniquePtr<FArchive> Writer;
+	TArray<uint8> Pending;
+	int32 NumRequests = 0;
+	FTSTicker::FDelegateHandle FlushHandle;
+};
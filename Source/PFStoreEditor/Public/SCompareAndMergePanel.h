@@ -5,10 +5,23 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/SListView.h"
+#include "StoreItemRecord.h"
+#include "StoreDropTableProvider.h"
+#include "SStoreMergeGrid.h"
 
+struct FPFRemoteCatalog;
+struct FStoreCatalogSnapshot;
+
+/** One conflict the three-way merge left for a human. */
 struct FCompareDiffRow
 {
     FString ItemId;
+
+    /** Index of the type tab the row belongs to: Items, Bundles, Containers or DropTables. */
+    int32 TypeTab = 0;
+
+    /** Into Session->Result.Conflicts, or into DropTableConflicts for TypeTab 3. */
+    int32 ConflictIndex = INDEX_NONE;
 };
 using FCompareDiffRowPtr = TSharedPtr<FCompareDiffRow>;
 
@@ -20,10 +33,35 @@ public:
     SLATE_END_ARGS()
 
     void Construct(const FArguments& InArgs);
+    virtual ~SCompareAndMergePanel() override;
 
 private:
     bool bShowDiffs = false;
 
+    FString CatalogVersion;
+    TArray<FDropTableInfo> LocalDropTables;
+    TSharedPtr<const FPFRemoteCatalog> Remote;
+    FDelegateHandle RemoteUpdatedHandle;
+
+    /** What the editor is compared against: -1 for PlayFab, else an index into CompareSnapshots. */
+    TArray<TSharedPtr<int32>> CompareOptions;
+    TArray<TSharedRef<const FStoreCatalogSnapshot>> CompareSnapshots;
+    TSharedPtr<int32> SelectedCompareOption;
+
+    /** The snapshot shown in place of PlayFab, null when comparing with PlayFab. */
+    TSharedPtr<const FStoreCatalogSnapshot> CompareSnapshot;
+
+    /** What changed from CompareSnapshot to the newest snapshot, for the status line. */
+    FString SnapshotChangesText;
+
+    /** Everything one-sided is already merged here; rows are the unresolved conflicts. */
+    TSharedPtr<FStoreMergeSession> Session;
+
+    /** Bumped by RebuildDiffRows; a diff window opened before then belongs to a merge that no longer exists. */
+    int32 MergeGeneration = 0;
+    TArray<FDropTableInfo> MergedDropTables;
+    TArray<FString> DropTableConflicts;
+
     int32 CurrentTypeTabIndex = 0;
 
     TArray<FCompareDiffRowPtr> DiffRows;
@@ -49,6 +87,17 @@ private:
     EVisibility GetDiffsVisibility() const;
 
     void ApplyFilter();
+    void RebuildDiffRows();
+    void RefreshConflictRows();
+    FReply OnOpenMergeGridClicked();
+    FReply OnSaveToEditorClicked();
+    /** Applies the choices of a diff window opened for ItemId while MergeGeneration was Generation. */
+    void ResolveConflict(const FString& ItemId, int32 Generation, const TArray<FFieldDiffRowPtr>& Choices);
+    void OnRemoteCatalogUpdated(TSharedRef<const FPFRemoteCatalog> Catalog);
+    FText GetRemoteStatusText() const;
+    void RefreshCompareOptions();
+    FText GetCompareOptionText(TSharedPtr<int32> Option) const;
+    FString DescribeConflict(const FCompareDiffRow& Row) const;
 
     TSharedRef<SWidget> MakeTypeTabButton(const FString& Label, int32 Index);
 };
\ No newline at end of file
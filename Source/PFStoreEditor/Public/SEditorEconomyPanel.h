@@ -7,6 +7,7 @@
 #include "Widgets/Views/SListView.h"
 
 #include "StoreItemProvider.h"
+#include "StoreItemQuery.h"
 
 struct FEditorStoreRow
 {
@@ -25,6 +26,7 @@ public:
     SLATE_END_ARGS()
 
     void Construct(const FArguments& InArgs);
+    virtual ~SEditorEconomyPanel() override;
 
 private:
     TArray<FAssetData> PendingAssets;
@@ -37,6 +39,24 @@ private:
     TSharedPtr<SListView<FEditorStoreRowPtr>> ListView;
     bool bIsLoadingStore = false;
 
+    // Every loaded row; Rows is the subset matching the query.
+    TArray<FEditorStoreRowPtr> LoadedRows;
+
+    // Loaded items as a catalog the query runs over, QueryRows[i] being item i. Built on first query
+    // and dropped whenever a store asset is edited or deleted.
+    TSharedPtr<const FStoreCatalog> QueryCatalog;
+    TArray<FEditorStoreRowPtr> QueryRows;
+    FDelegateHandle ObjectChangedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    bool bQueryRefreshPending = false;
+
+    TSharedPtr<SEditableTextBox> QueryTextBox;
+    FStoreItemQuery Query;
+    FText QueryStatus;
+
+    // Edits applied to the items the query selects, see FStoreBulkEdit.
+    TSharedPtr<SEditableTextBox> BulkEditTextBox;
+
     TSharedPtr<SEditableTextBox> ExtractPathTextBox;
 
 private:
@@ -51,6 +71,7 @@ private:
 
     FReply OnExtractBrowseClicked();
     FReply OnExtractClicked();
+    FReply OnCookClicked();
     void OnRowDoubleClicked(FEditorStoreRowPtr Item);
 
     TSharedRef<ITableRow> OnGenerateRow(FEditorStoreRowPtr Item,
@@ -60,5 +81,14 @@ private:
     EVisibility GetListVisibility() const;
     bool HandleLoadStoreTick(float DeltaTime);
 
+    void OnQueryTextChanged(const FText& Text);
+    void ApplyQuery();
+    void BuildQueryCatalog();
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    EActiveTimerReturnType OnRefreshQueryTimer(double CurrentTime, float DeltaTime);
+
+    FReply OnBulkEditPreviewClicked();
+
     void LoadTestDataForCurrentType();
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "StoreBulkEdit.h"
+
+/** One changed field of one item in a bulk edit preview. */
+struct FBulkEditFieldRow
+{
+    int32 ItemIndex = INDEX_NONE;
+    FName Field;
+};
+using FBulkEditFieldRowPtr = TSharedPtr<FBulkEditFieldRow>;
+
+/**
+ * Dry run of a bulk edit: every field it would change, old and new value side by side. Nothing
+ * is written until Apply, which runs the whole preview as one undoable transaction.
+ */
+class SStoreBulkEditPreview : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SStoreBulkEditPreview) {}
+        SLATE_ARGUMENT(TSharedPtr<const FStoreBulkEditPreview>, Preview)
+        /** After Apply, with what it did. */
+        SLATE_EVENT(TDelegate<void(const FStoreApplyResult&)>, OnApplied)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    FReply OnApplyClicked();
+    FReply OnCancelClicked();
+    void CloseWindow();
+    FText GetSummaryText() const;
+
+    TSharedRef<ITableRow> OnGenerateRow(FBulkEditFieldRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+    TSharedPtr<const FStoreBulkEditPreview> Preview;
+    TDelegate<void(const FStoreApplyResult&)> OnApplied;
+
+    TArray<FBulkEditFieldRowPtr> Rows;
+    TSharedPtr<SListView<FBulkEditFieldRowPtr>> ListView;
+    bool bSave = false;
+};
@@ -4,8 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "StoreItemProvider.h"
+#include "StoreItemRecord.h"
 #include "StoreDropTableProvider.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class FPFMultiPublish;
 
 class SStoreManagerPanel : public SCompoundWidget
 {
@@ -31,13 +35,42 @@ private:
 
 	FReply OnUploadBrowseClicked();
 	FReply OnUploadClicked();
+	FReply OnResumeUploadClicked();
+
+	/** A journal of a publish that was cut short exists for the current catalog version. */
+	bool bHasUnfinishedUpload = false;
+
+	FReply OnPublishToTargetsClicked();
+	TSharedRef<ITableRow> GenerateTargetRow(TSharedPtr<int32> Row, const TSharedRef<STableViewBase>& OwnerTable);
+
+	/** The last publish to targets, kept for its status rows. */
+	TSharedPtr<FPFMultiPublish> MultiPublish;
+	TArray<TSharedPtr<int32>> TargetRows;
+	TSharedPtr<SListView<TSharedPtr<int32>>> TargetListView;
+	bool bPublishChangesOnly = true;
 
 	//bool PickFolderDialog(FString& OutFolder);
 	bool PickFileDialog(const FString& Title, const FString& DefaultPath, const FString& DefaultFile, const FString& FileTypes, FString& OutFile);
 	void ShowDiffWindow(TSharedPtr<FJsonObject> Left, TSharedPtr<FJsonObject> Right);
 
-	void UploadCatalogItemsToPlayFab(const FString& File);
-	void UploadCatalogDropTablesToPlayFab(const FString& File);
+	/**
+	 * Publishes the given CSV or JSON file, or the project's assets when File is empty: items and
+	 * drop tables through one dependency-ordered admin request schedule. Every publish is journaled;
+	 * bResume skips what already landed in the last, unfinished one.
+	 */
+	void UploadCatalogItemsToPlayFab(const FString& File, bool bResume = false);
+
+	/** Publishes File, or the project's assets, to every enabled publish target at once. */
+	void PublishToTargets(const FString& File);
+
+	/** With an empty File every store asset of the project is published to Destination; asks first. True to go ahead. */
+	static bool ConfirmProjectWideUpload(const FString& File, const FString& Destination);
+
+	/** The items of a CSV or JSON file, or of the project's assets when File is empty. */
+	static bool LoadRecordsForUpload(const FString& File, TArray<FStoreItemRecord>& OutRecords);
+
+	/** The drop tables of a JSON file, of the _DropTables.csv next to an items CSV, or of the project's assets. */
+	static void LoadDropTablesForUpload(const FString& File, TArray<FDropTableInfo>& OutTables);
 
 	//TODO: remove TEST
 	void ShowDiffWindow_Test();
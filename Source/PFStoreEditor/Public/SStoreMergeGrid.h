@@ -0,0 +1,91 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "DiffChoice.h"
+#include "PFHelpers.h"
+
+struct FPFRemoteCatalog;
+
+/** A three-way merge being resolved, shared by Compare & Merge and the merge grid. */
+struct FStoreMergeSession
+{
+    FString CatalogVersion;
+    TArray<FStoreItemRecord> Local;
+    TSharedPtr<const FPFRemoteCatalog> Remote;
+
+    FStoreMergeResult Result;
+
+    /** Per Result.Merged entry: dropped by a delete-vs-edit decision. */
+    TBitArray<> Removed;
+
+    /** Per Result.Conflicts entry: decided, no longer listed. */
+    TBitArray<> Resolved;
+
+    const FStoreItemRecord* GetLocal(const FStoreItemConflict& Conflict) const
+    {
+        return Conflict.LocalIndex != INDEX_NONE ? &Local[Conflict.LocalIndex] : nullptr;
+    }
+
+    const FStoreItemRecord* GetRemote(const FStoreItemConflict& Conflict) const;
+
+    /** Takes PlayFab's value of Field, or for Field None decides whether a delete-vs-edit item survives. */
+    void Apply(int32 ConflictIndex, FName Field, EDiffChoice Choice);
+
+    int32 NumUnresolved() const { return Resolved.Num() - Resolved.CountSetBits(); }
+};
+
+/** One (item, field) difference. Field None stands for keeping or dropping the whole item. */
+struct FMergeFieldRow
+{
+    int32 ConflictIndex = INDEX_NONE;
+    FName Field;
+    EDiffChoice Choice = EDiffChoice::Left;
+    bool bDecided = false;
+};
+using FMergeFieldRowPtr = TSharedPtr<FMergeFieldRow>;
+
+/**
+ * Every open conflict of a merge session as one (item, field) row, filterable by field, item
+ * type, class and id, with bulk decisions over all rows that pass the filter. Left is the
+ * editor, Right is PlayFab. Rows are plain data; widgets exist only for the visible ones.
+ */
+class SStoreMergeGrid : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SStoreMergeGrid) {}
+        SLATE_ARGUMENT(TSharedPtr<FStoreMergeSession>, Session)
+        /** After Apply wrote the decided rows into the session. */
+        SLATE_EVENT(FSimpleDelegate, OnApplied)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    void BuildRows();
+    void ApplyFilter();
+    bool PassesFilter(const FMergeFieldRow& Row, FName Field) const;
+    void DecideFiltered(EDiffChoice Choice);
+    FReply OnApplyClicked();
+    FText GetSummaryText() const;
+
+    TSharedRef<ITableRow> OnGenerateRow(FMergeFieldRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+    TSharedRef<SWidget> MakeFilterCombo(TArray<TSharedPtr<FString>>& Options, TSharedPtr<FString>& Selected);
+
+    TSharedPtr<FStoreMergeSession> Session;
+    FSimpleDelegate OnApplied;
+
+    TArray<FMergeFieldRowPtr> AllRows;
+    TArray<FMergeFieldRowPtr> Rows;
+    TSharedPtr<SListView<FMergeFieldRowPtr>> ListView;
+
+    TArray<TSharedPtr<FString>> FieldOptions;
+    TSharedPtr<FString> FieldFilter;
+    TArray<TSharedPtr<FString>> TypeOptions;
+    TSharedPtr<FString> TypeFilter;
+    FString ClassFilter;
+    FString SearchText;
+};
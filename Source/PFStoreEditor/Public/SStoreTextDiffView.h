@@ -0,0 +1,39 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "StoreTextDiff.h"
+
+/**
+ * Unified line diff of two values of one field, with the changed words of replaced lines
+ * highlighted. Only visible lines get widgets, so megabyte-sized values scroll smoothly.
+ */
+class SStoreTextDiffView : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SStoreTextDiffView) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    /** Shows "comparing" until the diff, computed off the game thread, is ready. */
+    void SetTexts(FName InField, const FString& Left, const FString& Right);
+
+private:
+    void OnDiffReady(TSharedRef<const FStoreTextDiff> InDiff);
+    FText GetHeaderText() const;
+
+    TSharedRef<ITableRow> OnGenerateLine(TSharedPtr<FStoreTextDiffLine> Line, const TSharedRef<STableViewBase>& OwnerTable);
+
+    FName Field;
+
+    /** Bumped by SetTexts so a slower, earlier diff does not replace the current one. */
+    uint32 RequestSerial = 0;
+
+    TSharedPtr<const FStoreTextDiff> Diff;
+    TArray<TSharedPtr<FStoreTextDiffLine>> Lines;
+    TSharedPtr<SListView<TSharedPtr<FStoreTextDiffLine>>> ListView;
+};
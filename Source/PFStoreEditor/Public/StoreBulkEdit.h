@@ -0,0 +1,98 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PFHelpers.h"
+
+enum class EStoreBulkEditOp : uint8
+{
+	Set,      // =
+	Add,      // +=, appends to lists
+	Subtract, // -=, removes from lists
+	Scale,    // *=, or += / -= with a percentage
+};
+
+/** One "Field Op Value" of a bulk edit. */
+struct FStoreBulkEditAction
+{
+	/** Diff field the action writes, as in FStoreItemChange::Fields. */
+	FName Field;
+
+	/** For the currency fields: VirtualCurrencyPrices, BundledVirtualCurrencies, VirtualCurrencyContents. */
+	FCurrencyCode Currency;
+
+	EStoreBulkEditOp Op = EStoreBulkEditOp::Set;
+
+	/** Value of a string field. */
+	FString Text;
+
+	/** Entries of a list field, from a comma separated value. */
+	TArray<FString> Values;
+
+	/** Value of a flag (0 or 1), integer or currency amount. */
+	int64 Number = 0;
+
+	/** For Scale. */
+	double Factor = 1.0;
+
+	/** "= none" on a currency field removes the currency. */
+	bool bRemove = false;
+};
+
+/** What a bulk edit would change, computed without touching an asset. */
+struct FStoreBulkEditPreview
+{
+	int32 NumSelected = 0;
+
+	/** Selected items some action was skipped on, e.g. a bundle field on an item that is not a bundle. */
+	int32 NumSkipped = 0;
+
+	/** The selected items the edit changes, before and after, sorted by ItemId. */
+	TArray<FStoreItemRecord> Before;
+	TArray<FStoreItemRecord> After;
+
+	/** Changed fields per item, parallel to Before and After. */
+	TArray<TArray<FName>> Fields;
+
+	int32 Num() const { return After.Num(); }
+	int32 NumFieldChanges() const;
+};
+
+/**
+ * Catalog-wide edit such as "+10% on every GD price of class Weapon":
+ *
+ *     Where:   Class == Weapon
+ *     Actions: Price.GD += 10%; Tags += Season3
+ *
+ * Items are selected with an FStoreItemQuery and/or a list of ids. Preview runs the actions on
+ * copies of the snapshot records on all cores and keeps the items that really change; Apply then
+ * writes exactly those into their assets in one undoable transaction.
+ */
+class PFSTOREEDITOR_API FStoreBulkEdit
+{
+public:
+	/** FStoreItemQuery expression; empty selects every item (or every listed id). */
+	FString Where;
+
+	/** Optional ids the selection is limited to. */
+	TArray<FString> ItemIds;
+
+	TArray<FStoreBulkEditAction> Actions;
+
+	/**
+	 * Parses "Price.GD *= 1.1; Tags += Season3; IsTradable = true" into Actions, separated by ';'
+	 * or new lines outside double quotes, so CustomData = "a;b" and CustomData = {"Note":"a;b"} are
+	 * one edit each. Numbers on UsagePeriod take the query's time units, e.g. "UsagePeriod = 1d".
+	 */
+	bool ParseActions(FStringView Text, FString* OutError = nullptr);
+
+	/** Dry run over Records, usually PFHelpers::SnapshotItems of the provider assets. */
+	bool Preview(TConstArrayView<FStoreItemRecord> Records, FStoreBulkEditPreview& OutPreview, FString* OutError = nullptr) const;
+
+	/** Writes Preview.After into the assets, see PFHelpers::ApplyRecordsToAssets. */
+	static bool Apply(const FStoreBulkEditPreview& Preview, bool bSave, FStoreApplyResult& OutResult);
+
+	/** One line per field ParseActions understands, for tooltips. */
+	static FString GetSyntaxHelp();
+};
@@ -0,0 +1,128 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StoreItemRecord.h"
+#include "StoreDropTableProvider.h"
+
+struct FPFRemoteCatalog;
+struct FStoreCatalogDiff;
+
+/**
+ * Immutable map ItemId -> record as a hash array mapped trie, 32 ways per level. Set and Remove
+ * return a new trie that shares every node off the changed path with this one, and records are
+ * shared by reference, so keeping many versions of a catalog costs one copy plus the changes.
+ * Every node carries a hash of its contents; Diff skips subtrees that are the same node or hash
+ * the same, so comparing two versions only walks where they differ.
+ */
+class PFSTOREEDITOR_API FStoreItemTrie
+{
+public:
+	using FRecordRef = TSharedRef<const FStoreItemRecord>;
+
+	int32 Num() const;
+	bool IsEmpty() const { return !Root.IsValid(); }
+
+	/** Null if there is no such item. OutContentHash receives the hash the record was added with. */
+	const FStoreItemRecord* Find(const FString& ItemId, uint64* OutContentHash = nullptr) const;
+
+	/** Adds or replaces Record. ContentHash is PFHelpers::HashRecord of it; Diff compares by it. */
+	FStoreItemTrie Set(FRecordRef Record, uint64 ContentHash) const;
+
+	FStoreItemTrie Remove(const FString& ItemId) const;
+
+	/** A trie of all Records at once, much faster than one Set each. ContentHashes is parallel to Records. */
+	static FStoreItemTrie Build(TConstArrayView<FRecordRef> Records, TConstArrayView<uint64> ContentHashes);
+
+	/** Visits every record in trie order, which is stable but not sorted. */
+	void ForEach(TFunctionRef<void(const FRecordRef& Record, uint64 ContentHash)> Visit) const;
+
+	/** Copies of all records, sorted by ItemId. */
+	TArray<FStoreItemRecord> ToArray() const;
+
+	/**
+	 * Calls Visit for every item added, removed or changed between From and To, with the old
+	 * record (null if added) and the new one (null if removed). Order is unspecified.
+	 */
+	static void Diff(const FStoreItemTrie& From, const FStoreItemTrie& To,
+		TFunctionRef<void(const FStoreItemRecord* Old, const FStoreItemRecord* New)> Visit);
+
+	/** Diff as a catalog diff of To against From, with the changed fields of each item. */
+	static void Diff(const FStoreItemTrie& From, const FStoreItemTrie& To, FStoreCatalogDiff& OutDiff);
+
+	struct FNode;
+
+private:
+	TSharedPtr<const FNode> Root;
+};
+
+enum class EStoreSnapshotSource : uint8
+{
+	Export,
+	Upload,
+	Merge,
+};
+
+/** The editor's catalog at one point in time. */
+struct PFSTOREEDITOR_API FStoreCatalogSnapshot
+{
+	FDateTime Time;
+	EStoreSnapshotSource Source = EStoreSnapshotSource::Export;
+	FString Label;
+
+	FStoreItemTrie Items;
+
+	/** Shared with the previous snapshot while the tables do not change. */
+	TSharedRef<const TArray<FDropTableInfo>> DropTables = MakeShared<TArray<FDropTableInfo>>();
+	uint64 DropTablesHash = 0;
+
+	/** "2025-06-03 14:12 Upload (50012 items)", for pickers. */
+	FString Describe() const;
+
+	/** The snapshot as a catalog Compare & Merge can diff the editor against. */
+	TSharedRef<const FPFRemoteCatalog> ToCatalog(const FString& CatalogVersion) const;
+};
+
+/**
+ * Snapshots of the editor's catalog, one per export, upload and merge, per catalog version. On
+ * disk each version is an append-only log under Saved/PFStore/History holding every snapshot as
+ * the records that changed since the previous one; loading replays it, which rebuilds the shared
+ * structure. Past MaxCatalogHistorySnapshots the oldest snapshots are folded away.
+ */
+class PFSTOREEDITOR_API FStoreCatalogHistory
+{
+public:
+	static FStoreCatalogHistory& Get();
+
+	static FString GetHistoryFilePath(const FString& CatalogVersion);
+
+	/** Oldest first, read from disk on first use. */
+	const TArray<TSharedRef<const FStoreCatalogSnapshot>>& GetSnapshots(const FString& CatalogVersion);
+
+	/**
+	 * Records the catalog as the newest snapshot and appends it to the log. Records equal to the
+	 * previous snapshot's are shared with it rather than copied.
+	 */
+	TSharedRef<const FStoreCatalogSnapshot> AddSnapshot(const FString& CatalogVersion, const TArray<FStoreItemRecord>& Records,
+		const TArray<FDropTableInfo>& DropTables, EStoreSnapshotSource Source, const FString& Label = FString());
+
+private:
+	struct FEntry
+	{
+		TArray<TSharedRef<const FStoreCatalogSnapshot>> Snapshots;
+		bool bLoaded = false;
+	};
+
+	FEntry& GetEntry(const FString& CatalogVersion);
+
+	/** Appends one snapshot as a delta against Previous; a new file starts with the header. */
+	static bool AppendToFile(const FString& FilePath, const FStoreCatalogSnapshot* Previous, const FStoreCatalogSnapshot& Snapshot);
+
+	/** Writes the file anew from Snapshots, after the oldest were dropped. */
+	static bool RewriteFile(const FString& FilePath, const TArray<TSharedRef<const FStoreCatalogSnapshot>>& Snapshots);
+
+	static void Load(const FString& FilePath, TArray<TSharedRef<const FStoreCatalogSnapshot>>& OutSnapshots);
+
+	TMap<FString, FEntry> Entries;
+};
@@ -0,0 +1,90 @@
+// MIT Licensed. Copyright (c) 2025 Olga Taranova
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EStoreDiffOp : uint8
+{
+	Equal,
+	Delete,
+	Insert,
+};
+
+/** A run of tokens with the same edit. Delete runs index Left, Insert runs index Right, Equal runs both. */
+struct FStoreDiffRun
+{
+	EStoreDiffOp Op = EStoreDiffOp::Equal;
+	int32 LeftStart = 0;
+	int32 RightStart = 0;
+	int32 Len = 0;
+};
+
+/** One line of a unified view of two texts. */
+struct FStoreTextDiffLine
+{
+	EStoreDiffOp Op = EStoreDiffOp::Equal;
+	FString Text;
+
+	/** For a line replaced by (or replacing) a line on the other side: character ranges that differ. */
+	TArray<TPair<int32, int32>> ChangedRanges;
+};
+
+struct FStoreTextDiff
+{
+	TArray<TSharedPtr<FStoreTextDiffLine>> Lines;
+	int32 NumDeleted = 0;
+	int32 NumInserted = 0;
+
+	/** Both sides parsed as JSON and were compared as canonical (sorted, one value per line) documents. */
+	bool bStructuralJson = false;
+};
+
+namespace StoreTextDiff
+{
+	/**
+	 * Myers' O(ND) shortest edit script between two token sequences (tokens compared by hash).
+	 * Scripts costlier than MaxCost edits degrade to replacing the differing middle as a whole.
+	 */
+	PFSTOREEDITOR_API void DiffTokens(
+		TConstArrayView<uint64> Left,
+		TConstArrayView<uint64> Right,
+		TArray<FStoreDiffRun>& OutRuns,
+		int32 MaxCost = 2048);
+
+	/**
+	 * Line diff of two texts, with word-level ranges inside replaced lines. With bTryJson, values
+	 * that both parse as JSON objects or arrays are canonicalized first, so key order and
+	 * formatting do not show up as changes.
+	 */
+	PFSTOREEDITOR_API TSharedRef<const FStoreTextDiff> DiffText(
+		const FString& Left,
+		const FString& Right,
+		bool bTryJson);
+
+	/** Whether a value is long enough that a whole-value cell cannot show what changed. */
+	PFSTOREEDITOR_API bool IsLongText(const FString& Value);
+}
+
+/**
+ * DiffText results keyed by the content hashes of both sides, computed on the thread pool. The
+ * same pair asked for while in flight is computed once.
+ */
+class PFSTOREEDITOR_API FStoreTextDiffCache
+{
+public:
+	using FOnDiffReady = TFunction<void(TSharedRef<const FStoreTextDiff> Diff)>;
+
+	static FStoreTextDiffCache& Get();
+
+	/** Calls OnReady right away when cached, otherwise on the game thread once the worker is done. */
+	void Request(const FString& Left, const FString& Right, bool bTryJson, FOnDiffReady OnReady);
+
+private:
+	using FKey = TTuple<uint64, uint64, bool>;
+
+	static constexpr int32 MaxEntries = 256;
+
+	TMap<FKey, TSharedPtr<const FStoreTextDiff>> Results;
+	TMap<FKey, TArray<FOnDiffReady>> Pending;
+};